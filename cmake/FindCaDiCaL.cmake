@@ -41,7 +41,18 @@ if(NOT CaDiCaL_FOUND_SYSTEM)
 
   fail_if_include_missing("sys/resource.h" "CaDiCaL")
 
-  set(CaDiCaL_VERSION "1.2.1")
+  # 1.5.0 is the first release with the external propagator interface
+  # (IPASIR-UP) that is required by --sat-solver=cadical
+  set(CaDiCaL_VERSION "1.9.5")
+  # the downloaded release tarball is only used if it has this checksum
+  set(CaDiCaL_SHA1 ""
+      CACHE STRING "SHA1 of the CaDiCaL ${CaDiCaL_VERSION} release tarball")
+  if(NOT CaDiCaL_SHA1)
+    message(FATAL_ERROR
+      "The checksum of the CaDiCaL ${CaDiCaL_VERSION} release tarball is not "
+      "pinned. Configure with -DCaDiCaL_SHA1=<sha1> or use a system install "
+      "of CaDiCaL ${CaDiCaL_VERSION}.")
+  endif()
 
   # avoid configure script and instantiate the makefile manually the configure
   # scripts unnecessarily fails for cross compilation thus we do the bare
@@ -58,7 +69,7 @@ if(NOT CaDiCaL_FOUND_SYSTEM)
     ${COMMON_EP_CONFIG}
     BUILD_IN_SOURCE ON
     URL https://github.com/arminbiere/cadical/archive/refs/tags/rel-${CaDiCaL_VERSION}.tar.gz
-    URL_HASH SHA1=9de1176737b74440921ba86395fe5edbb3b131eb
+    URL_HASH SHA1=${CaDiCaL_SHA1}
     CONFIGURE_COMMAND mkdir -p <SOURCE_DIR>/build
     # avoid configure script, prepare the makefile manually
     COMMAND ${CMAKE_COMMAND} -E copy <SOURCE_DIR>/makefile.in
@@ -42,6 +42,7 @@ The following flags enable optional features (disable with --no-<option name>).
   --muzzle                 complete silence (no non-result output)
   --coverage               support for gcov coverage testing
   --profiling              support for gprof profiling
+  --thread-safe-nodes      allow sharing a NodeManager between threads
   --unit-testing           support for unit testing
   --python2                force Python 2 (deprecated)
   --python-bindings        build Python bindings based on new C++ API
@@ -133,6 +134,7 @@ shared=default
 static_binary=default
 statistics=default
 symfpu=default
+thread_safe_nodes=default
 tracing=default
 tsan=default
 ubsan=default
@@ -259,6 +261,9 @@ do
     --symfpu) symfpu=ON;;
     --no-symfpu) symfpu=OFF;;
 
+    --thread-safe-nodes) thread_safe_nodes=ON;;
+    --no-thread-safe-nodes) thread_safe_nodes=OFF;;
+
     --tracing) tracing=ON;;
     --no-tracing) tracing=OFF;;
 
@@ -373,6 +378,8 @@ cmake_opts=""
   && cmake_opts="$cmake_opts -DENABLE_STATIC_BINARY=$static_binary"
 [ $statistics != default ] \
   && cmake_opts="$cmake_opts -DENABLE_STATISTICS=$statistics"
+[ $thread_safe_nodes != default ] \
+  && cmake_opts="$cmake_opts -DENABLE_THREAD_SAFE_NODES=$thread_safe_nodes"
 [ $tracing != default ] \
   && cmake_opts="$cmake_opts -DENABLE_TRACING=$tracing"
 [ $unit_testing != default ] \
@@ -46,6 +46,7 @@
 #include "expr/metakind.h"
 #include "expr/node.h"
 #include "expr/node_algorithm.h"
+#include "expr/node_dag_io.h"
 #include "expr/node_manager.h"
 #include "expr/sequence.h"
 #include "expr/type_node.h"
@@ -6242,6 +6243,98 @@ std::vector<Term> Solver::getAssertions(void) const
   CVC4_API_TRY_CATCH_END;
 }
 
+void Solver::exportTerms(const std::vector<Term>& terms,
+                         std::ostream& out) const
+{
+  NodeManagerScope scope(getNodeManager());
+  CVC4_API_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_TERMS(terms);
+  //////// all checks before this line
+  NodeDagWriter::write(out, Term::termVectorToNodes(terms));
+  ////////
+  CVC4_API_TRY_CATCH_END;
+}
+
+std::vector<Term> Solver::importTerms(const char* data,
+                                      size_t size,
+                                      std::vector<Term>& symbols,
+                                      std::vector<Sort>& sorts) const
+{
+  NodeManagerScope scope(getNodeManager());
+  CVC4_API_TRY_CATCH_BEGIN;
+  CVC4_API_ARG_CHECK_NOT_NULLPTR(data);
+  //////// all checks before this line
+  NodeDagReader reader(data, size);
+  reader.read();
+  for (const Node& n : reader.getSymbols())
+  {
+    symbols.push_back(Term(this, n));
+  }
+  for (const TypeNode& tn : reader.getSorts())
+  {
+    sorts.push_back(Sort(this, tn));
+  }
+  std::vector<Term> res;
+  for (const Node& n : reader.getRoots())
+  {
+    res.push_back(Term(this, n));
+  }
+  return res;
+  ////////
+  CVC4_API_TRY_CATCH_END;
+}
+
+void Solver::saveCheckpoint(std::ostream& out, bool learnedClauses) const
+{
+  NodeManagerScope scope(getNodeManager());
+  CVC4_API_TRY_CATCH_BEGIN;
+  CVC4_API_CHECK(d_smtEngine->getOptions()[options::checkpoints])
+      << "Cannot save a checkpoint unless checkpoints are enabled (use "
+         "--checkpoints)";
+  //////// all checks before this line
+  d_smtEngine->saveCheckpoint(out, learnedClauses);
+  ////////
+  CVC4_API_TRY_CATCH_END;
+}
+
+void Solver::restoreCheckpoint(const char* data,
+                               size_t size,
+                               std::vector<Term>& symbols,
+                               std::vector<Sort>& sorts) const
+{
+  NodeManagerScope scope(getNodeManager());
+  CVC4_API_TRY_CATCH_BEGIN;
+  CVC4_API_ARG_CHECK_NOT_NULLPTR(data);
+  CVC4_API_CHECK(d_smtEngine->getOptions()[options::checkpoints])
+      << "Cannot restore a checkpoint unless checkpoints are enabled (use "
+         "--checkpoints)";
+  //////// all checks before this line
+  std::vector<Node> syms;
+  std::vector<TypeNode> tns;
+  d_smtEngine->restoreCheckpoint(data, size, syms, tns);
+  for (const Node& n : syms)
+  {
+    symbols.push_back(Term(this, n));
+  }
+  for (const TypeNode& tn : tns)
+  {
+    sorts.push_back(Sort(this, tn));
+  }
+  ////////
+  CVC4_API_TRY_CATCH_END;
+}
+
+std::map<std::string, double> Solver::getStatisticsSnapshot() const
+{
+  CVC4_API_TRY_CATCH_BEGIN;
+  //////// all checks before this line
+  std::vector<std::pair<std::string, double>> values;
+  d_smtEngine->sampleStatistics(values);
+  return std::map<std::string, double>(values.begin(), values.end());
+  ////////
+  CVC4_API_TRY_CATCH_END;
+}
+
 /**
  *  ( get-info <info_flag> )
  */
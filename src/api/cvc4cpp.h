@@ -3189,6 +3189,76 @@ class CVC4_EXPORT Solver
    */
   std::vector<Term> getAssertions() const;
 
+  /**
+   * Write the given terms, together with the sorts, symbols and datatype
+   * declarations they contain, to out in a compact binary format, which can
+   * be read by importTerms() of this or another solver.
+   * Terms of parametric datatypes, tuples, records, sort constructors and of
+   * floating-point arithmetic are not supported.
+   * @param terms the terms to export
+   * @param out the output stream
+   */
+  void exportTerms(const std::vector<Term>& terms, std::ostream& out) const;
+
+  /**
+   * Read terms that were written by exportTerms(). The data are read in a
+   * single pass, i.e., they may be the contents of a memory-mapped file.
+   * The symbols, uninterpreted sorts and datatypes of the exported terms are
+   * created afresh in this solver, with the same names.
+   * @param data the exported terms
+   * @param size the number of bytes of data
+   * @param symbols the free constants and functions of the exported terms,
+   *                in order of their first occurrence, are added to this
+   * @param sorts the uninterpreted sorts and datatypes of the exported terms
+   *              are added to this
+   * @return the imported terms, in the order they were exported
+   */
+  std::vector<Term> importTerms(const char* data,
+                                size_t size,
+                                std::vector<Term>& symbols,
+                                std::vector<Sort>& sorts) const;
+
+  /**
+   * Save a checkpoint of the state of this solver in the current scope to out,
+   * e.g., a file, from which restoreCheckpoint() of a fresh solver with the
+   * same logic and options restores it. The checkpoint contains the
+   * assertions, the result of preprocessing them, the theory lemmas that
+   * are not removable and, optionally, the clauses learned by the SAT solver.
+   * Requires to enable option 'checkpoints'. Saving the learned clauses is
+   * not supported with option 'sat-solver=cadical'.
+   * @param out the output stream
+   * @param learnedClauses whether to save the learned clauses
+   */
+  void saveCheckpoint(std::ostream& out, bool learnedClauses = false) const;
+
+  /**
+   * Restore a checkpoint that was saved by saveCheckpoint() into the current
+   * scope of this solver, without preprocessing its assertions again. The
+   * symbols, uninterpreted sorts and datatypes of the checkpoint are created
+   * afresh in this solver, with the same names.
+   * Requires to enable option 'checkpoints'.
+   * @param data the checkpoint
+   * @param size the number of bytes of data
+   * @param symbols the free constants and functions of the checkpoint are
+   *                added to this
+   * @param sorts the uninterpreted sorts and datatypes of the checkpoint are
+   *              added to this
+   */
+  void restoreCheckpoint(const char* data,
+                         size_t size,
+                         std::vector<Term>& symbols,
+                         std::vector<Sort>& sorts) const;
+
+  /**
+   * Get a snapshot of the counters and timers of this solver, which maps the
+   * name of each statistic to its value, in seconds for timers. Unlike the
+   * other methods of this class, this may be called by another thread while
+   * this solver is solving, e.g., to monitor a long-running checkSat() call.
+   * The snapshot is empty unless CVC4 was built with statistics support.
+   * @return the snapshot
+   */
+  std::map<std::string, double> getStatisticsSnapshot() const;
+
   /**
    * Get info from the solver.
    * SMT-LIB: ( get-info <info_flag> )
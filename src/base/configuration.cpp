@@ -89,6 +89,15 @@ bool Configuration::isStaticBuild()
 #endif
 }
 
+bool Configuration::isThreadSafeNodesBuild()
+{
+#if defined(CVC4_THREAD_SAFE_NODES)
+  return true;
+#else
+  return false;
+#endif
+}
+
 string Configuration::getPackageName() {
   return CVC4_PACKAGE_NAME;
 }
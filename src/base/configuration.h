@@ -79,6 +79,8 @@ public:
 
   static bool isStaticBuild();
 
+  static bool isThreadSafeNodesBuild();
+
   static std::string getPackageName();
 
   static std::string getVersionString();
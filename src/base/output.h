@@ -220,6 +220,8 @@ public:
   {
     return d_tags.find(tag) != d_tags.end();
   }
+  /** Whether some tag is enabled */
+  bool isAnyOn() const { return !d_tags.empty(); }
 
   std::ostream& setStream(std::ostream* os) { d_os = os; return *os; }
   std::ostream& getStream() const { return *d_os; }
@@ -346,6 +348,8 @@ public:
   {
     return d_tags.find(tag) != d_tags.end();
   }
+  /** Whether some tag is enabled */
+  bool isAnyOn() const { return !d_tags.empty(); }
 
   std::ostream& setStream(std::ostream* os) { d_os = os; return *d_os; }
   std::ostream& getStream() const { return *d_os; }
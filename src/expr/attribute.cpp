@@ -50,6 +50,7 @@ void AttributeManager::deleteAllAttributes(NodeValue* nv) {
   deleteFromTable(d_nodes, nv);
   deleteFromTable(d_types, nv);
   deleteFromTable(d_strings, nv);
+  d_denseNodes.erase(nv);
 }
 
 void AttributeManager::deleteAllAttributes() {
@@ -59,6 +60,9 @@ void AttributeManager::deleteAllAttributes() {
   deleteAllFromTable(d_nodes);
   deleteAllFromTable(d_types);
   deleteAllFromTable(d_strings);
+  d_inGarbageCollection = true;
+  d_denseNodes.clear();
+  d_inGarbageCollection = false;
 }
 
 void AttributeManager::deleteAttributes(const AttrIdVec& atids) {
@@ -96,6 +100,11 @@ void AttributeManager::deleteAttributes(const AttrIdVec& atids) {
     case AttrTableString:
       deleteAttributesFromTable(d_strings, ids);
       break;
+    case AttrTableDenseNode:
+      d_inGarbageCollection = true;
+      d_denseNodes.eraseAttributes(ids);
+      d_inGarbageCollection = false;
+      break;
 
     case AttrTableCDBool:
     case AttrTableCDUInt64:
@@ -98,7 +98,7 @@ class AttributeManager {
    * getTable<> is a helper template that gets the right table from an
    * AttributeManager given its type.
    */
-  template <class T, bool context_dep, class Enable>
+  template <class T, bool context_dep, bool dense, class Enable>
   friend struct getTable;
 
   bool d_inGarbageCollection;
@@ -125,6 +125,8 @@ public:
   AttrHash<TypeNode> d_types;
   /** Underlying hash table for string-valued attributes */
   AttrHash<std::string> d_strings;
+  /** Underlying dense table for node-valued DenseAttribute<>s */
+  AttrDenseTable<Node> d_denseNodes;
 
   /**
    * Get a particular attribute on a particular node.
@@ -233,7 +235,7 @@ namespace attr {
  * `std::enable_if` in the template parameter and the condition is false), the
  * instantiation is ignored due to the SFINAE rule.
  */
-template <class T, bool context_dep, class Enable = void>
+template <class T, bool context_dep, bool dense = false, class Enable = void>
 struct getTable;
 
 /** Access the "d_bools" member of AttributeManager. */
@@ -252,6 +254,7 @@ struct getTable<bool, false> {
 /** Access the "d_ints" member of AttributeManager. */
 template <class T>
 struct getTable<T,
+                false,
                 false,
                 // Use this specialization only for unsigned integers
                 typename std::enable_if<std::is_unsigned<T>::value>::type>
@@ -318,6 +321,19 @@ struct getTable<std::string, false> {
   }
 };
 
+/** Access the "d_denseNodes" member of AttributeManager. */
+template <>
+struct getTable<Node, false, true> {
+  static const AttrTableId id = AttrTableDenseNode;
+  typedef AttrDenseTable<Node> table_type;
+  static inline table_type& get(AttributeManager& am) {
+    return am.d_denseNodes;
+  }
+  static inline const table_type& get(const AttributeManager& am) {
+    return am.d_denseNodes;
+  }
+};
+
 }  // namespace attr
 
 // ATTRIBUTE MANAGER IMPLEMENTATIONS ===========================================
@@ -330,11 +346,13 @@ typename AttrKind::value_type
 AttributeManager::getAttribute(NodeValue* nv, const AttrKind&) const {
   typedef typename AttrKind::value_type value_type;
   typedef KindValueToTableValueMapping<value_type> mapping;
-  typedef typename getTable<value_type, AttrKind::context_dependent>::
-            table_type table_type;
+  typedef typename getTable<value_type,
+                            AttrKind::context_dependent,
+                            AttrKind::dense>::table_type table_type;
 
   const table_type& ah =
-    getTable<value_type, AttrKind::context_dependent>::get(*this);
+    getTable<value_type, AttrKind::context_dependent, AttrKind::dense>::get(
+        *this);
   typename table_type::const_iterator i =
     ah.find(std::make_pair(AttrKind::getId(), nv));
 
@@ -373,11 +391,13 @@ struct HasAttribute<true, AttrKind> {
     typedef typename AttrKind::value_type value_type;
     typedef KindValueToTableValueMapping<value_type> mapping;
     typedef typename getTable<value_type,
-                              AttrKind::context_dependent>::table_type
+                              AttrKind::context_dependent,
+                              AttrKind::dense>::table_type
       table_type;
 
     const table_type& ah =
-      getTable<value_type, AttrKind::context_dependent>::get(*am);
+      getTable<value_type, AttrKind::context_dependent, AttrKind::dense>::get(
+          *am);
     typename table_type::const_iterator i =
       ah.find(std::make_pair(AttrKind::getId(), nv));
 
@@ -401,11 +421,13 @@ struct HasAttribute<false, AttrKind> {
                                   NodeValue* nv) {
     typedef typename AttrKind::value_type value_type;
     //typedef KindValueToTableValueMapping<value_type> mapping;
-    typedef typename getTable<value_type, AttrKind::context_dependent>::
-              table_type table_type;
+    typedef typename getTable<value_type,
+                              AttrKind::context_dependent,
+                              AttrKind::dense>::table_type table_type;
 
     const table_type& ah =
-      getTable<value_type, AttrKind::context_dependent>::get(*am);
+      getTable<value_type, AttrKind::context_dependent, AttrKind::dense>::get(
+          *am);
     typename table_type::const_iterator i =
       ah.find(std::make_pair(AttrKind::getId(), nv));
 
@@ -421,11 +443,13 @@ struct HasAttribute<false, AttrKind> {
                                   typename AttrKind::value_type& ret) {
     typedef typename AttrKind::value_type value_type;
     typedef KindValueToTableValueMapping<value_type> mapping;
-    typedef typename getTable<value_type, AttrKind::context_dependent>::
-              table_type table_type;
+    typedef typename getTable<value_type,
+                              AttrKind::context_dependent,
+                              AttrKind::dense>::table_type table_type;
 
     const table_type& ah =
-      getTable<value_type, AttrKind::context_dependent>::get(*am);
+      getTable<value_type, AttrKind::context_dependent, AttrKind::dense>::get(
+          *am);
     typename table_type::const_iterator i =
       ah.find(std::make_pair(AttrKind::getId(), nv));
 
@@ -461,11 +485,13 @@ AttributeManager::setAttribute(NodeValue* nv,
                                const typename AttrKind::value_type& value) {
   typedef typename AttrKind::value_type value_type;
   typedef KindValueToTableValueMapping<value_type> mapping;
-  typedef typename getTable<value_type, AttrKind::context_dependent>::
-            table_type table_type;
+  typedef typename getTable<value_type,
+                            AttrKind::context_dependent,
+                            AttrKind::dense>::table_type table_type;
 
   table_type& ah =
-      getTable<value_type, AttrKind::context_dependent>::get(*this);
+      getTable<value_type, AttrKind::context_dependent, AttrKind::dense>::get(
+        *this);
   ah[std::make_pair(AttrKind::getId(), nv)] = mapping::convert(value);
 }
 
@@ -495,7 +521,8 @@ template <class AttrKind>
 AttributeUniqueId AttributeManager::getAttributeId(const AttrKind& attr){
   typedef typename AttrKind::value_type value_type;
   AttrTableId tableId = getTable<value_type,
-                                 AttrKind::context_dependent>::id;
+                                 AttrKind::context_dependent,
+                                 AttrKind::dense>::id;
   return AttributeUniqueId(tableId, attr.getId());
 }
 
@@ -546,12 +573,14 @@ void AttributeManager::reconstructTable(AttrHash<T>& table){
 template <class AttrKind>
 inline typename AttrKind::value_type
 NodeManager::getAttribute(expr::NodeValue* nv, const AttrKind&) const {
+  Lock guard = lock();
   return d_attrManager->getAttribute(nv, AttrKind());
 }
 
 template <class AttrKind>
 inline bool NodeManager::hasAttribute(expr::NodeValue* nv,
                                       const AttrKind&) const {
+  Lock guard = lock();
   return d_attrManager->hasAttribute(nv, AttrKind());
 }
 
@@ -559,6 +588,7 @@ template <class AttrKind>
 inline bool
 NodeManager::getAttribute(expr::NodeValue* nv, const AttrKind&,
                           typename AttrKind::value_type& ret) const {
+  Lock guard = lock();
   return d_attrManager->getAttribute(nv, AttrKind(), ret);
 }
 
@@ -566,18 +596,21 @@ template <class AttrKind>
 inline void
 NodeManager::setAttribute(expr::NodeValue* nv, const AttrKind&,
                           const typename AttrKind::value_type& value) {
+  Lock guard = lock();
   d_attrManager->setAttribute(nv, AttrKind(), value);
 }
 
 template <class AttrKind>
 inline typename AttrKind::value_type
 NodeManager::getAttribute(TNode n, const AttrKind&) const {
+  Lock guard = lock();
   return d_attrManager->getAttribute(n.d_nv, AttrKind());
 }
 
 template <class AttrKind>
 inline bool
 NodeManager::hasAttribute(TNode n, const AttrKind&) const {
+  Lock guard = lock();
   return d_attrManager->hasAttribute(n.d_nv, AttrKind());
 }
 
@@ -585,6 +618,7 @@ template <class AttrKind>
 inline bool
 NodeManager::getAttribute(TNode n, const AttrKind&,
                           typename AttrKind::value_type& ret) const {
+  Lock guard = lock();
   return d_attrManager->getAttribute(n.d_nv, AttrKind(), ret);
 }
 
@@ -592,18 +626,21 @@ template <class AttrKind>
 inline void
 NodeManager::setAttribute(TNode n, const AttrKind&,
                           const typename AttrKind::value_type& value) {
+  Lock guard = lock();
   d_attrManager->setAttribute(n.d_nv, AttrKind(), value);
 }
 
 template <class AttrKind>
 inline typename AttrKind::value_type
 NodeManager::getAttribute(TypeNode n, const AttrKind&) const {
+  Lock guard = lock();
   return d_attrManager->getAttribute(n.d_nv, AttrKind());
 }
 
 template <class AttrKind>
 inline bool
 NodeManager::hasAttribute(TypeNode n, const AttrKind&) const {
+  Lock guard = lock();
   return d_attrManager->hasAttribute(n.d_nv, AttrKind());
 }
 
@@ -611,6 +648,7 @@ template <class AttrKind>
 inline bool
 NodeManager::getAttribute(TypeNode n, const AttrKind&,
                           typename AttrKind::value_type& ret) const {
+  Lock guard = lock();
   return d_attrManager->getAttribute(n.d_nv, AttrKind(), ret);
 }
 
@@ -618,6 +656,7 @@ template <class AttrKind>
 inline void
 NodeManager::setAttribute(TypeNode n, const AttrKind&,
                           const typename AttrKind::value_type& value) {
+  Lock guard = lock();
   d_attrManager->setAttribute(n.d_nv, AttrKind(), value);
 }
 
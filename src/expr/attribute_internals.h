@@ -23,7 +23,11 @@
 #ifndef CVC4__EXPR__ATTRIBUTE_INTERNALS_H
 #define CVC4__EXPR__ATTRIBUTE_INTERNALS_H
 
+#include <bitset>
+#include <utility>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace cvc5 {
 namespace expr {
@@ -157,18 +161,141 @@ class AttrHash :
                                AttrHashFunction> {
 };/* class AttrHash<> */
 
+/**
+ * A paged array that maps NodeValue ids to values of type T.  Node ids are
+ * assigned consecutively, so nodes that are created around the same time
+ * share a page.  Pages are allocated on first use and released again when
+ * their last entry is erased, such that the memory for ids of long-dead
+ * nodes is returned.  A lookup is two array accesses instead of hashing.
+ */
+template <class T>
+class AttrPagedArray
+{
+ public:
+  AttrPagedArray() : d_size(0) {}
+
+  /** Get the entry for the given id, or NULL if there is none. */
+  T* find(uint64_t id)
+  {
+    Page* p = getPage(id);
+    return p != nullptr && p->d_present[offset(id)] ? &p->d_values[offset(id)]
+                                                    : nullptr;
+  }
+
+  /** Get the entry for the given id, or NULL if there is none. */
+  const T* find(uint64_t id) const
+  {
+    const Page* p = getPage(id);
+    return p != nullptr && p->d_present[offset(id)] ? &p->d_values[offset(id)]
+                                                    : nullptr;
+  }
+
+  /**
+   * Get the entry for the given id.  Inserts a default-constructed entry if
+   * there is none yet.
+   */
+  T& operator[](uint64_t id)
+  {
+    const size_t page = id >> PAGE_BITS;
+    if (page >= d_pages.size())
+    {
+      d_pages.resize(page + 1);
+    }
+    if (d_pages[page] == nullptr)
+    {
+      d_pages[page].reset(new Page());
+    }
+    Page& p = *d_pages[page];
+    const size_t i = offset(id);
+    if (!p.d_present[i])
+    {
+      // the slot may hold the value of an erased entry, or be uninitialized
+      p.d_values[i] = T();
+      p.d_present[i] = true;
+      ++p.d_size;
+      ++d_size;
+    }
+    return p.d_values[i];
+  }
+
+  /** Erase the entry for the given id, if any. */
+  void erase(uint64_t id)
+  {
+    Page* p = getPage(id);
+    const size_t i = offset(id);
+    if (p == nullptr || !p->d_present[i])
+    {
+      return;
+    }
+    // Destroying the value may trigger the deletion of other nodes, which
+    // erase their entries from this array.  Hence, the array is updated first
+    // and the old value is only destroyed on return.
+    T old = T();
+    std::swap(old, p->d_values[i]);
+    p->d_present[i] = false;
+    --d_size;
+    if (--p->d_size == 0)
+    {
+      d_pages[id >> PAGE_BITS].reset();
+    }
+  }
+
+  /** Erase all entries. */
+  void clear()
+  {
+    // see erase() on why the pages are destroyed last
+    std::vector<std::unique_ptr<Page>> pages;
+    pages.swap(d_pages);
+    d_size = 0;
+  }
+
+  /** Is the array empty? */
+  bool empty() const { return d_size == 0; }
+
+  /** The number of entries in the array. */
+  size_t size() const { return d_size; }
+
+ private:
+  /** Pages hold 2^PAGE_BITS consecutive ids. */
+  static const size_t PAGE_BITS = 10;
+  static const size_t PAGE_SIZE = size_t(1) << PAGE_BITS;
+
+  struct Page
+  {
+    Page() : d_size(0) {}
+    /** The values, only meaningful if marked as present. */
+    T d_values[PAGE_SIZE];
+    /** Which entries of this page are present. */
+    std::bitset<PAGE_SIZE> d_present;
+    /** The number of entries present in this page. */
+    size_t d_size;
+  };
+
+  static size_t offset(uint64_t id) { return id & (PAGE_SIZE - 1); }
+
+  Page* getPage(uint64_t id) const
+  {
+    const size_t page = id >> PAGE_BITS;
+    return page < d_pages.size() ? d_pages[page].get() : nullptr;
+  }
+
+  /** The pages, NULL if not allocated. */
+  std::vector<std::unique_ptr<Page>> d_pages;
+  /** The number of entries in all pages. */
+  size_t d_size;
+}; /* class AttrPagedArray<> */
+
 /**
  * In the case of Boolean-valued attributes we have a special
- * "AttrHash<bool>" to pack bits together in words.
+ * "AttrHash<bool>" to pack bits together in words.  Despite its name, the
+ * words are not hashed but stored densely by node id in an AttrPagedArray,
+ * since flags are queried on hot paths and are typically set on many nodes.
  */
 template <>
-class AttrHash<bool> :
-    protected std::unordered_map<NodeValue*,
-                                  uint64_t,
-                                  AttrBoolHashFunction> {
+class AttrHash<bool> {
 
-  /** A "super" type, like in Java, for easy reference below. */
-  typedef std::unordered_map<NodeValue*, uint64_t, AttrBoolHashFunction> super;
+  /** The underlying array of words. */
+  AttrPagedArray<uint64_t> d_words;
 
   /**
    * BitAccessor allows us to return a bit "by reference."  Of course,
@@ -207,29 +334,31 @@ class AttrHash<bool> :
    */
   class BitIterator {
 
-    std::pair<NodeValue* const, uint64_t>* d_entry;
+    NodeValue* d_nv;
+
+    uint64_t* d_word;
 
     uint64_t d_bit;
 
    public:
 
     BitIterator() :
-      d_entry(NULL),
+      d_nv(NULL),
+      d_word(NULL),
       d_bit(0) {
     }
 
-    BitIterator(std::pair<NodeValue* const, uint64_t>& entry, uint64_t bit)
-        : d_entry(&entry), d_bit(bit)
+    BitIterator(NodeValue* nv, uint64_t& word, uint64_t bit)
+        : d_nv(nv), d_word(&word), d_bit(bit)
     {
     }
 
     std::pair<NodeValue* const, BitAccessor> operator*() {
-      return std::make_pair(d_entry->first,
-                            BitAccessor(d_entry->second, d_bit));
+      return std::make_pair(d_nv, BitAccessor(*d_word, d_bit));
     }
 
     bool operator==(const BitIterator& b) {
-      return d_entry == b.d_entry && d_bit == b.d_bit;
+      return d_word == b.d_word && d_bit == b.d_bit;
     }
   };/* class AttrHash<bool>::BitIterator */
 
@@ -241,31 +370,33 @@ class AttrHash<bool> :
    */
   class ConstBitIterator {
 
-    const std::pair<NodeValue* const, uint64_t>* d_entry;
+    NodeValue* d_nv;
+
+    const uint64_t* d_word;
 
     uint64_t d_bit;
 
    public:
 
     ConstBitIterator() :
-      d_entry(NULL),
+      d_nv(NULL),
+      d_word(NULL),
       d_bit(0) {
     }
 
-    ConstBitIterator(const std::pair<NodeValue* const, uint64_t>& entry,
-                     uint64_t bit)
-        : d_entry(&entry), d_bit(bit)
+    ConstBitIterator(NodeValue* nv, const uint64_t& word, uint64_t bit)
+        : d_nv(nv), d_word(&word), d_bit(bit)
     {
     }
 
     std::pair<NodeValue* const, bool> operator*()
     {
-      return std::make_pair(
-          d_entry->first, (d_entry->second & GetBitSet(d_bit)) ? true : false);
+      return std::make_pair(d_nv,
+                            (*d_word & GetBitSet(d_bit)) ? true : false);
     }
 
     bool operator==(const ConstBitIterator& b) {
-      return d_entry == b.d_entry && d_bit == b.d_bit;
+      return d_word == b.d_word && d_bit == b.d_bit;
     }
   };/* class AttrHash<bool>::ConstBitIterator */
 
@@ -281,22 +412,16 @@ public:
   typedef ConstBitIterator const_iterator;
 
   /**
-   * Find the boolean value in the hash table.  Returns something ==
+   * Find the boolean value in the table.  Returns something ==
    * end() if not found.
    */
   BitIterator find(const std::pair<uint64_t, NodeValue*>& k) {
-    super::iterator i = super::find(k.second);
-    if(i == super::end()) {
+    uint64_t* word = d_words.find(k.second->getId());
+    if (word == nullptr)
+    {
       return BitIterator();
     }
-    /*
-    Debug.printf("boolattr",
-                 "underlying word at 0x%p looks like 0x%016llx, bit is %u\n",
-                 &(*i).second,
-                 (uint64_t)((*i).second),
-                 uint64_t(k.first));
-    */
-    return BitIterator(*i, k.first);
+    return BitIterator(k.second, *word, k.first);
   }
 
   /** The "off the end" iterator */
@@ -305,22 +430,16 @@ public:
   }
 
   /**
-   * Find the boolean value in the hash table.  Returns something ==
+   * Find the boolean value in the table.  Returns something ==
    * end() if not found.
    */
   ConstBitIterator find(const std::pair<uint64_t, NodeValue*>& k) const {
-    super::const_iterator i = super::find(k.second);
-    if(i == super::end()) {
+    const uint64_t* word = d_words.find(k.second->getId());
+    if (word == nullptr)
+    {
       return ConstBitIterator();
     }
-    /*
-    Debug.printf("boolattr",
-                 "underlying word at 0x%p looks like 0x%016llx, bit is %u\n",
-                 &(*i).second,
-                 (uint64_t)((*i).second),
-                 uint64_t(k.first));
-    */
-    return ConstBitIterator(*i, k.first);
+    return ConstBitIterator(k.second, *word, k.first);
   }
 
   /** The "off the end" const_iterator */
@@ -329,12 +448,11 @@ public:
   }
 
   /**
-   * Access the hash table using the underlying operator[].  Inserts
-   * the key into the table (associated to default value) if it's not
-   * already there.
+   * Access the table.  Inserts the key into the table (associated to
+   * default value) if it's not already there.
    */
   BitAccessor operator[](const std::pair<uint64_t, NodeValue*>& k) {
-    uint64_t& word = super::operator[](k.second);
+    uint64_t& word = d_words[k.second->getId()];
     return BitAccessor(word, k.first);
   }
 
@@ -342,27 +460,155 @@ public:
    * Delete all flags from the given node.
    */
   void erase(NodeValue* nv) {
-    super::erase(nv);
+    d_words.erase(nv->getId());
   }
 
   /**
-   * Clear the hash table.
+   * Clear the table.
    */
   void clear() {
-    super::clear();
+    d_words.clear();
   }
 
-  /** Is the hash table empty? */
+  /** Is the table empty? */
   bool empty() const {
-    return super::empty();
+    return d_words.empty();
   }
 
-  /** This is currently very misleading! */
+  /** The number of nodes with flags, not the number of flags. */
   size_t size() const {
-    return super::size();
+    return d_words.size();
   }
 };/* class AttrHash<bool> */
 
+/**
+ * The table underlying DenseAttribute<>s.  It holds one AttrPagedArray
+ * ("column") per attribute, indexed by the ids of the nodes.  It provides
+ * the subset of the AttrHash<> interface that the AttributeManager uses.
+ */
+template <class value_type>
+class AttrDenseTable
+{
+  /** An iterator to an entry, see AttrHash<bool>::BitIterator. */
+  template <class V>
+  class EntryIterator
+  {
+    NodeValue* d_nv;
+
+    V* d_value;
+
+   public:
+    EntryIterator() : d_nv(NULL), d_value(NULL) {}
+
+    EntryIterator(NodeValue* nv, V* value) : d_nv(nv), d_value(value) {}
+
+    std::pair<NodeValue* const, V&> operator*() const
+    {
+      return std::pair<NodeValue* const, V&>(d_nv, *d_value);
+    }
+
+    bool operator==(const EntryIterator& i) const
+    {
+      return d_value == i.d_value;
+    }
+  }; /* class AttrDenseTable<>::EntryIterator */
+
+  typedef AttrPagedArray<value_type> column_type;
+
+ public:
+  typedef EntryIterator<value_type> iterator;
+  typedef EntryIterator<const value_type> const_iterator;
+
+  /** Find the entry in the table.  Returns end() if not found. */
+  iterator find(const std::pair<uint64_t, NodeValue*>& k)
+  {
+    if (k.first >= d_columns.size())
+    {
+      return end();
+    }
+    return iterator(k.second, d_columns[k.first].find(k.second->getId()));
+  }
+
+  /** The "off the end" iterator */
+  iterator end() { return iterator(); }
+
+  /** Find the entry in the table.  Returns end() if not found. */
+  const_iterator find(const std::pair<uint64_t, NodeValue*>& k) const
+  {
+    if (k.first >= d_columns.size())
+    {
+      return end();
+    }
+    return const_iterator(k.second,
+                          d_columns[k.first].find(k.second->getId()));
+  }
+
+  /** The "off the end" const_iterator */
+  const_iterator end() const { return const_iterator(); }
+
+  /**
+   * Access the table.  Inserts the key into the table (associated to the
+   * default value) if it's not already there.
+   */
+  value_type& operator[](const std::pair<uint64_t, NodeValue*>& k)
+  {
+    if (k.first >= d_columns.size())
+    {
+      d_columns.resize(k.first + 1);
+    }
+    return d_columns[k.first][k.second->getId()];
+  }
+
+  /** Delete all attributes of the given node. */
+  void erase(NodeValue* nv)
+  {
+    const uint64_t id = nv->getId();
+    for (column_type& c : d_columns)
+    {
+      c.erase(id);
+    }
+  }
+
+  /** Delete the given attributes from all nodes. */
+  void eraseAttributes(const std::vector<uint64_t>& ids)
+  {
+    for (uint64_t id : ids)
+    {
+      if (id < d_columns.size())
+      {
+        d_columns[id].clear();
+      }
+    }
+  }
+
+  /** Clear the table. */
+  void clear()
+  {
+    for (column_type& c : d_columns)
+    {
+      c.clear();
+    }
+  }
+
+  /** Is the table empty? */
+  bool empty() const { return size() == 0; }
+
+  /** The number of entries in the table. */
+  size_t size() const
+  {
+    size_t size = 0;
+    for (const column_type& c : d_columns)
+    {
+      size += c.size();
+    }
+    return size;
+  }
+
+ private:
+  /** The columns, indexed by attribute id. */
+  std::vector<column_type> d_columns;
+}; /* class AttrDenseTable<> */
+
 }  // namespace attr
 
 // ATTRIBUTE IDENTIFIER ASSIGNMENT TEMPLATE ====================================
@@ -437,6 +683,9 @@ public:
    */
   static const bool context_dependent = context_dep;
 
+  /** Values of this attribute are stored in the table of its value type. */
+  static const bool dense = false;
+
   /**
    * Register this attribute kind and check that the ID is a valid ID
    * for bool-valued attributes.  Fail an assert if not.  Otherwise
@@ -485,6 +734,9 @@ public:
    */
   static const bool context_dependent = context_dep;
 
+  /** Flags are stored in AttrHash<bool>, which is dense by itself. */
+  static const bool dense = false;
+
   /**
    * Register this attribute kind and check that the ID is a valid ID
    * for bool-valued attributes.  Fail an assert if not.  Otherwise
@@ -498,6 +750,53 @@ public:
   }
 };/* class Attribute<..., bool, ...> */
 
+/**
+ * An "attribute type" structure for attributes whose values are stored
+ * densely by node id (in an AttrDenseTable<>) instead of in the hash table of
+ * their value type.  This makes lookups cheaper at the price of memory for
+ * every node id in the range the attribute is set on.  Use it only for
+ * attributes that are set on most nodes and queried on hot paths, such as the
+ * rewrite caches.
+ *
+ * @param T the tag for the attribute kind.
+ *
+ * @param value_t the underlying value_type for the attribute kind
+ */
+template <class T, class value_t>
+class DenseAttribute
+{
+  /**
+   * The unique ID associated to this attribute.  Assigned statically,
+   * at load time.  These IDs index the columns of the dense table.
+   */
+  static const uint64_t s_id;
+
+ public:
+  /** The value type for this attribute. */
+  typedef value_t value_type;
+
+  /** Get the unique ID associated to this attribute. */
+  static inline uint64_t getId() { return s_id; }
+
+  /** @see Attribute::has_default_value */
+  static const bool has_default_value = false;
+
+  /** Dense attributes are never context-dependent. */
+  static const bool context_dependent = false;
+
+  /** Values of this attribute are stored in a dense table. */
+  static const bool dense = true;
+
+  /** Register this attribute kind and return its id. */
+  static inline uint64_t registerAttribute()
+  {
+    typedef typename attr::KindValueToTableValueMapping<
+        value_t>::table_value_type table_value_type;
+    return attr::LastAttributeId<attr::AttrDenseTable<table_value_type>,
+                                 false>::getNextId();
+  }
+}; /* class DenseAttribute<> */
+
 // ATTRIBUTE IDENTIFIER ASSIGNMENT =============================================
 
 /** Assign unique IDs to attributes at load time. */
@@ -511,6 +810,11 @@ template <class T, bool context_dep>
 const uint64_t Attribute<T, bool, context_dep>::s_id =
     Attribute<T, bool, context_dep>::registerAttribute();
 
+/** Assign unique IDs to attributes at load time. */
+template <class T, class value_t>
+const uint64_t DenseAttribute<T, value_t>::s_id =
+    DenseAttribute<T, value_t>::registerAttribute();
+
 }  // namespace expr
 }  // namespace cvc5
 
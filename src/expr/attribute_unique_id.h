@@ -33,6 +33,7 @@ enum AttrTableId {
   AttrTableNode,
   AttrTableTypeNode,
   AttrTableString,
+  AttrTableDenseNode,
   AttrTableCDBool,
   AttrTableCDUInt64,
   AttrTableCDTNode,
@@ -850,16 +850,19 @@ void NodeBuilder<nchild_thresh>::decrRefCounts() {
 
 template <unsigned nchild_thresh>
 TypeNode NodeBuilder<nchild_thresh>::constructTypeNode() {
+  NodeManager::Lock guard = d_nm->lock();
   return TypeNode(constructNV());
 }
 
 template <unsigned nchild_thresh>
 TypeNode NodeBuilder<nchild_thresh>::constructTypeNode() const {
+  NodeManager::Lock guard = d_nm->lock();
   return TypeNode(constructNV());
 }
 
 template <unsigned nchild_thresh>
 Node NodeBuilder<nchild_thresh>::constructNode() {
+  NodeManager::Lock guard = d_nm->lock();
   Node n = Node(constructNV());
   maybeCheckType(n);
   return n;
@@ -867,6 +870,7 @@ Node NodeBuilder<nchild_thresh>::constructNode() {
 
 template <unsigned nchild_thresh>
 Node NodeBuilder<nchild_thresh>::constructNode() const {
+  NodeManager::Lock guard = d_nm->lock();
   Node n = Node(constructNV());
   maybeCheckType(n);
   return n;
@@ -874,6 +878,7 @@ Node NodeBuilder<nchild_thresh>::constructNode() const {
 
 template <unsigned nchild_thresh>
 Node* NodeBuilder<nchild_thresh>::constructNodePtr() {
+  NodeManager::Lock guard = d_nm->lock();
   // maybeCheckType() can throw an exception. Make sure to call the destructor
   // on the exception branch.
   std::unique_ptr<Node> np(new Node(constructNV()));
@@ -883,6 +888,7 @@ Node* NodeBuilder<nchild_thresh>::constructNodePtr() {
 
 template <unsigned nchild_thresh>
 Node* NodeBuilder<nchild_thresh>::constructNodePtr() const {
+  NodeManager::Lock guard = d_nm->lock();
   std::unique_ptr<Node> np(new Node(constructNV()));
   maybeCheckType(*np.get());
   return np.release();
@@ -942,7 +948,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
     // reference counts in this case.
     nv->d_nchildren = 0;
     nv->d_kind = d_nv->d_kind;
-    nv->d_id = d_nm->next_id++;// FIXME multithreading
+    nv->d_id = d_nm->next_id++;
     nv->d_rc = 0;
     setUsed();
     if(Debug.isOn("gc")) {
@@ -1019,7 +1025,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
       }
       nv->d_nchildren = d_inlineNv.d_nchildren;
       nv->d_kind = d_inlineNv.d_kind;
-      nv->d_id = d_nm->next_id++;// FIXME multithreading
+      nv->d_id = d_nm->next_id++;
       nv->d_rc = 0;
 
       std::copy(d_inlineNv.d_children,
@@ -1073,7 +1079,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
 
       crop();
       expr::NodeValue* nv = d_nv;
-      nv->d_id = d_nm->next_id++;// FIXME multithreading
+      nv->d_id = d_nm->next_id++;
       d_nv = &d_inlineNv;
       d_nvMaxChildren = nchild_thresh;
       setUsed();
@@ -1122,7 +1128,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
     // reference counts in this case.
     nv->d_nchildren = 0;
     nv->d_kind = d_nv->d_kind;
-    nv->d_id = d_nm->next_id++;// FIXME multithreading
+    nv->d_id = d_nm->next_id++;
     nv->d_rc = 0;
     Debug("gc") << "creating node value " << nv
                 << " [" << nv->d_id << "]: " << *nv << "\n";
@@ -1196,7 +1202,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
       }
       nv->d_nchildren = d_inlineNv.d_nchildren;
       nv->d_kind = d_inlineNv.d_kind;
-      nv->d_id = d_nm->next_id++;// FIXME multithreading
+      nv->d_id = d_nm->next_id++;
       nv->d_rc = 0;
 
       std::copy(d_inlineNv.d_children,
@@ -1250,7 +1256,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
       }
       nv->d_nchildren = d_nv->d_nchildren;
       nv->d_kind = d_nv->d_kind;
-      nv->d_id = d_nm->next_id++;// FIXME multithreading
+      nv->d_id = d_nm->next_id++;
       nv->d_rc = 0;
 
       std::copy(d_nv->d_children,
@@ -0,0 +1,800 @@
+/*********************                                                        */
+/*! \file node_dag_io.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Binary export and import of node DAGs
+ **/
+
+#include "expr/node_dag_io.h"
+
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <set>
+#include <unordered_set>
+
+#include "base/exception.h"
+#include "expr/array_store_all.h"
+#include "expr/dtype.h"
+#include "expr/dtype_cons.h"
+#include "expr/dtype_selector.h"
+#include "expr/emptyset.h"
+#include "expr/node_manager.h"
+#include "expr/node_manager_attributes.h"
+#include "expr/uninterpreted_constant.h"
+#include "theory/sets/singleton_op.h"
+#include "util/bitvector.h"
+#include "util/rational.h"
+#include "util/string.h"
+
+namespace cvc5 {
+
+namespace {
+
+/** The header of the format, whose last byte is the version. */
+const char s_header[8] = {'C', 'V', 'C', '4', 'D', 'A', 'G', 1};
+
+/** The tags of the entries of the type table. */
+enum TypeTag : uint8_t
+{
+  TYPE_CONSTANT_TAG,
+  TYPE_BITVECTOR_TAG,
+  TYPE_SORT_TAG,
+  TYPE_DATATYPE_TAG,
+  TYPE_COMPOUND_TAG
+};
+
+/** The tags of the entries of the node table. */
+enum NodeTag : uint8_t
+{
+  NODE_VARIABLE_TAG,
+  NODE_DATATYPE_OP_TAG,
+  NODE_CONSTANT_TAG,
+  NODE_APPLY_TAG
+};
+
+/** The kinds of the operators of datatypes. */
+enum DatatypeOp : uint8_t
+{
+  DT_CONSTRUCTOR,
+  DT_SELECTOR,
+  DT_TESTER
+};
+
+/** Is k a type kind whose types are built from their component types? */
+bool isCompoundTypeKind(Kind k)
+{
+  switch (k)
+  {
+    case kind::FUNCTION_TYPE:
+    case kind::ARRAY_TYPE:
+    case kind::SET_TYPE:
+    case kind::SEQUENCE_TYPE:
+    case kind::BAG_TYPE: return true;
+    default: return false;
+  }
+}
+
+void putByte(std::string& buf, uint8_t b)
+{
+  buf.push_back(static_cast<char>(b));
+}
+
+void putNumber(std::string& buf, uint32_t n)
+{
+  for (unsigned i = 0; i < 4; ++i)
+  {
+    putByte(buf, (n >> (8 * i)) & 0xff);
+  }
+}
+
+void putString(std::string& buf, const std::string& s)
+{
+  putNumber(buf, s.size());
+  buf += s;
+}
+
+}  // namespace
+
+void NodeDagWriter::write(std::ostream& out, const std::vector<Node>& roots)
+{
+  NodeDagWriter w;
+  std::vector<uint32_t> rootIds;
+  for (const Node& r : roots)
+  {
+    rootIds.push_back(w.addNode(r));
+  }
+  w.writeDatatypes();
+
+  std::string buf(s_header, sizeof(s_header));
+  putNumber(buf, w.d_dts.size());
+  for (const TypeNode& tn : w.d_dts)
+  {
+    const DType& dt = tn.getDType();
+    putString(buf, dt.getName());
+    putByte(buf, dt.isCodatatype());
+  }
+  putNumber(buf, w.d_numTypes);
+  buf += w.d_types;
+  buf += w.d_dtDecls;
+  putNumber(buf, w.d_nodeIds.size());
+  buf += w.d_nodes;
+  putNumber(buf, rootIds.size());
+  for (uint32_t id : rootIds)
+  {
+    putNumber(buf, id);
+  }
+  out.write(buf.data(), buf.size());
+}
+
+uint32_t NodeDagWriter::addType(TypeNode tn)
+{
+  auto it = d_typeIds.find(tn);
+  if (it != d_typeIds.end())
+  {
+    return it->second;
+  }
+  std::string entry;
+  Kind k = tn.getKind();
+  if (k == kind::TYPE_CONSTANT)
+  {
+    putByte(entry, TYPE_CONSTANT_TAG);
+    putNumber(entry, tn.getConst<TypeConstant>());
+  }
+  else if (k == kind::BITVECTOR_TYPE)
+  {
+    putByte(entry, TYPE_BITVECTOR_TAG);
+    putNumber(entry, tn.getBitVectorSize());
+  }
+  else if (tn.isSort() && tn.getNumChildren() == 0)
+  {
+    putByte(entry, TYPE_SORT_TAG);
+    putString(entry, tn.getName());
+  }
+  else if (k == kind::DATATYPE_TYPE)
+  {
+    const DType& dt = tn.getDType();
+    if (dt.isParametric() || dt.isTuple() || dt.isRecord() || dt.isSygus())
+    {
+      throw Exception("cannot export the datatype " + dt.getName());
+    }
+    auto itd = d_dtIds.find(tn);
+    uint32_t slot;
+    if (itd == d_dtIds.end())
+    {
+      slot = d_dts.size();
+      d_dtIds[tn] = slot;
+      d_dts.push_back(tn);
+    }
+    else
+    {
+      slot = itd->second;
+    }
+    putByte(entry, TYPE_DATATYPE_TAG);
+    putNumber(entry, slot);
+  }
+  else if (isCompoundTypeKind(k))
+  {
+    std::vector<uint32_t> cids;
+    for (const TypeNode& c : tn)
+    {
+      cids.push_back(addType(c));
+    }
+    putByte(entry, TYPE_COMPOUND_TAG);
+    putNumber(entry, k);
+    putNumber(entry, cids.size());
+    for (uint32_t cid : cids)
+    {
+      putNumber(entry, cid);
+    }
+  }
+  else
+  {
+    throw Exception("cannot export the type " + tn.toString());
+  }
+  d_types += entry;
+  uint32_t id = d_numTypes++;
+  d_typeIds[tn] = id;
+  return id;
+}
+
+uint32_t NodeDagWriter::addNode(TNode n)
+{
+  std::vector<std::pair<TNode, bool>> visit;
+  visit.emplace_back(n, false);
+  while (!visit.empty())
+  {
+    TNode cur = visit.back().first;
+    bool childrenDone = visit.back().second;
+    visit.pop_back();
+    if (d_nodeIds.find(cur) != d_nodeIds.end())
+    {
+      continue;
+    }
+    if (childrenDone)
+    {
+      writeNode(cur);
+      continue;
+    }
+    visit.emplace_back(cur, true);
+    if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+    {
+      visit.emplace_back(cur.getOperator(), false);
+    }
+    else if (cur.getKind() == kind::STORE_ALL)
+    {
+      visit.emplace_back(cur.getConst<ArrayStoreAll>().getValue(), false);
+    }
+    for (const Node& child : cur)
+    {
+      visit.emplace_back(child, false);
+    }
+  }
+  return d_nodeIds[n];
+}
+
+void NodeDagWriter::writeNode(TNode n)
+{
+  std::string& buf = d_nodes;
+  Kind k = n.getKind();
+  kind::MetaKind mk = n.getMetaKind();
+  if (mk == kind::metakind::VARIABLE)
+  {
+    TypeNode tn = n.getType();
+    if (tn.isConstructor() || tn.isSelector() || tn.isTester())
+    {
+      // operators of datatypes are referred to by their indices
+      const DType& dt = DType::datatypeOf(n);
+      DatatypeOp op;
+      TypeNode dtt;
+      size_t cindex, sindex = 0;
+      Node expected;
+      if (tn.isConstructor())
+      {
+        op = DT_CONSTRUCTOR;
+        dtt = tn.getConstructorRangeType();
+        cindex = DType::indexOf(n);
+        expected = dt[cindex].getConstructor();
+      }
+      else if (tn.isSelector())
+      {
+        op = DT_SELECTOR;
+        dtt = tn.getSelectorDomainType();
+        cindex = DType::cindexOf(n);
+        sindex = DType::indexOf(n);
+        expected = dt[cindex][sindex].getSelector();
+      }
+      else
+      {
+        op = DT_TESTER;
+        dtt = tn.getTesterDomainType();
+        cindex = DType::indexOf(n);
+        expected = dt[cindex].getTester();
+      }
+      if (expected != n)
+      {
+        throw Exception("cannot export the datatype operator " + n.toString());
+      }
+      uint32_t dtId = addType(dtt);
+      putByte(buf, NODE_DATATYPE_OP_TAG);
+      putByte(buf, op);
+      putNumber(buf, dtId);
+      putNumber(buf, cindex);
+      putNumber(buf, sindex);
+    }
+    else if (k == kind::VARIABLE || k == kind::BOUND_VARIABLE
+             || k == kind::SKOLEM)
+    {
+      uint32_t typeId = addType(tn);
+      putByte(buf, NODE_VARIABLE_TAG);
+      putNumber(buf, k);
+      bool hasName = n.hasAttribute(expr::VarNameAttr());
+      putByte(buf, hasName);
+      putString(buf, hasName ? n.getAttribute(expr::VarNameAttr()) : "");
+      putNumber(buf, typeId);
+    }
+    else
+    {
+      throw Exception("cannot export the variable " + n.toString());
+    }
+  }
+  else if (mk == kind::metakind::CONSTANT)
+  {
+    putByte(buf, NODE_CONSTANT_TAG);
+    putNumber(buf, k);
+    switch (k)
+    {
+      case kind::CONST_BOOLEAN: putByte(buf, n.getConst<bool>()); break;
+      case kind::CONST_RATIONAL:
+        putString(buf, n.getConst<Rational>().toString());
+        break;
+      case kind::CONST_BITVECTOR:
+      {
+        const BitVector& bv = n.getConst<BitVector>();
+        putNumber(buf, bv.getSize());
+        putString(buf, bv.getValue().toString(16));
+        break;
+      }
+      case kind::CONST_STRING:
+      {
+        const std::vector<unsigned>& vec = n.getConst<String>().getVec();
+        putNumber(buf, vec.size());
+        for (unsigned c : vec)
+        {
+          putNumber(buf, c);
+        }
+        break;
+      }
+      case kind::BITVECTOR_EXTRACT_OP:
+      {
+        const BitVectorExtract& e = n.getConst<BitVectorExtract>();
+        putNumber(buf, e.d_high);
+        putNumber(buf, e.d_low);
+        break;
+      }
+      case kind::BITVECTOR_BITOF_OP:
+        putNumber(buf, n.getConst<BitVectorBitOf>().d_bitIndex);
+        break;
+      case kind::BITVECTOR_REPEAT_OP:
+        putNumber(buf, n.getConst<BitVectorRepeat>().d_repeatAmount);
+        break;
+      case kind::BITVECTOR_ZERO_EXTEND_OP:
+        putNumber(buf, n.getConst<BitVectorZeroExtend>().d_zeroExtendAmount);
+        break;
+      case kind::BITVECTOR_SIGN_EXTEND_OP:
+        putNumber(buf, n.getConst<BitVectorSignExtend>().d_signExtendAmount);
+        break;
+      case kind::BITVECTOR_ROTATE_LEFT_OP:
+        putNumber(buf, n.getConst<BitVectorRotateLeft>().d_rotateLeftAmount);
+        break;
+      case kind::BITVECTOR_ROTATE_RIGHT_OP:
+        putNumber(buf,
+                  n.getConst<BitVectorRotateRight>().d_rotateRightAmount);
+        break;
+      case kind::INT_TO_BITVECTOR_OP:
+        putNumber(buf, n.getConst<IntToBitVector>().d_size);
+        break;
+      case kind::STORE_ALL:
+      {
+        const ArrayStoreAll& asa = n.getConst<ArrayStoreAll>();
+        putNumber(buf, addType(asa.getType()));
+        putNumber(buf, d_nodeIds[asa.getValue()]);
+        break;
+      }
+      case kind::EMPTYSET:
+        putNumber(buf, addType(n.getConst<EmptySet>().getType()));
+        break;
+      case kind::SINGLETON_OP:
+        putNumber(buf, addType(n.getConst<SingletonOp>().getType()));
+        break;
+      case kind::UNINTERPRETED_CONSTANT:
+      {
+        const UninterpretedConstant& uc = n.getConst<UninterpretedConstant>();
+        putNumber(buf, addType(uc.getType()));
+        putString(buf, uc.getIndex().toString());
+        break;
+      }
+      default:
+        throw Exception("cannot export the constant " + n.toString());
+    }
+  }
+  else
+  {
+    putByte(buf, NODE_APPLY_TAG);
+    putNumber(buf, k);
+    bool hasOp = mk == kind::metakind::PARAMETERIZED;
+    putNumber(buf, n.getNumChildren() + (hasOp ? 1 : 0));
+    if (hasOp)
+    {
+      putNumber(buf, d_nodeIds[n.getOperator()]);
+    }
+    for (const Node& child : n)
+    {
+      putNumber(buf, d_nodeIds[child]);
+    }
+  }
+  uint32_t id = d_nodeIds.size();
+  d_nodeIds[n] = id;
+}
+
+void NodeDagWriter::writeDatatypes()
+{
+  std::unordered_set<std::string> names;
+  // writing the selectors may add further datatypes
+  for (size_t i = 0; i < d_dts.size(); ++i)
+  {
+    const DType& dt = d_dts[i].getDType();
+    // datatypes are resolved by their names when they are read
+    if (!names.insert(dt.getName()).second)
+    {
+      throw Exception("cannot export two datatypes named " + dt.getName());
+    }
+    putNumber(d_dtDecls, dt.getNumConstructors());
+    for (size_t c = 0, ncons = dt.getNumConstructors(); c < ncons; ++c)
+    {
+      const DTypeConstructor& cons = dt[c];
+      putString(d_dtDecls, cons.getName());
+      putNumber(d_dtDecls, cons.getNumArgs());
+      for (size_t s = 0, nargs = cons.getNumArgs(); s < nargs; ++s)
+      {
+        putString(d_dtDecls, cons[s].getName());
+        putNumber(d_dtDecls, addType(cons[s].getRangeType()));
+      }
+    }
+  }
+}
+
+NodeDagReader::NodeDagReader(const char* data, size_t size)
+    : d_data(data), d_end(data + size)
+{
+}
+
+uint8_t NodeDagReader::readByte()
+{
+  if (d_data == d_end)
+  {
+    throw Exception("unexpected end of the exported terms");
+  }
+  return static_cast<uint8_t>(*d_data++);
+}
+
+uint32_t NodeDagReader::readNumber()
+{
+  uint32_t n = 0;
+  for (unsigned i = 0; i < 4; ++i)
+  {
+    n |= static_cast<uint32_t>(readByte()) << (8 * i);
+  }
+  return n;
+}
+
+std::string NodeDagReader::readString()
+{
+  uint32_t size = readNumber();
+  if (static_cast<size_t>(d_end - d_data) < size)
+  {
+    throw Exception("unexpected end of the exported terms");
+  }
+  std::string s(d_data, size);
+  d_data += size;
+  return s;
+}
+
+TypeNode NodeDagReader::readType()
+{
+  uint32_t id = readNumber();
+  if (id >= d_types.size())
+  {
+    throw Exception("invalid type index in the exported terms");
+  }
+  return d_types[id];
+}
+
+Node NodeDagReader::readNode()
+{
+  uint32_t id = readNumber();
+  if (id >= d_nodes.size())
+  {
+    throw Exception("invalid term index in the exported terms");
+  }
+  return d_nodes[id];
+}
+
+Kind NodeDagReader::readKind()
+{
+  uint32_t k = readNumber();
+  if (k >= kind::LAST_KIND)
+  {
+    throw Exception("invalid kind in the exported terms");
+  }
+  return static_cast<Kind>(k);
+}
+
+void NodeDagReader::read()
+{
+  if (static_cast<size_t>(d_end - d_data) < sizeof(s_header)
+      || std::memcmp(d_data, s_header, sizeof(s_header)) != 0)
+  {
+    throw Exception("the data are not exported terms of this version");
+  }
+  d_data += sizeof(s_header);
+  readTypes();
+  for (uint32_t i = 0, size = readNumber(); i < size; ++i)
+  {
+    readNodeEntry();
+  }
+  for (uint32_t i = 0, size = readNumber(); i < size; ++i)
+  {
+    Node r = readNode();
+    // type check the DAG, which was built without checks
+    r.getType(true);
+    d_roots.push_back(r);
+  }
+}
+
+void NodeDagReader::readTypes()
+{
+  NodeManager* nm = NodeManager::currentNM();
+  // the datatypes are first read with placeholder sorts for themselves
+  std::vector<DType> dts;
+  std::vector<TypeNode> placeholders;
+  for (uint32_t i = 0, size = readNumber(); i < size; ++i)
+  {
+    std::string name = readString();
+    bool isCo = readByte() != 0;
+    dts.emplace_back(name, isCo);
+    placeholders.push_back(
+        nm->mkSort(name, NodeManager::SORT_FLAG_PLACEHOLDER));
+  }
+  for (uint32_t i = 0, size = readNumber(); i < size; ++i)
+  {
+    TypeNode tn;
+    switch (readByte())
+    {
+      case TYPE_CONSTANT_TAG:
+      {
+        uint32_t tc = readNumber();
+        if (tc >= LAST_TYPE)
+        {
+          throw Exception("invalid type constant in the exported terms");
+        }
+        tn = nm->mkTypeConst(static_cast<TypeConstant>(tc));
+        break;
+      }
+      case TYPE_BITVECTOR_TAG:
+      {
+        uint32_t width = readNumber();
+        if (width == 0)
+        {
+          throw Exception("invalid bit-width in the exported terms");
+        }
+        tn = nm->mkBitVectorType(width);
+        break;
+      }
+      case TYPE_SORT_TAG:
+        tn = nm->mkSort(readString());
+        d_sorts.push_back(tn);
+        break;
+      case TYPE_DATATYPE_TAG:
+      {
+        uint32_t slot = readNumber();
+        if (slot >= placeholders.size())
+        {
+          throw Exception("invalid datatype index in the exported terms");
+        }
+        tn = placeholders[slot];
+        break;
+      }
+      case TYPE_COMPOUND_TAG:
+      {
+        Kind k = readKind();
+        std::vector<TypeNode> children;
+        for (uint32_t j = 0, nchildren = readNumber(); j < nchildren; ++j)
+        {
+          children.push_back(readType());
+        }
+        if (!isCompoundTypeKind(k)
+            || children.size() < kind::metakind::getMinArityForKind(k)
+            || children.size() > kind::metakind::getMaxArityForKind(k))
+        {
+          throw Exception("invalid type in the exported terms");
+        }
+        tn = nm->mkTypeNode(k, children);
+        break;
+      }
+      default: throw Exception("invalid type in the exported terms");
+    }
+    d_types.push_back(tn);
+  }
+  if (dts.empty())
+  {
+    return;
+  }
+  for (DType& dt : dts)
+  {
+    for (uint32_t c = 0, ncons = readNumber(); c < ncons; ++c)
+    {
+      std::shared_ptr<DTypeConstructor> cons =
+          std::make_shared<DTypeConstructor>(readString());
+      for (uint32_t s = 0, nargs = readNumber(); s < nargs; ++s)
+      {
+        std::string name = readString();
+        cons->addArg(name, readType());
+      }
+      dt.addConstructor(cons);
+    }
+  }
+  std::set<TypeNode> unresolved(placeholders.begin(), placeholders.end());
+  std::vector<TypeNode> resolved = nm->mkMutualDatatypeTypes(dts, unresolved);
+  // replace the placeholders in the types read so far
+  for (TypeNode& tn : d_types)
+  {
+    tn = tn.substitute(placeholders.begin(),
+                       placeholders.end(),
+                       resolved.begin(),
+                       resolved.end());
+  }
+  d_sorts.insert(d_sorts.end(), resolved.begin(), resolved.end());
+}
+
+void NodeDagReader::readNodeEntry()
+{
+  NodeManager* nm = NodeManager::currentNM();
+  Node n;
+  switch (readByte())
+  {
+    case NODE_VARIABLE_TAG:
+    {
+      Kind k = readKind();
+      bool hasName = readByte() != 0;
+      std::string name = readString();
+      TypeNode tn = readType();
+      if (k == kind::VARIABLE)
+      {
+        n = hasName ? nm->mkVar(name, tn) : nm->mkVar(tn);
+        d_symbols.push_back(n);
+      }
+      else if (k == kind::BOUND_VARIABLE)
+      {
+        n = hasName ? nm->mkBoundVar(name, tn) : nm->mkBoundVar(tn);
+      }
+      else if (k == kind::SKOLEM)
+      {
+        n = nm->mkSkolem(hasName ? name : "k",
+                         tn,
+                         "imported skolem",
+                         NodeManager::SKOLEM_EXACT_NAME);
+      }
+      else
+      {
+        throw Exception("invalid variable in the exported terms");
+      }
+      break;
+    }
+    case NODE_DATATYPE_OP_TAG:
+    {
+      uint8_t op = readByte();
+      TypeNode tn = readType();
+      uint32_t cindex = readNumber();
+      uint32_t sindex = readNumber();
+      if (!tn.isDatatype() || cindex >= tn.getDType().getNumConstructors())
+      {
+        throw Exception("invalid datatype operator in the exported terms");
+      }
+      const DTypeConstructor& cons = tn.getDType()[cindex];
+      if (op == DT_CONSTRUCTOR)
+      {
+        n = cons.getConstructor();
+      }
+      else if (op == DT_SELECTOR && sindex < cons.getNumArgs())
+      {
+        n = cons[sindex].getSelector();
+      }
+      else if (op == DT_TESTER)
+      {
+        n = cons.getTester();
+      }
+      else
+      {
+        throw Exception("invalid datatype operator in the exported terms");
+      }
+      break;
+    }
+    case NODE_CONSTANT_TAG:
+    {
+      Kind k = readKind();
+      switch (k)
+      {
+        case kind::CONST_BOOLEAN: n = nm->mkConst(readByte() != 0); break;
+        case kind::CONST_RATIONAL:
+          n = nm->mkConst(Rational(readString()));
+          break;
+        case kind::CONST_BITVECTOR:
+        {
+          uint32_t size = readNumber();
+          n = nm->mkConst(BitVector(size, Integer(readString(), 16)));
+          break;
+        }
+        case kind::CONST_STRING:
+        {
+          std::vector<unsigned> vec;
+          for (uint32_t i = 0, size = readNumber(); i < size; ++i)
+          {
+            vec.push_back(readNumber());
+          }
+          n = nm->mkConst(String(vec));
+          break;
+        }
+        case kind::BITVECTOR_EXTRACT_OP:
+        {
+          uint32_t high = readNumber();
+          uint32_t low = readNumber();
+          n = nm->mkConst(BitVectorExtract(high, low));
+          break;
+        }
+        case kind::BITVECTOR_BITOF_OP:
+          n = nm->mkConst(BitVectorBitOf(readNumber()));
+          break;
+        case kind::BITVECTOR_REPEAT_OP:
+          n = nm->mkConst(BitVectorRepeat(readNumber()));
+          break;
+        case kind::BITVECTOR_ZERO_EXTEND_OP:
+          n = nm->mkConst(BitVectorZeroExtend(readNumber()));
+          break;
+        case kind::BITVECTOR_SIGN_EXTEND_OP:
+          n = nm->mkConst(BitVectorSignExtend(readNumber()));
+          break;
+        case kind::BITVECTOR_ROTATE_LEFT_OP:
+          n = nm->mkConst(BitVectorRotateLeft(readNumber()));
+          break;
+        case kind::BITVECTOR_ROTATE_RIGHT_OP:
+          n = nm->mkConst(BitVectorRotateRight(readNumber()));
+          break;
+        case kind::INT_TO_BITVECTOR_OP:
+          n = nm->mkConst(IntToBitVector(readNumber()));
+          break;
+        case kind::STORE_ALL:
+        {
+          TypeNode tn = readType();
+          Node value = readNode();
+          if (!tn.isArray() || !value.isConst())
+          {
+            throw Exception("invalid constant array in the exported terms");
+          }
+          n = nm->mkConst(ArrayStoreAll(tn, value));
+          break;
+        }
+        case kind::EMPTYSET: n = nm->mkConst(EmptySet(readType())); break;
+        case kind::SINGLETON_OP:
+          n = nm->mkConst(SingletonOp(readType()));
+          break;
+        case kind::UNINTERPRETED_CONSTANT:
+        {
+          TypeNode tn = readType();
+          n = nm->mkConst(UninterpretedConstant(tn, Integer(readString())));
+          break;
+        }
+        default: throw Exception("invalid constant in the exported terms");
+      }
+      break;
+    }
+    case NODE_APPLY_TAG:
+    {
+      Kind k = readKind();
+      std::vector<Node> children;
+      for (uint32_t i = 0, nchildren = readNumber(); i < nchildren; ++i)
+      {
+        children.push_back(readNode());
+      }
+      kind::MetaKind mk = kind::metaKindOf(k);
+      // the operator of parameterized kinds is the first child
+      size_t nargs = children.size();
+      if (mk == kind::metakind::PARAMETERIZED)
+      {
+        if (nargs == 0)
+        {
+          throw Exception("invalid term in the exported terms");
+        }
+        --nargs;
+      }
+      if ((mk != kind::metakind::OPERATOR
+           && mk != kind::metakind::PARAMETERIZED)
+          || nargs < kind::metakind::getMinArityForKind(k)
+          || nargs > kind::metakind::getMaxArityForKind(k))
+      {
+        throw Exception("invalid term in the exported terms");
+      }
+      n = nm->mkNode(k, children);
+      break;
+    }
+    default: throw Exception("invalid term in the exported terms");
+  }
+  d_nodes.push_back(n);
+}
+
+}  // namespace cvc5
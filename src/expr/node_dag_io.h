@@ -0,0 +1,142 @@
+/*********************                                                        */
+/*! \file node_dag_io.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Binary export and import of node DAGs
+ **
+ ** Writing the DAG of a set of nodes, with the sorts, symbols and datatype
+ ** declarations it contains, in a compact binary format, and reading it into
+ ** another node manager.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__EXPR__NODE_DAG_IO_H
+#define CVC4__EXPR__NODE_DAG_IO_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/type_node.h"
+
+namespace cvc5 {
+
+/**
+ * Writes the DAG of a set of nodes in the binary format read by
+ * NodeDagReader.
+ *
+ * The format consists of a header, followed by tables that each refer to the
+ * entries of the previous tables and to earlier entries of their own table
+ * by index:
+ * - the names of the datatypes of the DAG,
+ * - the types of the DAG, where datatypes refer to the first table,
+ * - the declarations of the datatypes, with the types of their selectors,
+ * - the nodes of the DAG, where each node occurs once, after its children,
+ * - the indices of the roots.
+ * Numbers are unsigned 32-bit little-endian integers and strings are
+ * prefixed by their length, hence a buffer holding the format (e.g., a
+ * memory-mapped file) can be read in a single pass.
+ *
+ * Supported are the nodes of the builtin, Boolean, arithmetic, bit-vector,
+ * array, string, set, bag and uninterpreted function theories, and of
+ * datatypes that are neither parametric, tuples nor records. Uninterpreted
+ * sorts must not have parameters.
+ */
+class NodeDagWriter
+{
+ public:
+  /**
+   * Write the DAG of roots to out. Throws an Exception if it contains a node
+   * or type that is not supported.
+   */
+  static void write(std::ostream& out, const std::vector<Node>& roots);
+
+ private:
+  NodeDagWriter() = default;
+  /** Add the type tn and its component types, return the index of tn. */
+  uint32_t addType(TypeNode tn);
+  /** Add the DAG of n, return the index of n. */
+  uint32_t addNode(TNode n);
+  /** Add the operator or constant leaf n, whose children have been added */
+  void writeNode(TNode n);
+  /** Add the declarations of all datatypes added so far */
+  void writeDatatypes();
+
+  /** The datatypes, by their index */
+  std::vector<TypeNode> d_dts;
+  std::unordered_map<TypeNode, uint32_t, TypeNodeHashFunction> d_dtIds;
+  /** The serialized types */
+  std::string d_types;
+  uint32_t d_numTypes = 0;
+  std::unordered_map<TypeNode, uint32_t, TypeNodeHashFunction> d_typeIds;
+  /** The serialized datatype declarations */
+  std::string d_dtDecls;
+  /** The serialized nodes */
+  std::string d_nodes;
+  std::unordered_map<TNode, uint32_t, TNodeHashFunction> d_nodeIds;
+};
+
+/**
+ * Reads a DAG written by NodeDagWriter into the current node manager.
+ * Symbols, bound variables, skolems, uninterpreted sorts and datatypes of the
+ * DAG are created afresh with the same names.
+ */
+class NodeDagReader
+{
+ public:
+  /** Read from the given buffer, which must outlive the reader. */
+  NodeDagReader(const char* data, size_t size);
+
+  /**
+   * Read the DAG, and type check its roots. Throws an Exception if the data
+   * is malformed or the roots are not well-typed.
+   */
+  void read();
+  /** The roots, in the order they were written */
+  const std::vector<Node>& getRoots() const { return d_roots; }
+  /**
+   * The free symbols (i.e., nodes of kind VARIABLE) of the DAG, in the order
+   * they were written
+   */
+  const std::vector<Node>& getSymbols() const { return d_symbols; }
+  /** The uninterpreted sorts and the datatypes of the DAG */
+  const std::vector<TypeNode>& getSorts() const { return d_sorts; }
+
+ private:
+  uint8_t readByte();
+  uint32_t readNumber();
+  std::string readString();
+  /** Read a type index, which must be less than d_types.size() */
+  TypeNode readType();
+  /** Read a node index, which must be less than d_nodes.size() */
+  Node readNode();
+  /** Read a kind, and check that it is a valid kind */
+  Kind readKind();
+  /** Read the datatype names, types and datatype declarations */
+  void readTypes();
+  /** Read a node entry */
+  void readNodeEntry();
+
+  /** The buffer */
+  const char* d_data;
+  const char* d_end;
+  /** The types and nodes read so far, by their index */
+  std::vector<TypeNode> d_types;
+  std::vector<Node> d_nodes;
+  std::vector<Node> d_roots;
+  std::vector<Node> d_symbols;
+  std::vector<TypeNode> d_sorts;
+};
+
+}  // namespace cvc5
+
+#endif /* CVC4__EXPR__NODE_DAG_IO_H */
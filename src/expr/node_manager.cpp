@@ -95,6 +95,7 @@ typedef expr::Attribute<attr::LambdaBoundVarListTag, Node> LambdaBoundVarListAtt
 NodeManager::NodeManager()
     : d_skManager(new SkolemManager),
       d_bvManager(new BoundVarManager),
+      d_maxPoolSize(0),
       next_id(0),
       d_attrManager(new expr::attr::AttributeManager()),
       d_nodeUnderDeletion(nullptr),
@@ -274,6 +275,7 @@ NodeManager::~NodeManager() {
 
 const DType& NodeManager::getDTypeForIndex(size_t index) const
 {
+  Lock guard = lock();
   // if this assertion fails, it is likely due to not managing datatypes
   // properly w.r.t. multiple NodeManagers.
   Assert(index < d_dtypes.size());
@@ -281,7 +283,7 @@ const DType& NodeManager::getDTypeForIndex(size_t index) const
 }
 
 void NodeManager::reclaimZombies() {
-  // FIXME multithreading
+  Lock guard = lock();
   Assert(!d_attrManager->inGarbageCollection());
 
   Debug("gc") << "reclaiming " << d_zombies.size() << " zombie(s)!\n";
@@ -504,6 +506,7 @@ TypeNode NodeManager::getType(TNode n, bool check)
 }
 
 Node NodeManager::mkSkolem(const std::string& prefix, const TypeNode& type, const std::string& comment, int flags) {
+  Lock guard = lock();
   Node n = NodeBuilder<0>(this, kind::SKOLEM);
   setAttribute(n, TypeAttr(), type);
   setAttribute(n, TypeCheckedAttr(), true);
@@ -569,6 +572,7 @@ std::vector<TypeNode> NodeManager::mkMutualDatatypeTypes(
     uint32_t flags)
 {
   NodeManagerScope nms(this);
+  Lock guard = lock();
   std::map<std::string, TypeNode> nameResolutions;
   std::vector<TypeNode> dtts;
 
@@ -801,6 +805,7 @@ TypeNode NodeManager::mkFunctionType(const std::vector<TypeNode>& argTypes,
 }
 
 TypeNode NodeManager::mkTupleType(const std::vector<TypeNode>& types) {
+  Lock guard = lock();
   std::vector< TypeNode > ts;
   Debug("tuprec-debug") << "Make tuple type : ";
   for (unsigned i = 0; i < types.size(); ++ i) {
@@ -813,6 +818,7 @@ TypeNode NodeManager::mkTupleType(const std::vector<TypeNode>& types) {
 }
 
 TypeNode NodeManager::mkRecordType(const Record& rec) {
+  Lock guard = lock();
   return d_rt_cache.getRecordType( this, rec );
 }
 
@@ -822,6 +828,7 @@ void NodeManager::reclaimAllZombies(){
 
 /** Reclaim zombies while there are more than k nodes in the pool (if possible).*/
 void NodeManager::reclaimZombiesUntil(uint32_t k){
+  Lock guard = lock();
   if(safeToReclaimZombies()){
     while(poolSize() >= k && !d_zombies.empty()){
       reclaimZombies();
@@ -834,6 +841,7 @@ size_t NodeManager::poolSize() const{
 }
 
 TypeNode NodeManager::mkSort(uint32_t flags) {
+  Lock guard = lock();
   NodeBuilder<1> nb(this, kind::SORT_TYPE);
   Node sortTag = NodeBuilder<0>(this, kind::SORT_TAG);
   nb << sortTag;
@@ -845,6 +853,7 @@ TypeNode NodeManager::mkSort(uint32_t flags) {
 }
 
 TypeNode NodeManager::mkSort(const std::string& name, uint32_t flags) {
+  Lock guard = lock();
   NodeBuilder<1> nb(this, kind::SORT_TYPE);
   Node sortTag = NodeBuilder<0>(this, kind::SORT_TAG);
   nb << sortTag;
@@ -859,6 +868,7 @@ TypeNode NodeManager::mkSort(const std::string& name, uint32_t flags) {
 TypeNode NodeManager::mkSort(TypeNode constructor,
                                     const std::vector<TypeNode>& children,
                                     uint32_t flags) {
+  Lock guard = lock();
   Assert(constructor.getKind() == kind::SORT_TYPE
          && constructor.getNumChildren() == 0)
       << "expected a sort constructor";
@@ -886,6 +896,7 @@ TypeNode NodeManager::mkSortConstructor(const std::string& name,
                                         size_t arity,
                                         uint32_t flags)
 {
+  Lock guard = lock();
   Assert(arity > 0);
   NodeBuilder<> nb(this, kind::SORT_TYPE);
   Node sortTag = NodeBuilder<0>(this, kind::SORT_TAG);
@@ -901,6 +912,7 @@ TypeNode NodeManager::mkSortConstructor(const std::string& name,
 
 Node NodeManager::mkVar(const std::string& name, const TypeNode& type)
 {
+  Lock guard = lock();
   Node n = NodeBuilder<0>(this, kind::VARIABLE);
   setAttribute(n, TypeAttr(), type);
   setAttribute(n, TypeCheckedAttr(), true);
@@ -913,6 +925,7 @@ Node NodeManager::mkVar(const std::string& name, const TypeNode& type)
 
 Node* NodeManager::mkVarPtr(const std::string& name, const TypeNode& type)
 {
+  Lock guard = lock();
   Node* n = NodeBuilder<0>(this, kind::VARIABLE).constructNodePtr();
   setAttribute(*n, TypeAttr(), type);
   setAttribute(*n, TypeCheckedAttr(), true);
@@ -1044,6 +1057,7 @@ Node NodeManager::mkChain(Kind kind, const std::vector<Node>& children)
 
 Node NodeManager::mkVar(const TypeNode& type)
 {
+  Lock guard = lock();
   Node n = NodeBuilder<0>(this, kind::VARIABLE);
   setAttribute(n, TypeAttr(), type);
   setAttribute(n, TypeCheckedAttr(), true);
@@ -1055,6 +1069,7 @@ Node NodeManager::mkVar(const TypeNode& type)
 
 Node* NodeManager::mkVarPtr(const TypeNode& type)
 {
+  Lock guard = lock();
   Node* n = NodeBuilder<0>(this, kind::VARIABLE).constructNodePtr();
   setAttribute(*n, TypeAttr(), type);
   setAttribute(*n, TypeCheckedAttr(), true);
@@ -1093,6 +1108,7 @@ Node NodeManager::mkBooleanTermVariable() {
 }
 
 Node NodeManager::mkNullaryOperator(const TypeNode& type, Kind k) {
+  Lock guard = lock();
   std::map< TypeNode, Node >::iterator it = d_unique_vars[k].find( type );
   if( it==d_unique_vars[k].end() ){
     Node n = NodeBuilder<0>(this, k).constructNode();
@@ -1129,6 +1145,7 @@ Node NodeManager::mkBag(const TypeNode& t, const TNode n, const TNode m)
 }
 
 Node NodeManager::mkAbstractValue(const TypeNode& type) {
+  Lock guard = lock();
   Node n = mkConst(AbstractValue(++d_abstractValueCount));
   n.setAttribute(TypeAttr(), type);
   n.setAttribute(TypeCheckedAttr(), true);
@@ -1136,11 +1153,11 @@ Node NodeManager::mkAbstractValue(const TypeNode& type) {
 }
 
 bool NodeManager::safeToReclaimZombies() const{
-  // FIXME multithreading
   return !d_inReclaimZombies && !d_attrManager->inGarbageCollection();
 }
 
 void NodeManager::deleteAttributes(const std::vector<const expr::attr::AttributeUniqueId*>& ids){
+  Lock guard = lock();
   d_attrManager->deleteAttributes(ids);
 }
 
@@ -13,6 +13,14 @@
  **
  ** A manager for Nodes.
  **
+ ** If CVC4 is configured with --thread-safe-nodes, a NodeManager may be
+ ** shared by several threads (each with its own NodeManagerScope).  In that
+ ** configuration, reference counts are updated atomically and the node pool,
+ ** the zombies, the node ids and the attribute tables are guarded by a
+ ** (recursive) lock of the NodeManager.  A node value found by a pool lookup
+ ** is referenced before this lock is released, such that a zombie is never
+ ** reclaimed while another thread is about to resurrect it.
+ **
  ** Reviewed by Chris Conway, Apr 5 2010 (bug #65).
  **/
 
@@ -26,9 +34,13 @@
 #ifndef CVC4__NODE_MANAGER_H
 #define CVC4__NODE_MANAGER_H
 
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <unordered_set>
+#ifdef CVC4_THREAD_SAFE_NODES
+#include <mutex>
+#endif
 
 #include "base/check.h"
 #include "expr/kind.h"
@@ -46,6 +58,7 @@ class SkolemManager;
 class BoundVarManager;
 
 class DType;
+class NodeDagReader;
 
 namespace expr {
   namespace attr {
@@ -87,6 +100,8 @@ class NodeManager
   friend class api::Solver;
   friend class expr::NodeValue;
   friend class expr::TypeChecker;
+  // for recreating the symbols of exported terms
+  friend class NodeDagReader;
 
   template <unsigned nchild_thresh>
   friend class NodeBuilder;
@@ -115,6 +130,26 @@ class NodeManager
 
   static thread_local NodeManager* s_current;
 
+#ifdef CVC4_THREAD_SAFE_NODES
+  /**
+   * Guards the node value pool, the zombies, the node ids, the attribute
+   * tables and the caches of this NodeManager.  It is recursive since e.g.
+   * reclaiming a zombie may zombify its children.
+   */
+  mutable std::recursive_mutex d_mutex;
+  /** A scoped lock on d_mutex */
+  typedef std::unique_lock<std::recursive_mutex> Lock;
+#else
+  /** Without thread-safe nodes, locking the NodeManager is a no-op. */
+  struct Lock
+  {
+    ~Lock() {}
+  };
+#endif
+
+  /** Lock this NodeManager for the lifetime of the returned object. */
+  inline Lock lock() const;
+
   /** The skolem manager */
   std::unique_ptr<SkolemManager> d_skManager;
   /** The bound variable manager */
@@ -122,6 +157,9 @@ class NodeManager
 
   NodeValuePool d_nodeValuePool;
 
+  /** The maximal size of d_nodeValuePool so far */
+  size_t d_maxPoolSize;
+
   size_t next_id;
 
   expr::attr::AttributeManager* d_attrManager;
@@ -266,7 +304,13 @@ class NodeManager
    * Register a NodeValue as a zombie.
    */
   inline void markForDeletion(expr::NodeValue* nv) {
+    Lock guard = lock();
+#ifdef CVC4_THREAD_SAFE_NODES
+    // another thread may have resurrected nv in the meantime, it is then
+    // skipped by reclaimZombies()
+#else
     Assert(nv->d_rc == 0);
+#endif
 
     // if d_reclaiming is set, make sure we don't call
     // reclaimZombies(), because it's already running.
@@ -298,6 +342,7 @@ class NodeManager
    * will live as long as its containing NodeManager.
    */
   inline void markRefCountMaxedOut(expr::NodeValue* nv) {
+    Lock guard = lock();
     Assert(nv->HasMaximizedReferenceCount());
     if(Debug.isOn("gc")) {
       Debug("gc") << "marking node value " << nv
@@ -389,6 +434,7 @@ class NodeManager
 
   /** Subscribe to NodeManager events */
   void subscribeEvents(NodeManagerListener* listener) {
+    Lock guard = lock();
     Assert(std::find(d_listeners.begin(), d_listeners.end(), listener)
            == d_listeners.end())
         << "listener already subscribed";
@@ -397,6 +443,7 @@ class NodeManager
 
   /** Unsubscribe from NodeManager events */
   void unsubscribeEvents(NodeManagerListener* listener) {
+    Lock guard = lock();
     std::vector<NodeManagerListener*>::iterator elt = std::find(d_listeners.begin(), d_listeners.end(), listener);
     Assert(elt != d_listeners.end()) << "listener not subscribed";
     d_listeners.erase(elt);
@@ -1085,6 +1132,9 @@ class NodeManager
   /** Size of the node pool. */
   size_t poolSize() const;
 
+  /** Maximal size of the node pool over the lifetime of this NodeManager. */
+  size_t maxPoolSize() const { return d_maxPoolSize; }
+
   /** Deletes a list of attributes from the NM's AttributeManager.*/
   void deleteAttributes(const std::vector< const expr::attr::AttributeUniqueId* >& ids);
 
@@ -1181,6 +1231,12 @@ inline TypeNode NodeManager::mkTesterType(TypeNode domain) {
   return mkTypeNode(kind::TESTER_TYPE, domain );
 }
 
+#ifdef CVC4_THREAD_SAFE_NODES
+inline NodeManager::Lock NodeManager::lock() const { return Lock(d_mutex); }
+#else
+inline NodeManager::Lock NodeManager::lock() const { return Lock(); }
+#endif
+
 inline expr::NodeValue* NodeManager::poolLookup(expr::NodeValue* nv) const {
   NodeValuePool::const_iterator find = d_nodeValuePool.find(nv);
   if(find == d_nodeValuePool.end()) {
@@ -1193,14 +1249,15 @@ inline expr::NodeValue* NodeManager::poolLookup(expr::NodeValue* nv) const {
 inline void NodeManager::poolInsert(expr::NodeValue* nv) {
   Assert(d_nodeValuePool.find(nv) == d_nodeValuePool.end())
       << "NodeValue already in the pool!";
-  d_nodeValuePool.insert(nv);// FIXME multithreading
+  d_nodeValuePool.insert(nv);
+  d_maxPoolSize = std::max(d_maxPoolSize, d_nodeValuePool.size());
 }
 
 inline void NodeManager::poolRemove(expr::NodeValue* nv) {
   Assert(d_nodeValuePool.find(nv) != d_nodeValuePool.end())
       << "NodeValue is not in the pool!";
 
-  d_nodeValuePool.erase(nv);// FIXME multithreading
+  d_nodeValuePool.erase(nv);
 }
 
 }  // namespace cvc5
@@ -1525,6 +1582,9 @@ NodeClass NodeManager::mkConstInternal(const T& val) {
   // This method indirectly calls `NodeValue::inc()`, which relies on having
   // the correct `NodeManager` in scope.
   NodeManagerScope nms(this);
+  // the lookup and the insertion into the pool must not be interleaved with
+  // other threads, the returned node is constructed while holding the lock
+  Lock guard = lock();
 
   // typedef typename kind::metakind::constantMap<T>::OwningTheory theory_t;
   NVStorage<1> nvStorage;
@@ -1560,7 +1620,7 @@ NodeClass NodeManager::mkConstInternal(const T& val) {
 
   nv->d_nchildren = 0;
   nv->d_kind = kind::metakind::ConstantMap<T>::kind;
-  nv->d_id = next_id++;// FIXME multithreading
+  nv->d_id = next_id++;
   nv->d_rc = 0;
 
   //OwningTheory::mkConst(val);
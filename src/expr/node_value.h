@@ -28,6 +28,9 @@
 
 #include <iterator>
 #include <string>
+#ifdef CVC4_THREAD_SAFE_NODES
+#include <atomic>
+#endif
 
 #include "expr/kind.h"
 #include "options/language.h"
@@ -331,6 +334,22 @@ class NodeValue
   /** The ID (0 is reserved for the null value) */
   uint64_t d_id : NBITS_ID;
 
+#ifdef CVC4_THREAD_SAFE_NODES
+  /** Kind of the expression */
+  uint32_t d_kind : NBITS_KIND;
+
+  /** Number of children */
+  uint32_t d_nchildren : NBITS_NCHILDREN;
+
+  /**
+   * The expression's reference count.  @see cvc4::Node.
+   *
+   * With thread-safe nodes, the reference count lives in its own word so that
+   * it can be updated atomically.  It is still bounded by MAX_RC, and the
+   * header keeps its size since the id and the kind share the first word.
+   */
+  std::atomic<uint32_t> d_rc;
+#else
   /** The expression's reference count.  @see cvc4::Node. */
   uint32_t d_rc : NBITS_REFCOUNT;
 
@@ -339,6 +358,7 @@ class NodeValue
 
   /** Number of children */
   uint32_t d_nchildren : NBITS_NCHILDREN;
+#endif
 
   /** Variable number of child nodes */
   NodeValue* d_children[0];
@@ -403,12 +423,19 @@ inline std::ostream& operator<<(std::ostream& out, const NodeValue& nv);
 namespace cvc5 {
 namespace expr {
 
+#ifdef CVC4_THREAD_SAFE_NODES
+inline NodeValue::NodeValue(int)
+    : d_id(0), d_kind(kind::NULL_EXPR), d_nchildren(0), d_rc(MAX_RC)
+{
+}
+#else
 inline NodeValue::NodeValue(int) :
   d_id(0),
   d_rc(MAX_RC),
   d_kind(kind::NULL_EXPR),
   d_nchildren(0) {
 }
+#endif
 
 inline void NodeValue::decrRefCounts() {
   for(nv_iterator i = nv_begin(); i != nv_end(); ++i) {
@@ -416,11 +443,57 @@ inline void NodeValue::decrRefCounts() {
   }
 }
 
+#ifdef CVC4_THREAD_SAFE_NODES
+
+inline void NodeValue::inc() {
+  Assert(!isBeingDeleted())
+      << "NodeValue is currently being deleted "
+         "and increment is being called on it. Don't Do That!";
+  // the reference count is sticky once it reaches MAX_RC, hence we cannot
+  // simply use fetch_add here
+  uint32_t rc = d_rc.load(std::memory_order_relaxed);
+  do
+  {
+    if (__builtin_expect((rc == MAX_RC), false))
+    {
+      return;
+    }
+  } while (!d_rc.compare_exchange_weak(rc, rc + 1, std::memory_order_relaxed));
+  if (__builtin_expect((rc == MAX_RC - 1), false))
+  {
+    Assert(NodeManager::currentNM() != NULL)
+        << "No current NodeManager on incrementing of NodeValue: "
+           "maybe a public CVC4 interface function is missing a "
+           "NodeManagerScope ?";
+    NodeManager::currentNM()->markRefCountMaxedOut(this);
+  }
+}
+
+inline void NodeValue::dec() {
+  uint32_t rc = d_rc.load(std::memory_order_relaxed);
+  do
+  {
+    if (__builtin_expect((rc == MAX_RC), false))
+    {
+      return;
+    }
+  } while (!d_rc.compare_exchange_weak(rc, rc - 1, std::memory_order_acq_rel));
+  if (__builtin_expect((rc == 1), false))
+  {
+    Assert(NodeManager::currentNM() != NULL)
+        << "No current NodeManager on destruction of NodeValue: "
+           "maybe a public CVC4 interface function is missing a "
+           "NodeManagerScope ?";
+    NodeManager::currentNM()->markForDeletion(this);
+  }
+}
+
+#else /* CVC4_THREAD_SAFE_NODES */
+
 inline void NodeValue::inc() {
   Assert(!isBeingDeleted())
       << "NodeValue is currently being deleted "
          "and increment is being called on it. Don't Do That!";
-  // FIXME multithreading
   if (__builtin_expect((d_rc < MAX_RC - 1), true)) {
     ++d_rc;
   } else if (__builtin_expect((d_rc == MAX_RC - 1), false)) {
@@ -434,7 +507,6 @@ inline void NodeValue::inc() {
 }
 
 inline void NodeValue::dec() {
-  // FIXME multithreading
   if(__builtin_expect( ( d_rc < MAX_RC ), true )) {
     --d_rc;
     if(__builtin_expect( ( d_rc == 0 ), false )) {
@@ -447,6 +519,8 @@ inline void NodeValue::dec() {
   }
 }
 
+#endif /* CVC4_THREAD_SAFE_NODES */
+
 inline NodeValue::nv_iterator NodeValue::nv_begin() {
   return d_children;
 }
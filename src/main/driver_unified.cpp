@@ -31,6 +31,7 @@
 #include "main/command_executor.h"
 #include "main/interactive_shell.h"
 #include "main/main.h"
+#include "main/portfolio.h"
 #include "main/signal_handlers.h"
 #include "main/time_limit.h"
 #include "options/options.h"
@@ -188,6 +189,9 @@ int runCvc4(int argc, char* argv[], Options& opts) {
 
   // Create the command executor to execute the parsed commands
   pExecutor = std::make_unique<CommandExecutor>(opts);
+  // The portfolio owns the options of the executor of its winning solver
+  // instance, hence it must outlive pExecutor.
+  std::unique_ptr<Portfolio> portfolio;
 
   int returnValue = 0;
   {
@@ -202,6 +206,10 @@ int runCvc4(int argc, char* argv[], Options& opts) {
         throw Exception(
             "--tear-down-incremental doesn't work in interactive mode");
       }
+      if (opts.getPortfolio() > 1)
+      {
+        throw Exception("--portfolio doesn't work in interactive mode");
+      }
       if(!opts.wasSetByUserIncrementalSolving()) {
         cmd.reset(new SetOptionCommand("incremental", "true"));
         cmd->setMuted(true);
@@ -238,6 +246,10 @@ int runCvc4(int argc, char* argv[], Options& opts) {
         }
       }
     } else if( opts.getTearDownIncremental() > 0) {
+      if (opts.getPortfolio() > 1)
+      {
+        throw Exception("--portfolio doesn't work with --tear-down-incremental");
+      }
       if(!opts.getIncrementalSolving() && opts.getTearDownIncremental() > 1) {
         // For tear-down-incremental values greater than 1, need incremental
         // on too.
@@ -403,6 +415,26 @@ int runCvc4(int argc, char* argv[], Options& opts) {
           }
         }
       }
+    } else if (opts.getPortfolio() > 1) {
+      // Read the whole input once, it is parsed by every solver instance of
+      // the portfolio.
+      std::stringstream input;
+      if (inputFromStdin)
+      {
+        input << cin.rdbuf();
+      }
+      else
+      {
+        std::ifstream in(filename);
+        if (!in)
+        {
+          throw Exception("Couldn't open file: " + filenameStr);
+        }
+        input << in.rdbuf();
+      }
+      portfolio.reset(new Portfolio(opts, filenameStr, input.str()));
+      status = portfolio->run();
+      pExecutor = portfolio->releaseWinner();
     } else {
       if(!opts.wasSetByUserIncrementalSolving()) {
         cmd.reset(new SetOptionCommand("incremental", "false"));
@@ -484,6 +516,7 @@ int runCvc4(int argc, char* argv[], Options& opts) {
   }
 
   pExecutor.reset();
+  portfolio.reset();
 
   signal_handlers::cleanup();
 
@@ -302,8 +302,16 @@ restart:
     }
   }
 
-  d_parser->setInput(Input::newStringInput(d_options.getInputLanguage(),
-                                           input, INPUT_FILENAME));
+  if (d_options.getNativeSmt2Parser()
+      && language::isInputLang_smt2(d_options.getInputLanguage()))
+  {
+    d_parser->setInput(Input::newNativeSmt2StringInput(input, INPUT_FILENAME));
+  }
+  else
+  {
+    d_parser->setInput(Input::newStringInput(
+        d_options.getInputLanguage(), input, INPUT_FILENAME));
+  }
 
   /* There may be more than one command in the input. Build up a
      sequence. */
@@ -0,0 +1,263 @@
+/*********************                                                        */
+/*! \file portfolio.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Parallel portfolio of solver instances for the driver.
+ **
+ ** Every worker owns its own api::Solver (and thus its own NodeManager and
+ ** options) and lives in its own thread, which is the configuration the
+ ** thread_local scopes of NodeManager, SmtEngine and Options are built for.
+ ** Losing workers are stopped through SmtEngine::interrupt(), the same path
+ ** that is used for interrupting a solver from a signal handler.
+ **/
+
+#include "main/portfolio.h"
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "base/output.h"
+#include "options/set_language.h"
+#include "parser/parser.h"
+#include "parser/parser_builder.h"
+#include "smt/command.h"
+
+namespace cvc5 {
+namespace main {
+
+namespace {
+
+/** Returns true if cmd is a command that answers a satisfiability query. */
+bool isQueryCommand(Command* cmd)
+{
+  return dynamic_cast<CheckSatCommand*>(cmd) != nullptr
+         || dynamic_cast<CheckSatAssumingCommand*>(cmd) != nullptr
+         || dynamic_cast<QueryCommand*>(cmd) != nullptr;
+}
+
+/** Returns true if res is sat, unsat, entailed or not entailed. */
+bool isDefinitive(const api::Result& res)
+{
+  return !res.isNull() && !res.isSatUnknown() && !res.isEntailmentUnknown();
+}
+
+}  // namespace
+
+Portfolio::Portfolio(Options& options,
+                     const std::string& inputName,
+                     std::string input)
+    : d_options(options),
+      d_inputName(inputName),
+      d_input(std::move(input)),
+      d_done(false),
+      d_winner(0)
+{
+  size_t n = options.getPortfolio() > 0 ? options.getPortfolio() : 1;
+  // derive the seeds of the workers from the seed of the user, such that
+  // portfolio runs are reproducible
+  Random rng(std::stoull(options.getOption("seed")));
+  for (size_t i = 0; i < n; ++i)
+  {
+    d_workers.emplace_back(new Worker(i));
+    configureWorker(*d_workers.back(), rng);
+  }
+}
+
+Portfolio::~Portfolio()
+{
+  for (std::unique_ptr<Worker>& w : d_workers)
+  {
+    if (w->d_thread.joinable())
+    {
+      w->d_thread.join();
+    }
+    // ensure that the executor is destroyed before its options
+    w->d_executor.reset(nullptr);
+  }
+}
+
+void Portfolio::configureWorker(Worker& w, Random& rng)
+{
+  w.d_options.reset(new Options());
+  w.d_options->copyValues(d_options);
+  w.d_options->setOut(&w.d_out);
+  w.d_out << language::SetLanguage(d_options.getOutputLanguage());
+  if (w.d_index == 0)
+  {
+    // the first worker runs the configuration given by the user
+    return;
+  }
+  w.d_options->setOption("seed", std::to_string(rng.rand()));
+  w.d_options->setOption(
+      "random-seed",
+      std::to_string(rng.pick(1, std::numeric_limits<uint32_t>::max())));
+  if (std::stod(d_options.getOption("random-freq")) == 0.0)
+  {
+    // a small amount of random decisions lets the workers explore different
+    // parts of the search space
+    w.d_options->setOption("random-freq",
+                           std::to_string(rng.pickDouble(0.0, 0.05)));
+  }
+}
+
+bool Portfolio::run()
+{
+  for (std::unique_ptr<Worker>& w : d_workers)
+  {
+    Worker* pw = w.get();
+    w->d_thread = std::thread([this, pw]() { runWorker(*pw); });
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (true)
+    {
+      bool allFinished = true;
+      for (const std::unique_ptr<Worker>& w : d_workers)
+      {
+        allFinished = allFinished && w->d_finished;
+      }
+      if (allFinished)
+      {
+        break;
+      }
+      if (d_done.load())
+      {
+        // An interrupt that arrives before a worker entered its check-sat call
+        // is reset by it, hence interrupt repeatedly until everybody stopped.
+        interruptWorkers();
+      }
+      d_finishedCv.wait_for(lock, std::chrono::milliseconds(10));
+    }
+  }
+
+  for (std::unique_ptr<Worker>& w : d_workers)
+  {
+    w->d_thread.join();
+  }
+
+  Worker& winner = *d_workers[d_winner];
+  Trace("portfolio") << "portfolio: worker " << d_winner << " wins"
+                     << std::endl;
+  *d_options.getOut() << winner.d_out.str() << std::flush;
+  if (winner.d_exception != nullptr)
+  {
+    std::rethrow_exception(winner.d_exception);
+  }
+  return winner.d_status;
+}
+
+std::unique_ptr<CommandExecutor> Portfolio::releaseWinner()
+{
+  return std::move(d_workers[d_winner]->d_executor);
+}
+
+void Portfolio::runWorker(Worker& w)
+{
+  try
+  {
+    {
+      std::unique_lock<std::mutex> lock(d_mutex);
+      if (d_done.load())
+      {
+        w.d_definitive = false;
+        lock.unlock();
+        finishWorker(w);
+        return;
+      }
+      w.d_executor.reset(new CommandExecutor(*w.d_options));
+    }
+    CommandExecutor* exec = w.d_executor.get();
+    exec->getSmtEngine()->notifyStartParsing(d_inputName);
+
+    std::unique_ptr<Command> cmd;
+    if (!w.d_options->wasSetByUserIncrementalSolving())
+    {
+      cmd.reset(new SetOptionCommand("incremental", "false"));
+      cmd->setMuted(true);
+      exec->doCommand(cmd);
+    }
+
+    parser::ParserBuilder parserBuilder(exec->getSolver(),
+                                        exec->getSymbolManager(),
+                                        d_inputName,
+                                        *w.d_options);
+    parserBuilder.withStringInput(d_input);
+    std::unique_ptr<parser::Parser> parser(parserBuilder.build());
+    while (w.d_status)
+    {
+      if (d_done.load())
+      {
+        // some other worker already won
+        w.d_definitive = false;
+        break;
+      }
+      cmd.reset(parser->nextCommand());
+      if (cmd == nullptr)
+      {
+        break;
+      }
+      w.d_status = exec->doCommand(cmd);
+      if (cmd->interrupted())
+      {
+        w.d_definitive = false;
+        break;
+      }
+      if (isQueryCommand(cmd.get()) && !isDefinitive(exec->getResult()))
+      {
+        w.d_definitive = false;
+        // Only the output of the first worker is used as a fallback if no
+        // worker answers all queries, the others can stop here.
+        if (w.d_index > 0)
+        {
+          break;
+        }
+      }
+      if (dynamic_cast<QuitCommand*>(cmd.get()) != nullptr)
+      {
+        break;
+      }
+    }
+  }
+  catch (...)
+  {
+    w.d_exception = std::current_exception();
+    w.d_status = false;
+    w.d_definitive = false;
+  }
+  finishWorker(w);
+}
+
+void Portfolio::finishWorker(Worker& w)
+{
+  std::unique_lock<std::mutex> lock(d_mutex);
+  w.d_finished = true;
+  if (w.d_status && w.d_definitive && !d_done.load())
+  {
+    d_winner = w.d_index;
+    d_done.store(true);
+  }
+  d_finishedCv.notify_all();
+}
+
+void Portfolio::interruptWorkers()
+{
+  // d_mutex is held by the caller
+  for (std::unique_ptr<Worker>& w : d_workers)
+  {
+    if (!w->d_finished && w->d_executor != nullptr)
+    {
+      w->d_executor->getSmtEngine()->interrupt();
+    }
+  }
+}
+
+}  // namespace main
+}  // namespace cvc5
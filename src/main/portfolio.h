@@ -0,0 +1,138 @@
+/*********************                                                        */
+/*! \file portfolio.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Parallel portfolio of solver instances for the driver.
+ **
+ ** Implements the --portfolio=N mode of the driver: N differently configured
+ ** solver instances are run in separate threads on the same input. The first
+ ** instance that finishes with definitive results for all its queries wins,
+ ** the remaining instances are interrupted.
+ **/
+
+#ifndef CVC4__MAIN__PORTFOLIO_H
+#define CVC4__MAIN__PORTFOLIO_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "main/command_executor.h"
+#include "options/options.h"
+#include "util/random.h"
+
+namespace cvc5 {
+namespace main {
+
+/**
+ * A portfolio of solver instances that run in parallel on the same input.
+ *
+ * Each instance is executed by a CommandExecutor in its own thread, with its
+ * own copy of the options and its own output buffer. Only the output of the
+ * winning instance is forwarded to the output stream of the user.
+ */
+class Portfolio
+{
+ public:
+  /**
+   * Create a portfolio of options.getPortfolio() solver instances that read
+   * their commands from the given input. The name of the input is only used
+   * for error messages.
+   */
+  Portfolio(Options& options, const std::string& inputName, std::string input);
+  ~Portfolio();
+
+  /**
+   * Run all solver instances until one of them finished with definitive
+   * results, or all of them finished. The output of the winning instance is
+   * written to the output stream of the options given to the constructor.
+   * Rethrows the exception of the winning instance, if it raised one.
+   *
+   * @return the status of the winning instance
+   */
+  bool run();
+
+  /**
+   * Get the index of the winning instance. If no instance finished with
+   * definitive results, this is the first instance.
+   */
+  size_t getWinnerIndex() const { return d_winner; }
+
+  /**
+   * Release the command executor of the winning instance, e.g., for printing
+   * its statistics. The executor refers to options owned by this portfolio,
+   * hence the portfolio must outlive the returned executor.
+   */
+  std::unique_ptr<CommandExecutor> releaseWinner();
+
+ private:
+  /** A single solver instance of the portfolio. */
+  struct Worker
+  {
+    Worker(size_t index) : d_index(index) {}
+    /** The index of this worker in the portfolio */
+    size_t d_index;
+    /** The (diversified) options of this worker */
+    std::unique_ptr<Options> d_options;
+    /** The command executor, owned by this worker */
+    std::unique_ptr<CommandExecutor> d_executor;
+    /** Buffers the regular output of this worker */
+    std::stringstream d_out;
+    /** The thread this worker is executed in */
+    std::thread d_thread;
+    /** The status of the last command */
+    bool d_status = true;
+    /** Whether all queries of this worker had a definitive answer */
+    bool d_definitive = true;
+    /** Whether this worker has finished */
+    bool d_finished = false;
+    /** The exception raised by this worker, if any */
+    std::exception_ptr d_exception;
+  };
+
+  /**
+   * Configure the options of the given worker. Worker 0 uses the options as
+   * given by the user, all others are diversified by random seeds derived
+   * from the user's seed.
+   */
+  void configureWorker(Worker& w, Random& rng);
+  /** Parse and execute all commands in the given worker. */
+  void runWorker(Worker& w);
+  /** Notify that the given worker has finished. */
+  void finishWorker(Worker& w);
+  /** Interrupt all workers that have not finished yet. */
+  void interruptWorkers();
+
+  /** The options given by the user */
+  Options& d_options;
+  /** The name of the input */
+  std::string d_inputName;
+  /** The input, shared by all workers */
+  std::string d_input;
+  /** The workers */
+  std::vector<std::unique_ptr<Worker>> d_workers;
+  /** Set once a worker finished with definitive results */
+  std::atomic<bool> d_done;
+  /** The index of the winning worker */
+  size_t d_winner;
+  /** Protects d_finished, d_winner and the executors of the workers */
+  std::mutex d_mutex;
+  /** Notified whenever a worker finishes */
+  std::condition_variable d_finishedCv;
+}; /* class Portfolio */
+
+}  // namespace main
+}  // namespace cvc5
+
+#endif /* CVC4__MAIN__PORTFOLIO_H */
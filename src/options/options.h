@@ -166,7 +166,9 @@ public:
   bool getInteractivePrompt() const;
   bool getLanguageHelp() const;
   bool getMemoryMap() const;
+  bool getNativeSmt2Parser() const;
   bool getParseOnly() const;
+  unsigned getPortfolio() const;
   bool getProduceModels() const;
   bool getSegvSpin() const;
   bool getSemanticChecks() const;
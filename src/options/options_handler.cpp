@@ -161,6 +161,33 @@ void OptionsHandler::checkBvSatSolver(std::string option, SatSolverMode m)
   }
 }
 
+void OptionsHandler::checkCDCLTSatSolver(std::string option,
+                                         CDCLTSatSolverMode m)
+{
+  if (m == CDCLTSatSolverMode::CADICAL && !Configuration::isBuiltWithCadical())
+  {
+    std::stringstream ss;
+    ss << "option `" << option
+       << "' requires a CaDiCaL build of CVC4; this binary was not built with "
+          "CaDiCaL support";
+    throw OptionException(ss.str());
+  }
+}
+
+void OptionsHandler::threadSafeNodesBuild(std::string option, unsigned value)
+{
+#ifndef CVC4_THREAD_SAFE_NODES
+  if (value > 1)
+  {
+    std::stringstream ss;
+    ss << "option `" << option
+       << "' requires a build of CVC4 with thread-safe nodes; this binary was "
+          "not configured with --thread-safe-nodes";
+    throw OptionException(ss.str());
+  }
+#endif /* CVC4_THREAD_SAFE_NODES */
+}
+
 void OptionsHandler::checkBitblastMode(std::string option, BitblastMode m)
 {
   if (m == options::BitblastMode::LAZY)
@@ -340,6 +367,8 @@ void OptionsHandler::showConfiguration(std::string option) {
   print_config_cond("ubsan", Configuration::isUbsanBuild());
   print_config_cond("tsan", Configuration::isTsanBuild());
   print_config_cond("competition", Configuration::isCompetitionBuild());
+  print_config_cond("thread-safe-nodes",
+                    Configuration::isThreadSafeNodesBuild());
 
   std::cout << std::endl;
 
@@ -28,6 +28,7 @@
 #include "options/language.h"
 #include "options/option_exception.h"
 #include "options/printer_modes.h"
+#include "options/prop_options.h"
 #include "options/quantifiers_options.h"
 
 namespace cvc5 {
@@ -71,6 +72,10 @@ public:
   template<class T> void checkSatSolverEnabled(std::string option, T m);
 
   void checkBvSatSolver(std::string option, SatSolverMode m);
+  void checkCDCLTSatSolver(std::string option, CDCLTSatSolverMode m);
+
+  // smt/options_handlers.h
+  void threadSafeNodesBuild(std::string option, unsigned value);
   void checkBitblastMode(std::string option, BitblastMode m);
 
   void setBitblastAig(std::string option, bool arg);
@@ -108,10 +108,19 @@ bool Options::getMemoryMap() const{
   return (*this)[options::memoryMap];
 }
 
+bool Options::getNativeSmt2Parser() const
+{
+  return (*this)[options::nativeSmt2Parser];
+}
+
 bool Options::getParseOnly() const{
   return (*this)[options::parseOnly];
 }
 
+unsigned Options::getPortfolio() const{
+  return (*this)[options::portfolio];
+}
+
 bool Options::getProduceModels() const{
   return (*this)[options::produceModels];
 }
@@ -22,6 +22,7 @@
 #include "base/output.h"
 #include "parser/parser.h"
 #include "parser/parser_exception.h"
+#include "parser/smt2/smt2_native_input.h"
 
 
 using namespace std;
@@ -79,5 +80,27 @@ Input* Input::newStringInput(InputLanguage lang,
   return AntlrInput::newInput(lang, *inputStream);
 }
 
+Input* Input::newNativeSmt2FileInput(const std::string& filename,
+                                     bool useMmap)
+{
+  return new Smt2NativeInput(
+      Smt2NativeInputStream::newFileInputStream(filename, useMmap));
+}
+
+Input* Input::newNativeSmt2StreamInput(std::istream& input,
+                                       const std::string& name,
+                                       bool lineBuffered)
+{
+  return new Smt2NativeInput(
+      Smt2NativeInputStream::newStreamInputStream(input, name, lineBuffered));
+}
+
+Input* Input::newNativeSmt2StringInput(const std::string& input,
+                                       const std::string& name)
+{
+  return new Smt2NativeInput(
+      Smt2NativeInputStream::newStringInputStream(input, name));
+}
+
 }  // namespace parser
 }  // namespace cvc5
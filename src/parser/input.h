@@ -129,6 +129,36 @@ class CVC4_EXPORT Input
                                const std::string& input,
                                const std::string& name);
 
+  /** Create an input for the given file that is read by the hand-written
+   * SMT-LIB 2 parser instead of the ANTLR one.
+   *
+   * @param filename the input filename
+   * @param useMmap true if the parser should use memory-mapped I/O
+   */
+  static Input* newNativeSmt2FileInput(const std::string& filename,
+                                       bool useMmap = false);
+
+  /** Create an input for the given stream that is read by the hand-written
+   * SMT-LIB 2 parser instead of the ANTLR one.
+   *
+   * @param input the input stream
+   * @param name the name of the stream, for use in error messages
+   * @param lineBuffered whether the stream is read line by line (e.g., for
+   * interactive input) rather than in larger chunks
+   */
+  static Input* newNativeSmt2StreamInput(std::istream& input,
+                                         const std::string& name,
+                                         bool lineBuffered = false);
+
+  /** Create an input for the given string that is read by the hand-written
+   * SMT-LIB 2 parser instead of the ANTLR one.
+   *
+   * @param input the input string
+   * @param name the name of the stream, for use in error messages
+   */
+  static Input* newNativeSmt2StringInput(const std::string& input,
+                                         const std::string& name);
+
   /** Destructor. Frees the input stream and closes the input. */
   virtual ~Input();
 
@@ -65,6 +65,7 @@ void ParserBuilder::init(api::Solver* solver,
   d_canIncludeFile = true;
   d_mmap = false;
   d_parseOnly = false;
+  d_nativeSmt2 = false;
   d_logicIsForced = false;
   d_forcedLogic = "";
 }
@@ -72,21 +73,47 @@ void ParserBuilder::init(api::Solver* solver,
 Parser* ParserBuilder::build()
 {
   Input* input = NULL;
-  switch( d_inputType ) {
-  case FILE_INPUT:
-    input = Input::newFileInput(d_lang, d_filename, d_mmap);
-    break;
-  case LINE_BUFFERED_STREAM_INPUT:
-    Assert(d_streamInput != NULL);
-    input = Input::newStreamInput(d_lang, *d_streamInput, d_filename, true);
-    break;
-  case STREAM_INPUT:
-    Assert(d_streamInput != NULL);
-    input = Input::newStreamInput(d_lang, *d_streamInput, d_filename);
-    break;
-  case STRING_INPUT:
-    input = Input::newStringInput(d_lang, d_stringInput, d_filename);
-    break;
+  if (d_nativeSmt2 && language::isInputLang_smt2(d_lang))
+  {
+    switch (d_inputType)
+    {
+      case FILE_INPUT:
+        input = Input::newNativeSmt2FileInput(d_filename, d_mmap);
+        break;
+      case LINE_BUFFERED_STREAM_INPUT:
+        Assert(d_streamInput != NULL);
+        input =
+            Input::newNativeSmt2StreamInput(*d_streamInput, d_filename, true);
+        break;
+      case STREAM_INPUT:
+        Assert(d_streamInput != NULL);
+        input = Input::newNativeSmt2StreamInput(*d_streamInput, d_filename);
+        break;
+      case STRING_INPUT:
+        input = Input::newNativeSmt2StringInput(d_stringInput, d_filename);
+        break;
+    }
+  }
+  else
+  {
+    switch (d_inputType)
+    {
+      case FILE_INPUT:
+        input = Input::newFileInput(d_lang, d_filename, d_mmap);
+        break;
+      case LINE_BUFFERED_STREAM_INPUT:
+        Assert(d_streamInput != NULL);
+        input =
+            Input::newStreamInput(d_lang, *d_streamInput, d_filename, true);
+        break;
+      case STREAM_INPUT:
+        Assert(d_streamInput != NULL);
+        input = Input::newStreamInput(d_lang, *d_streamInput, d_filename);
+        break;
+      case STRING_INPUT:
+        input = Input::newStringInput(d_lang, d_stringInput, d_filename);
+        break;
+    }
   }
 
   Assert(input != NULL);
@@ -167,6 +194,12 @@ ParserBuilder& ParserBuilder::withParseOnly(bool flag) {
   return *this;
 }
 
+ParserBuilder& ParserBuilder::withNativeSmt2Parser(bool flag)
+{
+  d_nativeSmt2 = flag;
+  return *this;
+}
+
 ParserBuilder& ParserBuilder::withOptions(const Options& options) {
   ParserBuilder& retval = *this;
   retval =
@@ -175,6 +208,7 @@ ParserBuilder& ParserBuilder::withOptions(const Options& options) {
       .withChecks(options.getSemanticChecks())
       .withStrictMode(options.getStrictParsing())
       .withParseOnly(options.getParseOnly())
+      .withNativeSmt2Parser(options.getNativeSmt2Parser())
       .withIncludeFile(options.getFilesystemAccess());
   if(options.wasSetByUserForceLogicString()) {
     LogicInfo tmp(options.getForceLogicString());
@@ -88,6 +88,9 @@ class CVC4_EXPORT ParserBuilder
   /** Are we parsing only? */
   bool d_parseOnly;
 
+  /** Should we use the native SMT-LIB 2 parser for SMT-LIB 2 inputs? */
+  bool d_nativeSmt2;
+
   /** Is the logic forced by the user? */
   bool d_logicIsForced;
 
@@ -158,6 +161,12 @@ class CVC4_EXPORT ParserBuilder
    */
   ParserBuilder& withParseOnly(bool flag = true);
 
+  /**
+   * Should SMT-LIB 2 inputs be parsed by the hand-written parser instead of
+   * the ANTLR one? (Default: no)
+   */
+  ParserBuilder& withNativeSmt2Parser(bool flag = true);
+
   /** Derive settings from the given options. */
   ParserBuilder& withOptions(const Options& options);
 
@@ -0,0 +1,2177 @@
+/*********************                                                        */
+/*! \file smt2_native_input.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A hand-written lexer and parser for SMT-LIB 2.
+ **
+ ** The parsing methods correspond to the rules of Smt2.g of the same name and
+ ** should be kept in sync with them.
+ **/
+
+#include "parser/smt2/smt2_native_input.h"
+
+#include <fcntl.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* _WIN32 */
+
+#include <cctype>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <unordered_set>
+
+#include "base/check.h"
+#include "base/output.h"
+#include "expr/symbol_manager.h"
+#include "parser/parser_exception.h"
+#include "parser/smt2/smt2.h"
+#include "smt/command.h"
+#include "util/floatingpoint_size.h"
+
+namespace cvc5 {
+namespace parser {
+
+namespace {
+
+/** The size of the chunks in which streams are read. */
+const size_t s_chunkSize = 0x10000;
+
+/** Is c a character of a simple symbol or a keyword? */
+bool isSymbolChar(char c)
+{
+  switch (c)
+  {
+    case '+': case '-': case '/': case '*': case '=': case '%': case '?':
+    case '!': case '.': case '$': case '_': case '~': case '&': case '^':
+    case '<': case '>': case '@':
+      return true;
+    default: return std::isalnum(static_cast<unsigned char>(c)) != 0;
+  }
+}
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+bool isHexDigit(char c)
+{
+  return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+}  // namespace
+
+/* -------------------------------------------------------------------------- */
+
+Smt2NativeInputStream::Smt2NativeInputStream(const std::string& name)
+    : InputStream(name),
+      d_data(nullptr),
+      d_size(0),
+      d_stream(nullptr),
+      d_lineBuffered(false),
+      d_mmap(nullptr),
+      d_mmapSize(0)
+{
+}
+
+Smt2NativeInputStream::~Smt2NativeInputStream()
+{
+#ifndef _WIN32
+  if (d_mmap != nullptr)
+  {
+    munmap(d_mmap, d_mmapSize);
+  }
+#endif /* _WIN32 */
+}
+
+Smt2NativeInputStream* Smt2NativeInputStream::newFileInputStream(
+    const std::string& name, bool useMmap)
+{
+  std::unique_ptr<Smt2NativeInputStream> res(new Smt2NativeInputStream(name));
+#ifndef _WIN32
+  if (useMmap)
+  {
+    int fd = open(name.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      throw InputStreamException("Couldn't open file: " + name);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+      close(fd);
+      throw InputStreamException("Couldn't stat file: " + name);
+    }
+    if (st.st_size > 0)
+    {
+      void* data =
+          mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED)
+      {
+        close(fd);
+        throw InputStreamException("Couldn't memory map file: " + name);
+      }
+      res->d_mmap = data;
+      res->d_mmapSize = st.st_size;
+      res->d_data = static_cast<const char*>(data);
+      res->d_size = st.st_size;
+    }
+    close(fd);
+    return res.release();
+  }
+#endif /* _WIN32 */
+  std::unique_ptr<std::ifstream> file(new std::ifstream(name));
+  if (!file->is_open())
+  {
+    throw InputStreamException("Couldn't open file: " + name);
+  }
+  res->d_stream = file.get();
+  res->d_fileStream = std::move(file);
+  return res.release();
+}
+
+Smt2NativeInputStream* Smt2NativeInputStream::newStreamInputStream(
+    std::istream& input, const std::string& name, bool lineBuffered)
+{
+  Smt2NativeInputStream* res = new Smt2NativeInputStream(name);
+  res->d_stream = &input;
+  res->d_lineBuffered = lineBuffered;
+  return res;
+}
+
+Smt2NativeInputStream* Smt2NativeInputStream::newStringInputStream(
+    const std::string& input, const std::string& name)
+{
+  Smt2NativeInputStream* res = new Smt2NativeInputStream(name);
+  res->d_buffer = input;
+  res->d_data = res->d_buffer.data();
+  res->d_size = res->d_buffer.size();
+  return res;
+}
+
+bool Smt2NativeInputStream::fill(size_t pos)
+{
+  while (pos >= d_size && d_stream != nullptr)
+  {
+    if (d_lineBuffered)
+    {
+      // read a single line, such that interactive input is not blocked on
+      // characters that are not needed yet
+      std::string line;
+      if (!std::getline(*d_stream, line))
+      {
+        d_stream = nullptr;
+        break;
+      }
+      d_buffer.append(line);
+      d_buffer.push_back('\n');
+    }
+    else
+    {
+      size_t size = d_buffer.size();
+      d_buffer.resize(size + s_chunkSize);
+      d_stream->read(&d_buffer[size], s_chunkSize);
+      d_buffer.resize(size + d_stream->gcount());
+      if (!*d_stream)
+      {
+        d_stream = nullptr;
+      }
+    }
+    d_data = d_buffer.data();
+    d_size = d_buffer.size();
+  }
+  return pos < d_size;
+}
+
+size_t Smt2NativeInputStream::discard(size_t pos)
+{
+  // only discard larger blocks, such that the cost of moving the remaining
+  // characters is amortized
+  if (d_mmap != nullptr || pos < s_chunkSize)
+  {
+    return 0;
+  }
+  d_buffer.erase(0, pos);
+  d_data = d_buffer.data();
+  d_size = d_buffer.size();
+  return pos;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Smt2NativeInput::Smt2NativeInput(Smt2NativeInputStream* inputStream)
+    : Input(*inputStream),
+      d_state(nullptr),
+      d_numLookahead(0),
+      d_line(1),
+      d_column(0)
+{
+  std::unique_ptr<Source> s(new Source());
+  s->d_stream = inputStream;
+  s->d_pos = 0;
+  s->d_line = 1;
+  s->d_column = 0;
+  d_sources.push_back(std::move(s));
+}
+
+Smt2NativeInput::~Smt2NativeInput() {}
+
+void Smt2NativeInput::setParser(Parser& parser)
+{
+  Assert(dynamic_cast<Smt2*>(&parser) != nullptr);
+  d_state = static_cast<Smt2*>(&parser);
+}
+
+void Smt2NativeInput::warning(const std::string& msg)
+{
+  Warning() << d_sources.back()->d_stream->getName() << ':' << d_line << '.'
+            << d_column << ": " << msg << std::endl;
+}
+
+void Smt2NativeInput::parseError(const std::string& msg, bool eofException)
+{
+  const std::string name = d_sources.back()->d_stream->getName();
+  Debug("parser") << "Throwing exception: " << name << ":" << d_line << "."
+                  << d_column << ": " << msg << std::endl;
+  if (eofException)
+  {
+    throw ParserEndOfFileException(msg, name, d_line, d_column);
+  }
+  throw ParserException(msg, name, d_line, d_column);
+}
+
+/* ---------------------------------- lexer --------------------------------- */
+
+void Smt2NativeInput::advance(Source& s)
+{
+  if (s.d_stream->at(s.d_pos) == '\n')
+  {
+    ++s.d_line;
+    s.d_column = 0;
+  }
+  else
+  {
+    ++s.d_column;
+  }
+  ++s.d_pos;
+}
+
+void Smt2NativeInput::skipWhitespace(Source& s)
+{
+  Smt2NativeInputStream* in = s.d_stream;
+  while (in->available(s.d_pos))
+  {
+    char c = in->at(s.d_pos);
+    if (c == ';')
+    {
+      while (in->available(s.d_pos) && in->at(s.d_pos) != '\n')
+      {
+        advance(s);
+      }
+    }
+    else if (c == ' ' || c == '\t' || c == '\f' || c == '\r' || c == '\n')
+    {
+      advance(s);
+    }
+    else
+    {
+      return;
+    }
+  }
+}
+
+Smt2Token Smt2NativeInput::lex()
+{
+  skipWhitespace(*d_sources.back());
+  while (!d_sources.back()->d_stream->available(d_sources.back()->d_pos)
+         && d_sources.size() > 1)
+  {
+    // end of an included file, continue with the including one
+    d_retired.push_back(std::move(d_sources.back()));
+    d_sources.pop_back();
+    skipWhitespace(*d_sources.back());
+  }
+  Source& s = *d_sources.back();
+  Smt2NativeInputStream* in = s.d_stream;
+  Smt2Token t;
+  t.d_stream = in;
+  t.d_begin = s.d_pos;
+  t.d_line = s.d_line;
+  t.d_column = s.d_column;
+  if (!in->available(s.d_pos))
+  {
+    t.d_kind = Smt2TokenKind::END_OF_FILE;
+    t.d_end = s.d_pos;
+    return t;
+  }
+  // errors are reported at the start of the token
+  d_line = t.d_line;
+  d_column = t.d_column;
+  char c = in->at(s.d_pos);
+  advance(s);
+  switch (c)
+  {
+    case '(': t.d_kind = Smt2TokenKind::LPAREN; break;
+    case ')': t.d_kind = Smt2TokenKind::RPAREN; break;
+    case '|':
+      t.d_kind = Smt2TokenKind::QUOTED_SYMBOL;
+      while (true)
+      {
+        if (!in->available(s.d_pos))
+        {
+          parseError("unterminated |quoted| symbol", true);
+        }
+        c = in->at(s.d_pos);
+        advance(s);
+        if (c == '|')
+        {
+          break;
+        }
+        if (c == '\\')
+        {
+          parseError("backslash not permitted in |quoted| symbol", true);
+        }
+      }
+      break;
+    case '"':
+      t.d_kind = Smt2TokenKind::STRING;
+      while (true)
+      {
+        if (!in->available(s.d_pos))
+        {
+          parseError("unterminated string literal", true);
+        }
+        c = in->at(s.d_pos);
+        advance(s);
+        if (c == '"')
+        {
+          // SMT-LIB >=2.5 escapes a double quote as ""
+          if (d_state->escapeDupDblQuote() && in->available(s.d_pos)
+              && in->at(s.d_pos) == '"')
+          {
+            advance(s);
+            continue;
+          }
+          break;
+        }
+        // SMT-LIB 2.0 escapes \" and \\, the escapes are processed in
+        // parseStr()
+        if (c == '\\' && !d_state->escapeDupDblQuote()
+            && in->available(s.d_pos))
+        {
+          advance(s);
+        }
+      }
+      break;
+    case ':':
+      t.d_kind = Smt2TokenKind::KEYWORD;
+      while (in->available(s.d_pos) && isSymbolChar(in->at(s.d_pos)))
+      {
+        advance(s);
+      }
+      if (s.d_pos == t.d_begin + 1)
+      {
+        parseError("expected keyword after `:'");
+      }
+      break;
+    case '#':
+    {
+      if (!in->available(s.d_pos)
+          || (in->at(s.d_pos) != 'x' && in->at(s.d_pos) != 'b'))
+      {
+        parseError("expected #x or #b constant");
+      }
+      bool hex = in->at(s.d_pos) == 'x';
+      t.d_kind = hex ? Smt2TokenKind::HEXADECIMAL : Smt2TokenKind::BINARY;
+      advance(s);
+      while (in->available(s.d_pos)
+             && (hex ? isHexDigit(in->at(s.d_pos))
+                     : (in->at(s.d_pos) == '0' || in->at(s.d_pos) == '1')))
+      {
+        advance(s);
+      }
+      if (s.d_pos == t.d_begin + 2)
+      {
+        parseError(hex ? "expected hexadecimal digits after #x"
+                       : "expected binary digits after #b");
+      }
+      break;
+    }
+    default:
+      if (isDigit(c))
+      {
+        t.d_kind = Smt2TokenKind::NUMERAL;
+        while (in->available(s.d_pos) && isDigit(in->at(s.d_pos)))
+        {
+          advance(s);
+        }
+        if (d_state->strictModeEnabled() && c == '0'
+            && s.d_pos > t.d_begin + 1)
+        {
+          parseError("numerals with leading zeroes are not permitted in "
+                     "strict mode");
+        }
+        if (in->available(s.d_pos + 1) && in->at(s.d_pos) == '.'
+            && isDigit(in->at(s.d_pos + 1)))
+        {
+          t.d_kind = Smt2TokenKind::DECIMAL;
+          advance(s);
+          while (in->available(s.d_pos) && isDigit(in->at(s.d_pos)))
+          {
+            advance(s);
+          }
+        }
+      }
+      else if (isSymbolChar(c))
+      {
+        t.d_kind = Smt2TokenKind::SYMBOL;
+        while (in->available(s.d_pos) && isSymbolChar(in->at(s.d_pos)))
+        {
+          advance(s);
+        }
+      }
+      else
+      {
+        std::stringstream ss;
+        ss << "unexpected character `" << c << "'";
+        parseError(ss.str());
+      }
+      break;
+  }
+  t.d_end = s.d_pos;
+  return t;
+}
+
+const Smt2Token& Smt2NativeInput::peek(size_t i)
+{
+  Assert(i < 2);
+  while (d_numLookahead <= i)
+  {
+    d_lookahead[d_numLookahead] = lex();
+    ++d_numLookahead;
+  }
+  return d_lookahead[i];
+}
+
+Smt2Token Smt2NativeInput::next()
+{
+  peek();
+  Smt2Token t = d_lookahead[0];
+  d_lookahead[0] = d_lookahead[1];
+  --d_numLookahead;
+  d_line = t.d_line;
+  d_column = t.d_column;
+  return t;
+}
+
+Smt2Token Smt2NativeInput::expect(Smt2TokenKind kind, const char* what)
+{
+  Smt2Token t = next();
+  if (t.d_kind != kind)
+  {
+    if (t.d_kind == Smt2TokenKind::END_OF_FILE)
+    {
+      parseError(std::string("unexpected end of input, expected ") + what,
+                 true);
+    }
+    parseError(std::string("expected ") + what + ", got `"
+               + std::string(text(t)) + "'");
+  }
+  return t;
+}
+
+uint64_t Smt2NativeInput::numeralValue(const Smt2Token& t)
+{
+  Assert(t.d_kind == Smt2TokenKind::NUMERAL);
+  uint64_t res = 0;
+  for (char c : text(t))
+  {
+    uint64_t d = c - '0';
+    if (res > (std::numeric_limits<uint64_t>::max() - d) / 10)
+    {
+      parseError("numeral `" + std::string(text(t)) + "' is too large");
+    }
+    res = res * 10 + d;
+  }
+  return res;
+}
+
+void Smt2NativeInput::discardConsumedInput()
+{
+  d_retired.clear();
+  if (d_numLookahead > 0)
+  {
+    return;
+  }
+  Source& s = *d_sources.back();
+  s.d_pos -= s.d_stream->discard(s.d_pos);
+}
+
+void Smt2NativeInput::includeFile(const std::string& filename)
+{
+  // find the directory of the current input file
+  const std::string inputName = d_sources.back()->d_stream->getName();
+  std::string path;
+  size_t pos = inputName.rfind('/');
+  if (pos != std::string::npos)
+  {
+    path = std::string(inputName, 0, pos + 1);
+  }
+  path.append(filename);
+  std::unique_ptr<Source> s(new Source());
+  try
+  {
+    s->d_owned.reset(Smt2NativeInputStream::newFileInputStream(path, false));
+  }
+  catch (InputStreamException& e)
+  {
+    parseError("Couldn't open include file `" + path + "'");
+  }
+  s->d_stream = s->d_owned.get();
+  s->d_pos = 0;
+  s->d_line = 1;
+  s->d_column = 0;
+  d_sources.push_back(std::move(s));
+}
+
+/* --------------------------------- parser --------------------------------- */
+
+Command* Smt2NativeInput::parseCommand()
+{
+  Assert(d_state != nullptr);
+  discardConsumedInput();
+  if (peek().d_kind == Smt2TokenKind::END_OF_FILE)
+  {
+    return nullptr;
+  }
+  expect(Smt2TokenKind::LPAREN, "`('");
+  Smt2Token head = next();
+  if (head.d_kind != Smt2TokenKind::SYMBOL)
+  {
+    parseError("expected SMT-LIBv2 command",
+               head.d_kind == Smt2TokenKind::END_OF_FILE);
+  }
+  // copy the name, the buffer may be refilled while parsing the command
+  std::string name(text(head));
+  std::unique_ptr<Command> cmd;
+  if (name == "include")
+  {
+    std::string filename = parseStr(true);
+    expectRParen();
+    if (!d_state->canIncludeFile())
+    {
+      parseError("include-file feature was disabled for this run.");
+    }
+    if (d_state->strictModeEnabled())
+    {
+      parseError(
+          "Extended commands are not permitted while operating in strict "
+          "compliance mode.");
+    }
+    includeFile(filename);
+    // The command of the included file will be produced at the next
+    // parseCommand() call
+    return new EmptyCommand("include::" + filename);
+  }
+  parseCommandBody(name, &cmd);
+  expectRParen();
+  return cmd.release();
+}
+
+api::Term Smt2NativeInput::parseExpr()
+{
+  Assert(d_state != nullptr);
+  discardConsumedInput();
+  if (peek().d_kind == Smt2TokenKind::END_OF_FILE)
+  {
+    return api::Term();
+  }
+  api::Term expr2;
+  return parseTerm(expr2);
+}
+
+void Smt2NativeInput::parseCommandBody(std::string_view name,
+                                       std::unique_ptr<Command>* cmd)
+{
+  SymbolManager* symman = d_state->getSymbolManager();
+  std::string sym;
+  api::Term expr, expr2;
+  api::Sort t;
+  std::vector<api::Term> terms;
+  std::vector<api::Sort> sorts;
+  std::vector<std::pair<std::string, api::Sort>> sortedVarNames;
+  std::vector<api::Term> flattenVars;
+
+  if (name == "assert")
+  {
+    d_state->checkThatLogicIsSet();
+    d_state->clearLastNamedTerm();
+    expr = parseTerm(expr2);
+    bool inUnsatCore = d_state->lastNamedTerm().first == expr;
+    cmd->reset(new AssertCommand(expr, inUnsatCore));
+    if (inUnsatCore)
+    {
+      // set the expression name, if there was a named term
+      std::pair<api::Term, std::string> namedTerm = d_state->lastNamedTerm();
+      symman->setExpressionName(namedTerm.first, namedTerm.second, true);
+    }
+  }
+  else if (name == "declare-fun")
+  {
+    d_state->checkThatLogicIsSet();
+    sym = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    d_state->checkUserSymbol(sym);
+    expect(Smt2TokenKind::LPAREN, "`('");
+    parseSortList(sorts);
+    expectRParen();
+    t = parseSort(CHECK_DECLARED);
+    if (!sorts.empty())
+    {
+      t = d_state->mkFlatFunctionType(sorts, t);
+    }
+    if (t.isFunction())
+    {
+      d_state->checkLogicAllowsFunctions();
+    }
+    // we allow overloading for function declarations
+    api::Term func = d_state->bindVar(sym, t, false, true);
+    cmd->reset(new DeclareFunctionCommand(sym, func, t));
+  }
+  else if (name == "define-fun")
+  {
+    d_state->checkThatLogicIsSet();
+    sym = parseSymbol(CHECK_UNDECLARED, SYM_VARIABLE);
+    d_state->checkUserSymbol(sym);
+    expect(Smt2TokenKind::LPAREN, "`('");
+    parseSortedVarList(sortedVarNames);
+    expectRParen();
+    t = parseSort(CHECK_DECLARED);
+    for (const std::pair<std::string, api::Sort>& sv : sortedVarNames)
+    {
+      sorts.push_back(sv.second);
+    }
+    t = d_state->mkFlatFunctionType(sorts, t, flattenVars);
+    d_state->pushScope();
+    terms = d_state->bindBoundVars(sortedVarNames);
+    expr = parseTerm(expr2);
+    if (!flattenVars.empty())
+    {
+      // if this function has any implicit variables flattenVars,
+      // we apply the body of the definition to the flatten vars
+      expr = d_state->mkHoApply(expr, flattenVars);
+      terms.insert(terms.end(), flattenVars.begin(), flattenVars.end());
+    }
+    d_state->popScope();
+    // declare the name down here (while parsing term, signature
+    // must not be extended with the name itself; no recursion
+    // permitted)
+    // we allow overloading for function definitions
+    api::Term func = d_state->bindVar(sym, t, false, true);
+    cmd->reset(new DefineFunctionCommand(
+        sym, func, terms, expr, symman->getGlobalDeclarations()));
+  }
+  else if (name == "check-sat")
+  {
+    d_state->checkThatLogicIsSet();
+    if (peek().d_kind != Smt2TokenKind::RPAREN)
+    {
+      expr = parseTerm(expr2);
+      if (d_state->strictModeEnabled())
+      {
+        parseError(
+            "Extended commands (such as check-sat with an argument) are not "
+            "permitted while operating in strict compliance mode.");
+      }
+    }
+    cmd->reset(new CheckSatCommand(expr));
+  }
+  else if (name == "check-sat-assuming")
+  {
+    d_state->checkThatLogicIsSet();
+    if (peek().d_kind != Smt2TokenKind::LPAREN)
+    {
+      parseError(
+          "The check-sat-assuming command expects a list of terms.  Perhaps "
+          "you forgot a pair of parentheses?");
+    }
+    next();
+    parseTermList(terms);
+    expectRParen();
+    cmd->reset(new CheckSatAssumingCommand(terms));
+  }
+  else if (name == "push" || name == "pop")
+  {
+    parsePushPop(name == "push", cmd);
+  }
+  else if (name == "set-logic")
+  {
+    sym = parseSymbol(CHECK_NONE, SYM_SORT);
+    cmd->reset(d_state->setLogic(sym));
+  }
+  else if (name == "set-info" || name == "set-option")
+  {
+    parseSetOption(name == "set-info", cmd);
+  }
+  else if (name == "get-info")
+  {
+    sym = parseKeyword();
+    cmd->reset(new GetInfoCommand(sym.c_str() + 1));
+  }
+  else if (name == "get-option")
+  {
+    sym = parseKeyword();
+    cmd->reset(new GetOptionCommand(sym.c_str() + 1));
+  }
+  else if (name == "declare-sort")
+  {
+    d_state->checkThatLogicIsSet();
+    d_state->checkLogicAllowsFreeSorts();
+    sym = parseSymbol(CHECK_UNDECLARED, SYM_SORT);
+    d_state->checkUserSymbol(sym);
+    uint64_t arity = numeralValue(expect(Smt2TokenKind::NUMERAL, "numeral"));
+    Debug("parser") << "declare sort: '" << sym << "' arity=" << arity
+                    << std::endl;
+    if (arity == 0)
+    {
+      api::Sort type = d_state->mkSort(sym);
+      cmd->reset(new DeclareSortCommand(sym, 0, type));
+    }
+    else
+    {
+      api::Sort type = d_state->mkSortConstructor(sym, arity);
+      cmd->reset(new DeclareSortCommand(sym, arity, type));
+    }
+  }
+  else if (name == "define-sort")
+  {
+    d_state->checkThatLogicIsSet();
+    sym = parseSymbol(CHECK_UNDECLARED, SYM_SORT);
+    d_state->checkUserSymbol(sym);
+    std::vector<std::string> names;
+    expect(Smt2TokenKind::LPAREN, "`('");
+    parseSymbolList(names, CHECK_NONE, SYM_SORT);
+    expectRParen();
+    d_state->pushScope();
+    for (const std::string& n : names)
+    {
+      sorts.push_back(d_state->mkSort(n));
+    }
+    t = parseSort(CHECK_DECLARED);
+    d_state->popScope();
+    // Do NOT call mkSort, since that creates a new sort!
+    // This name is not its own distinct sort, it's an alias.
+    d_state->defineParameterizedType(sym, sorts, t);
+    cmd->reset(new DefineSortCommand(sym, sorts, t));
+  }
+  else if ((name == "declare-datatype" || name == "declare-datatypes")
+           && d_state->v2_6())
+  {
+    d_state->checkThatLogicIsSet();
+    std::vector<std::string> dnames;
+    std::vector<int> arities;
+    if (name == "declare-datatype")
+    {
+      dnames.push_back(parseSymbol(CHECK_UNDECLARED, SYM_SORT));
+      arities.push_back(-1);
+      parseDatatypesDef(false, dnames, arities, cmd);
+    }
+    else
+    {
+      // datatype definition prelude
+      expect(Smt2TokenKind::LPAREN, "`('");
+      while (peek().d_kind == Smt2TokenKind::LPAREN)
+      {
+        next();
+        dnames.push_back(parseSymbol(CHECK_UNDECLARED, SYM_SORT));
+        uint64_t arity =
+            numeralValue(expect(Smt2TokenKind::NUMERAL, "numeral"));
+        arities.push_back(static_cast<int>(arity));
+        expectRParen();
+      }
+      expectRParen();
+      expect(Smt2TokenKind::LPAREN, "`('");
+      parseDatatypesDef(false, dnames, arities, cmd);
+      expectRParen();
+    }
+  }
+  else if (name == "get-value")
+  {
+    d_state->checkThatLogicIsSet();
+    if (peek().d_kind != Smt2TokenKind::LPAREN)
+    {
+      parseError(
+          "The get-value command expects a list of terms.  Perhaps you "
+          "forgot a pair of parentheses?");
+    }
+    next();
+    parseTermList(terms);
+    expectRParen();
+    cmd->reset(new GetValueCommand(terms));
+  }
+  else if (name == "get-assignment")
+  {
+    d_state->checkThatLogicIsSet();
+    cmd->reset(new GetAssignmentCommand());
+  }
+  else if (name == "get-assertions")
+  {
+    d_state->checkThatLogicIsSet();
+    cmd->reset(new GetAssertionsCommand());
+  }
+  else if (name == "get-proof")
+  {
+    d_state->checkThatLogicIsSet();
+    cmd->reset(new GetProofCommand());
+  }
+  else if (name == "get-unsat-assumptions")
+  {
+    d_state->checkThatLogicIsSet();
+    cmd->reset(new GetUnsatAssumptionsCommand);
+  }
+  else if (name == "get-unsat-core")
+  {
+    d_state->checkThatLogicIsSet();
+    cmd->reset(new GetUnsatCoreCommand);
+  }
+  else if (name == "exit")
+  {
+    cmd->reset(new QuitCommand());
+  }
+  else if (parseSmt25Command(name, cmd))
+  {
+  }
+  else if (parseExtendedCommand(name, cmd))
+  {
+    if (d_state->strictModeEnabled())
+    {
+      parseError(
+          "Extended commands are not permitted while operating in strict "
+          "compliance mode.");
+    }
+  }
+  else if (name == "benchmark")
+  {
+    parseError(
+        "In SMT-LIBv2 mode, but got something that looks like SMT-LIBv1, "
+        "which is not supported anymore.");
+  }
+  else
+  {
+    parseError("expected SMT-LIBv2 command, got `" + std::string(name)
+               + "'.");
+  }
+}
+
+void Smt2NativeInput::parsePushPop(bool isPush,
+                                   std::unique_ptr<Command>* cmd)
+{
+  d_state->checkThatLogicIsSet();
+  if (peek().d_kind != Smt2TokenKind::NUMERAL)
+  {
+    if (d_state->strictModeEnabled())
+    {
+      parseError(isPush ? "Strict compliance mode demands an integer to be "
+                          "provided to PUSH.  Maybe you want (push 1)?"
+                        : "Strict compliance mode demands an integer to be "
+                          "provided to POP.Maybe you want (pop 1)?");
+    }
+    if (isPush)
+    {
+      d_state->pushScope(true);
+      cmd->reset(new PushCommand());
+    }
+    else
+    {
+      d_state->popScope();
+      cmd->reset(new PopCommand());
+    }
+    return;
+  }
+  uint64_t num = numeralValue(next());
+  if (!isPush && num > d_state->scopeLevel())
+  {
+    parseError("Attempted to pop above the top stack frame.");
+  }
+  if (num == 0)
+  {
+    cmd->reset(new EmptyCommand());
+    return;
+  }
+  std::unique_ptr<CommandSequence> seq;
+  if (num > 1)
+  {
+    seq.reset(new CommandSequence());
+  }
+  for (uint64_t i = 0; i < num; ++i)
+  {
+    Command* c;
+    if (isPush)
+    {
+      d_state->pushScope(true);
+      c = new PushCommand();
+    }
+    else
+    {
+      d_state->popScope();
+      c = new PopCommand();
+    }
+    if (seq == nullptr)
+    {
+      cmd->reset(c);
+      return;
+    }
+    c->setMuted(num - i > 1);
+    seq->addCommand(c);
+  }
+  cmd->reset(seq.release());
+}
+
+bool Smt2NativeInput::parseSmt25Command(std::string_view name,
+                                        std::unique_ptr<Command>* cmd)
+{
+  SymbolManager* symman = d_state->getSymbolManager();
+  api::Term expr, expr2;
+  api::Sort t;
+  std::vector<std::pair<std::string, api::Sort>> sortedVarNames;
+  std::vector<api::Term> flattenVars;
+  std::vector<api::Term> bvs;
+  if (name == "declare-const")
+  {
+    d_state->checkThatLogicIsSet();
+    std::string sym = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    d_state->checkUserSymbol(sym);
+    t = parseSort(CHECK_DECLARED);
+    // allow overloading here
+    api::Term c = d_state->bindVar(sym, t, false, true);
+    cmd->reset(new DeclareFunctionCommand(sym, c, t));
+  }
+  else if (name == "get-model")
+  {
+    d_state->checkThatLogicIsSet();
+    cmd->reset(new GetModelCommand());
+  }
+  else if (name == "echo")
+  {
+    if (peek().d_kind == Smt2TokenKind::RPAREN)
+    {
+      cmd->reset(new EchoCommand());
+    }
+    else
+    {
+      cmd->reset(new EchoCommand(parseSimpleSymbolicExpr(true)));
+    }
+  }
+  else if (name == "reset")
+  {
+    cmd->reset(new ResetCommand());
+    // reset the state of the parser, which is independent of the symbol
+    // manager
+    d_state->reset();
+  }
+  else if (name == "reset-assertions")
+  {
+    cmd->reset(new ResetAssertionsCommand());
+  }
+  else if (name == "define-fun-rec")
+  {
+    d_state->checkThatLogicIsSet();
+    std::string fname = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    d_state->checkUserSymbol(fname);
+    expect(Smt2TokenKind::LPAREN, "`('");
+    parseSortedVarList(sortedVarNames);
+    expectRParen();
+    t = parseSort(CHECK_DECLARED);
+    api::Term func =
+        d_state->bindDefineFunRec(fname, sortedVarNames, t, flattenVars);
+    d_state->pushDefineFunRecScope(sortedVarNames, func, flattenVars, bvs);
+    expr = parseTerm(expr2);
+    d_state->popScope();
+    if (!flattenVars.empty())
+    {
+      expr = d_state->mkHoApply(expr, flattenVars);
+    }
+    cmd->reset(new DefineFunctionRecCommand(
+        func, bvs, expr, symman->getGlobalDeclarations()));
+  }
+  else if (name == "define-funs-rec")
+  {
+    d_state->checkThatLogicIsSet();
+    std::vector<std::vector<std::pair<std::string, api::Sort>>>
+        sortedVarNamesList;
+    std::vector<std::vector<api::Term>> flattenVarsList;
+    std::vector<std::vector<api::Term>> formals;
+    std::vector<api::Term> funcs;
+    std::vector<api::Term> funcDefs;
+    expect(Smt2TokenKind::LPAREN, "`('");
+    do
+    {
+      expect(Smt2TokenKind::LPAREN, "`('");
+      std::string fname = parseSymbol(CHECK_UNDECLARED, SYM_VARIABLE);
+      d_state->checkUserSymbol(fname);
+      expect(Smt2TokenKind::LPAREN, "`('");
+      parseSortedVarList(sortedVarNames);
+      expectRParen();
+      t = parseSort(CHECK_DECLARED);
+      flattenVars.clear();
+      funcs.push_back(
+          d_state->bindDefineFunRec(fname, sortedVarNames, t, flattenVars));
+      // add to lists (need to remember for when parsing the bodies)
+      sortedVarNamesList.push_back(sortedVarNames);
+      flattenVarsList.push_back(flattenVars);
+      sortedVarNames.clear();
+      expectRParen();
+    } while (peek().d_kind == Smt2TokenKind::LPAREN);
+    expectRParen();
+    expect(Smt2TokenKind::LPAREN, "`('");
+    do
+    {
+      size_t j = funcDefs.size();
+      if (j >= funcs.size())
+      {
+        parseError(
+            "Number of functions defined does not match number listed in "
+            "define-funs-rec");
+      }
+      bvs.clear();
+      d_state->pushDefineFunRecScope(
+          sortedVarNamesList[j], funcs[j], flattenVarsList[j], bvs);
+      expr = parseTerm(expr2);
+      if (!flattenVarsList[j].empty())
+      {
+        expr = d_state->mkHoApply(expr, flattenVarsList[j]);
+      }
+      funcDefs.push_back(expr);
+      formals.push_back(bvs);
+      d_state->popScope();
+    } while (peek().d_kind != Smt2TokenKind::RPAREN);
+    expectRParen();
+    if (funcs.size() != funcDefs.size())
+    {
+      parseError(
+          "Number of functions defined does not match number listed in "
+          "define-funs-rec");
+    }
+    cmd->reset(new DefineFunctionRecCommand(
+        funcs, formals, funcDefs, symman->getGlobalDeclarations()));
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+bool Smt2NativeInput::parseExtendedCommand(std::string_view name,
+                                           std::unique_ptr<Command>* cmd)
+{
+  SymbolManager* symman = d_state->getSymbolManager();
+  api::Term e, e2;
+  std::vector<api::Term> terms;
+  if ((name == "declare-codatatype" || name == "declare-codatatypes")
+      && d_state->v2_6())
+  {
+    d_state->checkThatLogicIsSet();
+    std::vector<std::string> dnames;
+    std::vector<int> arities;
+    if (name == "declare-codatatype")
+    {
+      dnames.push_back(parseSymbol(CHECK_UNDECLARED, SYM_SORT));
+      arities.push_back(-1);
+      parseDatatypesDef(true, dnames, arities, cmd);
+    }
+    else
+    {
+      expect(Smt2TokenKind::LPAREN, "`('");
+      while (peek().d_kind == Smt2TokenKind::LPAREN)
+      {
+        next();
+        dnames.push_back(parseSymbol(CHECK_UNDECLARED, SYM_SORT));
+        uint64_t arity =
+            numeralValue(expect(Smt2TokenKind::NUMERAL, "numeral"));
+        arities.push_back(static_cast<int>(arity));
+        expectRParen();
+      }
+      expectRParen();
+      expect(Smt2TokenKind::LPAREN, "`('");
+      parseDatatypesDef(true, dnames, arities, cmd);
+      expectRParen();
+    }
+  }
+  else if (name == "define-const")
+  {
+    d_state->checkThatLogicIsSet();
+    std::string sym = parseSymbol(CHECK_UNDECLARED, SYM_VARIABLE);
+    d_state->checkUserSymbol(sym);
+    api::Sort t = parseSort(CHECK_DECLARED);
+    d_state->pushScope();
+    e = parseTerm(e2);
+    d_state->popScope();
+    // declare the name down here (while parsing term, signature
+    // must not be extended with the name itself; no recursion
+    // permitted)
+    api::Term func = d_state->bindVar(sym, t);
+    cmd->reset(new DefineFunctionCommand(
+        sym, func, terms, e, symman->getGlobalDeclarations()));
+  }
+  else if (name == "simplify")
+  {
+    d_state->checkThatLogicIsSet();
+    cmd->reset(new SimplifyCommand(parseTerm(e2)));
+  }
+  else if (name == "get-qe" || name == "get-qe-disjunct")
+  {
+    d_state->checkThatLogicIsSet();
+    e = parseTerm(e2);
+    cmd->reset(new GetQuantifierEliminationCommand(e, name == "get-qe"));
+  }
+  else if (name == "declare-heap")
+  {
+    expect(Smt2TokenKind::LPAREN, "`('");
+    api::Sort t = parseSort(CHECK_DECLARED);
+    api::Sort s = parseSort(CHECK_DECLARED);
+    cmd->reset(new DeclareHeapCommand(t, s));
+    expectRParen();
+  }
+  else if (name == "block-model")
+  {
+    d_state->checkThatLogicIsSet();
+    cmd->reset(new BlockModelCommand());
+  }
+  else if (name == "block-model-values")
+  {
+    d_state->checkThatLogicIsSet();
+    if (peek().d_kind != Smt2TokenKind::LPAREN)
+    {
+      parseError(
+          "The block-model-value command expects a list of terms.  Perhaps "
+          "you forgot a pair of parentheses?");
+    }
+    next();
+    parseTermList(terms);
+    expectRParen();
+    cmd->reset(new BlockModelValuesCommand(terms));
+  }
+  else
+  {
+    static const std::unordered_set<std::string> unsupported = {
+        "declare-datatype", "declare-datatypes", "declare-codatatype",
+        "declare-codatatypes", "declare-sorts", "declare-funs",
+        "declare-preds", "define", "get-abduct", "get-interpol"};
+    if (unsupported.find(std::string(name)) != unsupported.end())
+    {
+      parseError("The command `" + std::string(name)
+                 + "' is not supported by --native-smt2-parser in this "
+                   "language version, use the default parser instead.");
+    }
+    return false;
+  }
+  return true;
+}
+
+void Smt2NativeInput::parseDatatypesDef(bool isCo,
+                                        const std::vector<std::string>& dnames,
+                                        const std::vector<int>& arities,
+                                        std::unique_ptr<Command>* cmd)
+{
+  api::Solver* solver = d_state->getSolver();
+  std::vector<api::DatatypeDecl> dts;
+  std::vector<api::Sort> params;
+  d_state->pushScope();
+  // Declare the datatypes that are currently being defined as unresolved
+  // types. If we do not know the arity of the datatype yet, we wait to
+  // define it until parsing the preamble of its body, see Smt2.g.
+  for (size_t i = 0, dsize = dnames.size(); i < dsize; i++)
+  {
+    if (arities[i] >= 0)
+    {
+      d_state->mkUnresolvedType(dnames[i], static_cast<size_t>(arities[i]));
+    }
+  }
+  do
+  {
+    expect(Smt2TokenKind::LPAREN, "`('");
+    params.clear();
+    if (dts.size() >= dnames.size())
+    {
+      parseError("Too many datatypes defined in this block.");
+    }
+    int arity = arities[dts.size()];
+    const std::string& dname = dnames[dts.size()];
+    bool par = isSymbol(peek(), "par");
+    if (par)
+    {
+      next();
+      d_state->pushScope();
+      expect(Smt2TokenKind::LPAREN, "`('");
+      while (peek().d_kind != Smt2TokenKind::RPAREN)
+      {
+        params.push_back(
+            d_state->mkSort(parseSymbol(CHECK_UNDECLARED, SYM_SORT)));
+      }
+      expectRParen();
+      // if the arity was fixed by prelude and is not equal to the number of
+      // parameters
+      if (arity >= 0 && static_cast<int>(params.size()) != arity)
+      {
+        parseError("Wrong number of parameters for datatype.");
+      }
+      expect(Smt2TokenKind::LPAREN, "`('");
+    }
+    else if (arity > 0)
+    {
+      parseError("No parameters given for datatype.");
+    }
+    if (arity < 0)
+    {
+      // now declare it as an unresolved type
+      d_state->mkUnresolvedType(dname, params.size());
+    }
+    Debug("parser-dt") << params.size() << " parameters for " << dname
+                       << std::endl;
+    dts.push_back(solver->mkDatatypeDecl(dname, params, isCo));
+    do
+    {
+      expect(Smt2TokenKind::LPAREN, "`('");
+      parseConstructorDef(dts.back());
+      expectRParen();
+    } while (peek().d_kind == Smt2TokenKind::LPAREN);
+    if (par)
+    {
+      expectRParen();
+      d_state->popScope();
+    }
+    expectRParen();
+  } while (peek().d_kind == Smt2TokenKind::LPAREN);
+  if (dts.size() != dnames.size())
+  {
+    parseError("Wrong number of datatypes provided.");
+  }
+  d_state->popScope();
+  cmd->reset(new DatatypeDeclarationCommand(
+      d_state->bindMutualDatatypeTypes(dts, true)));
+}
+
+void Smt2NativeInput::parseConstructorDef(api::DatatypeDecl& type)
+{
+  std::string id = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+  api::DatatypeConstructorDecl ctor =
+      d_state->getSolver()->mkDatatypeConstructorDecl(id);
+  while (peek().d_kind == Smt2TokenKind::LPAREN)
+  {
+    next();
+    std::string sel = parseSymbol(CHECK_NONE, SYM_SORT);
+    api::Sort t = parseSort(CHECK_NONE);
+    ctor.addSelector(sel, t);
+    expectRParen();
+  }
+  type.addConstructor(ctor);
+}
+
+void Smt2NativeInput::parseSetOption(bool isInfo,
+                                     std::unique_ptr<Command>* cmd)
+{
+  std::string name = parseKeyword();
+  api::Term sexpr = parseSymbolicExpr();
+  if (isInfo)
+  {
+    cmd->reset(new SetInfoCommand(name.c_str() + 1, sexprToString(sexpr)));
+    return;
+  }
+  cmd->reset(new SetOptionCommand(name.c_str() + 1, sexprToString(sexpr)));
+  // Ugly that this changes the state of the parser; but
+  // global-declarations affects parsing, so we can't hold off
+  // on this until some SmtEngine eventually (if ever) executes it.
+  if (name == ":global-declarations")
+  {
+    d_state->getSymbolManager()->setGlobalDeclarations(
+        sexprToString(sexpr) == "true");
+  }
+}
+
+std::string Smt2NativeInput::parseSymbol(DeclarationCheck check,
+                                         SymbolType type)
+{
+  Smt2Token t = next();
+  std::string id;
+  if (t.d_kind == Smt2TokenKind::SYMBOL)
+  {
+    id = text(t);
+    if (id == "_" || id == "!")
+    {
+      parseError("expected symbol, got reserved word `" + id + "'");
+    }
+  }
+  else if (t.d_kind == Smt2TokenKind::QUOTED_SYMBOL)
+  {
+    // strip off the bars
+    id = text(t).substr(1, t.d_end - t.d_begin - 2);
+  }
+  else if (t.d_kind == Smt2TokenKind::END_OF_FILE)
+  {
+    parseError("unexpected end of input, expected symbol", true);
+  }
+  else
+  {
+    parseError("expected symbol, got `" + std::string(text(t)) + "'");
+  }
+  if (!d_state->isAbstractValue(id))
+  {
+    // if an abstract value, SmtEngine handles declaration
+    d_state->checkDeclaration(id, check, type);
+  }
+  return id;
+}
+
+std::string Smt2NativeInput::parseKeyword()
+{
+  return std::string(text(expect(Smt2TokenKind::KEYWORD, "keyword")));
+}
+
+void Smt2NativeInput::parseSymbolList(std::vector<std::string>& names,
+                                      DeclarationCheck check,
+                                      SymbolType type)
+{
+  while (peek().d_kind == Smt2TokenKind::SYMBOL
+         || peek().d_kind == Smt2TokenKind::QUOTED_SYMBOL)
+  {
+    names.push_back(parseSymbol(check, type));
+  }
+}
+
+std::string Smt2NativeInput::parseStr(bool fsmtlib)
+{
+  Smt2Token t = expect(Smt2TokenKind::STRING, "string literal");
+  // strip off the quotes
+  std::string s(text(t).substr(1, t.d_end - t.d_begin - 2));
+  for (char c : s)
+  {
+    if (static_cast<unsigned char>(c) > 127 && !std::isprint(c))
+    {
+      parseError(
+          "Extended/unprintable characters are not part of SMT-LIB, and they "
+          "must be encoded as escape sequences");
+    }
+  }
+  bool dupDblQuote = d_state->escapeDupDblQuote();
+  if (!fsmtlib && !dupDblQuote)
+  {
+    return s;
+  }
+  std::string res;
+  res.reserve(s.size());
+  for (size_t i = 0, size = s.size(); i < size; ++i)
+  {
+    if (dupDblQuote && s[i] == '"')
+    {
+      // Handle SMT-LIB >=2.5 standard escape '""'.
+      ++i;
+      Assert(i < size && s[i] == '"');
+    }
+    else if (!dupDblQuote && s[i] == '\\' && i + 1 < size)
+    {
+      // Handle SMT-LIB 2.0 standard escapes '\\' and '\"'.
+      ++i;
+      if (s[i] != '\\' && s[i] != '"')
+      {
+        res.push_back('\\');
+      }
+    }
+    res.push_back(s[i]);
+  }
+  return res;
+}
+
+std::string Smt2NativeInput::parseSimpleSymbolicExpr(bool allowKeyword)
+{
+  switch (peek().d_kind)
+  {
+    case Smt2TokenKind::NUMERAL:
+    case Smt2TokenKind::DECIMAL:
+    case Smt2TokenKind::HEXADECIMAL:
+    case Smt2TokenKind::BINARY: return std::string(text(next()));
+    case Smt2TokenKind::STRING: return parseStr(false);
+    case Smt2TokenKind::KEYWORD:
+      if (allowKeyword)
+      {
+        return std::string(text(next()));
+      }
+      break;
+    default: break;
+  }
+  return parseSymbol(CHECK_NONE, SYM_SORT);
+}
+
+api::Term Smt2NativeInput::parseSymbolicExpr()
+{
+  api::Solver* solver = d_state->getSolver();
+  if (peek().d_kind == Smt2TokenKind::LPAREN)
+  {
+    next();
+    std::vector<api::Term> children;
+    while (peek().d_kind != Smt2TokenKind::RPAREN)
+    {
+      children.push_back(parseSymbolicExpr());
+    }
+    expectRParen();
+    return solver->mkTerm(api::SEXPR, children);
+  }
+  std::string s = parseSimpleSymbolicExpr(true);
+  return solver->mkString(d_state->processAdHocStringEsc(s));
+}
+
+api::Term Smt2NativeInput::parseTerm(api::Term& expr2)
+{
+  api::Solver* solver = d_state->getSolver();
+  Smt2Token t = peek();
+  switch (t.d_kind)
+  {
+    case Smt2TokenKind::LPAREN: return parseTermNonVariable(expr2);
+    case Smt2TokenKind::SYMBOL:
+      if (isSymbol(t, "mkTuple")
+          && d_state->isTheoryEnabled(theory::THEORY_DATATYPES))
+      {
+        // empty tuple constant
+        next();
+        return solver->mkTuple(std::vector<api::Sort>(),
+                               std::vector<api::Term>());
+      }
+      CVC4_FALLTHROUGH;
+    case Smt2TokenKind::QUOTED_SYMBOL:
+    {
+      // a qualified identifier (section 3.6 of SMT-LIB version 2.6)
+      ParseOp p;
+      parseIdentifier(p);
+      return d_state->parseOpToExpr(p);
+    }
+    case Smt2TokenKind::NUMERAL:
+      next();
+      return solver->mkInteger(std::string(text(t)));
+    case Smt2TokenKind::DECIMAL:
+      next();
+      return solver->ensureTermSort(solver->mkReal(std::string(text(t))),
+                                    solver->getRealSort());
+    case Smt2TokenKind::HEXADECIMAL:
+      next();
+      return solver->mkBitVector(std::string(text(t).substr(2)), 16);
+    case Smt2TokenKind::BINARY:
+      next();
+      return solver->mkBitVector(std::string(text(t).substr(2)), 2);
+    case Smt2TokenKind::STRING:
+      return d_state->mkStringConstant(parseStr(false));
+    default: break;
+  }
+  next();
+  if (t.d_kind == Smt2TokenKind::END_OF_FILE)
+  {
+    parseError("unexpected end of input, expected term", true);
+  }
+  parseError("expected term, got `" + std::string(text(t)) + "'");
+  return api::Term();
+}
+
+api::Term Smt2NativeInput::parseTermNonVariable(api::Term& expr2)
+{
+  api::Solver* solver = d_state->getSolver();
+  Assert(peek().d_kind == Smt2TokenKind::LPAREN);
+  const Smt2Token& h = peek(1);
+  api::Term expr, f, f2;
+  std::vector<api::Term> args;
+  if (h.d_kind == Smt2TokenKind::SYMBOL)
+  {
+    if (isSymbol(h, "forall") || isSymbol(h, "exists"))
+    {
+      api::Kind kind = isSymbol(h, "forall") ? api::FORALL : api::EXISTS;
+      next();
+      next();
+      if (!d_state->isTheoryEnabled(theory::THEORY_QUANTIFIERS))
+      {
+        parseError("Quantifier used in non-quantified logic.");
+      }
+      d_state->pushScope();
+      args.push_back(parseBoundVarList());
+      f = parseTerm(f2);
+      expectRParen();
+      d_state->popScope();
+      args.push_back(f);
+      if (!f2.isNull())
+      {
+        args.push_back(f2);
+      }
+      return solver->mkTerm(kind, args);
+    }
+    if (isSymbol(h, "let"))
+    {
+      return parseLetTerm();
+    }
+    if (isSymbol(h, "!"))
+    {
+      return parseAttributedTerm(expr2);
+    }
+    if (isSymbol(h, "_"))
+    {
+      return parseIndexedConstant();
+    }
+    if (isSymbol(h, "as"))
+    {
+      ParseOp p;
+      parseQualIdentifier(p);
+      return d_state->parseOpToExpr(p);
+    }
+    if (isSymbol(h, "match") && d_state->v2_6()
+        && d_state->isTheoryEnabled(theory::THEORY_DATATYPES))
+    {
+      return parseMatchTerm();
+    }
+    if (isSymbol(h, "lambda") && d_state->isHoEnabled())
+    {
+      next();
+      next();
+      d_state->pushScope();
+      args.push_back(parseBoundVarList());
+      args.push_back(parseTerm(f2));
+      expectRParen();
+      d_state->popScope();
+      return solver->mkTerm(api::LAMBDA, args);
+    }
+    if (isSymbol(h, "comprehension")
+        && d_state->isTheoryEnabled(theory::THEORY_SETS))
+    {
+      next();
+      next();
+      d_state->pushScope();
+      args.push_back(parseBoundVarList());
+      args.push_back(parseTerm(f2));
+      args.push_back(parseTerm(f2));
+      expectRParen();
+      d_state->popScope();
+      return solver->mkTerm(api::COMPREHENSION, args);
+    }
+    if (isSymbol(h, "mkTuple")
+        && d_state->isTheoryEnabled(theory::THEORY_DATATYPES))
+    {
+      next();
+      next();
+      parseTermList(args);
+      expectRParen();
+      std::vector<api::Sort> sorts;
+      for (const api::Term& arg : args)
+      {
+        sorts.emplace_back(arg.getSort());
+      }
+      return solver->mkTuple(sorts, args);
+    }
+    if (isSymbol(h, "tuple_project")
+        && d_state->isTheoryEnabled(theory::THEORY_DATATYPES))
+    {
+      next();
+      next();
+      expr = parseTerm(f2);
+      expectRParen();
+      std::vector<uint32_t> indices;
+      api::Op op = solver->mkOp(api::TUPLE_PROJECT, indices);
+      return solver->mkTerm(op, expr);
+    }
+  }
+  // an application of a qualified identifier
+  next();
+  ParseOp p;
+  parseQualIdentifier(p);
+  parseTermList(args);
+  expectRParen();
+  return d_state->applyParseOp(p, args);
+}
+
+api::Term Smt2NativeInput::parseLetTerm()
+{
+  next();
+  next();
+  api::Term expr, f2;
+  std::unordered_set<std::string> names;
+  std::vector<std::pair<std::string, api::Term>> binders;
+  expect(Smt2TokenKind::LPAREN, "`('");
+  d_state->pushScope();
+  do
+  {
+    expect(Smt2TokenKind::LPAREN, "`('");
+    std::string name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    expr = parseTerm(f2);
+    expectRParen();
+    // this is a parallel let, so we have to save up all the contributions
+    // of the let and define them only later on
+    if (!names.insert(name).second)
+    {
+      std::stringstream ss;
+      ss << "warning: symbol `" << name << "' bound multiple times by let;"
+         << " the last binding will be used, shadowing earlier ones";
+      d_state->warning(ss.str());
+    }
+    binders.push_back(std::make_pair(name, expr));
+  } while (peek().d_kind == Smt2TokenKind::LPAREN);
+  expectRParen();
+  // now implement these bindings
+  for (const std::pair<std::string, api::Term>& binder : binders)
+  {
+    d_state->defineVar(binder.first, binder.second);
+  }
+  expr = parseTerm(f2);
+  expectRParen();
+  d_state->popScope();
+  return expr;
+}
+
+api::Term Smt2NativeInput::parseMatchTerm()
+{
+  api::Solver* solver = d_state->getSolver();
+  next();
+  next();
+  api::Term f, f2, f3;
+  std::vector<api::Term> matchcases;
+  api::Term expr = parseTerm(f2);
+  if (!expr.getSort().isDatatype())
+  {
+    parseError("Cannot match on non-datatype term.");
+  }
+  expect(Smt2TokenKind::LPAREN, "`('");
+  do
+  {
+    expect(Smt2TokenKind::LPAREN, "`('");
+    if (peek().d_kind == Smt2TokenKind::LPAREN)
+    {
+      // case with non-nullary pattern
+      next();
+      f = parseTerm(f2);
+      std::vector<api::Term> args;
+      d_state->pushScope();
+      // f should be a constructor
+      api::Sort type = f.getSort();
+      Debug("parser-dt") << "Pattern head : " << f << " " << type
+                         << std::endl;
+      if (!type.isConstructor())
+      {
+        parseError(
+            "Pattern must be application of a constructor or a variable.");
+      }
+      api::Datatype dt = type.getConstructorCodomainSort().getDatatype();
+      if (dt.isParametric())
+      {
+        // lookup constructor by name
+        api::DatatypeConstructor dc = dt.getConstructor(f.toString());
+        api::Term scons = dc.getSpecializedConstructorTerm(expr.getSort());
+        // take the type of the specialized constructor instead
+        type = scons.getSort();
+      }
+      std::vector<api::Sort> argTypes = type.getConstructorDomainSorts();
+      // arguments of the pattern
+      while (peek().d_kind != Smt2TokenKind::RPAREN)
+      {
+        std::string name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+        if (args.size() >= argTypes.size())
+        {
+          parseError("Too many arguments for pattern.");
+        }
+        // make of proper type
+        args.push_back(d_state->bindBoundVar(name, argTypes[args.size()]));
+      }
+      expectRParen();
+      f3 = parseTerm(f2);
+      // make the match case
+      std::vector<api::Term> cargs;
+      cargs.push_back(f);
+      cargs.insert(cargs.end(), args.begin(), args.end());
+      api::Term c = solver->mkTerm(api::APPLY_CONSTRUCTOR, cargs);
+      api::Term bvla = solver->mkTerm(api::BOUND_VAR_LIST, args);
+      matchcases.push_back(solver->mkTerm(api::MATCH_BIND_CASE, bvla, c, f3));
+      // now, pop the scope
+      d_state->popScope();
+    }
+    else
+    {
+      // case with nullary or variable pattern
+      std::string name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+      if (d_state->isDeclared(name, SYM_VARIABLE))
+      {
+        f = d_state->getVariable(name);
+        api::Sort type = f.getSort();
+        if (!type.isConstructor() || !type.getConstructorDomainSorts().empty())
+        {
+          parseError(
+              "Must apply constructors of arity greater than 0 to arguments "
+              "in pattern.");
+        }
+        // make nullary constructor application
+        f = solver->mkTerm(api::APPLY_CONSTRUCTOR, f);
+      }
+      else
+      {
+        // it has the type of the head expr
+        f = d_state->bindBoundVar(name, expr.getSort());
+      }
+      f3 = parseTerm(f2);
+      if (f.getKind() == api::VARIABLE)
+      {
+        api::Term bvlf = solver->mkTerm(api::BOUND_VAR_LIST, f);
+        matchcases.push_back(
+            solver->mkTerm(api::MATCH_BIND_CASE, bvlf, f, f3));
+      }
+      else
+      {
+        matchcases.push_back(solver->mkTerm(api::MATCH_CASE, f, f3));
+      }
+    }
+    expectRParen();
+  } while (peek().d_kind == Smt2TokenKind::LPAREN);
+  expectRParen();
+  expectRParen();
+  std::vector<api::Term> mchildren;
+  mchildren.push_back(expr);
+  mchildren.insert(mchildren.end(), matchcases.begin(), matchcases.end());
+  return solver->mkTerm(api::MATCH, mchildren);
+}
+
+api::Term Smt2NativeInput::parseAttributedTerm(api::Term& expr2)
+{
+  api::Solver* solver = d_state->getSolver();
+  next();
+  next();
+  api::Term f2;
+  api::Term expr = parseTerm(f2);
+  std::vector<api::Term> patexprs;
+  do
+  {
+    std::string attr;
+    api::Term attexpr = parseAttribute(expr, attr);
+    if (!attexpr.isNull())
+    {
+      patexprs.push_back(attexpr);
+    }
+  } while (peek().d_kind == Smt2TokenKind::KEYWORD);
+  expectRParen();
+  if (patexprs.empty())
+  {
+    expr2 = f2;
+    return expr;
+  }
+  if (!f2.isNull() && f2.getKind() == api::INST_PATTERN_LIST)
+  {
+    for (size_t i = 0; i < f2.getNumChildren(); i++)
+    {
+      if (f2[i].getKind() == api::INST_PATTERN)
+      {
+        patexprs.push_back(f2[i]);
+      }
+      else
+      {
+        std::stringstream ss;
+        ss << "warning: rewrite rules do not support " << f2[i]
+           << " within instantiation pattern list";
+        d_state->warning(ss.str());
+      }
+    }
+  }
+  expr2 = solver->mkTerm(api::INST_PATTERN_LIST, patexprs);
+  return expr;
+}
+
+api::Term Smt2NativeInput::parseAttribute(api::Term& expr, std::string& attr)
+{
+  api::Solver* solver = d_state->getSolver();
+  std::string keyword = parseKeyword();
+  api::Term e2;
+  if (keyword == ":pattern")
+  {
+    std::vector<api::Term> patexprs;
+    expect(Smt2TokenKind::LPAREN, "`('");
+    do
+    {
+      patexprs.push_back(parseTerm(e2));
+    } while (peek().d_kind != Smt2TokenKind::RPAREN);
+    expectRParen();
+    attr = keyword;
+    return solver->mkTerm(api::INST_PATTERN, patexprs);
+  }
+  if (keyword == ":no-pattern")
+  {
+    api::Term patexpr = parseTerm(e2);
+    attr = keyword;
+    return solver->mkTerm(api::INST_NO_PATTERN, patexpr);
+  }
+  if (keyword == ":quant-inst-max-level")
+  {
+    Smt2Token n = expect(Smt2TokenKind::NUMERAL, "numeral");
+    std::vector<api::Term> values;
+    values.push_back(solver->mkInteger(std::string(text(n))));
+    std::string attrName = keyword.substr(1);
+    api::Term avar = d_state->bindVar(attrName, solver->getBooleanSort());
+    Command* c = new SetUserAttributeCommand(attrName, avar, values);
+    c->setMuted(true);
+    d_state->preemptCommand(c);
+    return solver->mkTerm(api::INST_ATTRIBUTE, avar);
+  }
+  if (keyword == ":qid")
+  {
+    api::Term sexpr = parseSymbolicExpr();
+    api::Term avar =
+        solver->mkConst(solver->getBooleanSort(), sexprToString(sexpr));
+    attr = keyword;
+    Command* c = new SetUserAttributeCommand("qid", avar);
+    c->setMuted(true);
+    d_state->preemptCommand(c);
+    return solver->mkTerm(api::INST_ATTRIBUTE, avar);
+  }
+  if (keyword == ":named")
+  {
+    api::Term sexpr = parseSymbolicExpr();
+    attr = keyword;
+    // notify that expression was given a name
+    d_state->notifyNamedExpression(expr, sexprToString(sexpr));
+    return api::Term();
+  }
+  Smt2TokenKind k = peek().d_kind;
+  if (k != Smt2TokenKind::KEYWORD && k != Smt2TokenKind::LPAREN
+      && k != Smt2TokenKind::RPAREN)
+  {
+    parseSimpleSymbolicExpr(false);
+  }
+  attr = keyword;
+  d_state->attributeNotSupported(attr);
+  return api::Term();
+}
+
+api::Term Smt2NativeInput::parseIndexedConstant()
+{
+  api::Solver* solver = d_state->getSolver();
+  next();
+  next();
+  api::Term atomTerm;
+  const Smt2Token& t = peek();
+  if (isSymbol(t, "emp") && d_state->isTheoryEnabled(theory::THEORY_SEP))
+  {
+    next();
+    api::Sort type = parseSort(CHECK_DECLARED);
+    api::Sort type2 = parseSort(CHECK_DECLARED);
+    // Empty heap constant in seperation logic
+    api::Term v1 = solver->mkConst(type, "_emp1");
+    api::Term v2 = solver->mkConst(type2, "_emp2");
+    atomTerm = solver->mkTerm(api::SEP_EMP, v1, v2);
+  }
+  else if (isSymbol(t, "char")
+           && d_state->isTheoryEnabled(theory::THEORY_STRINGS))
+  {
+    next();
+    Smt2Token h = expect(Smt2TokenKind::HEXADECIMAL, "hexadecimal constant");
+    atomTerm = solver->mkChar(std::string(text(h).substr(2)));
+  }
+  else
+  {
+    std::string name(text(expect(Smt2TokenKind::SYMBOL, "symbol")));
+    std::vector<uint64_t> numerals;
+    parseNonemptyNumeralList(numerals);
+    atomTerm = d_state->mkIndexedConstant(name, numerals);
+  }
+  expectRParen();
+  return atomTerm;
+}
+
+void Smt2NativeInput::parseTermList(std::vector<api::Term>& terms)
+{
+  api::Term expr2;
+  do
+  {
+    terms.push_back(parseTerm(expr2));
+  } while (peek().d_kind != Smt2TokenKind::RPAREN);
+}
+
+void Smt2NativeInput::parseQualIdentifier(ParseOp& p)
+{
+  if (peek().d_kind != Smt2TokenKind::LPAREN || !isSymbol(peek(1), "as"))
+  {
+    parseIdentifier(p);
+    return;
+  }
+  next();
+  next();
+  if (isSymbol(peek(), "const") && !d_state->strictModeEnabled())
+  {
+    next();
+    api::Sort type = parseSort(CHECK_DECLARED);
+    p.d_kind = api::CONST_ARRAY;
+    d_state->parseOpApplyTypeAscription(p, type);
+  }
+  else
+  {
+    parseIdentifier(p);
+    api::Sort type = parseSort(CHECK_DECLARED);
+    d_state->parseOpApplyTypeAscription(p, type);
+  }
+  expectRParen();
+}
+
+void Smt2NativeInput::parseIdentifier(ParseOp& p)
+{
+  if (peek().d_kind != Smt2TokenKind::LPAREN)
+  {
+    p.d_name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    return;
+  }
+  next();
+  if (!isSymbol(peek(), "_"))
+  {
+    Smt2Token t = next();
+    parseError("expected identifier, got `" + std::string(text(t)) + "'",
+               t.d_kind == Smt2TokenKind::END_OF_FILE);
+  }
+  next();
+  parseIndexedIdentifier(p);
+  expectRParen();
+}
+
+void Smt2NativeInput::parseIndexedIdentifier(ParseOp& p)
+{
+  api::Solver* solver = d_state->getSolver();
+  std::vector<uint64_t> numerals;
+  const Smt2Token& t = peek();
+  bool datatypes = d_state->isTheoryEnabled(theory::THEORY_DATATYPES);
+  if (isSymbol(t, "is") && d_state->v2_6() && datatypes)
+  {
+    next();
+    api::Term f2;
+    api::Term f = parseTerm(f2);
+    if (f.getKind() == api::APPLY_CONSTRUCTOR && f.getNumChildren() == 1)
+    {
+      // for nullary constructors, must get the operator
+      f = f[0];
+    }
+    if (!f.getSort().isConstructor())
+    {
+      parseError("Bad syntax for test (_ is X), X must be a constructor.");
+    }
+    // get the datatype that f belongs to
+    api::Sort sf = f.getSort().getConstructorCodomainSort();
+    api::Datatype d = sf.getDatatype();
+    // lookup by name
+    api::DatatypeConstructor dc = d.getConstructor(f.toString());
+    p.d_expr = dc.getTesterTerm();
+  }
+  else if (isSymbol(t, "tupSel") && datatypes)
+  {
+    next();
+    // we adopt a special syntax (_ tupSel n)
+    p.d_kind = api::APPLY_SELECTOR;
+    // put m in expr so that the caller can deal with this case
+    p.d_expr = solver->mkInteger(
+        numeralValue(expect(Smt2TokenKind::NUMERAL, "numeral")));
+  }
+  else if (isSymbol(t, "tuple_project") && datatypes)
+  {
+    next();
+    // we adopt a special syntax (_ tuple_project i_1 ... i_n) where
+    // i_1, ..., i_n are numerals
+    parseNonemptyNumeralList(numerals);
+    p.d_kind = api::TUPLE_PROJECT;
+    std::vector<uint32_t> indices(numerals.begin(), numerals.end());
+    p.d_op = solver->mkOp(api::TUPLE_PROJECT, indices);
+  }
+  else
+  {
+    std::string name(text(expect(Smt2TokenKind::SYMBOL, "symbol")));
+    parseNonemptyNumeralList(numerals);
+    p.d_op = d_state->mkIndexedOp(name, numerals);
+  }
+}
+
+void Smt2NativeInput::parseNonemptyNumeralList(std::vector<uint64_t>& numerals)
+{
+  do
+  {
+    numerals.push_back(
+        numeralValue(expect(Smt2TokenKind::NUMERAL, "numeral")));
+  } while (peek().d_kind == Smt2TokenKind::NUMERAL);
+}
+
+api::Sort Smt2NativeInput::parseSort(DeclarationCheck check)
+{
+  api::Solver* solver = d_state->getSolver();
+  if (peek().d_kind != Smt2TokenKind::LPAREN)
+  {
+    std::string name = parseSymbol(CHECK_NONE, SYM_SORT);
+    if (check == CHECK_DECLARED || d_state->isDeclared(name, SYM_SORT))
+    {
+      return d_state->getSort(name);
+    }
+    return d_state->mkUnresolvedType(name);
+  }
+  next();
+  api::Sort t;
+  std::vector<api::Sort> args;
+  if (isSymbol(peek(), "->") && d_state->isHoEnabled())
+  {
+    next();
+    parseSortList(args);
+    expectRParen();
+    if (args.size() < 2)
+    {
+      parseError("Arrow types must have at least 2 arguments");
+    }
+    // flatten the type
+    api::Sort rangeType = args.back();
+    args.pop_back();
+    return d_state->mkFlatFunctionType(args, rangeType);
+  }
+  bool indexed = isSymbol(peek(), "_");
+  if (indexed)
+  {
+    next();
+  }
+  std::string name = parseSymbol(CHECK_NONE, SYM_SORT);
+  if (peek().d_kind == Smt2TokenKind::NUMERAL)
+  {
+    std::vector<uint64_t> numerals;
+    parseNonemptyNumeralList(numerals);
+    if (!indexed)
+    {
+      std::stringstream ss;
+      ss << "SMT-LIB requires use of an indexed sort here, e.g. (_ " << name
+         << " ...)";
+      parseError(ss.str());
+    }
+    if (name == "BitVec")
+    {
+      if (numerals.size() != 1)
+      {
+        parseError("Illegal bitvector type.");
+      }
+      if (numerals.front() == 0)
+      {
+        parseError("Illegal bitvector size: 0");
+      }
+      t = solver->mkBitVectorSort(numerals.front());
+    }
+    else if (name == "FloatingPoint")
+    {
+      if (numerals.size() != 2)
+      {
+        parseError("Illegal floating-point type.");
+      }
+      if (!validExponentSize(numerals[0]))
+      {
+        parseError("Illegal floating-point exponent size");
+      }
+      if (!validSignificandSize(numerals[1]))
+      {
+        parseError("Illegal floating-point significand size");
+      }
+      t = solver->mkFloatingPointSort(numerals[0], numerals[1]);
+    }
+    else
+    {
+      std::stringstream ss;
+      ss << "unknown indexed sort symbol `" << name << "'";
+      parseError(ss.str());
+    }
+    expectRParen();
+    return t;
+  }
+  parseSortList(args);
+  expectRParen();
+  if (indexed)
+  {
+    std::stringstream ss;
+    ss << "Unexpected use of indexing operator `_' before `" << name
+       << "', try leaving it out";
+    parseError(ss.str());
+  }
+  if (args.empty())
+  {
+    parseError(
+        "Extra parentheses around sort name not permitted in SMT-LIB");
+  }
+  else if (name == "Array"
+           && d_state->isTheoryEnabled(theory::THEORY_ARRAYS))
+  {
+    if (args.size() != 2)
+    {
+      parseError("Illegal array type.");
+    }
+    t = solver->mkArraySort(args[0], args[1]);
+  }
+  else if (name == "Set" && d_state->isTheoryEnabled(theory::THEORY_SETS))
+  {
+    if (args.size() != 1)
+    {
+      parseError("Illegal set type.");
+    }
+    t = solver->mkSetSort(args[0]);
+  }
+  else if (name == "Bag" && d_state->isTheoryEnabled(theory::THEORY_BAGS))
+  {
+    if (args.size() != 1)
+    {
+      parseError("Illegal bag type.");
+    }
+    t = solver->mkBagSort(args[0]);
+  }
+  else if (name == "Seq" && !d_state->strictModeEnabled()
+           && d_state->isTheoryEnabled(theory::THEORY_STRINGS))
+  {
+    if (args.size() != 1)
+    {
+      parseError("Illegal sequence type.");
+    }
+    t = solver->mkSequenceSort(args[0]);
+  }
+  else if (name == "Tuple" && !d_state->strictModeEnabled())
+  {
+    t = solver->mkTupleSort(args);
+  }
+  else if (check == CHECK_DECLARED || d_state->isDeclared(name, SYM_SORT))
+  {
+    t = d_state->getSort(name, args);
+  }
+  else
+  {
+    // make unresolved type
+    t = d_state->mkUnresolvedTypeConstructor(name, args);
+    t = t.instantiate(args);
+  }
+  return t;
+}
+
+void Smt2NativeInput::parseSortList(std::vector<api::Sort>& sorts)
+{
+  while (peek().d_kind != Smt2TokenKind::RPAREN)
+  {
+    sorts.push_back(parseSort(CHECK_DECLARED));
+  }
+}
+
+void Smt2NativeInput::parseSortedVarList(
+    std::vector<std::pair<std::string, api::Sort>>& sortedVars)
+{
+  while (peek().d_kind == Smt2TokenKind::LPAREN)
+  {
+    next();
+    std::string name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    api::Sort t = parseSort(CHECK_DECLARED);
+    expectRParen();
+    sortedVars.push_back(make_pair(name, t));
+  }
+}
+
+api::Term Smt2NativeInput::parseBoundVarList()
+{
+  std::vector<std::pair<std::string, api::Sort>> sortedVarNames;
+  expect(Smt2TokenKind::LPAREN, "`('");
+  parseSortedVarList(sortedVarNames);
+  expectRParen();
+  std::vector<api::Term> args = d_state->bindBoundVars(sortedVarNames);
+  return d_state->getSolver()->mkTerm(api::BOUND_VAR_LIST, args);
+}
+
+}  // namespace parser
+}  // namespace cvc5
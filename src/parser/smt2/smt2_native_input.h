@@ -0,0 +1,298 @@
+/*********************                                                        */
+/*! \file smt2_native_input.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A hand-written lexer and parser for SMT-LIB 2.
+ **
+ ** A hand-written lexer and recursive-descent parser for SMT-LIB 2 that is
+ ** used instead of the ANTLR generated one with --native-smt2-parser. It
+ ** reads the input from a memory-mapped file, a string or chunk-wise from a
+ ** stream, tokenizes it without copying, and builds terms through the same
+ ** Smt2 parser state as the ANTLR grammar in Smt2.g. SyGuS and some
+ ** extended commands are not supported.
+ **/
+
+#include "cvc4parser_private.h"
+
+#ifndef CVC4__PARSER__SMT2__SMT2_NATIVE_INPUT_H
+#define CVC4__PARSER__SMT2__SMT2_NATIVE_INPUT_H
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "api/cvc4cpp.h"
+#include "parser/input.h"
+#include "parser/parse_op.h"
+#include "parser/parser.h"
+
+namespace cvc5 {
+
+class Command;
+
+namespace parser {
+
+class Smt2;
+
+/**
+ * The characters of an SMT-LIB 2 input. The characters are either the
+ * memory-mapped file, a copy of a string, or read from a stream on demand,
+ * in chunks or line by line. Characters of a stream that have been consumed
+ * are discarded by discard(), such that the buffer does not grow with the
+ * size of the input.
+ */
+class Smt2NativeInputStream : public InputStream
+{
+ public:
+  /**
+   * Create an input stream for the given file. The file is memory-mapped if
+   * useMmap is true, and read in chunks otherwise.
+   *
+   * @throws InputStreamException if the file cannot be opened
+   */
+  static Smt2NativeInputStream* newFileInputStream(const std::string& name,
+                                                   bool useMmap);
+  /** Create an input stream that reads from the given stream. */
+  static Smt2NativeInputStream* newStreamInputStream(std::istream& input,
+                                                     const std::string& name,
+                                                     bool lineBuffered);
+  /** Create an input stream for a copy of the given string. */
+  static Smt2NativeInputStream* newStringInputStream(const std::string& input,
+                                                     const std::string& name);
+
+  ~Smt2NativeInputStream() override;
+
+  /**
+   * Make the character at position pos available, reading more of the
+   * underlying stream if necessary. Returns false if the input ends before
+   * pos.
+   */
+  bool available(size_t pos)
+  {
+    return pos < d_size || (d_stream != nullptr && fill(pos));
+  }
+  /** The character at position pos, which must be available. */
+  char at(size_t pos) const { return d_data[pos]; }
+  /** The characters in [begin, end), which must be available. */
+  std::string_view text(size_t begin, size_t end) const
+  {
+    return std::string_view(d_data + begin, end - begin);
+  }
+  /**
+   * Discard the characters before position pos if this stream owns its
+   * buffer and enough of them have been consumed. Returns the number of
+   * discarded characters, by which all positions must be shifted.
+   */
+  size_t discard(size_t pos);
+
+ private:
+  Smt2NativeInputStream(const std::string& name);
+
+  /** Read from d_stream until pos is available or the stream ends. */
+  bool fill(size_t pos);
+
+  /** The characters, d_size of which are available. */
+  const char* d_data;
+  size_t d_size;
+  /** The buffer for strings and streams. */
+  std::string d_buffer;
+  /** The stream to read from, or null if all characters are available. */
+  std::istream* d_stream;
+  /** The file stream for files that are not memory-mapped. */
+  std::unique_ptr<std::istream> d_fileStream;
+  /** Whether d_stream is read line by line. */
+  bool d_lineBuffered;
+  /** The memory-mapped file and its size, if any. */
+  void* d_mmap;
+  size_t d_mmapSize;
+}; /* class Smt2NativeInputStream */
+
+/** The kinds of tokens of the native SMT-LIB 2 lexer. */
+enum class Smt2TokenKind
+{
+  LPAREN,
+  RPAREN,
+  /** A simple symbol, including reserved words such as let or _ */
+  SYMBOL,
+  /** A |quoted| symbol, the text includes the bars */
+  QUOTED_SYMBOL,
+  /** A keyword, the text includes the colon */
+  KEYWORD,
+  NUMERAL,
+  DECIMAL,
+  /** A #x hexadecimal constant, the text includes the prefix */
+  HEXADECIMAL,
+  /** A #b binary constant, the text includes the prefix */
+  BINARY,
+  /** A string literal, the text includes the quotes */
+  STRING,
+  END_OF_FILE
+};
+
+/**
+ * A token, given by its position in the input stream it was read from. The
+ * text of the token is not copied.
+ */
+struct Smt2Token
+{
+  Smt2TokenKind d_kind;
+  Smt2NativeInputStream* d_stream;
+  size_t d_begin;
+  size_t d_end;
+  uint32_t d_line;
+  uint32_t d_column;
+};
+
+/**
+ * An input that is parsed by the native SMT-LIB 2 parser. The parser is a
+ * recursive-descent parser with a lookahead of at most two tokens that
+ * mirrors the rules of Smt2.g and calls the same methods of the Smt2 parser
+ * state. Tokens are lexed on demand, such that a command is returned as soon
+ * as its closing parenthesis has been read, which is required for
+ * interactive input.
+ */
+class Smt2NativeInput : public Input
+{
+ public:
+  /** Create an input that takes ownership of the given input stream. */
+  Smt2NativeInput(Smt2NativeInputStream* inputStream);
+  ~Smt2NativeInput() override;
+
+ protected:
+  /**
+   * Parse a command from the input. Returns <code>NULL</code> if there is
+   * no command there to parse.
+   *
+   * @throws ParserException if an error is encountered during parsing.
+   */
+  Command* parseCommand() override;
+
+  /**
+   * Parse an expression from the input. Returns a null <code>Term</code> if
+   * there is no expression there to parse.
+   *
+   * @throws ParserException if an error is encountered during parsing.
+   */
+  api::Term parseExpr() override;
+
+  /** Issue a warning to the user, with source file, line, and column info. */
+  void warning(const std::string& msg) override;
+
+  /** Throws a <code>ParserException</code> with the given message. */
+  void parseError(const std::string& msg, bool eofException = false) override;
+
+  /** Set the Parser object for this input, which must be an Smt2 parser. */
+  void setParser(Parser& parser) override;
+
+ private:
+  /** An input stream that is being lexed and the lexer state in it. */
+  struct Source
+  {
+    Smt2NativeInputStream* d_stream;
+    /** The owned stream of included files */
+    std::unique_ptr<Smt2NativeInputStream> d_owned;
+    size_t d_pos;
+    uint32_t d_line;
+    uint32_t d_column;
+  };
+
+  //------------------------------------ lexer
+  /** Lex the next token of the current source. */
+  Smt2Token lex();
+  /** Skip whitespace and comments. */
+  void skipWhitespace(Source& s);
+  /** Advance s by one character, tracking lines and columns. */
+  void advance(Source& s);
+  /** Get the i^th token of the lookahead, with i < 2. */
+  const Smt2Token& peek(size_t i = 0);
+  /** Consume the next token. */
+  Smt2Token next();
+  /** Consume the next token, which must be of the given kind. */
+  Smt2Token expect(Smt2TokenKind kind, const char* what);
+  /** Consume the closing parenthesis of the current s-expression. */
+  void expectRParen() { expect(Smt2TokenKind::RPAREN, "`)'"); }
+  /** The text of the given token. */
+  std::string_view text(const Smt2Token& t) const
+  {
+    return t.d_stream->text(t.d_begin, t.d_end);
+  }
+  /** Is t the symbol (not |quoted|) with the given name? */
+  bool isSymbol(const Smt2Token& t, std::string_view name) const
+  {
+    return t.d_kind == Smt2TokenKind::SYMBOL && text(t) == name;
+  }
+  /** The value of a numeral token, as used for arities and indices. */
+  uint64_t numeralValue(const Smt2Token& t);
+  /** Discard consumed input and retired sources between commands. */
+  void discardConsumedInput();
+  /** Push the included file with the given name. */
+  void includeFile(const std::string& filename);
+
+  //------------------------------------ parser, the rules of Smt2.g
+  void parseCommandBody(std::string_view name, std::unique_ptr<Command>* cmd);
+  bool parseSmt25Command(std::string_view name, std::unique_ptr<Command>* cmd);
+  bool parseExtendedCommand(std::string_view name,
+                            std::unique_ptr<Command>* cmd);
+  void parsePushPop(bool isPush, std::unique_ptr<Command>* cmd);
+  void parseDatatypesDef(bool isCo,
+                         const std::vector<std::string>& dnames,
+                         const std::vector<int>& arities,
+                         std::unique_ptr<Command>* cmd);
+  void parseConstructorDef(api::DatatypeDecl& type);
+  void parseSetOption(bool isInfo, std::unique_ptr<Command>* cmd);
+  std::string parseSymbol(DeclarationCheck check, SymbolType type);
+  std::string parseKeyword();
+  void parseSymbolList(std::vector<std::string>& names,
+                       DeclarationCheck check,
+                       SymbolType type);
+  std::string parseStr(bool fsmtlib);
+  std::string parseSimpleSymbolicExpr(bool allowKeyword);
+  api::Term parseSymbolicExpr();
+  api::Term parseTerm(api::Term& expr2);
+  api::Term parseTermNonVariable(api::Term& expr2);
+  api::Term parseLetTerm();
+  api::Term parseMatchTerm();
+  api::Term parseAttributedTerm(api::Term& expr2);
+  api::Term parseIndexedConstant();
+  api::Term parseAttribute(api::Term& expr, std::string& attr);
+  void parseTermList(std::vector<api::Term>& terms);
+  void parseQualIdentifier(ParseOp& p);
+  void parseIdentifier(ParseOp& p);
+  void parseIndexedIdentifier(ParseOp& p);
+  void parseNonemptyNumeralList(std::vector<uint64_t>& numerals);
+  api::Sort parseSort(DeclarationCheck check);
+  void parseSortList(std::vector<api::Sort>& sorts);
+  void parseSortedVarList(
+      std::vector<std::pair<std::string, api::Sort>>& sortedVars);
+  api::Term parseBoundVarList();
+
+  /** The parser state. */
+  Smt2* d_state;
+  /** The stack of sources, the input stream and included files. */
+  std::vector<std::unique_ptr<Source>> d_sources;
+  /**
+   * Included files that have ended. They are kept until the next command,
+   * since tokens in the lookahead may refer to them.
+   */
+  std::vector<std::unique_ptr<Source>> d_retired;
+  /** The lookahead. */
+  Smt2Token d_lookahead[2];
+  size_t d_numLookahead;
+  /** The position of the last consumed token, for error messages. */
+  uint32_t d_line;
+  uint32_t d_column;
+}; /* class Smt2NativeInput */
+
+}  // namespace parser
+}  // namespace cvc5
+
+#endif /* CVC4__PARSER__SMT2__SMT2_NATIVE_INPUT_H */
@@ -32,11 +32,8 @@ PreprocessingPassResult ExtRewPre::applyInternal(
     AssertionPipeline* assertionsToPreprocess)
 {
   theory::quantifiers::ExtendedRewriter extr(options::extRewPrepAgg());
-  for (unsigned i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
-  {
-    assertionsToPreprocess->replace(
-        i, extr.extendedRewrite((*assertionsToPreprocess)[i]));
-  }
+  replaceEach(assertionsToPreprocess,
+              [&extr](TNode n) { return extr.extendedRewrite(n); });
   return PreprocessingPassResult::NO_CONFLICT;
 }
 
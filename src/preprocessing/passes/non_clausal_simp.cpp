@@ -66,7 +66,8 @@ NonClausalSimp::NonClausalSimp(PreprocessingPassContext* preprocContext)
                                      preprocContext->getUserContext(),
                                      "NonClausalSimp::llra")
                    : nullptr),
-      d_tsubsList(preprocContext->getUserContext())
+      d_tsubsList(preprocContext->getUserContext()),
+      d_learnedLits(preprocContext->getUserContext())
 {
 }
 
@@ -111,6 +112,23 @@ PreprocessingPassResult NonClausalSimp::applyInternal(
                    << std::endl;
     propagator->assertTrue((*assertionsToPreprocess)[i]);
   }
+  // Assert the literals learned by previous calls, such that the new
+  // assertions are simplified with respect to them
+  if (isIncremental())
+  {
+    SubstitutionMap& tls = d_preprocContext->getTopLevelSubstitutions().get();
+    for (const Node& lit : d_learnedLits)
+    {
+      Node slit = Rewriter::rewrite(tls.apply(lit));
+      if (slit.isConst() && slit.getConst<bool>())
+      {
+        continue;
+      }
+      Trace("non-clausal-simplify")
+          << "asserting previously learned " << slit << std::endl;
+      propagator->assertTrue(slit);
+    }
+  }
 
   Trace("non-clausal-simplify") << "propagating" << std::endl;
   TrustNode conf = propagator->propagate();
@@ -374,7 +392,7 @@ PreprocessingPassResult NonClausalSimp::applyInternal(
     // process learned literal
     learned = processLearnedLit(
         learned, newSubstitutions.get(), constantPropagations.get());
-    if (s.find(learned) != s.end())
+    if (!recordLearnedLit(learned) || s.find(learned) != s.end())
     {
       continue;
     }
@@ -391,7 +409,7 @@ PreprocessingPassResult NonClausalSimp::applyInternal(
     Assert(top_level_substs.apply(cProp) == cProp);
     // process learned literal (substitutions only)
     cProp = processLearnedLit(cProp, newSubstitutions.get(), nullptr);
-    if (s.find(cProp) != s.end())
+    if (!recordLearnedLit(cProp) || s.find(cProp) != s.end())
     {
       continue;
     }
@@ -446,6 +464,17 @@ PreprocessingPassResult NonClausalSimp::applyInternal(
 
 bool NonClausalSimp::isProofEnabled() const { return d_pnm != nullptr; }
 
+bool NonClausalSimp::isIncremental() const
+{
+  return options::incrementalSolving() && options::incrementalSimp()
+         && !isProofEnabled();
+}
+
+bool NonClausalSimp::recordLearnedLit(Node lit)
+{
+  return !isIncremental() || d_learnedLits.insert(lit);
+}
+
 Node NonClausalSimp::processLearnedLit(Node lit,
                                        theory::TrustSubstitutionMap* subs,
                                        theory::TrustSubstitutionMap* cp)
@@ -17,6 +17,7 @@
 #ifndef CVC4__PREPROCESSING__PASSES__NON_CLAUSAL_SIMP_H
 #define CVC4__PREPROCESSING__PASSES__NON_CLAUSAL_SIMP_H
 
+#include "context/cdhashset.h"
 #include "context/cdlist.h"
 #include "expr/node.h"
 #include "preprocessing/preprocessing_pass.h"
@@ -77,8 +78,19 @@ class NonClausalSimp : public PreprocessingPass
    * d_llpg below and returns the rewritten learned literal.
    */
   Node processRewrittenLearnedLit(theory::TrustNode trn);
+  /**
+   * Record that learned literal lit holds in the current user context.
+   * Returns false if it was recorded by a previous call already. Literals are
+   * only recorded if isIncremental() holds.
+   */
+  bool recordLearnedLit(Node lit);
   /** Is proof enabled? */
   bool isProofEnabled() const;
+  /**
+   * Are the literals learned by previous calls reused (--incremental-simp)?
+   * This is not supported with proofs.
+   */
+  bool isIncremental() const;
   /** The proof node manager */
   ProofNodeManager* d_pnm;
   /** the learned literal preprocess proof generator */
@@ -93,6 +105,11 @@ class NonClausalSimp : public PreprocessingPass
    * for storing proofs.
    */
   context::CDList<std::shared_ptr<theory::TrustSubstitutionMap> > d_tsubsList;
+  /**
+   * The (user-context-dependent) learned literals and constant propagations
+   * of previous calls, if isIncremental().
+   */
+  context::CDHashSet<Node, NodeHashFunction> d_learnedLits;
 };
 
 }  // namespace passes
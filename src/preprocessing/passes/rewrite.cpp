@@ -32,9 +32,8 @@ Rewrite::Rewrite(PreprocessingPassContext* preprocContext)
 PreprocessingPassResult Rewrite::applyInternal(
   AssertionPipeline* assertionsToPreprocess)
 {
-  for (unsigned i = 0; i < assertionsToPreprocess->size(); ++i) {
-    assertionsToPreprocess->replace(i, Rewriter::rewrite((*assertionsToPreprocess)[i]));
-  }
+  replaceEach(assertionsToPreprocess,
+              [](TNode n) { return Rewriter::rewrite(n); });
 
   return PreprocessingPassResult::NO_CONFLICT;
 }
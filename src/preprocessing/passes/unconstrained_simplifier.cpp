@@ -19,6 +19,8 @@
 #include "preprocessing/passes/unconstrained_simplifier.h"
 
 #include "expr/dtype.h"
+#include "expr/node_algorithm.h"
+#include "options/smt_options.h"
 #include "preprocessing/assertion_pipeline.h"
 #include "preprocessing/preprocessing_pass_context.h"
 #include "smt/logic_exception.h"
@@ -38,7 +40,9 @@ UnconstrainedSimplifier::UnconstrainedSimplifier(
     : PreprocessingPass(preprocContext, "unconstrained-simplifier"),
       d_numUnconstrainedElim("preprocessor::number of unconstrained elims", 0),
       d_context(preprocContext->getDecisionContext()),
-      d_substitutions(preprocContext->getDecisionContext())
+      d_substitutions(preprocContext->getDecisionContext()),
+      d_eliminated(preprocContext->getUserContext()),
+      d_reasserted(preprocContext->getUserContext())
 {
   smtStatisticsRegistry()->registerStat(&d_numUnconstrainedElim);
 }
@@ -99,8 +103,9 @@ void UnconstrainedSimplifier::visitAll(TNode assertion)
 
     if (current.getNumChildren() == 0)
     {
-      if (current.getKind() == kind::VARIABLE
-          || current.getKind() == kind::SKOLEM)
+      if ((current.getKind() == kind::VARIABLE
+           || current.getKind() == kind::SKOLEM)
+          && !isConstrained(current))
       {
         d_unconstrained.insert(current);
       }
@@ -124,6 +129,53 @@ void UnconstrainedSimplifier::visitAll(TNode assertion)
   }
 }
 
+bool UnconstrainedSimplifier::isConstrained(TNode var)
+{
+  if (!options::incrementalSolving())
+  {
+    return false;
+  }
+  const context::CDHashSet<Node, NodeHashFunction>& syms =
+      d_preprocContext->getSymsInAssertions();
+  return syms.find(var) != syms.end()
+         || d_preprocContext->getTopLevelSubstitutions().get().hasSubstitution(
+             var);
+}
+
+void UnconstrainedSimplifier::reassertEliminated(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  vector<TNode> visit;
+  for (const std::pair<const TNode, unsigned>& v : d_visited)
+  {
+    if (v.first.isVar())
+    {
+      visit.push_back(v.first);
+    }
+  }
+  while (!visit.empty())
+  {
+    TNode var = visit.back();
+    visit.pop_back();
+    context::CDHashMap<Node, Node, NodeHashFunction>::const_iterator it =
+        d_eliminated.find(var);
+    if (it == d_eliminated.end() || d_reasserted.contains((*it).second))
+    {
+      continue;
+    }
+    Node assertion = (*it).second;
+    Trace("unc-simp") << "UnconstrainedSimplifier::reassertEliminated: "
+                      << assertion << " for " << var << std::endl;
+    d_reasserted.insert(assertion);
+    assertionsToPreprocess->push_back(assertion);
+    visitAll(assertion);
+    // the assertion may contain variables that were eliminated elsewhere
+    std::unordered_set<Node, NodeHashFunction> syms;
+    expr::getSymbols(assertion, syms);
+    visit.insert(visit.end(), syms.begin(), syms.end());
+  }
+}
+
 Node UnconstrainedSimplifier::newUnconstrainedVar(TypeNode t, TNode var)
 {
   Node n = NodeManager::currentNM()->mkSkolem(
@@ -853,6 +905,10 @@ PreprocessingPassResult UnconstrainedSimplifier::applyInternal(
   {
     visitAll(assertion);
   }
+  if (options::incrementalSolving())
+  {
+    reassertEliminated(assertionsToPreprocess);
+  }
 
   if (!d_unconstrained.empty())
   {
@@ -862,6 +918,22 @@ PreprocessingPassResult UnconstrainedSimplifier::applyInternal(
     {
       Node a = assertions[i];
       Node as = Rewriter::rewrite(d_substitutions.apply(a));
+      if (options::incrementalSolving() && as != a)
+      {
+        // remember which variables were eliminated from a, such that a is
+        // reasserted if a later call sees one of them
+        std::unordered_set<Node, NodeHashFunction> syms;
+        std::unordered_set<Node, NodeHashFunction> symsSimp;
+        expr::getSymbols(a, syms);
+        expr::getSymbols(as, symsSimp);
+        for (const Node& v : syms)
+        {
+          if (symsSimp.find(v) == symsSimp.end())
+          {
+            d_eliminated.insert(v, a);
+          }
+        }
+      }
       // replace the assertion
       assertionsToPreprocess->replace(i, as);
     }
@@ -24,6 +24,8 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "context/cdhashmap.h"
+#include "context/cdhashset.h"
 #include "expr/node.h"
 #include "preprocessing/preprocessing_pass.h"
 #include "theory/substitutions.h"
@@ -60,12 +62,32 @@ class UnconstrainedSimplifier : public PreprocessingPass
   context::Context* d_context;
   theory::SubstitutionMap d_substitutions;
 
+  /**
+   * In incremental mode, the variables that previous calls eliminated from an
+   * assertion, mapped to the assertion before the simplification. This is
+   * user-context-dependent, like the simplified assertion.
+   */
+  context::CDHashMap<Node, Node, NodeHashFunction> d_eliminated;
+  /** The assertions of d_eliminated reasserted in the current user context */
+  context::CDHashSet<Node, NodeHashFunction> d_reasserted;
+
   /**
    * Visit all subterms in assertion. This method throws a LogicException if
    * there is a subterm that is unhandled by this preprocessing pass (e.g. a
    * quantified formula).
    */
   void visitAll(TNode assertion);
+  /**
+   * Is var constrained by assertions of previous calls? This is the case in
+   * incremental mode if it occurs in them or has a top-level substitution.
+   */
+  bool isConstrained(TNode var);
+  /**
+   * Reassert the assertions that previous calls eliminated a variable of
+   * d_visited from, since the simplification of these assertions is only
+   * sound as long as the variable does not occur elsewhere.
+   */
+  void reassertEliminated(AssertionPipeline* assertionsToPreprocess);
   Node newUnconstrainedVar(TypeNode t, TNode var);
   void processUnconstrained();
 };
@@ -16,8 +16,17 @@
 
 #include "preprocessing/preprocessing_pass.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "options/smt_options.h"
 #include "preprocessing/assertion_pipeline.h"
 #include "preprocessing/preprocessing_pass_context.h"
+#include "preprocessing/preprocessing_pass_profile.h"
 #include "printer/printer.h"
 #include "smt/dump.h"
 #include "smt/output_manager.h"
@@ -29,13 +38,27 @@ namespace preprocessing {
 
 PreprocessingPassResult PreprocessingPass::apply(
     AssertionPipeline* assertionsToPreprocess) {
-  TimerStat::CodeTimer codeTimer(d_timer);
-  Trace("preprocessing") << "PRE " << d_name << std::endl;
-  Chat() << d_name << "..." << std::endl;
-  dumpAssertions(("pre-" + d_name).c_str(), *assertionsToPreprocess);
-  PreprocessingPassResult result = applyInternal(assertionsToPreprocess);
-  dumpAssertions(("post-" + d_name).c_str(), *assertionsToPreprocess);
-  Trace("preprocessing") << "POST " << d_name << std::endl;
+  if (d_profile != nullptr)
+  {
+    d_profile->begin(*assertionsToPreprocess, d_preprocContext);
+  }
+  PreprocessingPassResult result;
+  {
+    TimerStat::CodeTimer codeTimer(d_timer);
+    Trace("preprocessing") << "PRE " << d_name << std::endl;
+    Chat() << d_name << "..." << std::endl;
+    dumpAssertions(("pre-" + d_name).c_str(), *assertionsToPreprocess);
+    result = applyInternal(assertionsToPreprocess);
+    dumpAssertions(("post-" + d_name).c_str(), *assertionsToPreprocess);
+    Trace("preprocessing") << "POST " << d_name << std::endl;
+  }
+  if (d_profile != nullptr)
+  {
+    d_profile->end(*assertionsToPreprocess,
+                   d_preprocContext,
+                   result == PreprocessingPassResult::CONFLICT,
+                   d_preprocContext->getProfileOut());
+  }
   return result;
 }
 
@@ -55,11 +78,85 @@ void PreprocessingPass::dumpAssertions(const char* key,
   }
 }
 
+void PreprocessingPass::replaceEach(AssertionPipeline* assertionsToPreprocess,
+                                    const std::function<Node(TNode)>& fn)
+{
+  // the number of assertions a thread claims at once
+  static const size_t chunkSize = 256;
+  size_t size = assertionsToPreprocess->size();
+  size_t numThreads = std::min<size_t>(options::ppThreads(),
+                                       (size + chunkSize - 1) / chunkSize);
+  if (numThreads <= 1)
+  {
+    for (size_t i = 0; i < size; ++i)
+    {
+      assertionsToPreprocess->replace(i, fn((*assertionsToPreprocess)[i]));
+    }
+    return;
+  }
+
+  Trace("preprocessing") << "process " << size << " assertions on "
+                         << numThreads << " threads" << std::endl;
+  const std::vector<Node>& assertions = assertionsToPreprocess->ref();
+  std::vector<Node> results(size);
+  std::atomic<size_t> next(0);
+  std::mutex errorMutex;
+  std::exception_ptr error;
+  SmtEngine* smt = d_preprocContext->getSmt();
+  auto work = [&]() {
+    smt::SmtScope scope(smt);
+    try
+    {
+      for (size_t begin = next.fetch_add(chunkSize); begin < size;
+           begin = next.fetch_add(chunkSize))
+      {
+        for (size_t i = begin, end = std::min(size, begin + chunkSize); i < end;
+             ++i)
+        {
+          results[i] = fn(assertions[i]);
+        }
+      }
+    }
+    catch (...)
+    {
+      // stop the other threads and rethrow the first exception below
+      next.store(size);
+      std::lock_guard<std::mutex> guard(errorMutex);
+      if (!error)
+      {
+        error = std::current_exception();
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < numThreads; ++i)
+  {
+    threads.emplace_back(work);
+  }
+  work();
+  for (std::thread& t : threads)
+  {
+    t.join();
+  }
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+  for (size_t i = 0; i < size; ++i)
+  {
+    assertionsToPreprocess->replace(i, results[i]);
+  }
+}
+
 PreprocessingPass::PreprocessingPass(PreprocessingPassContext* preprocContext,
                                      const std::string& name)
     : d_name(name), d_timer("preprocessing::" + name) {
   d_preprocContext = preprocContext;
   smtStatisticsRegistry()->registerStat(&d_timer);
+  if (options::ppProfile())
+  {
+    d_profile.reset(new PreprocessingPassProfile(name));
+  }
 }
 
 PreprocessingPass::~PreprocessingPass() {
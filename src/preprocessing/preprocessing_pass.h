@@ -31,8 +31,11 @@
 #ifndef CVC4__PREPROCESSING__PREPROCESSING_PASS_H
 #define CVC4__PREPROCESSING__PREPROCESSING_PASS_H
 
+#include <functional>
+#include <memory>
 #include <string>
 
+#include "expr/node.h"
 #include "util/statistics_registry.h"
 #include "util/stats_timer.h"
 
@@ -41,6 +44,7 @@ namespace preprocessing {
 
 class AssertionPipeline;
 class PreprocessingPassContext;
+class PreprocessingPassProfile;
 
 /**
  * Preprocessing passes return a result which indicates whether a conflict has
@@ -70,6 +74,20 @@ class PreprocessingPass {
   virtual PreprocessingPassResult applyInternal(
       AssertionPipeline* assertionsToPreprocess) = 0;
 
+  /**
+   * Replace each assertion of assertionsToPreprocess by the result of fn on
+   * it, for passes that simplify each assertion independently.
+   *
+   * With --pp-threads=N for N > 1, the assertions are split into chunks that
+   * N threads claim one at a time, and the results are merged into the
+   * pipeline in order once all chunks are done. fn is then called
+   * concurrently and may only construct and rewrite nodes. This excludes the
+   * datatypes rewriter, hence setDefaults() rejects the option in logics
+   * with datatypes.
+   */
+  void replaceEach(AssertionPipeline* assertionsToPreprocess,
+                   const std::function<Node(TNode)>& fn);
+
   /* Context for Preprocessing Passes that initializes necessary variables */
   PreprocessingPassContext* d_preprocContext;
 
@@ -78,6 +96,8 @@ class PreprocessingPass {
   std::string d_name;
   /* Timer for registering the preprocessing time of this pass */
   TimerStat d_timer;
+  /* Profile of the invocations of this pass, if --pp-profile is enabled */
+  std::unique_ptr<PreprocessingPassProfile> d_profile;
 };
 
 }  // namespace preprocessing
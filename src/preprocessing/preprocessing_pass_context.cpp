@@ -16,11 +16,21 @@
 
 #include "preprocessing/preprocessing_pass_context.h"
 
+#include <atomic>
+#include <fstream>
+
+#include "base/output.h"
 #include "expr/node_algorithm.h"
+#include "options/smt_options.h"
 
 namespace cvc5 {
 namespace preprocessing {
 
+namespace {
+/** The number of preprocessing pass contexts created so far */
+std::atomic<uint32_t> s_numContexts(0);
+}  // namespace
+
 PreprocessingPassContext::PreprocessingPassContext(
     SmtEngine* smt,
     theory::booleans::CircuitPropagator* circuitPropagator,
@@ -30,8 +40,21 @@ PreprocessingPassContext::PreprocessingPassContext(
       d_topLevelSubstitutions(smt->getUserContext(), pnm),
       d_circuitPropagator(circuitPropagator),
       d_pnm(pnm),
-      d_symsInAssertions(smt->getUserContext())
+      d_symsInAssertions(smt->getUserContext()),
+      d_profileId(s_numContexts++)
 {
+  if (options::ppProfile() && !options::ppProfileFile().empty())
+  {
+    // append, such that several SmtEngines may write to the same file
+    d_profileOut.reset(
+        new std::ofstream(options::ppProfileFile(), std::ios::app));
+    if (!*d_profileOut)
+    {
+      Warning() << "cannot write preprocessing profile file "
+                << options::ppProfileFile() << std::endl;
+      d_profileOut.reset();
+    }
+  }
 }
 
 theory::TrustSubstitutionMap&
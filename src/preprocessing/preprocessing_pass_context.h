@@ -21,6 +21,9 @@
 #ifndef CVC4__PREPROCESSING__PREPROCESSING_PASS_CONTEXT_H
 #define CVC4__PREPROCESSING__PREPROCESSING_PASS_CONTEXT_H
 
+#include <iosfwd>
+#include <memory>
+
 #include "context/cdhashset.h"
 #include "smt/smt_engine.h"
 #include "theory/trust_substitutions.h"
@@ -72,6 +75,17 @@ class PreprocessingPassContext
   /** Gets a reference to the top-level substitution map */
   theory::TrustSubstitutionMap& getTopLevelSubstitutions();
 
+  /**
+   * The stream that the profiles of pass invocations are written to, null if
+   * no --pp-profile-file is given.
+   */
+  std::ostream* getProfileOut() { return d_profileOut.get(); }
+  /**
+   * The number of this context among those created in this process, which
+   * tells apart the profiles of several SmtEngines in the same file.
+   */
+  uint32_t getProfileId() const { return d_profileId; }
+
   /** Record symbols in assertions
    *
    * This method is called when a set of assertions is finalized. It adds
@@ -103,6 +117,10 @@ class PreprocessingPassContext
    */
   context::CDHashSet<Node, NodeHashFunction> d_symsInAssertions;
 
+  /** The output stream of --pp-profile-file, if any */
+  std::unique_ptr<std::ofstream> d_profileOut;
+  /** The number of this context, see getProfileId() */
+  uint32_t d_profileId;
 };  // class PreprocessingPassContext
 
 }  // namespace preprocessing
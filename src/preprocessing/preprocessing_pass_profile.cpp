@@ -0,0 +1,146 @@
+/*********************                                                        */
+/*! \file preprocessing_pass_profile.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Profile of the invocations of a preprocessing pass.
+ **/
+
+#include "preprocessing/preprocessing_pass_profile.h"
+
+#include <ostream>
+#include <vector>
+
+#include "preprocessing/assertion_pipeline.h"
+#include "preprocessing/preprocessing_pass_context.h"
+#include "smt/smt_statistics_registry.h"
+
+namespace cvc5 {
+namespace preprocessing {
+
+PreprocessingPassProfile::PreprocessingPassProfile(const std::string& name)
+    : d_name(name),
+      d_curAssertions(0),
+      d_curDagSize(0),
+      d_curSubstitutions(0),
+      d_numInvocations("preprocessing::" + name + "::invocations", 0),
+      d_numAssertionsBefore("preprocessing::" + name + "::assertionsBefore",
+                            0),
+      d_numAssertionsAfter("preprocessing::" + name + "::assertionsAfter", 0),
+      d_dagSizeBefore("preprocessing::" + name + "::dagSizeBefore", 0),
+      d_dagSizeAfter("preprocessing::" + name + "::dagSizeAfter", 0),
+      d_numNewSkolems("preprocessing::" + name + "::newSkolems", 0),
+      d_numNewSubstitutions("preprocessing::" + name + "::newSubstitutions", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_numInvocations);
+  smtStatisticsRegistry()->registerStat(&d_numAssertionsBefore);
+  smtStatisticsRegistry()->registerStat(&d_numAssertionsAfter);
+  smtStatisticsRegistry()->registerStat(&d_dagSizeBefore);
+  smtStatisticsRegistry()->registerStat(&d_dagSizeAfter);
+  smtStatisticsRegistry()->registerStat(&d_numNewSkolems);
+  smtStatisticsRegistry()->registerStat(&d_numNewSubstitutions);
+}
+
+PreprocessingPassProfile::~PreprocessingPassProfile()
+{
+  if (smtStatisticsRegistry() != nullptr)
+  {
+    smtStatisticsRegistry()->unregisterStat(&d_numInvocations);
+    smtStatisticsRegistry()->unregisterStat(&d_numAssertionsBefore);
+    smtStatisticsRegistry()->unregisterStat(&d_numAssertionsAfter);
+    smtStatisticsRegistry()->unregisterStat(&d_dagSizeBefore);
+    smtStatisticsRegistry()->unregisterStat(&d_dagSizeAfter);
+    smtStatisticsRegistry()->unregisterStat(&d_numNewSkolems);
+    smtStatisticsRegistry()->unregisterStat(&d_numNewSubstitutions);
+  }
+}
+
+void PreprocessingPassProfile::begin(const AssertionPipeline& assertions,
+                                     PreprocessingPassContext* context)
+{
+  d_curSkolems.clear();
+  d_curAssertions = assertions.size();
+  d_curDagSize = getDagSize(assertions, d_curSkolems);
+  d_curSubstitutions = context->getTopLevelSubstitutions().get().size();
+  // start the clock last, such that the profile itself is not timed
+  d_curStart = std::chrono::steady_clock::now();
+}
+
+void PreprocessingPassProfile::end(const AssertionPipeline& assertions,
+                                   PreprocessingPassContext* context,
+                                   bool conflict,
+                                   std::ostream* out)
+{
+  std::chrono::duration<double> time =
+      std::chrono::steady_clock::now() - d_curStart;
+  std::unordered_set<Node, NodeHashFunction> skolems;
+  size_t dagSize = getDagSize(assertions, skolems);
+  size_t newSkolems = 0;
+  for (const Node& k : skolems)
+  {
+    if (d_curSkolems.find(k) == d_curSkolems.end())
+    {
+      ++newSkolems;
+    }
+  }
+  d_curSkolems.clear();
+  size_t substitutions = context->getTopLevelSubstitutions().get().size();
+  // substitutions are only removed on pop, i.e., not by preprocessing
+  size_t newSubstitutions = substitutions - d_curSubstitutions;
+
+  ++d_numInvocations;
+  d_numAssertionsBefore += d_curAssertions;
+  d_numAssertionsAfter += assertions.size();
+  d_dagSizeBefore += d_curDagSize;
+  d_dagSizeAfter += dagSize;
+  d_numNewSkolems += newSkolems;
+  d_numNewSubstitutions += newSubstitutions;
+
+  if (out != nullptr)
+  {
+    // pass names only consist of letters, digits and dashes, so they do not
+    // need to be escaped
+    (*out) << "{\"engine\": " << context->getProfileId()
+           << ", \"pass\": \"" << d_name << "\""
+           << ", \"invocation\": " << d_numInvocations.get()
+           << ", \"time\": " << time.count()
+           << ", \"assertionsBefore\": " << d_curAssertions
+           << ", \"assertionsAfter\": " << assertions.size()
+           << ", \"dagSizeBefore\": " << d_curDagSize
+           << ", \"dagSizeAfter\": " << dagSize
+           << ", \"newSkolems\": " << newSkolems
+           << ", \"newSubstitutions\": " << newSubstitutions
+           << ", \"conflict\": " << (conflict ? "true" : "false") << "}"
+           << std::endl;
+  }
+}
+
+size_t PreprocessingPassProfile::getDagSize(
+    const AssertionPipeline& assertions,
+    std::unordered_set<Node, NodeHashFunction>& skolems)
+{
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit(assertions.begin(), assertions.end());
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (!visited.insert(cur).second)
+    {
+      continue;
+    }
+    if (cur.getKind() == kind::SKOLEM)
+    {
+      skolems.insert(cur);
+    }
+    visit.insert(visit.end(), cur.begin(), cur.end());
+  }
+  return visited.size();
+}
+
+}  // namespace preprocessing
+}  // namespace cvc5
@@ -0,0 +1,91 @@
+/*********************                                                        */
+/*! \file preprocessing_pass_profile.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Profile of the invocations of a preprocessing pass.
+ **
+ ** Records how each invocation of a preprocessing pass changes the
+ ** assertions, for --pp-profile.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PREPROCESSING_PASS_PROFILE_H
+#define CVC4__PREPROCESSING__PREPROCESSING_PASS_PROFILE_H
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <unordered_set>
+
+#include "expr/node.h"
+#include "util/statistics_registry.h"
+
+namespace cvc5 {
+namespace preprocessing {
+
+class AssertionPipeline;
+class PreprocessingPassContext;
+
+/**
+ * The profile of a preprocessing pass. For each invocation, it records the
+ * wall time, the number of assertions and their DAG size before and after,
+ * the number of skolems that occur in the assertions afterwards but did not
+ * before, and the number of top-level substitutions that were added.
+ *
+ * The sums over all invocations are statistics, and if an output stream is
+ * given each invocation is written to it as a JSON object on its own line.
+ */
+class PreprocessingPassProfile
+{
+ public:
+  PreprocessingPassProfile(const std::string& name);
+  ~PreprocessingPassProfile();
+
+  /** Record the state before an invocation of the pass. */
+  void begin(const AssertionPipeline& assertions,
+             PreprocessingPassContext* context);
+  /**
+   * Record the state after the invocation, and write the invocation to out
+   * if it is not null.
+   */
+  void end(const AssertionPipeline& assertions,
+           PreprocessingPassContext* context,
+           bool conflict,
+           std::ostream* out);
+
+ private:
+  /**
+   * Get the number of nodes of the DAG of assertions, and add the skolems
+   * that occur in it to skolems.
+   */
+  static size_t getDagSize(const AssertionPipeline& assertions,
+                           std::unordered_set<Node, NodeHashFunction>& skolems);
+
+  /** The name of the pass. */
+  std::string d_name;
+  /** The state before the current invocation. */
+  size_t d_curAssertions;
+  size_t d_curDagSize;
+  size_t d_curSubstitutions;
+  std::unordered_set<Node, NodeHashFunction> d_curSkolems;
+  std::chrono::steady_clock::time_point d_curStart;
+
+  IntStat d_numInvocations;
+  IntStat d_numAssertionsBefore;
+  IntStat d_numAssertionsAfter;
+  IntStat d_dagSizeBefore;
+  IntStat d_dagSizeAfter;
+  IntStat d_numNewSkolems;
+  IntStat d_numNewSubstitutions;
+};
+
+}  // namespace preprocessing
+}  // namespace cvc5
+
+#endif /* CVC4__PREPROCESSING__PREPROCESSING_PASS_PROFILE_H */
@@ -11,14 +11,21 @@
  **
  ** \brief Wrapper for CaDiCaL SAT Solver.
  **
- ** Implementation of the CaDiCaL SAT solver for CVC4 (bitvectors).
+ ** Implementation of the CaDiCaL SAT solver for CVC4 (bitvectors). CaDiCaL
+ ** can also be used as SAT solver of the main CDCL(T) engine, in which case
+ ** it is connected to the theory proxy through CaDiCaL's external propagator
+ ** interface (IPASIR-UP).
  **/
 
 #include "prop/cadical.h"
 
 #ifdef CVC4_USE_CADICAL
 
+#include <deque>
+
 #include "base/check.h"
+#include "context/context.h"
+#include "prop/theory_proxy.h"
 
 namespace cvc5 {
 namespace prop {
@@ -53,16 +60,555 @@ CadicalLit toCadicalLit(const SatLiteral lit)
 
 CadicalVar toCadicalVar(SatVariable var) { return var; }
 
+SatLiteral toSatLiteral(CadicalLit lit)
+{
+  return lit < 0 ? SatLiteral(-lit, true) : SatLiteral(lit, false);
+}
+
 }  // namespace helper functions
 
+/**
+ * Connects CaDiCaL to the theory proxy, this plays the role of the
+ * CVC4-specific parts of the bundled Minisat (see prop/minisat/core/Solver.cc).
+ *
+ * All variables created through CadicalSolver::newVar() are observed, i.e.,
+ * CaDiCaL notifies this propagator about their assignments. The propagator
+ * maintains a copy of the trail of these assignments, which is used to answer
+ * value queries during search, and mirrors decision levels and user levels
+ * with pushes and pops of the SAT context. Assignments to theory atoms are
+ * enqueued in the theory proxy, the theories are checked lazily when CaDiCaL
+ * asks for external propagations, and theory lemmas are handed to CaDiCaL as
+ * external clauses.
+ */
+class CadicalPropagator : public CaDiCaL::ExternalPropagator
+{
+ public:
+  CadicalPropagator(TheoryProxy* proxy,
+                    context::Context* context,
+                    CaDiCaL::Solver& solver,
+                    CadicalSolver::Statistics& stats)
+      : d_proxy(proxy),
+        d_context(context),
+        d_solver(solver),
+        d_stats(stats),
+        d_decisionLevel(0),
+        d_inSearch(false),
+        d_checkPending(false),
+        d_searchStopped(false),
+        d_stopLevel(0),
+        d_reasonIndex(0),
+        d_clauseIndex(0)
+  {
+    d_userLevelVars.emplace_back();
+  }
+
+  /* ExternalPropagator callbacks ------------------------------------------- */
+
+  void notify_assignment(const std::vector<int>& lits) override
+  {
+    for (int lit : lits)
+    {
+      SatLiteral slit = toSatLiteral(lit);
+      VarInfo& info = d_varInfo[slit.getSatVariable()];
+      if (!info.d_active)
+      {
+        continue;
+      }
+      if (d_solver.fixed(lit) != 0)
+      {
+        // fixed literals are kept on the trail when backtracking, see pop()
+        info.d_fixed = true;
+      }
+      if (info.d_value != SAT_VALUE_UNKNOWN)
+      {
+        Assert((info.d_value == SAT_VALUE_TRUE) != slit.isNegated());
+        continue;
+      }
+      assign(slit);
+    }
+  }
+
+  void notify_new_decision_level() override
+  {
+    push();
+    ++d_decisionLevel;
+  }
+
+  void notify_backtrack(size_t level) override
+  {
+    backtrack(level);
+    // CaDiCaL does not notify restarts, backtracking over all decisions is
+    // the closest approximation
+    if (level <= d_activationLits.size())
+    {
+      d_proxy->notifyRestart();
+    }
+    d_proxy->spendResource(ResourceManager::Resource::SatConflictStep);
+  }
+
+  bool cb_check_found_model(const std::vector<int>& model) override
+  {
+    Trace("cadical::propagator") << "cb_check_found_model" << std::endl;
+    if (d_searchStopped)
+    {
+      // the theories were checked when the search was stopped
+      return true;
+    }
+    return fullCheck();
+  }
+
+  int cb_decide() override
+  {
+    SatLiteral lit = d_proxy->getNextTheoryDecisionRequest();
+    if (lit.isNull() && !d_searchStopped)
+    {
+      bool stopSearch = false;
+      lit = d_proxy->getNextDecisionEngineRequest(stopSearch);
+      if (stopSearch)
+      {
+        stopSearchAt(d_decisionLevel);
+        return 0;
+      }
+    }
+    if (!lit.isNull() && value(lit) == SAT_VALUE_UNKNOWN)
+    {
+      return toCadicalLit(lit);
+    }
+    return 0;
+  }
+
+  int cb_propagate() override
+  {
+    if (d_propagations.empty() && d_checkPending)
+    {
+      d_checkPending = false;
+      d_proxy->theoryCheck(theory::Theory::EFFORT_STANDARD);
+      theoryPropagate();
+    }
+    while (!d_propagations.empty())
+    {
+      SatLiteral lit = d_propagations.front();
+      d_propagations.pop_front();
+      if (value(lit) == SAT_VALUE_UNKNOWN)
+      {
+        ++d_stats.d_numTheoryPropagations;
+        return toCadicalLit(lit);
+      }
+      if (value(lit) == SAT_VALUE_FALSE)
+      {
+        addConflict(lit);
+      }
+    }
+    return 0;
+  }
+
+  int cb_add_reason_clause_lit(int propagated_lit) override
+  {
+    if (d_reasonIndex == 0)
+    {
+      d_reason.clear();
+      d_proxy->explainPropagation(toSatLiteral(propagated_lit), d_reason);
+      Assert(!d_reason.empty() && d_reason[0] == toSatLiteral(propagated_lit));
+    }
+    if (d_reasonIndex < d_reason.size())
+    {
+      return toCadicalLit(d_reason[d_reasonIndex++]);
+    }
+    d_reasonIndex = 0;
+    return 0;
+  }
+
+  bool cb_has_external_clause() override { return !d_newClauses.empty(); }
+
+  int cb_add_external_clause_lit() override
+  {
+    Assert(!d_newClauses.empty());
+    const std::vector<CadicalLit>& clause = d_newClauses.front();
+    if (d_clauseIndex < clause.size())
+    {
+      return clause[d_clauseIndex++];
+    }
+    d_newClauses.pop_front();
+    d_clauseIndex = 0;
+    return 0;
+  }
+
+  /* Interface for CadicalSolver -------------------------------------------- */
+
+  /**
+   * Observe the given new variable. If preRegister is true, the variable is
+   * notified to the theory proxy again when backtracking below the current
+   * decision level, as the theories unregister it on backtracking.
+   */
+  void addVar(SatVariable var, bool isTheoryAtom, bool preRegister)
+  {
+    if (var >= d_varInfo.size())
+    {
+      d_varInfo.resize(var + 1);
+    }
+    VarInfo& info = d_varInfo[var];
+    info.d_active = true;
+    info.d_theoryAtom = isTheoryAtom;
+    d_userLevelVars.back().push_back(var);
+    d_solver.add_observed_var(toCadicalVar(var));
+    if (preRegister && d_decisionLevel > 0)
+    {
+      d_varsToRegister.emplace_back(var, d_decisionLevel);
+    }
+  }
+
+  /**
+   * Add a clause. During search, the clause is handed to CaDiCaL as external
+   * clause, otherwise it is added directly.
+   */
+  void addClause(const std::vector<CadicalLit>& clause)
+  {
+    if (d_inSearch)
+    {
+      ++d_stats.d_numLemmas;
+      d_newClauses.push_back(clause);
+      return;
+    }
+    for (CadicalLit lit : clause)
+    {
+      d_solver.add(lit);
+    }
+    d_solver.add(0);
+  }
+
+  /** The activation literal of the current user level, 0 at user level 0. */
+  CadicalLit getActivationLit() const
+  {
+    return d_activationLits.empty() ? 0 : d_activationLits.back();
+  }
+
+  /** The number of user levels. */
+  size_t getUserLevel() const { return d_activationLits.size(); }
+
+  /** Assume the activation literals of all user levels. */
+  void assumeActivationLits()
+  {
+    for (CadicalLit lit : d_activationLits)
+    {
+      d_solver.assume(lit);
+    }
+  }
+
+  void setInSearch(bool inSearch)
+  {
+    d_inSearch = inSearch;
+    if (!inSearch)
+    {
+      // the literals that were not asserted are irrelevant for the model
+      d_searchStopped = false;
+      d_unassertedLits.clear();
+      // add the clauses that were not picked up by CaDiCaL anymore, e.g.,
+      // since the search was terminated
+      std::deque<std::vector<CadicalLit>> clauses;
+      clauses.swap(d_newClauses);
+      d_clauseIndex = 0;
+      for (const std::vector<CadicalLit>& clause : clauses)
+      {
+        addClause(clause);
+      }
+    }
+  }
+
+  /**
+   * Push a user level with the given (fresh) activation variable, which
+   * belongs to the new user level.
+   */
+  void userPush(SatVariable activation)
+  {
+    Assert(d_decisionLevel == 0);
+    push();
+    d_userLevelVars.emplace_back();
+    addVar(activation, false, false);
+    d_activationLits.push_back(toCadicalVar(activation));
+  }
+
+  void userPop()
+  {
+    Assert(d_decisionLevel == 0);
+    Assert(!d_activationLits.empty());
+    CadicalLit activation = d_activationLits.back();
+    d_activationLits.pop_back();
+    // deactivate the variables of the popped level, the CNF stream creates
+    // new variables for their atoms if they are used again
+    for (SatVariable var : d_userLevelVars.back())
+    {
+      d_varInfo[var].d_active = false;
+      d_solver.remove_observed_var(toCadicalVar(var));
+    }
+    d_userLevelVars.pop_back();
+    pop();
+    // disable the clauses of the popped level for good
+    d_solver.add(-activation);
+    d_solver.add(0);
+  }
+
+  /** Backtrack to the given decision level. */
+  void backtrack(size_t level)
+  {
+    if (level >= d_decisionLevel)
+    {
+      return;
+    }
+    while (d_decisionLevel > level)
+    {
+      pop();
+      --d_decisionLevel;
+    }
+    d_propagations.clear();
+    if (d_searchStopped && level < d_stopLevel)
+    {
+      resumeSearch();
+    }
+    // variables introduced at higher decision levels must be registered
+    // with the theories again
+    for (size_t i = d_varsToRegister.size();
+         i > 0 && d_varsToRegister[i - 1].second > d_decisionLevel;
+         --i)
+    {
+      std::pair<SatVariable, size_t>& v = d_varsToRegister[i - 1];
+      v.second = d_decisionLevel;
+      if (d_varInfo[v.first].d_active)
+      {
+        d_proxy->variableNotify(v.first);
+      }
+    }
+    while (!d_varsToRegister.empty() && d_varsToRegister.back().second == 0)
+    {
+      d_varsToRegister.pop_back();
+    }
+  }
+
+  SatValue value(SatLiteral lit) const
+  {
+    SatVariable var = lit.getSatVariable();
+    if (var >= d_varInfo.size() || d_varInfo[var].d_value == SAT_VALUE_UNKNOWN)
+    {
+      return SAT_VALUE_UNKNOWN;
+    }
+    bool isTrue = (d_varInfo[var].d_value == SAT_VALUE_TRUE);
+    return isTrue != lit.isNegated() ? SAT_VALUE_TRUE : SAT_VALUE_FALSE;
+  }
+
+ private:
+  /** Information about a variable of the SAT solver. */
+  struct VarInfo
+  {
+    /** Whether the variable is observed, i.e., belongs to an active level */
+    bool d_active = false;
+    /** Whether the variable is a theory atom */
+    bool d_theoryAtom = false;
+    /** Whether the variable is assigned at the root level of CaDiCaL */
+    bool d_fixed = false;
+    /** The value of the (positive literal of the) variable */
+    SatValue d_value = SAT_VALUE_UNKNOWN;
+  };
+
+  /**
+   * Add the given literal to the trail and enqueue it in the theories, unless
+   * the search was stopped.
+   */
+  void assign(SatLiteral lit)
+  {
+    VarInfo& info = d_varInfo[lit.getSatVariable()];
+    info.d_value = lit.isNegated() ? SAT_VALUE_FALSE : SAT_VALUE_TRUE;
+    d_trail.push_back(lit);
+    if (info.d_theoryAtom)
+    {
+      if (d_searchStopped)
+      {
+        d_unassertedLits.push_back(lit);
+        return;
+      }
+      d_proxy->enqueueTheoryLiteral(lit);
+      d_checkPending = true;
+    }
+  }
+
+  /**
+   * Check the theories at full effort until they are done. Returns false if
+   * they added clauses.
+   */
+  bool fullCheck()
+  {
+    do
+    {
+      d_proxy->theoryCheck(theory::Theory::EFFORT_FULL);
+      theoryPropagate();
+      if (!d_newClauses.empty())
+      {
+        return false;
+      }
+    } while (d_proxy->theoryNeedCheck());
+    return true;
+  }
+
+  /**
+   * Called when the decision engine requests to stop the search at the given
+   * decision level, since the current assignment satisfies the input. As in
+   * Minisat, where the search then ends with the current partial assignment,
+   * the theories are checked at full effort. If they are done, the literals
+   * CaDiCaL assigns from now on complete the model without being asserted to
+   * the theories, until it backtracks below the given level.
+   */
+  void stopSearchAt(size_t level)
+  {
+    Trace("cadical::propagator") << "stop search at " << level << std::endl;
+    d_checkPending = false;
+    if (fullCheck() && d_propagations.empty())
+    {
+      d_searchStopped = true;
+      d_stopLevel = level;
+    }
+  }
+
+  /** Assert the literals that were assigned since the search was stopped */
+  void resumeSearch()
+  {
+    d_searchStopped = false;
+    std::vector<SatLiteral> lits;
+    lits.swap(d_unassertedLits);
+    // a literal may occur several times if it was assigned again
+    std::vector<bool> asserted(d_varInfo.size(), false);
+    for (const SatLiteral& lit : lits)
+    {
+      SatVariable var = lit.getSatVariable();
+      if (value(lit) == SAT_VALUE_TRUE && !asserted[var])
+      {
+        asserted[var] = true;
+        d_proxy->enqueueTheoryLiteral(lit);
+        d_checkPending = true;
+      }
+    }
+  }
+
+  /** Push a level of the SAT context (a decision or user level). */
+  void push()
+  {
+    d_trailLimits.push_back(d_trail.size());
+    d_context->push();
+  }
+
+  /**
+   * Pop a level of the SAT context. Fixed literals assigned at the popped
+   * level are asserted again at the current level, since CaDiCaL does not
+   * notify them again.
+   */
+  void pop()
+  {
+    Assert(!d_trailLimits.empty());
+    size_t limit = d_trailLimits.back();
+    d_trailLimits.pop_back();
+    d_context->pop();
+    std::vector<SatLiteral> fixed;
+    for (size_t i = limit, size = d_trail.size(); i < size; ++i)
+    {
+      VarInfo& info = d_varInfo[d_trail[i].getSatVariable()];
+      if (info.d_fixed && info.d_active)
+      {
+        fixed.push_back(d_trail[i]);
+      }
+      info.d_value = SAT_VALUE_UNKNOWN;
+    }
+    d_trail.resize(limit);
+    for (const SatLiteral& lit : fixed)
+    {
+      assign(lit);
+    }
+  }
+
+  /** Fetch the theory propagations from the theory proxy. */
+  void theoryPropagate()
+  {
+    SatClause propagated;
+    d_proxy->theoryPropagate(propagated);
+    for (const SatLiteral& lit : propagated)
+    {
+      SatValue val = value(lit);
+      if (val == SAT_VALUE_UNKNOWN)
+      {
+        d_propagations.push_back(lit);
+      }
+      else if (val == SAT_VALUE_FALSE)
+      {
+        addConflict(lit);
+      }
+    }
+  }
+
+  /** Add the explanation of the false propagated literal lit as clause. */
+  void addConflict(SatLiteral lit)
+  {
+    Trace("cadical::propagator")
+        << "conflict in theory propagation of " << lit << std::endl;
+    SatClause explanation;
+    d_proxy->explainPropagation(lit, explanation);
+    std::vector<CadicalLit> clause;
+    for (const SatLiteral& l : explanation)
+    {
+      clause.push_back(toCadicalLit(l));
+    }
+    addClause(clause);
+  }
+
+  /** The theory proxy */
+  TheoryProxy* d_proxy;
+  /** The SAT context */
+  context::Context* d_context;
+  /** The connected CaDiCaL instance */
+  CaDiCaL::Solver& d_solver;
+  /** The statistics of the solver */
+  CadicalSolver::Statistics& d_stats;
+
+  /** Information about the variables, indexed by variable */
+  std::vector<VarInfo> d_varInfo;
+  /** The assigned literals of observed variables */
+  std::vector<SatLiteral> d_trail;
+  /** The size of the trail when the SAT context was pushed */
+  std::vector<size_t> d_trailLimits;
+  /** The current decision level of CaDiCaL */
+  size_t d_decisionLevel;
+  /** The activation literals of the user levels */
+  std::vector<CadicalLit> d_activationLits;
+  /** The variables introduced at each user level */
+  std::vector<std::vector<SatVariable>> d_userLevelVars;
+  /** Variables to register again on backtracking, with their levels */
+  std::vector<std::pair<SatVariable, size_t>> d_varsToRegister;
+
+  /** Whether we are in a call to solve() */
+  bool d_inSearch;
+  /** Whether there are assignments the theories did not check yet */
+  bool d_checkPending;
+  /** Whether the search was stopped, see stopSearchAt() */
+  bool d_searchStopped;
+  /** The decision level at which the search was stopped */
+  size_t d_stopLevel;
+  /** The theory literals assigned since the search was stopped */
+  std::vector<SatLiteral> d_unassertedLits;
+  /** Theory propagations that were not handed to CaDiCaL yet */
+  std::deque<SatLiteral> d_propagations;
+  /** The reason clause that is currently handed to CaDiCaL */
+  SatClause d_reason;
+  /** The index of the next literal of d_reason */
+  size_t d_reasonIndex;
+  /** Clauses that were not handed to CaDiCaL yet */
+  std::deque<std::vector<CadicalLit>> d_newClauses;
+  /** The index of the next literal of the first clause in d_newClauses */
+  size_t d_clauseIndex;
+};
+
 CadicalSolver::CadicalSolver(StatisticsRegistry* registry,
-                             const std::string& name)
+                             const std::string& prefix)
     : d_solver(new CaDiCaL::Solver()),
       // Note: CaDiCaL variables start with index 1 rather than 0 since negated
       //       literals are represented as the negation of the index.
       d_nextVarIdx(1),
       d_inSatMode(false),
-      d_statistics(registry, name)
+      d_statistics(registry, prefix)
 {
 }
 
@@ -82,12 +628,27 @@ CadicalSolver::~CadicalSolver() {}
 
 ClauseId CadicalSolver::addClause(SatClause& clause, bool removable)
 {
+  ++d_statistics.d_numClauses;
+  if (d_propagator)
+  {
+    std::vector<CadicalLit> lits;
+    for (const SatLiteral& lit : clause)
+    {
+      lits.push_back(toCadicalLit(lit));
+    }
+    // guard the clause by the activation literal of the current user level
+    if (d_propagator->getActivationLit() != 0)
+    {
+      lits.push_back(-d_propagator->getActivationLit());
+    }
+    d_propagator->addClause(lits);
+    return ClauseIdError;
+  }
   for (const SatLiteral& lit : clause)
   {
     d_solver->add(toCadicalLit(lit));
   }
   d_solver->add(0);
-  ++d_statistics.d_numClauses;
   return ClauseIdError;
 }
 
@@ -103,7 +664,12 @@ SatVariable CadicalSolver::newVar(bool isTheoryAtom,
                                   bool canErase)
 {
   ++d_statistics.d_numVariables;
-  return d_nextVarIdx++;
+  SatVariable var = d_nextVarIdx++;
+  if (d_propagator)
+  {
+    d_propagator->addVar(var, isTheoryAtom, preRegister);
+  }
+  return var;
 }
 
 SatVariable CadicalSolver::trueVar() { return d_true; }
@@ -114,7 +680,17 @@ SatValue CadicalSolver::solve()
 {
   TimerStat::CodeTimer codeTimer(d_statistics.d_solveTime);
   d_assumptions.clear();
+  if (d_propagator)
+  {
+    resetTrail();
+    d_propagator->assumeActivationLits();
+    d_propagator->setInSearch(true);
+  }
   SatValue res = toSatValue(d_solver->solve());
+  if (d_propagator)
+  {
+    d_propagator->setInSearch(false);
+  }
   d_inSatMode = (res == SAT_VALUE_TRUE);
   ++d_statistics.d_numSatCalls;
   return res;
@@ -161,6 +737,10 @@ void CadicalSolver::interrupt() { d_solver->terminate(); }
 
 SatValue CadicalSolver::value(SatLiteral l)
 {
+  if (d_propagator)
+  {
+    return d_propagator->value(l);
+  }
   Assert(d_inSatMode);
   return toSatValueLit(d_solver->val(toCadicalLit(l)));
 }
@@ -168,27 +748,101 @@ SatValue CadicalSolver::value(SatLiteral l)
 SatValue CadicalSolver::modelValue(SatLiteral l)
 {
   Assert(d_inSatMode);
-  return value(l);
+  return toSatValueLit(d_solver->val(toCadicalLit(l)));
 }
 
 unsigned CadicalSolver::getAssertionLevel() const
 {
+  if (d_propagator)
+  {
+    return d_propagator->getUserLevel();
+  }
   Unreachable() << "CaDiCaL does not support assertion levels.";
 }
 
 bool CadicalSolver::ok() const { return d_inSatMode; }
 
+void CadicalSolver::initialize(context::Context* context,
+                               prop::TheoryProxy* theoryProxy,
+                               cvc5::context::UserContext* userContext,
+                               ProofNodeManager* pnm)
+{
+  Assert(pnm == nullptr) << "CaDiCaL does not support proofs.";
+  d_propagator.reset(
+      new CadicalPropagator(theoryProxy, context, *d_solver, d_statistics));
+  d_solver->connect_external_propagator(d_propagator.get());
+  // observe the variables created by init()
+  for (SatVariable var = 1; var < d_nextVarIdx; ++var)
+  {
+    d_propagator->addVar(var, false, false);
+  }
+}
+
+void CadicalSolver::push()
+{
+  resetTrail();
+  d_propagator->userPush(d_nextVarIdx++);
+}
+
+void CadicalSolver::pop()
+{
+  resetTrail();
+  d_propagator->userPop();
+  d_inSatMode = false;
+}
+
+void CadicalSolver::resetTrail()
+{
+  if (d_propagator)
+  {
+    d_propagator->backtrack(0);
+  }
+}
+
+bool CadicalSolver::properExplanation(SatLiteral lit, SatLiteral expl) const
+{
+  return true;
+}
+
+void CadicalSolver::requirePhase(SatLiteral lit)
+{
+  d_solver->phase(toCadicalLit(lit));
+}
+
+bool CadicalSolver::isDecision(SatVariable decn) const
+{
+  return d_solver->is_decision(toCadicalVar(decn));
+}
+
+std::shared_ptr<ProofNode> CadicalSolver::getProof()
+{
+  // proofs are rejected with --sat-solver=cadical in setDefaults()
+  Unreachable() << "CaDiCaL does not support proofs.";
+  return nullptr;
+}
+
+void CadicalSolver::getLearnedClauses(std::vector<SatClause>& clauses) const
+{
+  // saving learned clauses is rejected with --sat-solver=cadical in
+  // SmtEngine::saveCheckpoint()
+  Unreachable() << "CaDiCaL does not give access to its learned clauses.";
+}
+
 CadicalSolver::Statistics::Statistics(StatisticsRegistry* registry,
                                       const std::string& prefix)
     : d_registry(registry),
-      d_numSatCalls("theory::bv::" + prefix + "::cadical::calls_to_solve", 0),
-      d_numVariables("theory::bv::" + prefix + "::cadical::variables", 0),
-      d_numClauses("theory::bv::" + prefix + "::cadical::clauses", 0),
-      d_solveTime("theory::bv::" + prefix + "::cadical::solve_time")
+      d_numSatCalls(prefix + "cadical::calls_to_solve", 0),
+      d_numVariables(prefix + "cadical::variables", 0),
+      d_numClauses(prefix + "cadical::clauses", 0),
+      d_numTheoryPropagations(prefix + "cadical::theory_propagations", 0),
+      d_numLemmas(prefix + "cadical::lemmas", 0),
+      d_solveTime(prefix + "cadical::solve_time")
 {
   d_registry->registerStat(&d_numSatCalls);
   d_registry->registerStat(&d_numVariables);
   d_registry->registerStat(&d_numClauses);
+  d_registry->registerStat(&d_numTheoryPropagations);
+  d_registry->registerStat(&d_numLemmas);
   d_registry->registerStat(&d_solveTime);
 }
 
@@ -196,6 +850,8 @@ CadicalSolver::Statistics::~Statistics() {
   d_registry->unregisterStat(&d_numSatCalls);
   d_registry->unregisterStat(&d_numVariables);
   d_registry->unregisterStat(&d_numClauses);
+  d_registry->unregisterStat(&d_numTheoryPropagations);
+  d_registry->unregisterStat(&d_numLemmas);
   d_registry->unregisterStat(&d_solveTime);
 }
 
@@ -11,7 +11,10 @@
  **
  ** \brief Wrapper for CaDiCaL SAT Solver.
  **
- ** Implementation of the CaDiCaL SAT solver for CVC4 (bitvectors).
+ ** Implementation of the CaDiCaL SAT solver for CVC4 (bitvectors). CaDiCaL
+ ** can also be used as SAT solver of the main CDCL(T) engine, in which case
+ ** it is connected to the theory proxy through CaDiCaL's external propagator
+ ** interface (IPASIR-UP).
  **/
 
 #include "cvc4_private.h"
@@ -29,9 +32,12 @@
 namespace cvc5 {
 namespace prop {
 
-class CadicalSolver : public SatSolver
+class CadicalPropagator;
+
+class CadicalSolver : public CDCLTSatSolverInterface
 {
   friend class SatSolverFactory;
+  friend class CadicalPropagator;
 
  public:
   ~CadicalSolver() override;
@@ -64,12 +70,44 @@ class CadicalSolver : public SatSolver
 
   bool ok() const override;
 
+  /* CDCLTSatSolverInterface ------------------------------------------------ */
+
+  void initialize(context::Context* context,
+                  prop::TheoryProxy* theoryProxy,
+                  cvc5::context::UserContext* userContext,
+                  ProofNodeManager* pnm) override;
+
+  /**
+   * Push a user level. Clauses added at user level k > 0 are guarded by the
+   * activation literal of level k, which is assumed in every call to solve().
+   */
+  void push() override;
+
+  /**
+   * Pop a user level. Disables the clauses of the popped level by asserting
+   * the negation of its activation literal, and deactivates the variables
+   * that were introduced at the popped level.
+   */
+  void pop() override;
+
+  void resetTrail() override;
+
+  bool properExplanation(SatLiteral lit, SatLiteral expl) const override;
+
+  void requirePhase(SatLiteral lit) override;
+
+  bool isDecision(SatVariable decn) const override;
+
+  std::shared_ptr<ProofNode> getProof() override;
+
+  void getLearnedClauses(std::vector<SatClause>& clauses) const override;
+
  private:
   /**
    * Private to disallow creation outside of SatSolverFactory.
    * Function init() must be called after creation.
    */
-  CadicalSolver(StatisticsRegistry* registry, const std::string& name = "");
+  CadicalSolver(StatisticsRegistry* registry, const std::string& prefix);
   /**
    * Initialize SAT solver instance.
    * Note: Split out to not call virtual functions in constructor.
@@ -77,6 +115,11 @@ class CadicalSolver : public SatSolver
   void init();
 
   std::unique_ptr<CaDiCaL::Solver> d_solver;
+  /**
+   * The connection to the theory proxy, only set if this is the SAT solver of
+   * the main CDCL(T) engine (see initialize()).
+   */
+  std::unique_ptr<CadicalPropagator> d_propagator;
   /**
    * Stores the current set of assumptions provided via solve() and is used to
    * query the solver if a given assumption is false.
@@ -94,6 +137,8 @@ class CadicalSolver : public SatSolver
     IntStat d_numSatCalls;
     IntStat d_numVariables;
     IntStat d_numClauses;
+    IntStat d_numTheoryPropagations;
+    IntStat d_numLemmas;
     TimerStat d_solveTime;
     Statistics(StatisticsRegistry* registry, const std::string& prefix);
     ~Statistics();
@@ -186,7 +186,14 @@ Solver::Solver(cvc5::prop::TheoryProxy* proxy,
       //
       ,
       learntsize_adjust_start_confl(100),
-      learntsize_adjust_inc(1.5)
+      learntsize_adjust_inc(1.5),
+      glucose_restart(false),
+      restart_lbd_factor(0.8),
+      restart_block_factor(1.4),
+      restart_block_start(10000),
+      lbd_reduce(false),
+      lbd_core(2),
+      lbd_tier2(6)
 
       // Statistics: (formerly in 'SolverStats')
       //
@@ -202,7 +209,8 @@ Solver::Solver(cvc5::prop::TheoryProxy* proxy,
       clauses_literals(0),
       learnts_literals(0),
       max_literals(0),
-      tot_literals(0)
+      tot_literals(0),
+      blocked_restarts(0)
 
       ,
       ok(true),
@@ -214,7 +222,12 @@ Solver::Solver(cvc5::prop::TheoryProxy* proxy,
       simpDB_props(0),
       order_heap(VarOrderLt(activity)),
       progress_estimate(0),
-      remove_satisfied(!enableIncremental)
+      remove_satisfied(!enableIncremental),
+      lbd_stamp(0),
+      lbd_queue(50),
+      trail_queue(5000),
+      lbd_sum(0),
+      lbd_count(0)
 
       // Resource constraints:
       //
@@ -1017,7 +1030,19 @@ int Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
         Clause& c = ca[confl];
         max_resolution_level = std::max(max_resolution_level, c.level());
 
-        if (c.removable()) claBumpActivity(c);
+        if (c.removable())
+        {
+          claBumpActivity(c);
+          if (lbd_reduce)
+          {
+            c.setUsed(true);
+            if (c.lbd() > lbd_core)
+            {
+              unsigned lbd = computeLbd(c);
+              if (lbd < c.lbd()) c.setLbd(lbd);
+            }
+          }
+        }
       }
 
         if (Trace.isOn("pf::sat"))
@@ -1540,6 +1565,11 @@ struct reduceDB_lt {
 };
 void Solver::reduceDB()
 {
+    if (lbd_reduce)
+    {
+      reduceDBByLbd();
+      return;
+    }
     int     i, j;
     double  extra_lim = cla_inc / clauses_removable.size();    // Remove any clause below this activity
 
@@ -1557,6 +1587,51 @@ void Solver::reduceDB()
     checkGarbage();
 }
 
+/*_________________________________________________________________________________________________
+|
+|  reduceDBByLbd : ()  ->  [void]
+|
+|  Description:
+|    Remove half of the learnt clauses that are not protected by their LBD, preferring clauses
+|    with a high LBD and a low activity. Clauses with an LBD of at most 'lbd_core' are kept
+|    forever, clauses with an LBD of at most 'lbd_tier2' are kept as long as they took part in a
+|    conflict since the last reduction. Binary and locked clauses are never removed.
+|________________________________________________________________________________________________@*/
+struct reduceDBByLbd_lt {
+    ClauseAllocator& ca;
+    reduceDBByLbd_lt(ClauseAllocator& ca_) : ca(ca_) {}
+    bool operator () (CRef x, CRef y) {
+        if (ca[x].lbd() != ca[y].lbd()) return ca[x].lbd() > ca[y].lbd();
+        return ca[x].activity() < ca[y].activity(); }
+};
+void Solver::reduceDBByLbd()
+{
+    int i, j;
+    int candidates = 0;
+    for (i = 0; i < clauses_removable.size(); i++){
+        const Clause& c = ca[clauses_removable[i]];
+        if (c.size() > 2 && c.lbd() > lbd_core && !(c.lbd() <= lbd_tier2 && c.used()))
+            candidates++;
+    }
+
+    sort(clauses_removable, reduceDBByLbd_lt(ca));
+    // The clauses are sorted from worst to best, delete the first half of the candidates:
+    int limit = candidates / 2;
+    for (i = j = 0; i < clauses_removable.size(); i++){
+        Clause& c = ca[clauses_removable[i]];
+        bool protect = c.size() <= 2 || c.lbd() <= lbd_core || (c.lbd() <= lbd_tier2 && c.used());
+        if (!protect && limit > 0 && !locked(c)){
+            removeClause(clauses_removable[i]);
+            limit--;
+        }else{
+            c.setUsed(false);
+            clauses_removable[j++] = clauses_removable[i];
+        }
+    }
+    clauses_removable.shrink(i - j);
+    checkGarbage();
+}
+
 
 void Solver::removeSatisfied(vec<CRef>& cs)
 {
@@ -1692,6 +1767,23 @@ lbool Solver::search(int nof_conflicts)
       // Analyze the conflict
       learnt_clause.clear();
       int max_level = analyze(confl, learnt_clause, backtrack_level);
+      // the LBD is computed before backtracking, when all literals are still assigned
+      unsigned lbd = (lbd_reduce || glucose_restart) ? computeLbd(learnt_clause) : 0;
+      if (glucose_restart)
+      {
+        // Block the next restart if the trail is unusually large, the solver may be close to a
+        // model (Audemard & Simon, CP 2012)
+        trail_queue.push(trail.size());
+        if (conflicts > (uint64_t)restart_block_start && lbd_queue.full()
+            && trail.size() > restart_block_factor * trail_queue.avg())
+        {
+          lbd_queue.clear();
+          blocked_restarts++;
+        }
+        lbd_queue.push(lbd);
+        lbd_sum += lbd;
+        lbd_count++;
+      }
       cancelUntil(backtrack_level);
 
       // Assert the conflict clause and the asserting literal
@@ -1715,6 +1807,7 @@ lbool Solver::search(int nof_conflicts)
         clauses_removable.push(cr);
         attachClause(cr);
         claBumpActivity(ca[cr]);
+        if (lbd_reduce) ca[cr].setLbd(lbd);
         uncheckedEnqueue(learnt_clause[0], cr);
         if (options::unsatCores() && !isProofEnabled())
         {
@@ -1789,6 +1882,7 @@ lbool Solver::search(int nof_conflicts)
       }
 
       if ((nof_conflicts >= 0 && conflictC >= nof_conflicts)
+          || (glucose_restart && dynamicRestart())
           || !withinBudget(ResourceManager::Resource::SatConflictStep))
       {
         // Reached bound on number of conflicts:
@@ -1871,6 +1965,25 @@ double Solver::progressEstimate() const
     return progress / nVars();
 }
 
+/*_________________________________________________________________________________________________
+|
+|  dynamicRestart : ()  ->  [bool]
+|
+|  Description:
+|    Glucose-style restart policy (Audemard & Simon, IJCAI 2009). Returns TRUE if the average LBD
+|    of the most recent learnt clauses, scaled by 'restart_lbd_factor', exceeds the average LBD of
+|    all learnt clauses since the last call to 'solve_()', i.e., if the quality of the learnt
+|    clauses decreased recently.
+|________________________________________________________________________________________________@*/
+bool Solver::dynamicRestart()
+{
+    if (lbd_queue.full() && lbd_queue.avg() * restart_lbd_factor > (double)lbd_sum / lbd_count){
+        lbd_queue.clear();
+        return true;
+    }
+    return false;
+}
+
 /*
   Finite subsequences of the Luby-sequence:
 
@@ -1922,6 +2035,11 @@ lbool Solver::solve_()
     learntsize_adjust_cnt     = (int)learntsize_adjust_confl;
     lbool   status            = l_Undef;
 
+    lbd_queue.clear();
+    trail_queue.clear();
+    lbd_sum                   = 0;
+    lbd_count                 = 0;
+
     if (verbosity >= 1){
         printf("============================[ Search Statistics ]==============================\n");
         printf("| Conflicts |          ORIGINAL         |          LEARNT          | Progress |\n");
@@ -1932,8 +2050,17 @@ lbool Solver::solve_()
     // Search:
     int curr_restarts = 0;
     while (status == l_Undef){
-        double rest_base = luby_restart ? luby(restart_inc, curr_restarts) : pow(restart_inc, curr_restarts);
-        status = search(rest_base * restart_first);
+        if (glucose_restart)
+        {
+          // restarts are triggered by search() itself
+          status = search(-1);
+        }
+        else
+        {
+          double rest_base = luby_restart ? luby(restart_inc, curr_restarts)
+                                          : pow(restart_inc, curr_restarts);
+          status = search(rest_base * restart_first);
+        }
         if (!withinBudget(ResourceManager::Resource::SatConflictStep))
           break;  // FIXME add restart option?
         curr_restarts++;
@@ -2366,7 +2493,12 @@ void ClauseAllocator::reloc(CRef& cr,
   // Copy extra data-fields:
   // (This could be cleaned-up. Generalize Clause-constructor to be applicable here instead?)
   to[cr].mark(c.mark());
-  if (to[cr].removable())         to[cr].activity() = c.activity();
+  if (to[cr].removable())
+  {
+    to[cr].activity() = c.activity();
+    to[cr].setLbd(c.lbd());
+    to[cr].setUsed(c.used());
+  }
   else if (to[cr].has_extra()) to[cr].calcAbstraction();
 }
 
@@ -254,6 +254,7 @@ public:
     int     nAssigns   ()      const;       // The current number of assigned literals.
     int     nClauses   ()      const;       // The current number of original clauses.
     int     nLearnts   ()      const;       // The current number of learnt clauses.
+    const Clause& learnt(int i) const;      // The i-th learnt clause.
     int     nVars      ()      const;       // The current number of variables.
     int     nFreeVars  ()      const;
     bool    isDecision (Var x) const;       // is the given var a decision?
@@ -305,10 +306,19 @@ public:
     int       learntsize_adjust_start_confl;
     double    learntsize_adjust_inc;
 
+    bool      glucose_restart;    // Restart dynamically based on the LBD of recent learnt clauses (Glucose).                  (default false)
+    double    restart_lbd_factor; // Restart if the recent average LBD times this factor exceeds the global average (K).       (default 0.8)
+    double    restart_block_factor; // Block restarts if the trail is this factor larger than its recent average (R).           (default 1.4)
+    int       restart_block_start;  // The number of conflicts before restarts may be blocked.                                 (default 10000)
+    bool      lbd_reduce;         // Keep learnt clauses in tiers by their LBD in 'reduceDB()'.                                (default false)
+    unsigned  lbd_core;           // Learnt clauses with at most this LBD are never removed.                                    (default 2)
+    unsigned  lbd_tier2;          // Learnt clauses with at most this LBD are kept while they are used in conflicts.            (default 6)
+
     // Statistics: (read-only member variable)
     //
     uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts, resources_consumed;
     uint64_t dec_vars, clauses_literals, learnts_literals, max_literals, tot_literals;
+    uint64_t blocked_restarts;
 
 protected:
 
@@ -420,6 +430,15 @@ protected:
     double              learntsize_adjust_confl;
     int                 learntsize_adjust_cnt;
 
+    // Glucose-style LBD computation and dynamic restarts:
+    //
+    vec<uint64_t>          lbd_stamps;      // 'lbd_stamps[l]' is the value of 'lbd_stamp' when level 'l' was counted last.
+    uint64_t               lbd_stamp;
+    BoundedQueue<unsigned> lbd_queue;       // The LBDs of the most recent learnt clauses.
+    BoundedQueue<unsigned> trail_queue;     // The trail sizes at the most recent conflicts.
+    uint64_t               lbd_sum;         // The sum of the LBDs of all learnt clauses since the last 'solve_()'.
+    uint64_t               lbd_count;       // The number of learnt clauses since the last 'solve_()'.
+
     // Resource contraints:
     //
     int64_t             conflict_budget;    // -1 means no budget.
@@ -448,6 +467,10 @@ protected:
     lbool    search           (int nof_conflicts);                                     // Search for a given number of conflicts.
     lbool    solve_           ();                                                      // Main solve method (assumptions given in 'assumptions').
     void     reduceDB         ();                                                      // Reduce the set of learnt clauses.
+    void     reduceDBByLbd    ();                                                      // Reduce the set of learnt clauses, keeping them in tiers by LBD.
+    template<class C>
+    unsigned computeLbd       (const C& c);                                            // The number of distinct decision levels of the literals in 'c'.
+    bool     dynamicRestart   ();                                                      // Returns TRUE if a Glucose-style restart is due.
     void     removeSatisfied  (vec<CRef>& cs);                                         // Shrink 'cs' to contain only non-satisfied clauses.
     void     rebuildOrderHeap ();
 
@@ -608,6 +631,22 @@ inline void Solver::newDecisionLevel()
 }
 
 inline int      Solver::decisionLevel ()      const   { return trail_lim.size(); }
+
+template<class C>
+inline unsigned Solver::computeLbd(const C& c)
+{
+    lbd_stamp++;
+    unsigned lbd = 0;
+    for (int i = 0; i < c.size(); i++){
+        int l = level(var(c[i]));
+        if (l >= lbd_stamps.size()) lbd_stamps.growTo(l + 1, 0);
+        if (lbd_stamps[l] != lbd_stamp){
+            lbd_stamps[l] = lbd_stamp;
+            lbd++;
+        }
+    }
+    return lbd;
+}
 inline uint32_t Solver::abstractLevel (Var x) const   { return 1 << (level(x) & 31); }
 inline lbool Solver::value(Var x) const
 {
@@ -624,6 +663,7 @@ inline lbool    Solver::modelValue    (Lit p) const   { return model[var(p)] ^ s
 inline int      Solver::nAssigns      ()      const   { return trail.size(); }
 inline int      Solver::nClauses      ()      const   { return clauses_persistent.size(); }
 inline int      Solver::nLearnts      ()      const   { return clauses_removable.size(); }
+inline const Clause& Solver::learnt(int i) const { return ca[clauses_removable[i]]; }
 inline int      Solver::nVars         ()      const   { return vardata.size(); }
 inline int      Solver::nFreeVars     ()      const   { return (int)dec_vars - (trail_lim.size() == 0 ? trail.size() : trail_lim[0]); }
 inline bool     Solver::properExplanation(Lit l, Lit expl) const { return value(l) == l_True && value(expl) == l_True && trail_index(var(expl)) < trail_index(var(l)); }
@@ -199,7 +199,8 @@ class Clause {
         unsigned reloced   : 1;
         unsigned size      : 27;
         unsigned level     : 32; }                            header;
-    union { Lit lit; float act; uint32_t abs; CRef rel; } data[0];
+    struct Glue { unsigned lbd : 31; unsigned used : 1; };
+    union { Lit lit; float act; uint32_t abs; CRef rel; Glue glue; } data[0];
 
     friend class ClauseAllocator;
 
@@ -216,9 +217,11 @@ class Clause {
         for (int i = 0; i < ps.size(); i++) data[i].lit = ps[i];
 
         if (header.has_extra){
-            if (header.removable)
+            if (header.removable){
               data[header.size].act = 0;
-            else
+              data[header.size + 1].glue.lbd = ps.size();
+              data[header.size + 1].glue.used = 0;
+            }else
               calcAbstraction();
         }
     }
@@ -233,11 +236,36 @@ public:
     }
 
     int          level       ()      const   { return header.level; }
+    // The literal block distance (LBD), i.e., the number of distinct decision levels of the
+    // literals of the clause, at the time it was computed last. Defaults to the size. Only
+    // removable clauses have the word after the activity that stores it:
+    unsigned lbd() const
+    {
+      Assert(header.removable);
+      return data[header.size + 1].glue.lbd;
+    }
+    void setLbd(unsigned l)
+    {
+      Assert(header.removable);
+      data[header.size + 1].glue.lbd = l;
+    }
+    // Whether the clause took part in conflict analysis since the last reduction:
+    bool used() const
+    {
+      Assert(header.removable);
+      return data[header.size + 1].glue.used;
+    }
+    void setUsed(bool u)
+    {
+      Assert(header.removable);
+      data[header.size + 1].glue.used = u;
+    }
     int          size        ()      const   { return header.size; }
     void shrink(int i)
     {
       Assert(i <= size());
       if (header.has_extra) data[header.size - i] = data[header.size];
+      if (header.removable) data[header.size + 1 - i] = data[header.size + 1];
       header.size -= i;
     }
     void         pop         ()              { shrink(1); }
@@ -281,8 +309,9 @@ const CRef CRef_Undef = RegionAllocator<uint32_t>::Ref_Undef;
 const CRef CRef_Lazy  = RegionAllocator<uint32_t>::Ref_Undef - 1;
 class ClauseAllocator : public RegionAllocator<uint32_t>
 {
-    static int clauseWord32Size(int size, bool has_extra){
-        return (sizeof(Clause) + (sizeof(Lit) * (size + (int)has_extra))) / sizeof(uint32_t); }
+    // Removable clauses have the activity and the LBD after their literals:
+    static int clauseWord32Size(int size, bool has_extra, bool removable){
+        return (sizeof(Clause) + (sizeof(Lit) * (size + (int)has_extra + (int)removable))) / sizeof(uint32_t); }
  public:
     bool extra_clause_field;
 
@@ -301,7 +330,7 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
       bool use_extra = removable | extra_clause_field;
 
       CRef cid = RegionAllocator<uint32_t>::alloc(
-          clauseWord32Size(ps.size(), use_extra));
+          clauseWord32Size(ps.size(), use_extra, removable));
       new (lea(cid)) Clause(ps, use_extra, removable, level);
 
       return cid;
@@ -317,7 +346,7 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
     void free(CRef cid)
     {
         Clause& c = operator[](cid);
-        RegionAllocator<uint32_t>::free(clauseWord32Size(c.size(), c.has_extra()));
+        RegionAllocator<uint32_t>::free(clauseWord32Size(c.size(), c.has_extra(), c.removable()));
     }
 
     void reloc(CRef& cr,
@@ -327,6 +356,33 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
 };
 
 
+//=================================================================================================
+// BoundedQueue -- a fixed-size queue of the most recent values that maintains their sum:
+
+template<class T>
+class BoundedQueue
+{
+    vec<T>   elems;
+    int      head;
+    int      count;
+    uint64_t sum;
+
+ public:
+    BoundedQueue(int size) : head(0), count(0), sum(0) { elems.growTo(size); }
+
+    void push(T x) {
+        if (count == elems.size()) sum -= elems[head];
+        else                       count++;
+        elems[head] = x;
+        sum += x;
+        head = (head + 1) % elems.size(); }
+
+    bool   full () const { return count == elems.size(); }
+    double avg  () const { return count == 0 ? 0 : (double)sum / count; }
+    void   clear()       { head = 0; count = 0; sum = 0; }
+};
+
+
 //=================================================================================================
 // OccLists -- a class for maintaining occurence lists with lazy deletion:
 
@@ -147,6 +147,11 @@ void MinisatSatSolver::setupOptions() {
   d_minisat->clause_decay = options::satClauseDecay();
   d_minisat->restart_first = options::satRestartFirst();
   d_minisat->restart_inc = options::satRestartInc();
+  d_minisat->luby_restart =
+      options::satRestartMode() == options::SatRestartMode::LUBY;
+  d_minisat->glucose_restart =
+      options::satRestartMode() == options::SatRestartMode::GLUCOSE;
+  d_minisat->lbd_reduce = options::satLbdReduce();
 }
 
 ClauseId MinisatSatSolver::addClause(SatClause& clause, bool removable) {
@@ -235,6 +240,16 @@ std::shared_ptr<ProofNode> MinisatSatSolver::getProof()
   return d_minisat->getProof();
 }
 
+void MinisatSatSolver::getLearnedClauses(std::vector<SatClause>& clauses) const
+{
+  for (int i = 0, nlearnts = d_minisat->nLearnts(); i < nlearnts; ++i)
+  {
+    SatClause clause;
+    toSatClause(d_minisat->learnt(i), clause);
+    clauses.push_back(clause);
+  }
+}
+
 /** Incremental interface */
 
 unsigned MinisatSatSolver::getAssertionLevel() const {
@@ -263,7 +278,8 @@ MinisatSatSolver::Statistics::Statistics(StatisticsRegistry* registry) :
     d_statClausesLiterals("sat::clauses_literals"),
     d_statLearntsLiterals("sat::learnts_literals"),
     d_statMaxLiterals("sat::max_literals"),
-    d_statTotLiterals("sat::tot_literals")
+    d_statTotLiterals("sat::tot_literals"),
+    d_statBlockedRestarts("sat::blocked_restarts")
 {
   d_registry->registerStat(&d_statStarts);
   d_registry->registerStat(&d_statDecisions);
@@ -274,6 +290,7 @@ MinisatSatSolver::Statistics::Statistics(StatisticsRegistry* registry) :
   d_registry->registerStat(&d_statLearntsLiterals);
   d_registry->registerStat(&d_statMaxLiterals);
   d_registry->registerStat(&d_statTotLiterals);
+  d_registry->registerStat(&d_statBlockedRestarts);
 }
 
 MinisatSatSolver::Statistics::~Statistics() {
@@ -286,6 +303,7 @@ MinisatSatSolver::Statistics::~Statistics() {
   d_registry->unregisterStat(&d_statLearntsLiterals);
   d_registry->unregisterStat(&d_statMaxLiterals);
   d_registry->unregisterStat(&d_statTotLiterals);
+  d_registry->unregisterStat(&d_statBlockedRestarts);
 }
 
 void MinisatSatSolver::Statistics::init(Minisat::SimpSolver* minisat){
@@ -298,6 +316,7 @@ void MinisatSatSolver::Statistics::init(Minisat::SimpSolver* minisat){
   d_statLearntsLiterals.set(minisat->learnts_literals);
   d_statMaxLiterals.set(minisat->max_literals);
   d_statTotLiterals.set(minisat->tot_literals);
+  d_statBlockedRestarts.set(minisat->blocked_restarts);
 }
 
 }  // namespace prop
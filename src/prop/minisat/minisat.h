@@ -91,6 +91,8 @@ class MinisatSatSolver : public CDCLTSatSolverInterface
   /** Retrieve the refutation proof of this SAT solver. */
   std::shared_ptr<ProofNode> getProof() override;
 
+  void getLearnedClauses(std::vector<SatClause>& clauses) const override;
+
  private:
 
   /** The SatSolver used */
@@ -108,7 +110,7 @@ class MinisatSatSolver : public CDCLTSatSolverInterface
     ReferenceStat<uint64_t> d_statRndDecisions, d_statPropagations;
     ReferenceStat<uint64_t> d_statConflicts, d_statClausesLiterals;
     ReferenceStat<uint64_t> d_statLearntsLiterals,  d_statMaxLiterals;
-    ReferenceStat<uint64_t> d_statTotLiterals;
+    ReferenceStat<uint64_t> d_statTotLiterals, d_statBlockedRestarts;
   public:
     Statistics(StatisticsRegistry* registry);
     ~Statistics();
@@ -28,6 +28,7 @@
 #include "options/main_options.h"
 #include "options/options.h"
 #include "options/proof_options.h"
+#include "options/prop_options.h"
 #include "options/smt_options.h"
 #include "proof/proof_manager.h"
 #include "prop/cnf_stream.h"
@@ -82,14 +83,25 @@ PropEngine::PropEngine(TheoryEngine* te,
       d_ppm(nullptr),
       d_interrupted(false),
       d_resourceManager(rm),
-      d_outMgr(outMgr)
+      d_outMgr(outMgr),
+      d_ckptAssertions(userContext),
+      d_ckptSkolemDefs(userContext),
+      d_ckptLemmas(userContext),
+      d_ckptLearnedClauses(userContext)
 {
   Debug("prop") << "Constructing the PropEngine" << std::endl;
 
   d_decisionEngine.reset(new DecisionEngine(satContext, userContext, rm));
   d_decisionEngine->init();  // enable appropriate strategies
 
-  d_satSolver = SatSolverFactory::createCDCLTMinisat(smtStatisticsRegistry());
+  if (options::satSolver() == options::CDCLTSatSolverMode::CADICAL)
+  {
+    d_satSolver = SatSolverFactory::createCDCLTCadical(smtStatisticsRegistry());
+  }
+  else
+  {
+    d_satSolver = SatSolverFactory::createCDCLTMinisat(smtStatisticsRegistry());
+  }
 
   // CNF stream and theory proxy required pointers to each other, make the
   // theory proxy first
@@ -184,6 +196,10 @@ void PropEngine::assertFormula(TNode node) {
   // NOTE: we do not notify the theory proxy here, since we've already
   // notified the theory proxy during notifyPreprocessedAssertions
   assertInternal(node, false, false, true);
+  if (options::checkpoints())
+  {
+    d_ckptAssertions.push_back(node);
+  }
 }
 
 void PropEngine::assertSkolemDefinition(TNode node, TNode skolem)
@@ -192,6 +208,10 @@ void PropEngine::assertSkolemDefinition(TNode node, TNode skolem)
   Debug("prop") << "assertFormula(" << node << ")" << std::endl;
   d_theoryProxy->notifyAssertion(node, skolem);
   assertInternal(node, false, false, true);
+  if (options::checkpoints())
+  {
+    d_ckptSkolemDefs.push_back(std::pair<Node, Node>(node, skolem));
+  }
 }
 
 void PropEngine::assertLemma(theory::TrustNode tlemma, theory::LemmaProperty p)
@@ -290,9 +310,82 @@ void PropEngine::assertLemmasInternal(
       Node lem = ppLemmas[i].getProven();
       d_theoryProxy->notifyAssertion(ppLemmas[i].getProven(), ppSkolems[i]);
     }
+    if (options::checkpoints())
+    {
+      if (!trn.isNull())
+      {
+        d_ckptLemmas.push_back(trn.getProven());
+      }
+      for (size_t i = 0, lsize = ppLemmas.size(); i < lsize; ++i)
+      {
+        d_ckptSkolemDefs.push_back(
+            std::pair<Node, Node>(ppLemmas[i].getProven(), ppSkolems[i]));
+      }
+    }
+  }
+}
+
+void PropEngine::getAssertedFormulas(std::vector<Node>& assertions,
+                                     std::vector<Node>& skolemDefs,
+                                     std::vector<Node>& skolems,
+                                     std::vector<Node>& lemmas) const
+{
+  assertions.insert(
+      assertions.end(), d_ckptAssertions.begin(), d_ckptAssertions.end());
+  for (const std::pair<Node, Node>& sd : d_ckptSkolemDefs)
+  {
+    skolemDefs.push_back(sd.first);
+    skolems.push_back(sd.second);
+  }
+  lemmas.insert(lemmas.end(), d_ckptLemmas.begin(), d_ckptLemmas.end());
+}
+
+void PropEngine::getLearnedClauses(std::vector<Node>& clauses) const
+{
+  // the restored learned clauses are permanent clauses of the SAT solver
+  clauses.insert(
+      clauses.end(), d_ckptLearnedClauses.begin(), d_ckptLearnedClauses.end());
+  NodeManager* nm = NodeManager::currentNM();
+  const CnfStream::LiteralToNodeMap& litToNode = d_cnfStream->getNodeCache();
+  std::vector<SatClause> satClauses;
+  d_satSolver->getLearnedClauses(satClauses);
+  for (const SatClause& sc : satClauses)
+  {
+    std::vector<Node> lits;
+    for (const SatLiteral& l : sc)
+    {
+      CnfStream::LiteralToNodeMap::const_iterator it = litToNode.find(l);
+      if (it == litToNode.end())
+      {
+        break;
+      }
+      lits.push_back((*it).second);
+    }
+    // skip clauses with literals that have no formula
+    if (lits.size() == sc.size() && !lits.empty())
+    {
+      clauses.push_back(nm->mkOr(lits));
+    }
   }
 }
 
+void PropEngine::assertCheckpointLemma(TNode node)
+{
+  Assert(options::checkpoints());
+  Debug("prop") << "assertCheckpointLemma(" << node << ")" << std::endl;
+  assertInternal(node, false, false, true);
+  d_ckptLemmas.push_back(node);
+}
+
+void PropEngine::assertCheckpointLearnedClause(TNode node)
+{
+  Assert(options::checkpoints());
+  Debug("prop") << "assertCheckpointLearnedClause(" << node << ")"
+                << std::endl;
+  assertInternal(node, false, false, true);
+  d_ckptLearnedClauses.push_back(node);
+}
+
 void PropEngine::requirePhase(TNode n, bool phase) {
   Debug("prop") << "requirePhase(" << n << ", " << phase << ")" << std::endl;
 
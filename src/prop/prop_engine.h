@@ -150,6 +150,36 @@ class PropEngine
    */
   void assertLemma(theory::TrustNode tlemma, theory::LemmaProperty p);
 
+  /**
+   * Get the formulas asserted to this prop engine in the current user
+   * context, which are only recorded with --checkpoints.
+   *
+   * @param assertions The formulas asserted via assertFormula
+   * @param skolemDefs The skolem definitions, asserted via
+   * assertSkolemDefinition or introduced by preprocessing lemmas
+   * @param skolems The skolems that skolemDefs correspond to
+   * @param lemmas The lemmas that are not removable
+   */
+  void getAssertedFormulas(std::vector<Node>& assertions,
+                           std::vector<Node>& skolemDefs,
+                           std::vector<Node>& skolems,
+                           std::vector<Node>& lemmas) const;
+  /**
+   * Get the clauses that the SAT solver learned, or that were asserted as
+   * removable lemmas, as disjunctions of the formulas of their literals.
+   */
+  void getLearnedClauses(std::vector<Node>& clauses) const;
+  /**
+   * Assert a lemma of a restored checkpoint. Like the lemmas that are not
+   * removable, it is saved as a lemma by later checkpoints.
+   */
+  void assertCheckpointLemma(TNode node);
+  /**
+   * Assert a learned clause of a restored checkpoint, as a permanent clause.
+   * It is saved as a learned clause by later checkpoints.
+   */
+  void assertCheckpointLearnedClause(TNode node);
+
   /**
    * If ever n is decided upon, it must be in the given phase.  This
    * occurs *globally*, i.e., even if the literal is untranslated by
@@ -378,6 +408,17 @@ class PropEngine
 
   /** Reference to the output manager of the smt engine */
   OutputManager& d_outMgr;
+
+  /**
+   * The formulas asserted in the current user context, for checkpoints. These
+   * are the formulas asserted via assertFormula, the skolem definitions and
+   * their skolems, the lemmas that are not removable and the learned clauses
+   * of restored checkpoints.
+   */
+  context::CDList<Node> d_ckptAssertions;
+  context::CDList<std::pair<Node, Node>> d_ckptSkolemDefs;
+  context::CDList<Node> d_ckptLemmas;
+  context::CDList<Node> d_ckptLearnedClauses;
 };
 
 }  // namespace prop
@@ -171,6 +171,12 @@ class CDCLTSatSolverInterface : public SatSolver
 
   virtual std::shared_ptr<ProofNode> getProof() = 0;
 
+  /**
+   * Get the clauses that were learned or asserted as removable, which the
+   * solver may delete later, if it supports this.
+   */
+  virtual void getLearnedClauses(std::vector<SatClause>& clauses) const = 0;
+
 }; /* class CDCLTSatSolverInterface */
 
 inline std::ostream& operator <<(std::ostream& out, prop::SatLiteral lit) {
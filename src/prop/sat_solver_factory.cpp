@@ -55,7 +55,20 @@ SatSolver* SatSolverFactory::createCadical(StatisticsRegistry* registry,
                                            const std::string& name)
 {
 #ifdef CVC4_USE_CADICAL
-  CadicalSolver* res = new CadicalSolver(registry, name);
+  CadicalSolver* res =
+      new CadicalSolver(registry, "theory::bv::" + name + "::");
+  res->init();
+  return res;
+#else
+  Unreachable() << "CVC4 was not compiled with CaDiCaL support.";
+#endif
+}
+
+CDCLTSatSolverInterface* SatSolverFactory::createCDCLTCadical(
+    StatisticsRegistry* registry)
+{
+#ifdef CVC4_USE_CADICAL
+  CadicalSolver* res = new CadicalSolver(registry, "prop::");
   res->init();
   return res;
 #else
@@ -45,6 +45,13 @@ class SatSolverFactory
   static SatSolver* createCadical(StatisticsRegistry* registry,
                                   const std::string& name = "");
 
+  /**
+   * Create CaDiCaL as SAT solver of the main CDCL(T) engine, which is
+   * connected to the theories in CDCLTSatSolverInterface::initialize().
+   */
+  static CDCLTSatSolverInterface* createCDCLTCadical(
+      StatisticsRegistry* registry);
+
   static SatSolver* createKissat(StatisticsRegistry* registry,
                                  const std::string& name = "");
 }; /* class SatSolverFactory */
@@ -0,0 +1,159 @@
+/*********************                                                        */
+/*! \file checkpoint.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Checkpoints of the state of an SMT engine
+ **/
+
+#include "smt/checkpoint.h"
+
+#include <cstring>
+#include <ostream>
+
+#include "base/check.h"
+#include "base/exception.h"
+#include "expr/node_dag_io.h"
+
+namespace cvc5 {
+namespace smt {
+
+namespace {
+
+/** The header of the format, whose last byte is the version. */
+const char s_header[9] = {'C', 'V', 'C', '4', 'C', 'K', 'P', 'T', 1};
+
+/** The number of lists of a checkpoint whose sizes are written. */
+const size_t s_numLists = 6;
+
+void putNumber(std::ostream& out, uint32_t n)
+{
+  for (unsigned i = 0; i < 4; ++i)
+  {
+    out.put(static_cast<char>((n >> (8 * i)) & 0xff));
+  }
+}
+
+uint32_t getNumber(const char*& data, const char* end)
+{
+  if (end - data < 4)
+  {
+    throw Exception("unexpected end of the checkpoint");
+  }
+  uint32_t n = 0;
+  for (unsigned i = 0; i < 4; ++i)
+  {
+    n |= static_cast<uint32_t>(static_cast<uint8_t>(*data++)) << (8 * i);
+  }
+  return n;
+}
+
+/**
+ * Add the next size elements of roots, starting at index i, to v. If
+ * formulas is true, they must be formulas.
+ */
+void getList(const std::vector<Node>& roots,
+             size_t& i,
+             uint32_t size,
+             bool formulas,
+             std::vector<Node>& v)
+{
+  for (size_t end = i + size; i < end; ++i)
+  {
+    if (formulas && !roots[i].getType().isBoolean())
+    {
+      throw Exception("the checkpoint has a term that is not a formula");
+    }
+    v.push_back(roots[i]);
+  }
+}
+
+}  // namespace
+
+void Checkpoint::write(std::ostream& out) const
+{
+  Assert(d_skolemDefs.size() == d_skolems.size());
+  out.write(s_header, sizeof(s_header));
+  putNumber(out, d_logic.size());
+  out << d_logic;
+  putNumber(out, d_assertions.size());
+  putNumber(out, d_ppAssertions.size());
+  putNumber(out, d_skolemDefs.size());
+  putNumber(out, d_substs.size());
+  putNumber(out, d_lemmas.size());
+  putNumber(out, d_learnedClauses.size());
+
+  // all formulas are written as the roots of a single DAG, so that shared
+  // subterms are written once
+  std::vector<Node> roots(d_assertions.begin(), d_assertions.end());
+  roots.insert(roots.end(), d_ppAssertions.begin(), d_ppAssertions.end());
+  roots.insert(roots.end(), d_skolemDefs.begin(), d_skolemDefs.end());
+  roots.insert(roots.end(), d_skolems.begin(), d_skolems.end());
+  for (const std::pair<Node, Node>& s : d_substs)
+  {
+    roots.push_back(s.first);
+    roots.push_back(s.second);
+  }
+  roots.insert(roots.end(), d_lemmas.begin(), d_lemmas.end());
+  roots.insert(
+      roots.end(), d_learnedClauses.begin(), d_learnedClauses.end());
+  NodeDagWriter::write(out, roots);
+}
+
+void Checkpoint::read(const char* data, size_t size)
+{
+  const char* end = data + size;
+  if (size < sizeof(s_header)
+      || std::memcmp(data, s_header, sizeof(s_header)) != 0)
+  {
+    throw Exception("the data are not a checkpoint of this version");
+  }
+  data += sizeof(s_header);
+  uint32_t logicSize = getNumber(data, end);
+  if (static_cast<size_t>(end - data) < logicSize)
+  {
+    throw Exception("unexpected end of the checkpoint");
+  }
+  d_logic.assign(data, logicSize);
+  data += logicSize;
+  uint32_t sizes[s_numLists];
+  for (size_t i = 0; i < s_numLists; ++i)
+  {
+    sizes[i] = getNumber(data, end);
+  }
+
+  NodeDagReader reader(data, end - data);
+  reader.read();
+  const std::vector<Node>& roots = reader.getRoots();
+  // the skolem definitions and substitutions have two roots each
+  size_t numRoots = size_t(sizes[0]) + sizes[1] + 2 * size_t(sizes[2])
+                    + 2 * size_t(sizes[3]) + sizes[4] + sizes[5];
+  if (roots.size() != numRoots)
+  {
+    throw Exception("the checkpoint has an unexpected number of formulas");
+  }
+  size_t i = 0;
+  getList(roots, i, sizes[0], true, d_assertions);
+  getList(roots, i, sizes[1], true, d_ppAssertions);
+  getList(roots, i, sizes[2], true, d_skolemDefs);
+  getList(roots, i, sizes[2], false, d_skolems);
+  for (uint32_t j = 0; j < sizes[3]; ++j, i += 2)
+  {
+    if (!roots[i].getType().isComparableTo(roots[i + 1].getType()))
+    {
+      throw Exception("the checkpoint has an ill-typed substitution");
+    }
+    d_substs.push_back(std::pair<Node, Node>(roots[i], roots[i + 1]));
+  }
+  getList(roots, i, sizes[4], true, d_lemmas);
+  getList(roots, i, sizes[5], true, d_learnedClauses);
+  d_symbols = reader.getSymbols();
+  d_sorts = reader.getSorts();
+}
+
+}  // namespace smt
+}  // namespace cvc5
@@ -0,0 +1,77 @@
+/*********************                                                        */
+/*! \file checkpoint.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Checkpoints of the state of an SMT engine
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__SMT__CHECKPOINT_H
+#define CVC4__SMT__CHECKPOINT_H
+
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/type_node.h"
+
+namespace cvc5 {
+namespace smt {
+
+/**
+ * A checkpoint of the state of an SMT engine in its current user context,
+ * which can be restored into a fresh SMT engine with the same logic and
+ * options, e.g., in another process.
+ *
+ * A checkpoint consists of the input assertions, with their definitions
+ * expanded, the result of preprocessing them (the preprocessed assertions,
+ * the skolem definitions and the top-level substitutions), the lemmas that
+ * are not removable and, optionally, the clauses learned by the SAT solver.
+ * It is written as its logic and the sizes of these lists, followed by the
+ * DAG of their formulas in the format of NodeDagWriter.
+ */
+struct Checkpoint
+{
+  /** Write this checkpoint to out. */
+  void write(std::ostream& out) const;
+  /**
+   * Read a checkpoint from the given buffer into the current node manager.
+   * Throws an Exception if the data is not a checkpoint.
+   */
+  void read(const char* data, size_t size);
+
+  /** The logic of the SMT engine */
+  std::string d_logic;
+  /** The input assertions */
+  std::vector<Node> d_assertions;
+  /** The preprocessed assertions */
+  std::vector<Node> d_ppAssertions;
+  /** The skolem definitions, and the skolems they define */
+  std::vector<Node> d_skolemDefs;
+  std::vector<Node> d_skolems;
+  /** The top-level substitutions */
+  std::vector<std::pair<Node, Node>> d_substs;
+  /** The lemmas that are not removable */
+  std::vector<Node> d_lemmas;
+  /** The learned clauses */
+  std::vector<Node> d_learnedClauses;
+  /**
+   * The free symbols, and the uninterpreted sorts and datatypes, of a
+   * checkpoint that was read
+   */
+  std::vector<Node> d_symbols;
+  std::vector<TypeNode> d_sorts;
+};
+
+}  // namespace smt
+}  // namespace cvc5
+
+#endif /* CVC4__SMT__CHECKPOINT_H */
@@ -22,6 +22,8 @@
 #include "smt/dump.h"
 #include "smt/preprocess_proof_generator.h"
 #include "smt/smt_engine.h"
+#include "theory/theory_engine.h"
+#include "theory/theory_model.h"
 
 using namespace std;
 using namespace cvc5::theory;
@@ -104,6 +106,31 @@ void Preprocessor::clearLearnedLiterals()
   d_propagator.getLearnedLiterals().clear();
 }
 
+void Preprocessor::getTopLevelSubstitutions(
+    std::vector<std::pair<Node, Node>>& substs)
+{
+  const SubstitutionMap& tls = d_ppContext->getTopLevelSubstitutions().get();
+  for (SubstitutionMap::const_iterator it = tls.begin(); it != tls.end(); ++it)
+  {
+    substs.push_back(std::pair<Node, Node>((*it).first, (*it).second));
+  }
+}
+
+void Preprocessor::notifyRestoredAssertions(
+    const std::vector<Node>& assertions,
+    const std::vector<std::pair<Node, Node>>& substs)
+{
+  TrustSubstitutionMap& tls = d_ppContext->getTopLevelSubstitutions();
+  TheoryModel* m = d_smt.getTheoryEngine()->getModel();
+  for (const std::pair<Node, Node>& s : substs)
+  {
+    tls.addSubstitution(s.first, s.second);
+    m->addSubstitution(s.first, s.second);
+  }
+  d_ppContext->recordSymbolsInAssertions(assertions);
+  d_assertionsProcessed = true;
+}
+
 void Preprocessor::cleanup() { d_processor.cleanup(); }
 
 Node Preprocessor::expandDefinitions(const Node& n, bool expandOnly)
@@ -62,6 +62,21 @@ class Preprocessor
    * Clear learned literals from the Boolean propagator.
    */
   void clearLearnedLiterals();
+  /**
+   * Get the top-level substitutions inferred while processing the assertions
+   * of the current user context.
+   */
+  void getTopLevelSubstitutions(std::vector<std::pair<Node, Node>>& substs);
+  /**
+   * Notify that the given assertions, which were preprocessed by another
+   * solver with the top-level substitutions substs, are asserted without
+   * being processed by this class. This is the case when restoring a
+   * checkpoint. The substitutions are applied to the assertions of later
+   * calls to process, and to the model.
+   */
+  void notifyRestoredAssertions(
+      const std::vector<Node>& assertions,
+      const std::vector<std::pair<Node, Node>>& substs);
   /**
    * Cleanup, which deletes the processing passes owned by this module. This
    * is required to be done explicitly so that passes are deleted before the
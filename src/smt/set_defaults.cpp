@@ -16,6 +16,7 @@
 
 #include <sstream>
 
+#include "base/configuration.h"
 #include "base/output.h"
 #include "options/arith_options.h"
 #include "options/arrays_options.h"
@@ -362,10 +363,69 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
     options::produceAssertions.set(true);
   }
 
+  // the CDCL(T) engine only produces proofs and unsat cores with Minisat
+  if (options::satSolver() == options::CDCLTSatSolverMode::CADICAL
+      && (options::produceProofs() || options::unsatCores()))
+  {
+    throw OptionException(
+        "--sat-solver=cadical does not support proofs and unsat cores, use "
+        "--sat-solver=minisat instead");
+  }
+
+  // the datatypes rewriter fills caches of the datatype definitions lazily,
+  // which is not safe when assertions are rewritten on several threads
+  if (options::ppThreads() > 1 && logic.isTheoryEnabled(THEORY_DATATYPES))
+  {
+    throw OptionException(
+        "--pp-threads greater than 1 is not supported in logics with "
+        "datatypes");
+  }
+
+  // tracing and debug output is not synchronized between the threads that
+  // match triggers
+  if (options::quantThreads() > 1
+      && (TraceChannel.isAnyOn() || DebugChannel.isAnyOn()))
+  {
+    throw OptionException(
+        "--quant-threads greater than 1 is not supported with tracing and "
+        "debug output");
+  }
+
+  // checkpoints are restored into solvers that may receive further
+  // assertions, and do not record proofs
+  if (options::checkpoints())
+  {
+    if (!options::incrementalSolving())
+    {
+      throw OptionException("checkpoints require incremental solving");
+    }
+    if (options::produceProofs() || options::unsatCores())
+    {
+      throw OptionException(
+          "checkpoints are not supported with proofs and unsat cores");
+    }
+  }
+
+  if (!options::statsExportFile().empty())
+  {
+    if (!Configuration::isStatisticsBuild())
+    {
+      throw OptionException(
+          "--stats-export-file requires a statistics-enabled build of CVC4");
+    }
+    if (options::statsExportInterval() == 0)
+    {
+      throw OptionException("--stats-export-interval must be positive");
+    }
+  }
+
   // Disable options incompatible with incremental solving, unsat cores or
   // output an error if enabled explicitly. It is also currently incompatible
-  // with arithmetic, force the option off.
-  if (options::incrementalSolving() || options::unsatCores())
+  // with arithmetic, force the option off. Unconstrained simplification
+  // supports incremental solving with --incremental-simp, but checkpoints do
+  // not record which variables it eliminated.
+  if ((options::incrementalSolving() && !options::incrementalSimp())
+      || options::unsatCores() || options::checkpoints())
   {
     if (options::unconstrainedSimp())
     {
@@ -373,10 +433,10 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
       {
         throw OptionException(
             "unconstrained simplification not supported with unsat "
-            "cores/incremental solving");
+            "cores/incremental solving/checkpoints (try --incremental-simp)");
       }
       Notice() << "SmtEngine: turning off unconstrained simplification to "
-                  "support unsat cores/incremental solving"
+                  "support unsat cores/incremental solving/checkpoints"
                << std::endl;
       options::unconstrainedSimp.set(false);
     }
@@ -1300,6 +1360,16 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
   {
     options::quantDynamicSplit.set(options::QuantDSplitMode::NONE);
   }
+  // incremental E-matching filters the candidates computed by the trigger
+  // index, and assumes all terms of the term database are current
+  if (options::eMatchingIncremental()
+      && (!options::triggerIndex()
+          || options::termDbMode() != options::TermDbMode::ALL))
+  {
+    throw OptionException(
+        "--e-matching-incremental requires --trigger-index and "
+        "--term-db-mode=all");
+  }
 
   // until bugs 371,431 are fixed
   if (!options::minisatUseElim.wasSetByUser())
@@ -28,6 +28,7 @@
 #include "options/main_options.h"
 #include "options/printer_options.h"
 #include "options/proof_options.h"
+#include "options/prop_options.h"
 #include "options/smt_options.h"
 #include "options/theory_options.h"
 #include "printer/printer.h"
@@ -38,6 +39,7 @@
 #include "smt/abstract_values.h"
 #include "smt/assertions.h"
 #include "smt/check_models.h"
+#include "smt/checkpoint.h"
 #include "smt/defined_function.h"
 #include "smt/dump.h"
 #include "smt/dump_manager.h"
@@ -56,6 +58,7 @@
 #include "smt/smt_engine_state.h"
 #include "smt/smt_engine_stats.h"
 #include "smt/smt_solver.h"
+#include "smt/statistics_sampler.h"
 #include "smt/sygus_solver.h"
 #include "smt/unsat_core_manager.h"
 #include "theory/quantifiers/instantiation_list.h"
@@ -292,6 +295,16 @@ void SmtEngine::finishInit()
 
   Assert(getLogicInfo().isLocked());
 
+  // internal subsolvers share the options, but not the file
+  if (!options::statsExportFile().empty() && !d_isInternalSubsolver)
+  {
+    d_statsSampler.reset(
+        new StatisticsSampler(*d_env->getStatisticsRegistry(),
+                              options::statsExportFile(),
+                              options::statsExportFormat(),
+                              options::statsExportInterval()));
+  }
+
   // store that we are finished initializing
   d_state->finishInit();
   Trace("smt-debug") << "SmtEngine::finishInit done" << std::endl;
@@ -310,6 +323,9 @@ SmtEngine::~SmtEngine()
   SmtScope smts(this);
 
   try {
+    // write the last sample of the statistics before they are destroyed
+    d_statsSampler.reset(nullptr);
+
     shutdown();
 
     // global push/pop around everything, to ensure proper destruction
@@ -424,6 +440,10 @@ void SmtEngine::setResultStatistic(const std::string& result) {
 
 void SmtEngine::setTotalTimeStatistic(double seconds) {
   d_stats->d_driverTotalTime.set(seconds);
+  // the total time is set at the end of the run, which is also when we are
+  // interested in the size of the node pool
+  d_stats->d_driverNodeValues.set(getNodeManager()->poolSize());
+  d_stats->d_driverMaxNodeValues.set(getNodeManager()->maxPoolSize());
 }
 
 void SmtEngine::setLogicInternal()
@@ -1747,6 +1767,76 @@ std::vector<Node> SmtEngine::getAssertions()
   return res;
 }
 
+void SmtEngine::saveCheckpoint(std::ostream& out, bool learnedClauses)
+{
+  SmtScope smts(this);
+  finishInit();
+  d_state->doPendingPops();
+  Trace("smt") << "SMT saveCheckpoint()" << endl;
+  if (!options::checkpoints())
+  {
+    throw ModalException(
+        "Cannot save a checkpoint unless checkpoints are enabled "
+        "(try --checkpoints).");
+  }
+  if (learnedClauses
+      && options::satSolver() == options::CDCLTSatSolverMode::CADICAL)
+  {
+    throw ModalException(
+        "Cannot save the learned clauses in a checkpoint with "
+        "--sat-solver=cadical, which does not give access to them.");
+  }
+  // preprocess the pending assertions and assert them to the prop engine
+  d_smtSolver->processAssertions(*d_asserts);
+  smt::Checkpoint cp;
+  cp.d_logic = getLogicInfo().getLogicString();
+  context::CDList<Node>* al = d_asserts->getAssertionList();
+  Assert(al != nullptr);
+  std::unordered_map<Node, Node, NodeHashFunction> cache;
+  for (const Node& a : *al)
+  {
+    cp.d_assertions.push_back(d_pp->expandDefinitions(a, cache));
+  }
+  d_smtSolver->saveCheckpoint(cp, learnedClauses);
+  cp.write(out);
+}
+
+void SmtEngine::restoreCheckpoint(const char* data,
+                                  size_t size,
+                                  std::vector<Node>& symbols,
+                                  std::vector<TypeNode>& sorts)
+{
+  SmtScope smts(this);
+  finishInit();
+  d_state->doPendingPops();
+  Trace("smt") << "SMT restoreCheckpoint()" << endl;
+  if (!options::checkpoints())
+  {
+    throw ModalException(
+        "Cannot restore a checkpoint unless checkpoints are enabled "
+        "(try --checkpoints).");
+  }
+  smt::Checkpoint cp;
+  cp.read(data, size);
+  if (cp.d_logic != getLogicInfo().getLogicString())
+  {
+    std::stringstream ss;
+    ss << "Cannot restore a checkpoint of logic " << cp.d_logic
+       << " in logic " << getLogicInfo().getLogicString() << ".";
+    throw ModalException(ss.str());
+  }
+  // the input assertions are only kept for getting and checking assertions
+  context::CDList<Node>* al = d_asserts->getAssertionList();
+  Assert(al != nullptr);
+  for (const Node& a : cp.d_assertions)
+  {
+    al->push_back(a);
+  }
+  d_smtSolver->restoreCheckpoint(cp);
+  symbols.insert(symbols.end(), cp.d_symbols.begin(), cp.d_symbols.end());
+  sorts.insert(sorts.end(), cp.d_sorts.begin(), cp.d_sorts.end());
+}
+
 void SmtEngine::push()
 {
   SmtScope smts(this);
@@ -1870,6 +1960,12 @@ void SmtEngine::safeFlushStatistics(int fd) const
   d_env->getStatisticsRegistry()->safeFlushInformation(fd);
 }
 
+void SmtEngine::sampleStatistics(
+    std::vector<std::pair<std::string, double>>& values) const
+{
+  d_env->getStatisticsRegistry()->sample(values);
+}
+
 void SmtEngine::setUserAttribute(const std::string& attr,
                                  Node expr,
                                  const std::vector<Node>& expr_values,
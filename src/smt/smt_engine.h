@@ -97,6 +97,7 @@ class SygusSolver;
 class AbductionSolver;
 class InterpolationSolver;
 class QuantElimSolver;
+class StatisticsSampler;
 /**
  * Representation of a defined function.  We keep these around in
  * SmtEngine to permit expanding definitions late (and lazily), to
@@ -256,6 +257,7 @@ class CVC4_EXPORT SmtEngine
   void setResultStatistic(const std::string& result) CVC4_EXPORT;
   /**
    * Helper method for the API to put the total runtime into the statistics.
+   * Also records the current and maximal size of the node pool.
    */
   void setTotalTimeStatistic(double seconds) CVC4_EXPORT;
 
@@ -712,6 +714,34 @@ class CVC4_EXPORT SmtEngine
    */
   std::vector<Node> getAssertions();
 
+  /**
+   * Save a checkpoint of the state of this SmtEngine in the current user
+   * context to out. This first preprocesses the pending assertions, as push
+   * does. The checkpoint contains the assertions, the preprocessed
+   * assertions, the top-level substitutions, the lemmas that are not
+   * removable and, if learnedClauses is true, the clauses learned by the SAT
+   * solver. Only permitted with checkpoints enabled.
+   *
+   * @throw ModalException, or Exception if the assertions contain a term that
+   * cannot be saved
+   */
+  void saveCheckpoint(std::ostream& out, bool learnedClauses);
+
+  /**
+   * Restore the checkpoint in the given buffer, which was saved by an
+   * SmtEngine with the same logic and options, into the current user context.
+   * Its preprocessed assertions are asserted without preprocessing them
+   * again. The free symbols, uninterpreted sorts and datatypes of the
+   * checkpoint are created anew, and added to symbols and sorts. Only
+   * permitted with checkpoints enabled.
+   *
+   * @throw ModalException, or Exception if the data is not a checkpoint
+   */
+  void restoreCheckpoint(const char* data,
+                         size_t size,
+                         std::vector<Node>& symbols,
+                         std::vector<TypeNode>& sorts);
+
   /**
    * Push a user-level context.
    * throw@ ModalException, LogicException, UnsafeInterruptException
@@ -832,6 +862,14 @@ class CVC4_EXPORT SmtEngine
    */
   void safeFlushStatistics(int fd) const;
 
+  /**
+   * Add the name and the current value of each statistic that may be sampled
+   * while solving, i.e., of the counters and timers, to values. Unlike the
+   * other methods of this class, this may be called by another thread.
+   */
+  void sampleStatistics(
+      std::vector<std::pair<std::string, double>>& values) const;
+
   /**
    * Set user attribute.
    * This function is called when an attribute is set by a user.
@@ -1131,6 +1169,8 @@ class CVC4_EXPORT SmtEngine
 
   /** The statistics class */
   std::unique_ptr<smt::SmtEngineStatistics> d_stats;
+  /** Writes samples of the statistics to the file of --stats-export-file */
+  std::unique_ptr<smt::StatisticsSampler> d_statsSampler;
 
   /** the output manager for commands */
   mutable OutputManager d_outMgr;
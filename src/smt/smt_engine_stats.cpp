@@ -33,7 +33,9 @@ SmtEngineStatistics::SmtEngineStatistics()
       d_simplifiedToFalse("smt::SmtEngine::simplifiedToFalse", 0),
       d_driverFilename("driver::filename", ""),
       d_driverResult("driver::sat/unsat", ""),
-      d_driverTotalTime("driver::totalTime", 0.0)
+      d_driverTotalTime("driver::totalTime", 0.0),
+      d_driverNodeValues("driver::nodeValues", 0),
+      d_driverMaxNodeValues("driver::maxNodeValues", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_definitionExpansionTime);
   smtStatisticsRegistry()->registerStat(&d_numConstantProps);
@@ -49,6 +51,8 @@ SmtEngineStatistics::SmtEngineStatistics()
   smtStatisticsRegistry()->registerStat(&d_driverFilename);
   smtStatisticsRegistry()->registerStat(&d_driverResult);
   smtStatisticsRegistry()->registerStat(&d_driverTotalTime);
+  smtStatisticsRegistry()->registerStat(&d_driverNodeValues);
+  smtStatisticsRegistry()->registerStat(&d_driverMaxNodeValues);
 }
 
 SmtEngineStatistics::~SmtEngineStatistics()
@@ -67,6 +71,8 @@ SmtEngineStatistics::~SmtEngineStatistics()
   smtStatisticsRegistry()->unregisterStat(&d_driverFilename);
   smtStatisticsRegistry()->unregisterStat(&d_driverResult);
   smtStatisticsRegistry()->unregisterStat(&d_driverTotalTime);
+  smtStatisticsRegistry()->unregisterStat(&d_driverNodeValues);
+  smtStatisticsRegistry()->unregisterStat(&d_driverMaxNodeValues);
 }
 
 }  // namespace smt
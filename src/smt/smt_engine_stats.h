@@ -57,6 +57,10 @@ struct SmtEngineStatistics
   BackedStat<std::string> d_driverResult;
   /** Total time of the current run */
   BackedStat<double> d_driverTotalTime;
+  /** Number of node values in the node pool at the end of the run */
+  IntStat d_driverNodeValues;
+  /** Maximal number of node values in the node pool during the run */
+  IntStat d_driverMaxNodeValues;
 }; /* struct SmtEngineStatistics */
 
 }  // namespace smt
@@ -17,6 +17,7 @@
 #include "options/smt_options.h"
 #include "prop/prop_engine.h"
 #include "smt/assertions.h"
+#include "smt/checkpoint.h"
 #include "smt/preprocessor.h"
 #include "smt/smt_engine.h"
 #include "smt/smt_engine_state.h"
@@ -272,6 +273,45 @@ void SmtSolver::processAssertions(Assertions& as)
   as.clearCurrent();
 }
 
+void SmtSolver::saveCheckpoint(Checkpoint& cp, bool learnedClauses)
+{
+  d_propEngine->getAssertedFormulas(
+      cp.d_ppAssertions, cp.d_skolemDefs, cp.d_skolems, cp.d_lemmas);
+  d_pp.getTopLevelSubstitutions(cp.d_substs);
+  if (learnedClauses)
+  {
+    d_propEngine->getLearnedClauses(cp.d_learnedClauses);
+  }
+}
+
+void SmtSolver::restoreCheckpoint(const Checkpoint& cp)
+{
+  // the lemmas are asserted like preprocessed assertions, which are notified
+  // to the theory engine, whereas the learned clauses are not
+  std::vector<Node> assertions(cp.d_ppAssertions);
+  assertions.insert(
+      assertions.end(), cp.d_skolemDefs.begin(), cp.d_skolemDefs.end());
+  assertions.insert(assertions.end(), cp.d_lemmas.begin(), cp.d_lemmas.end());
+  d_pp.notifyRestoredAssertions(assertions, cp.d_substs);
+  d_propEngine->notifyPreprocessedAssertions(assertions);
+  for (const Node& a : cp.d_ppAssertions)
+  {
+    d_propEngine->assertFormula(a);
+  }
+  for (size_t i = 0, size = cp.d_skolemDefs.size(); i < size; ++i)
+  {
+    d_propEngine->assertSkolemDefinition(cp.d_skolemDefs[i], cp.d_skolems[i]);
+  }
+  for (const Node& lem : cp.d_lemmas)
+  {
+    d_propEngine->assertCheckpointLemma(lem);
+  }
+  for (const Node& c : cp.d_learnedClauses)
+  {
+    d_propEngine->assertCheckpointLearnedClause(c);
+  }
+}
+
 void SmtSolver::setProofNodeManager(ProofNodeManager* pnm) { d_pnm = pnm; }
 
 TheoryEngine* SmtSolver::getTheoryEngine() { return d_theoryEngine.get(); }
@@ -41,6 +41,7 @@ class QuantifiersEngine;
 namespace smt {
 
 class Assertions;
+struct Checkpoint;
 class SmtEngineState;
 class Preprocessor;
 struct SmtEngineStatistics;
@@ -113,6 +114,19 @@ class SmtSolver
    * into the SMT solver, and clears the buffer.
    */
   void processAssertions(Assertions& as);
+  /**
+   * Add the state of this solver in the current user context to the
+   * checkpoint cp, i.e., the preprocessed assertions, the skolem definitions,
+   * the top-level substitutions and the lemmas that are not removable. If
+   * learnedClauses is true, also add the clauses learned by the SAT solver.
+   * The assertions of the SmtEngine must have been processed.
+   */
+  void saveCheckpoint(Checkpoint& cp, bool learnedClauses);
+  /**
+   * Restore the state of checkpoint cp into the current user context, by
+   * asserting its preprocessed formulas directly to the prop engine.
+   */
+  void restoreCheckpoint(const Checkpoint& cp);
   /**
    * Set proof node manager. Enables proofs in this SmtSolver. Should be
    * called before finishInit.
@@ -0,0 +1,112 @@
+/*********************                                                        */
+/*! \file statistics_sampler.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Periodic export of samples of the statistics to a file
+ **/
+
+#include "smt/statistics_sampler.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "base/exception.h"
+#include "util/statistics_export.h"
+#include "util/statistics_registry.h"
+
+namespace cvc5 {
+namespace smt {
+
+namespace {
+/** The number of samplers created so far in this process */
+std::atomic<uint64_t> s_numSamplers(0);
+
+/**
+ * Get a temporary file next to filename that no other sampler, in this or
+ * another process, writes to.
+ */
+std::string getTmpFilename(const std::string& filename)
+{
+  std::stringstream ss;
+  ss << filename << "." << getpid() << "." << s_numSamplers++ << ".tmp";
+  return ss.str();
+}
+}  // namespace
+
+StatisticsSampler::StatisticsSampler(const StatisticsRegistry& reg,
+                                     const std::string& filename,
+                                     options::StatsExportFormat format,
+                                     uint64_t interval)
+    : d_reg(reg),
+      d_filename(filename),
+      d_tmpFilename(getTmpFilename(filename)),
+      d_format(format),
+      d_interval(interval),
+      d_stop(false)
+{
+  if (!write())
+  {
+    throw Exception("cannot write statistics to `" + filename + "'");
+  }
+  d_thread = std::thread([this]() { run(); });
+}
+
+StatisticsSampler::~StatisticsSampler()
+{
+  {
+    std::lock_guard<std::mutex> guard(d_mutex);
+    d_stop = true;
+  }
+  d_cv.notify_one();
+  d_thread.join();
+  write();
+}
+
+void StatisticsSampler::run()
+{
+  std::unique_lock<std::mutex> lock(d_mutex);
+  while (!d_cv.wait_for(lock, d_interval, [this]() { return d_stop; }))
+  {
+    lock.unlock();
+    // failures are ignored, the file may be written again later
+    write();
+    lock.lock();
+  }
+}
+
+bool StatisticsSampler::write() const
+{
+  std::vector<std::pair<std::string, double>> values;
+  d_reg.sample(values);
+  {
+    std::ofstream out(d_tmpFilename);
+    if (d_format == options::StatsExportFormat::PROMETHEUS)
+    {
+      printStatisticsPrometheus(out, values);
+    }
+    else
+    {
+      printStatisticsJson(out, values);
+    }
+    out.close();
+    if (!out)
+    {
+      return false;
+    }
+  }
+  return std::rename(d_tmpFilename.c_str(), d_filename.c_str()) == 0;
+}
+
+}  // namespace smt
+}  // namespace cvc5
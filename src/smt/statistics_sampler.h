@@ -0,0 +1,82 @@
+/*********************                                                        */
+/*! \file statistics_sampler.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Periodic export of samples of the statistics to a file
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__SMT__STATISTICS_SAMPLER_H
+#define CVC4__SMT__STATISTICS_SAMPLER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "options/base_options.h"
+
+namespace cvc5 {
+
+class StatisticsRegistry;
+
+namespace smt {
+
+/**
+ * Writes a sample of the statistics of a registry (see
+ * StatisticsRegistry::sample()) to a file in a background thread, at a
+ * fixed interval and when it is destroyed. The file is replaced atomically,
+ * by writing the sample to a temporary file next to it first, so that
+ * monitoring tools never read a partial sample.
+ */
+class StatisticsSampler
+{
+ public:
+  /**
+   * Start writing samples of reg in the given format to filename every
+   * interval milliseconds. Throws an Exception if filename cannot be written.
+   */
+  StatisticsSampler(const StatisticsRegistry& reg,
+                    const std::string& filename,
+                    options::StatsExportFormat format,
+                    uint64_t interval);
+  /** Stop the background thread, and write a final sample. */
+  ~StatisticsSampler();
+
+ private:
+  /** The loop of the background thread */
+  void run();
+  /** Write a sample, returns false if the file could not be written */
+  bool write() const;
+
+  /** The sampled registry */
+  const StatisticsRegistry& d_reg;
+  /** The file to write to, and the temporary file next to it */
+  std::string d_filename;
+  std::string d_tmpFilename;
+  /** The format of the samples */
+  options::StatsExportFormat d_format;
+  /** The interval between two samples */
+  std::chrono::milliseconds d_interval;
+  /** Protects d_stop */
+  std::mutex d_mutex;
+  /** Notified when d_stop is set */
+  std::condition_variable d_cv;
+  /** Whether the background thread should stop */
+  bool d_stop;
+  /** The background thread */
+  std::thread d_thread;
+};
+
+}  // namespace smt
+}  // namespace cvc5
+
+#endif /* CVC4__SMT__STATISTICS_SAMPLER_H */
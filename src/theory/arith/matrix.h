@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <queue>
 #include <utility>
 #include <vector>
@@ -207,6 +208,20 @@ public:
   uint32_t size() const{ return d_size; }
   uint32_t capacity() const{ return d_entries.capacity(); }
 
+  /** The number of allocated entries, including the freed ones. */
+  uint32_t numAllocated() const { return d_entries.size(); }
+
+  /**
+   * Replaces all entries by the given entries, which are all in use.
+   * Ids of the previous entries are invalidated.
+   */
+  void reset(EntryArray& entries)
+  {
+    d_entries.swap(entries);
+    d_freedEntries = std::queue<EntryID>();
+    d_size = d_entries.size();
+  }
+
 
 private:
   bool inBounds(EntryID id) const{
@@ -399,6 +414,15 @@ protected:
 
   T d_zero;
 
+  /**
+   * If true, the entries are periodically moved into row-major order
+   * (see compactEntries()).
+   */
+  bool d_compactRows;
+
+  /** The number of entries added since the last compaction. */
+  uint32_t d_entriesAddedSinceCompaction;
+
 public:
   /**
    * Constructs an empty Matrix.
@@ -410,7 +434,9 @@ public:
     d_rowInMergeBuffer(ROW_INDEX_SENTINEL),
     d_entriesInUse(0),
     d_entries(),
-    d_zero(0)
+    d_zero(0),
+    d_compactRows(false),
+    d_entriesAddedSinceCompaction(0)
   {}
 
   Matrix(const T& zero)
@@ -420,7 +446,9 @@ public:
     d_rowInMergeBuffer(ROW_INDEX_SENTINEL),
     d_entriesInUse(0),
     d_entries(),
-    d_zero(zero)
+    d_zero(zero),
+    d_compactRows(false),
+    d_entriesAddedSinceCompaction(0)
   {}
 
   Matrix(const Matrix& m)
@@ -430,7 +458,9 @@ public:
     d_rowInMergeBuffer(m.d_rowInMergeBuffer),
     d_entriesInUse(m.d_entriesInUse),
     d_entries(m.d_entries),
-    d_zero(m.d_zero)
+    d_zero(m.d_zero),
+    d_compactRows(m.d_compactRows),
+    d_entriesAddedSinceCompaction(m.d_entriesAddedSinceCompaction)
   {
     d_columns.clear();
     for(typename ColumnTable::const_iterator c=m.d_columns.begin(), cend = m.d_columns.end(); c!=cend; ++c){
@@ -450,6 +480,8 @@ public:
     d_entriesInUse = (m.d_entriesInUse);
     d_entries = (m.d_entries);
     d_zero = (m.d_zero);
+    d_compactRows = m.d_compactRows;
+    d_entriesAddedSinceCompaction = m.d_entriesAddedSinceCompaction;
     d_columns.clear();
     for(typename ColumnTable::const_iterator c=m.d_columns.begin(), cend = m.d_columns.end(); c!=cend; ++c){
       const ColumnVector<T>& col = *c;
@@ -479,11 +511,76 @@ protected:
     Assert(newEntry.getCoefficient() != 0);
 
     ++d_entriesInUse;
+    ++d_entriesAddedSinceCompaction;
 
     d_rows[row].insert(newId);
     d_columns[col].insert(newId);
   }
 
+  /**
+   * Moves the entries into row-major order: the entries of each row are
+   * stored contiguously, in the order of the rows and of the row lists, and
+   * freed entries are released. This is the layout of a compressed sparse row
+   * matrix, the column lists act as the column index into it. The order of
+   * the row and column lists is preserved, hence traversals are unchanged.
+   *
+   * All entry ids and references to entries are invalidated, so this must
+   * not be called while a row is in the merge buffer.
+   */
+  void compactEntries()
+  {
+    Assert(d_rowInMergeBuffer == ROW_INDEX_SENTINEL);
+    Assert(d_mergeBuffer.empty());
+
+    std::vector<EntryID> renaming(d_entries.numAllocated(), ENTRYID_SENTINEL);
+    std::vector<Entry> compacted;
+    compacted.reserve(d_entriesInUse);
+    for (const RowVectorT& row : d_rows)
+    {
+      for (RowIterator i = row.begin(); !i.atEnd(); ++i)
+      {
+        renaming[i.getID()] = compacted.size();
+        compacted.push_back(std::move(d_entries.get(i.getID())));
+      }
+    }
+    Assert(compacted.size() == d_entriesInUse);
+
+    auto rename = [&renaming](EntryID id) {
+      return id == ENTRYID_SENTINEL ? id : renaming[id];
+    };
+    for (Entry& e : compacted)
+    {
+      e.setNextRowEntryID(rename(e.getNextRowEntryID()));
+      e.setPrevRowEntryID(rename(e.getPrevRowEntryID()));
+      e.setNextColEntryID(rename(e.getNextColEntryID()));
+      e.setPrevColEntryID(rename(e.getPrevColEntryID()));
+    }
+    for (RowVectorT& row : d_rows)
+    {
+      row = RowVectorT(rename(row.getHead()), row.getSize(), &d_entries);
+    }
+    for (ColumnVectorT& col : d_columns)
+    {
+      col = ColumnVectorT(rename(col.getHead()), col.getSize(), &d_entries);
+    }
+    d_entries.reset(compacted);
+    d_entriesAddedSinceCompaction = 0;
+  }
+
+  /**
+   * Calls compactEntries() if row compaction is enabled and at least as many
+   * entries have been added since the last compaction as there are entries in
+   * use. The cost of compacting is thereby amortized over the additions.
+   */
+  void compactEntriesIfFragmented()
+  {
+    if (d_compactRows
+        && d_entriesAddedSinceCompaction >= std::max(d_entriesInUse, 1024u))
+    {
+      compactEntries();
+    }
+  }
+
   void removeEntry(EntryID id){
     Assert(d_entriesInUse > 0);
     --d_entriesInUse;
@@ -527,6 +624,9 @@ public:
     return d_rows.size();
   }
 
+  /** Enables or disables the periodic compaction into row-major order. */
+  void setCompactRows(bool compact) { d_compactRows = compact; }
+
   size_t getNumColumns() const {
     return d_columns.size();
   }
@@ -62,6 +62,8 @@ void Tableau::pivot(ArithVar oldBasic, ArithVar newBasic, CoefficientChangeCallb
   Assert(!isBasic(oldBasic));
   Assert(isBasic(newBasic));
   Assert(getColLength(newBasic) == 1);
+
+  compactEntriesIfFragmented();
 }
 
 /**
@@ -143,6 +145,8 @@ void Tableau::addRow(ArithVar basic,
   Assert(debugNoZeroCoefficients(newRow));
   Assert(debugMatchingCountsForRow(newRow));
   Assert(getColLength(basic) == 1);
+
+  compactEntriesIfFragmented();
 }
 
 void Tableau::removeBasicRow(ArithVar basic){
@@ -21,6 +21,7 @@
 
 #include <vector>
 
+#include "options/arith_options.h"
 #include "theory/arith/arithvar.h"
 #include "theory/arith/matrix.h"
 #include "util/dense_map.h"
@@ -50,7 +51,11 @@ private:
 
 public:
 
-  Tableau() : Matrix<Rational>(Rational(0)) {}
+  Tableau() : Matrix<Rational>(Rational(0))
+  {
+    setCompactRows(options::arithTableauLayout()
+                   == options::ArithTableauLayout::CSR);
+  }
 
   typedef Matrix<Rational>::ColIterator ColIterator;
   typedef Matrix<Rational>::RowIterator RowIterator;
@@ -0,0 +1,230 @@
+/*********************                                                        */
+/*! \file aig.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A lightweight and-inverter graph.
+ **/
+
+#include "theory/bv/bitblast/aig.h"
+
+#include <utility>
+
+namespace cvc5 {
+namespace theory {
+namespace bv {
+
+Aig::Aig() : d_numInputs(0), d_numRewrites(0), d_numHashHits(0)
+{
+  // id 0 is reserved for the constants
+  d_nodes.push_back(AigNode{0, 0, 0});
+}
+
+AigEdge Aig::mkInput()
+{
+  uint32_t id = d_nodes.size();
+  d_nodes.push_back(AigNode{0, 0, 0});
+  ++d_numInputs;
+  return AigEdge(this, id << 1);
+}
+
+AigEdge Aig::mkAnd(AigEdge a, AigEdge b)
+{
+  if (a.isFalse() || b.isFalse())
+  {
+    return AigEdge::mkConst(false);
+  }
+  if (a.isTrue())
+  {
+    return b;
+  }
+  if (b.isTrue())
+  {
+    return a;
+  }
+  Assert(a.getAig() == b.getAig());
+  return a.getAig()->mkAndRec(a, b);
+}
+
+AigEdge Aig::mkXor(AigEdge a, AigEdge b)
+{
+  if (a.isConst())
+  {
+    return a.isTrue() ? ~b : b;
+  }
+  if (b.isConst())
+  {
+    return b.isTrue() ? ~a : a;
+  }
+  return mkOr(mkAnd(a, ~b), mkAnd(~a, b));
+}
+
+AigEdge Aig::mkIte(AigEdge cond, AigEdge a, AigEdge b)
+{
+  if (cond.isConst())
+  {
+    return cond.isTrue() ? a : b;
+  }
+  if (a == b)
+  {
+    return a;
+  }
+  return mkOr(mkAnd(cond, a), mkAnd(~cond, b));
+}
+
+AigEdge Aig::mkAndRec(AigEdge a, AigEdge b)
+{
+  // level one: idempotence and contradiction
+  if (a == b)
+  {
+    return a;
+  }
+  if (a == ~b)
+  {
+    return AigEdge::mkConst(false);
+  }
+  if (a.getLit() > b.getLit())
+  {
+    std::swap(a, b);
+  }
+
+  // level two, the rules are applied with the roles of a and b swapped, such
+  // that x is an AND gate (possibly negated) and y is the other operand
+  for (int i = 0; i < 2; ++i)
+  {
+    AigEdge x = i == 0 ? a : b;
+    AigEdge y = i == 0 ? b : a;
+    if (x.isConst() || isInput(x.getId()))
+    {
+      continue;
+    }
+    AigEdge x0 = getChild0(x.getId());
+    AigEdge x1 = getChild1(x.getId());
+    if (!x.isNegated())
+    {
+      // contradiction: (x0 & x1) & ~x0 = false
+      if (y == ~x0 || y == ~x1)
+      {
+        ++d_numRewrites;
+        return AigEdge::mkConst(false);
+      }
+      // idempotence: (x0 & x1) & x0 = x0 & x1
+      if (y == x0 || y == x1)
+      {
+        ++d_numRewrites;
+        return x;
+      }
+      if (!isInput(y.getId()))
+      {
+        AigEdge y0 = getChild0(y.getId());
+        AigEdge y1 = getChild1(y.getId());
+        if (!y.isNegated())
+        {
+          // contradiction: (x0 & x1) & (~x0 & y1) = false
+          if (y0 == ~x0 || y0 == ~x1 || y1 == ~x0 || y1 == ~x1)
+          {
+            ++d_numRewrites;
+            return AigEdge::mkConst(false);
+          }
+          // idempotence: (x0 & x1) & (x0 & y1) = (x0 & x1) & y1
+          if (y0 == x0 || y0 == x1)
+          {
+            ++d_numRewrites;
+            return mkAndRec(x, y1);
+          }
+          if (y1 == x0 || y1 == x1)
+          {
+            ++d_numRewrites;
+            return mkAndRec(x, y0);
+          }
+        }
+        else
+        {
+          // subsumption: (x0 & x1) & ~(~x0 & y1) = x0 & x1
+          if (y0 == ~x0 || y0 == ~x1 || y1 == ~x0 || y1 == ~x1)
+          {
+            ++d_numRewrites;
+            return x;
+          }
+          // substitution: (x0 & x1) & ~(x0 & y1) = (x0 & x1) & ~y1
+          if (y0 == x0 || y0 == x1)
+          {
+            ++d_numRewrites;
+            return mkAndRec(x, ~y1);
+          }
+          if (y1 == x0 || y1 == x1)
+          {
+            ++d_numRewrites;
+            return mkAndRec(x, ~y0);
+          }
+        }
+      }
+    }
+    else
+    {
+      // subsumption: ~(x0 & x1) & ~x0 = ~x0
+      if (y == ~x0 || y == ~x1)
+      {
+        ++d_numRewrites;
+        return y;
+      }
+      // substitution: ~(x0 & x1) & x0 = x0 & ~x1
+      if (y == x0)
+      {
+        ++d_numRewrites;
+        return mkAndRec(y, ~x1);
+      }
+      if (y == x1)
+      {
+        ++d_numRewrites;
+        return mkAndRec(y, ~x0);
+      }
+      if (y.isNegated() && !isInput(y.getId()))
+      {
+        // resolution: ~(x0 & x1) & ~(x0 & ~x1) = ~x0
+        AigEdge y0 = getChild0(y.getId());
+        AigEdge y1 = getChild1(y.getId());
+        if ((y0 == x0 && y1 == ~x1) || (y1 == x0 && y0 == ~x1))
+        {
+          ++d_numRewrites;
+          return ~x0;
+        }
+        if ((y0 == x1 && y1 == ~x0) || (y1 == x1 && y0 == ~x0))
+        {
+          ++d_numRewrites;
+          return ~x1;
+        }
+      }
+    }
+  }
+  return lookupOrCreate(a, b);
+}
+
+AigEdge Aig::lookupOrCreate(AigEdge a, AigEdge b)
+{
+  if (a.getLit() > b.getLit())
+  {
+    std::swap(a, b);
+  }
+  uint64_t key = (static_cast<uint64_t>(a.getLit()) << 32) | b.getLit();
+  auto it = d_unique.find(key);
+  if (it != d_unique.end())
+  {
+    ++d_numHashHits;
+    return AigEdge(this, it->second << 1);
+  }
+  uint32_t id = d_nodes.size();
+  d_nodes.push_back(AigNode{a.getLit(), b.getLit(), 0});
+  ++d_nodes[a.getId()].d_parents;
+  ++d_nodes[b.getId()].d_parents;
+  d_unique.emplace(key, id);
+  return AigEdge(this, id << 1);
+}
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,175 @@
+/*********************                                                        */
+/*! \file aig.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A lightweight and-inverter graph.
+ **
+ ** A lightweight and-inverter graph (AIG) with structural hashing and local
+ ** two-level rewriting, used by the native AIG bit-blaster.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__BV__BITBLAST__AIG_H
+#define CVC4__THEORY__BV__BITBLAST__AIG_H
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "base/check.h"
+
+namespace cvc5 {
+namespace theory {
+namespace bv {
+
+class Aig;
+
+/**
+ * An edge of an AIG, i.e., a possibly negated node. The constants true and
+ * false do not belong to any AIG, such that they can be created without
+ * one (see mkTrue<AigEdge>()).
+ */
+class AigEdge
+{
+ public:
+  /** The constant false. */
+  AigEdge() : d_aig(nullptr), d_lit(0) {}
+
+  static AigEdge mkConst(bool value) { return AigEdge(nullptr, value); }
+
+  bool isConst() const { return d_aig == nullptr; }
+  bool isTrue() const { return isConst() && d_lit == 1; }
+  bool isFalse() const { return isConst() && d_lit == 0; }
+  bool isNegated() const { return d_lit & 1; }
+  /** The id of the node of this edge, 0 for the constants. */
+  uint32_t getId() const { return d_lit >> 1; }
+  /** The id of the node shifted left by one, plus one if negated. */
+  uint32_t getLit() const { return d_lit; }
+  Aig* getAig() const { return d_aig; }
+
+  /** The edge to the same node with the negation flipped. */
+  AigEdge operator~() const { return AigEdge(d_aig, d_lit ^ 1); }
+  /** The edge to the same node without negation. */
+  AigEdge regular() const { return AigEdge(d_aig, d_lit & ~1u); }
+
+  bool operator==(const AigEdge& other) const
+  {
+    return d_aig == other.d_aig && d_lit == other.d_lit;
+  }
+  bool operator!=(const AigEdge& other) const { return !(*this == other); }
+
+ private:
+  friend class Aig;
+  AigEdge(Aig* aig, uint32_t lit) : d_aig(aig), d_lit(lit) {}
+
+  Aig* d_aig;
+  uint32_t d_lit;
+};
+
+/**
+ * An and-inverter graph. Nodes are inputs or two-input AND gates, edges may
+ * be negated. AND gates are structurally hashed and simplified on creation
+ * by the local two-level rewriting rules of
+ *
+ *   R. Brummayer, A. Biere: Local Two-Level And-Inverter Graph Minimization
+ *   without Blowup. MEMICS 2006.
+ *
+ * Nodes are never deleted, ids are consecutive and children always have
+ * smaller ids than their parents.
+ */
+class Aig
+{
+ public:
+  Aig();
+
+  /** Create a new input. */
+  AigEdge mkInput();
+
+  /**
+   * Create the conjunction of a and b. At most one of a and b may be a
+   * constant without an AIG, otherwise both must belong to the same AIG.
+   */
+  static AigEdge mkAnd(AigEdge a, AigEdge b);
+  static AigEdge mkOr(AigEdge a, AigEdge b) { return ~mkAnd(~a, ~b); }
+  static AigEdge mkXor(AigEdge a, AigEdge b);
+  static AigEdge mkIff(AigEdge a, AigEdge b) { return ~mkXor(a, b); }
+  static AigEdge mkIte(AigEdge cond, AigEdge a, AigEdge b);
+
+  /** Is the node with the given id an input? */
+  bool isInput(uint32_t id) const
+  {
+    Assert(id < d_nodes.size());
+    return d_nodes[id].d_child0 == 0;
+  }
+  /** The children of the AND gate with the given id. */
+  AigEdge getChild0(uint32_t id) const
+  {
+    Assert(!isInput(id));
+    return AigEdge(const_cast<Aig*>(this), d_nodes[id].d_child0);
+  }
+  AigEdge getChild1(uint32_t id) const
+  {
+    Assert(!isInput(id));
+    return AigEdge(const_cast<Aig*>(this), d_nodes[id].d_child1);
+  }
+  /** The number of AND gates that have the node with the given id as child. */
+  uint32_t getNumParents(uint32_t id) const
+  {
+    Assert(id < d_nodes.size());
+    return d_nodes[id].d_parents;
+  }
+
+  /** The number of nodes, including the unused node with id 0. */
+  size_t getNumNodes() const { return d_nodes.size(); }
+  size_t getNumInputs() const { return d_numInputs; }
+  size_t getNumAnds() const { return d_nodes.size() - d_numInputs - 1; }
+  /** The number of AND gates that were simplified away by rewriting. */
+  uint64_t getNumRewrites() const { return d_numRewrites; }
+  /** The number of AND gates that were found in the unique table. */
+  uint64_t getNumHashHits() const { return d_numHashHits; }
+
+ private:
+  struct AigNode
+  {
+    /** The literals of the children, 0 for inputs. */
+    uint32_t d_child0;
+    uint32_t d_child1;
+    uint32_t d_parents;
+  };
+
+  /**
+   * Rewrite and hash the conjunction of a and b, which belong to this AIG.
+   */
+  AigEdge mkAndRec(AigEdge a, AigEdge b);
+  /** Create or look up the AND gate of a and b, without rewriting. */
+  AigEdge lookupOrCreate(AigEdge a, AigEdge b);
+
+  std::vector<AigNode> d_nodes;
+  /** The unique table, maps the pair of child literals to the gate id. */
+  std::unordered_map<uint64_t, uint32_t> d_unique;
+  size_t d_numInputs;
+  uint64_t d_numRewrites;
+  uint64_t d_numHashHits;
+}; /* class Aig */
+
+struct AigEdgeHashFunction
+{
+  size_t operator()(const AigEdge& e) const
+  {
+    return std::hash<uint32_t>()(e.getLit())
+           ^ std::hash<const void*>()(e.getAig());
+  }
+};
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__BV__BITBLAST__AIG_H */
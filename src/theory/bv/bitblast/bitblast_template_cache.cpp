@@ -0,0 +1,465 @@
+/*********************                                                        */
+/*! \file bitblast_template_cache.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A persistent cache of bit-blasting templates.
+ **/
+
+#include "theory/bv/bitblast/bitblast_template_cache.h"
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+
+#include "base/output.h"
+#include "theory/bv/bitblast/simple_bitblaster.h"
+#include "theory/bv/theory_bv_utils.h"
+
+namespace cvc5 {
+namespace theory {
+namespace bv {
+
+namespace {
+
+/** The name of an operator that has templates in the template file. */
+const char* toOpName(Kind k)
+{
+  switch (k)
+  {
+    case kind::BITVECTOR_MULT: return "bvmul";
+    case kind::BITVECTOR_UDIV: return "bvudiv";
+    case kind::BITVECTOR_UREM: return "bvurem";
+    default: return nullptr;
+  }
+}
+
+/** The name of a gate in the template file. */
+const char* toGateName(Kind k)
+{
+  switch (k)
+  {
+    case kind::NOT: return "not";
+    case kind::AND: return "and";
+    case kind::OR: return "or";
+    case kind::XOR: return "xor";
+    case kind::EQUAL: return "=";
+    case kind::ITE: return "ite";
+    default: return nullptr;
+  }
+}
+
+/** The operator or gate with the given name, UNDEFINED_KIND if none. */
+Kind fromName(const std::string& name, const char* (*toName)(Kind))
+{
+  for (Kind k : {kind::BITVECTOR_MULT,
+                 kind::BITVECTOR_UDIV,
+                 kind::BITVECTOR_UREM,
+                 kind::NOT,
+                 kind::AND,
+                 kind::OR,
+                 kind::XOR,
+                 kind::EQUAL,
+                 kind::ITE})
+  {
+    const char* n = toName(k);
+    if (n != nullptr && name == n)
+    {
+      return k;
+    }
+  }
+  return kind::UNDEFINED_KIND;
+}
+
+/** Is the number of operands valid for a term of operator k? */
+bool isValidOpArity(Kind k, unsigned n)
+{
+  switch (k)
+  {
+    case kind::BITVECTOR_UDIV:
+    case kind::BITVECTOR_UREM: return n == 2;
+    default: return n >= 2;
+  }
+}
+
+/** Is the number of children valid for a gate of kind k? */
+bool isValidArity(Kind k, size_t n)
+{
+  switch (k)
+  {
+    case kind::NOT: return n == 1;
+    case kind::XOR:
+    case kind::EQUAL: return n == 2;
+    case kind::ITE: return n == 3;
+    default: return n >= 2;
+  }
+}
+
+}  // namespace
+
+BitblastTemplate::BitblastTemplate()
+    : BitblastTemplate(kind::UNDEFINED_KIND, 0, 0)
+{
+}
+
+BitblastTemplate::BitblastTemplate(Kind k, unsigned width, unsigned arity)
+    : d_kind(k), d_width(width), d_arity(arity), d_numInputs(width * arity)
+{
+}
+
+bool BitblastTemplate::compile(const std::vector<Node>& inputs,
+                               const std::vector<Node>& outputs)
+{
+  Assert(inputs.size() == d_numInputs);
+  Assert(outputs.size() == d_width);
+  d_gates.clear();
+  d_outputs.clear();
+
+  std::unordered_map<TNode, uint32_t, TNodeHashFunction> values;
+  for (uint32_t i = 0; i < d_numInputs; ++i)
+  {
+    Assert(values.find(inputs[i]) == values.end());
+    values[inputs[i]] = i + 2;
+  }
+  // compute the gates in post-order
+  std::vector<std::pair<TNode, bool>> visit;
+  for (const Node& out : outputs)
+  {
+    visit.emplace_back(out, false);
+  }
+  while (!visit.empty())
+  {
+    TNode cur = visit.back().first;
+    bool childrenDone = visit.back().second;
+    visit.pop_back();
+    if (values.find(cur) != values.end())
+    {
+      continue;
+    }
+    if (cur.getKind() == kind::CONST_BOOLEAN)
+    {
+      values[cur] = cur.getConst<bool>() ? 1 : 0;
+      continue;
+    }
+    if (toGateName(cur.getKind()) == nullptr)
+    {
+      Trace("bv-bitblast-templates")
+          << "no template for gate " << cur.getKind() << std::endl;
+      return false;
+    }
+    if (!childrenDone)
+    {
+      visit.emplace_back(cur, true);
+      for (const Node& child : cur)
+      {
+        visit.emplace_back(child, false);
+      }
+      continue;
+    }
+    Gate gate{cur.getKind(), {}};
+    for (const Node& child : cur)
+    {
+      Assert(values.find(child) != values.end());
+      gate.d_children.push_back(values[child]);
+    }
+    values[cur] = d_numInputs + 2 + d_gates.size();
+    d_gates.push_back(gate);
+  }
+  for (const Node& out : outputs)
+  {
+    d_outputs.push_back(values[out]);
+  }
+  return true;
+}
+
+void BitblastTemplate::instantiate(const std::vector<Node>& inputs,
+                                   std::vector<Node>& bits) const
+{
+  Assert(inputs.size() == d_numInputs);
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<Node> values;
+  values.reserve(d_numInputs + 2 + d_gates.size());
+  values.push_back(nm->mkConst(false));
+  values.push_back(nm->mkConst(true));
+  values.insert(values.end(), inputs.begin(), inputs.end());
+  std::vector<Node> children;
+  for (const Gate& gate : d_gates)
+  {
+    children.clear();
+    for (uint32_t child : gate.d_children)
+    {
+      children.push_back(values[child]);
+    }
+    values.push_back(nm->mkNode(gate.d_kind, children));
+  }
+  for (uint32_t out : d_outputs)
+  {
+    bits.push_back(values[out]);
+  }
+}
+
+void BitblastTemplate::write(std::ostream& out) const
+{
+  out << toOpName(d_kind) << " " << d_width << " " << d_arity << " "
+      << d_gates.size() << "\n";
+  for (const Gate& gate : d_gates)
+  {
+    out << toGateName(gate.d_kind);
+    for (uint32_t child : gate.d_children)
+    {
+      out << " " << child;
+    }
+    out << "\n";
+  }
+  for (uint32_t i = 0; i < d_outputs.size(); ++i)
+  {
+    out << (i == 0 ? "" : " ") << d_outputs[i];
+  }
+  out << "\n";
+}
+
+bool BitblastTemplate::read(std::istream& in)
+{
+  std::string name;
+  size_t numGates;
+  if (!(in >> name >> d_width >> d_arity >> numGates))
+  {
+    return false;
+  }
+  d_kind = fromName(name, toOpName);
+  // the number of input bits must fit into the value numbers
+  if (d_kind == kind::UNDEFINED_KIND || d_width == 0
+      || !isValidOpArity(d_kind, d_arity)
+      || d_arity > (UINT32_MAX - 2) / d_width)
+  {
+    return false;
+  }
+  d_numInputs = d_width * d_arity;
+  d_gates.clear();
+  d_outputs.clear();
+  // each gate is on its own line, and may only refer to earlier values
+  uint32_t numValues = d_numInputs + 2;
+  std::string line;
+  std::getline(in, line);
+  for (size_t i = 0; i < numGates; ++i, ++numValues)
+  {
+    if (!std::getline(in, line))
+    {
+      return false;
+    }
+    std::istringstream ls(line);
+    Gate gate{kind::UNDEFINED_KIND, {}};
+    ls >> name;
+    gate.d_kind = fromName(name, toGateName);
+    uint32_t child;
+    while (ls >> child)
+    {
+      if (child >= numValues)
+      {
+        return false;
+      }
+      gate.d_children.push_back(child);
+    }
+    if (gate.d_kind == kind::UNDEFINED_KIND
+        || !isValidArity(gate.d_kind, gate.d_children.size()))
+    {
+      return false;
+    }
+    d_gates.push_back(gate);
+  }
+  for (unsigned i = 0; i < d_width; ++i)
+  {
+    uint32_t out;
+    if (!(in >> out) || out >= numValues)
+    {
+      return false;
+    }
+    d_outputs.push_back(out);
+  }
+  return true;
+}
+
+BitblastTemplateCache* BitblastTemplateCache::get(const std::string& file)
+{
+  static BitblastTemplateCache cache;
+  if (!file.empty())
+  {
+    std::lock_guard<std::mutex> guard(cache.d_mutex);
+    if (cache.d_file.empty())
+    {
+      cache.d_file = file;
+      cache.load();
+    }
+  }
+  return &cache;
+}
+
+bool BitblastTemplateCache::bbTerm(TNode node,
+                                   TBitblaster<Node>* bb,
+                                   std::vector<Node>& bits)
+{
+  if (toOpName(node.getKind()) == nullptr)
+  {
+    return false;
+  }
+  std::shared_ptr<const BitblastTemplate> t = getTemplate(
+      node.getKind(), utils::getSize(node), node.getNumChildren());
+  if (t == nullptr)
+  {
+    return false;
+  }
+  std::vector<Node> inputs;
+  for (const Node& child : node)
+  {
+    std::vector<Node> childBits;
+    bb->bbTerm(child, childBits);
+    inputs.insert(inputs.end(), childBits.begin(), childBits.end());
+  }
+  t->instantiate(inputs, bits);
+  return true;
+}
+
+std::shared_ptr<const BitblastTemplate> BitblastTemplateCache::getTemplate(
+    Kind k, unsigned width, unsigned arity)
+{
+  Key key(k, width, arity);
+  {
+    std::lock_guard<std::mutex> guard(d_mutex);
+    auto it = d_templates.find(key);
+    if (it != d_templates.end())
+    {
+      return it->second;
+    }
+  }
+  // create the template without holding the lock, if another thread created
+  // it in the meantime, its template is used
+  std::shared_ptr<const BitblastTemplate> t = mkTemplate(k, width, arity);
+  std::lock_guard<std::mutex> guard(d_mutex);
+  auto res = d_templates.emplace(key, t);
+  if (res.second && t != nullptr && !d_file.empty())
+  {
+    save();
+  }
+  return res.first->second;
+}
+
+std::shared_ptr<const BitblastTemplate> BitblastTemplateCache::mkTemplate(
+    Kind k, unsigned width, unsigned arity)
+{
+  Trace("bv-bitblast-templates") << "create template for " << toOpName(k)
+                                 << " " << width << " " << arity << std::endl;
+  NodeManager* nm = NodeManager::currentNM();
+  TypeNode type = nm->mkBitVectorType(width);
+  std::vector<Node> operands;
+  std::vector<Node> inputs;
+  for (unsigned i = 0; i < arity; ++i)
+  {
+    Node op = nm->mkSkolem("bbt", type, "operand of a bit-blasting template");
+    operands.push_back(op);
+    for (unsigned j = 0; j < width; ++j)
+    {
+      inputs.push_back(utils::mkBitOf(op, j));
+    }
+  }
+  Node node = nm->mkNode(k, operands);
+
+  // bit-blast with the default strategies of a fresh bit-blaster, which
+  // bit-blasts the operands to the inputs
+  BBSimple bb(nullptr);
+  std::vector<Node> bits;
+  switch (k)
+  {
+    case kind::BITVECTOR_MULT: DefaultMultBB<Node>(node, bits, &bb); break;
+    case kind::BITVECTOR_UDIV: DefaultUdivBB<Node>(node, bits, &bb); break;
+    case kind::BITVECTOR_UREM: DefaultUremBB<Node>(node, bits, &bb); break;
+    default: Unreachable();
+  }
+
+  auto t = std::make_shared<BitblastTemplate>(k, width, arity);
+  if (!t->compile(inputs, bits))
+  {
+    return nullptr;
+  }
+  return t;
+}
+
+void BitblastTemplateCache::load()
+{
+  std::ifstream in(d_file);
+  if (!in)
+  {
+    // the file is created when the first template is saved
+    return;
+  }
+  size_t numLoaded = 0;
+  size_t numSkipped = 0;
+  std::string line;
+  while (in >> std::ws && in.peek() != EOF)
+  {
+    std::streampos start = in.tellg();
+    auto t = std::make_shared<BitblastTemplate>();
+    if (!t->read(in))
+    {
+      // skip the first line of the invalid record, the next record starts
+      // at a later line
+      in.clear();
+      in.seekg(start);
+      std::getline(in, line);
+      ++numSkipped;
+      continue;
+    }
+    // templates of this process take precedence, they are equivalent
+    d_templates.emplace(Key(t->getKind(), t->getWidth(), t->getArity()), t);
+    ++numLoaded;
+  }
+  if (numSkipped > 0)
+  {
+    Warning() << "ignoring " << numSkipped
+              << " invalid lines of the bit-blasting template file " << d_file
+              << std::endl;
+  }
+  Trace("bv-bitblast-templates")
+      << "loaded " << numLoaded << " templates from " << d_file << std::endl;
+}
+
+void BitblastTemplateCache::save()
+{
+  // merge the templates other processes saved since the file was loaded, and
+  // replace the file by all templates, such that concurrent writers do not
+  // interleave and invalid or duplicate records do not accumulate
+  load();
+  std::stringstream tmpFile;
+  tmpFile << d_file << "." << getpid() << ".tmp";
+  {
+    std::ofstream out(tmpFile.str());
+    for (const std::pair<const Key, std::shared_ptr<const BitblastTemplate>>&
+             t : d_templates)
+    {
+      if (t.second != nullptr)
+      {
+        t.second->write(out);
+      }
+    }
+    out.close();
+    if (out && std::rename(tmpFile.str().c_str(), d_file.c_str()) == 0)
+    {
+      return;
+    }
+  }
+  std::remove(tmpFile.str().c_str());
+  Warning() << "cannot write bit-blasting template file " << d_file
+            << std::endl;
+}
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,158 @@
+/*********************                                                        */
+/*! \file bitblast_template_cache.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A persistent cache of bit-blasting templates.
+ **
+ ** A process-wide cache of the bit-blasted forms of multiplications,
+ ** divisions and remainders per bit-width, which can be saved to and loaded
+ ** from a file (see --bv-bitblast-templates).
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__BV__BITBLAST__BITBLAST_TEMPLATE_CACHE_H
+#define CVC4__THEORY__BV__BITBLAST__BITBLAST_TEMPLATE_CACHE_H
+
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "expr/kind.h"
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace theory {
+namespace bv {
+
+template <class T>
+class TBitblaster;
+
+/**
+ * A bit-blasting template: the bit-blasted form of a term with a given
+ * operator, bit-width and number of operands, as a straight-line program of
+ * Boolean gates over the bits of the operands.
+ *
+ * Values of the program are numbered: 0 and 1 are the constants false and
+ * true, 2 to 2 + n - 1 are the n operand bits (the bits of the first operand
+ * from least to most significant, then those of the second operand, etc.),
+ * and the following values are the results of the gates, in order.
+ */
+class BitblastTemplate
+{
+ public:
+  BitblastTemplate();
+  BitblastTemplate(Kind k, unsigned width, unsigned arity);
+
+  Kind getKind() const { return d_kind; }
+  unsigned getWidth() const { return d_width; }
+  unsigned getArity() const { return d_arity; }
+
+  /**
+   * Create the program that computes the bits 'outputs' from the operand bits
+   * 'inputs', which must be pairwise distinct and must not occur in other
+   * positions of the circuit. Returns false if the circuit contains
+   * operators other than NOT, AND, OR, XOR, EQUAL and ITE.
+   */
+  bool compile(const std::vector<Node>& inputs,
+               const std::vector<Node>& outputs);
+  /** Compute the output bits 'bits' of the program for the operand bits. */
+  void instantiate(const std::vector<Node>& inputs,
+                   std::vector<Node>& bits) const;
+
+  /** Write this template to out, in the format read by read(). */
+  void write(std::ostream& out) const;
+  /**
+   * Read a template written by write() from in. Returns false if in does not
+   * start with a valid template, e.g., if its number of operands does not
+   * match its operator.
+   */
+  bool read(std::istream& in);
+
+ private:
+  struct Gate
+  {
+    Kind d_kind;
+    std::vector<uint32_t> d_children;
+  };
+  Kind d_kind;
+  unsigned d_width;
+  unsigned d_arity;
+  uint32_t d_numInputs;
+  std::vector<Gate> d_gates;
+  std::vector<uint32_t> d_outputs;
+};
+
+/**
+ * The process-wide cache of bit-blasting templates of multiplications,
+ * divisions and remainders. A template is created by bit-blasting a term of
+ * the given operator and width over fresh operands the first time it is
+ * needed, and every further term of the same operator and width (in any
+ * solver instance of the process) is bit-blasted by instantiating the
+ * template with the bits of its operands.
+ *
+ * If a template file is given, the cache is initialized with the templates
+ * of the file, and the file is rewritten with all templates when a new one
+ * is created, such that they persist across processes.
+ */
+class BitblastTemplateCache
+{
+ public:
+  /**
+   * Get the cache. The templates of 'file' are loaded the first time a
+   * non-empty file is given.
+   */
+  static BitblastTemplateCache* get(const std::string& file);
+
+  /**
+   * Bit-blast node with the template of its operator and width, using bb to
+   * bit-blast its operands. Returns false and leaves bits unchanged if node
+   * is not a multiplication, division or remainder.
+   */
+  bool bbTerm(TNode node, TBitblaster<Node>* bb, std::vector<Node>& bits);
+
+ private:
+  using Key = std::tuple<Kind, unsigned, unsigned>;
+
+  BitblastTemplateCache() = default;
+
+  /** Get the template for the given key, or null if it has none. */
+  std::shared_ptr<const BitblastTemplate> getTemplate(Kind k,
+                                                      unsigned width,
+                                                      unsigned arity);
+  /** Bit-blast a term of the given key over fresh operands. */
+  static std::shared_ptr<const BitblastTemplate> mkTemplate(Kind k,
+                                                            unsigned width,
+                                                            unsigned arity);
+  /**
+   * Load the templates of d_file that are valid and not in the cache yet, must
+   * be called with d_mutex locked.
+   */
+  void load();
+  /**
+   * Atomically replace d_file by the templates of the cache and of d_file,
+   * must be called with d_mutex locked.
+   */
+  void save();
+
+  std::mutex d_mutex;
+  /** The templates, null for keys that have no template. */
+  std::map<Key, std::shared_ptr<const BitblastTemplate>> d_templates;
+  /** The template file, empty if templates are not persisted. */
+  std::string d_file;
+};
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__BV__BITBLAST__BITBLAST_TEMPLATE_CACHE_H */
@@ -23,6 +23,8 @@
 #include "prop/sat_solver_factory.h"
 #include "smt/smt_engine.h"
 #include "smt/smt_statistics_registry.h"
+#include "theory/bv/bitblast/bitblast_template_cache.h"
+#include "theory/bv/bitblast/native_aig_bitblaster.h"
 #include "theory/bv/bv_solver_lazy.h"
 #include "theory/bv/theory_bv.h"
 #include "theory/theory_model.h"
@@ -36,6 +38,11 @@ EagerBitblaster::EagerBitblaster(BVSolverLazy* theory_bv, context::Context* c)
       d_context(c),
       d_satSolver(),
       d_bitblastingRegistrar(new BitblastingRegistrar(this)),
+      d_aigBitblaster(),
+      d_templates(
+          options::bvBitblastTemplates()
+              ? BitblastTemplateCache::get(options::bvBitblastTemplateFile())
+              : nullptr),
       d_bv(theory_bv),
       d_bbAtoms(),
       d_variables(),
@@ -77,6 +84,11 @@ EagerBitblaster::EagerBitblaster(BVSolverLazy* theory_bv, context::Context* c)
                                         rm,
                                         prop::FormulaLitPolicy::INTERNAL,
                                         "EagerBitblaster"));
+  if (options::bvNativeAig())
+  {
+    d_aigBitblaster.reset(new NativeAigBitblaster(
+        d_satSolver.get(), d_cnfStream.get(), "EagerBitblaster"));
+  }
 }
 
 EagerBitblaster::~EagerBitblaster() {}
@@ -111,6 +123,21 @@ void EagerBitblaster::bbAtom(TNode node)
 
   Debug("bitvector-bitblast") << "Bitblasting node " << node << "\n";
 
+  AlwaysAssert(options::bitblastMode() == options::BitblastMode::EAGER);
+  if (d_aigBitblaster != nullptr)
+  {
+    // asserting that the atom is true iff the output of its AIG is
+    storeBBAtom(node, Node::null());
+    d_cnfStream->ensureLiteral(node);
+    prop::SatLiteral lit = d_cnfStream->getLiteral(node);
+    prop::SatLiteral aigLit = d_aigBitblaster->getAtomLiteral(node);
+    prop::SatClause c1{~lit, aigLit};
+    prop::SatClause c2{lit, ~aigLit};
+    d_satSolver->addClause(c1, false);
+    d_satSolver->addClause(c2, false);
+    return;
+  }
+
   // the bitblasted definition of the atom
   Node normalized = Rewriter::rewrite(node);
   Node atom_bb =
@@ -124,7 +151,6 @@ void EagerBitblaster::bbAtom(TNode node)
   Node atom_definition =
       NodeManager::currentNM()->mkNode(kind::EQUAL, node, atom_bb);
 
-  AlwaysAssert(options::bitblastMode() == options::BitblastMode::EAGER);
   storeBBAtom(node, atom_bb);
   d_cnfStream->convertAndAssert(atom_definition, false, false);
 }
@@ -152,7 +178,10 @@ void EagerBitblaster::bbTerm(TNode node, Bits& bits) {
   d_bv->spendResource(ResourceManager::Resource::BitblastStep);
   Debug("bitvector-bitblast") << "Bitblasting node " << node << "\n";
 
-  d_termBBStrategies[node.getKind()](node, bits, this);
+  if (d_templates == nullptr || !d_templates->bbTerm(node, this, bits))
+  {
+    d_termBBStrategies[node.getKind()](node, bits, this);
+  }
 
   Assert(bits.size() == utils::getSize(node));
 
@@ -211,6 +240,10 @@ bool EagerBitblaster::solve(const std::vector<Node>& assumptions)
  * @return
  */
 Node EagerBitblaster::getModelFromSatSolver(TNode a, bool fullModel) {
+  if (d_aigBitblaster != nullptr)
+  {
+    return d_aigBitblaster->getModelValue(a, fullModel);
+  }
   if (!hasBBTerm(a)) {
     return fullModel ? utils::mkConst(utils::getSize(a), 0u) : Node();
   }
@@ -241,13 +274,18 @@ bool EagerBitblaster::collectModelInfo(TheoryModel* m, bool fullModel)
   NodeManager* nm = NodeManager::currentNM();
 
   // Collect the values for the bit-vector variables
-  TNodeSet::iterator it = d_variables.begin();
-  for (; it != d_variables.end(); ++it) {
+  const TNodeSet& variables = d_aigBitblaster != nullptr
+                                  ? d_aigBitblaster->getVariables()
+                                  : d_variables;
+  TNodeSet::const_iterator it = variables.begin();
+  for (; it != variables.end(); ++it) {
     TNode var = *it;
     if (d_bv->isLeaf(var) || isSharedTerm(var) ||
         (var.isVar() && var.getType().isBoolean())) {
       // only shared terms could not have been bit-blasted
-      Assert(hasBBTerm(var) || isSharedTerm(var));
+      Assert(hasBBTerm(var)
+             || (d_aigBitblaster != nullptr && d_aigBitblaster->hasBBTerm(var))
+             || isSharedTerm(var));
 
       Node const_value = getModelFromSatSolver(var, true);
 
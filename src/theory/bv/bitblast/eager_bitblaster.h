@@ -30,7 +30,9 @@ namespace cvc5 {
 namespace theory {
 namespace bv {
 
+class BitblastTemplateCache;
 class BitblastingRegistrar;
+class NativeAigBitblaster;
 class BVSolverLazy;
 
 class EagerBitblaster : public TBitblaster<Node>
@@ -60,6 +62,10 @@ class EagerBitblaster : public TBitblaster<Node>
   typedef std::unordered_set<TNode, TNodeHashFunction> TNodeSet;
   std::unique_ptr<prop::SatSolver> d_satSolver;
   std::unique_ptr<BitblastingRegistrar> d_bitblastingRegistrar;
+  /** The AIG bit-blaster that bit-blasts atoms with --bv-native-aig. */
+  std::unique_ptr<NativeAigBitblaster> d_aigBitblaster;
+  /** The bit-blasting templates with --bv-bitblast-templates, or null. */
+  BitblastTemplateCache* d_templates;
 
   BVSolverLazy* d_bv;
   TNodeSet d_bbAtoms;
@@ -24,6 +24,7 @@
 #include "smt/smt_engine.h"
 #include "smt/smt_statistics_registry.h"
 #include "theory/bv/abstraction.h"
+#include "theory/bv/bitblast/bitblast_template_cache.h"
 #include "theory/bv/bv_solver_lazy.h"
 #include "theory/bv/theory_bv.h"
 #include "theory/bv/theory_bv_utils.h"
@@ -70,6 +71,10 @@ TLazyBitblaster::TLazyBitblaster(context::Context* c,
       d_explanations(new (true) ExplanationMap(c)),
       d_variables(),
       d_bbAtoms(),
+      d_templates(
+          options::bvBitblastTemplates()
+              ? BitblastTemplateCache::get(options::bvBitblastTemplateFile())
+              : nullptr),
       d_abstraction(NULL),
       d_emptyNotify(emptyNotify),
       d_fullModelAssertionLevel(c, 0),
@@ -230,7 +235,10 @@ void TLazyBitblaster::bbTerm(TNode node, Bits& bits) {
   Debug("bitvector-bitblast") << "Bitblasting term " << node <<"\n";
   ++d_statistics.d_numTerms;
 
-  d_termBBStrategies[node.getKind()] (node, bits,this);
+  if (d_templates == nullptr || !d_templates->bbTerm(node, this, bits))
+  {
+    d_termBBStrategies[node.getKind()](node, bits, this);
+  }
 
   Assert(bits.size() == utils::getSize(node));
 
@@ -34,6 +34,7 @@ class NullRegistrat;
 namespace theory {
 namespace bv {
 
+class BitblastTemplateCache;
 class BVSolverLazy;
 
 class TLazyBitblaster : public TBitblaster<Node>
@@ -140,6 +141,8 @@ class TLazyBitblaster : public TBitblaster<Node>
                                     bvEagerPropagate option enabled. */
   TNodeSet d_variables;
   TNodeSet d_bbAtoms;
+  /** The bit-blasting templates with --bv-bitblast-templates, or null. */
+  BitblastTemplateCache* d_templates;
   AbstractionModule* d_abstraction;
   bool d_emptyNotify;
 
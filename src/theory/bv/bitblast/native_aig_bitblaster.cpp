@@ -0,0 +1,439 @@
+/*********************                                                        */
+/*! \file native_aig_bitblaster.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Bit-blaster that bit-blasts to the built-in AIG.
+ **/
+
+#include "theory/bv/bitblast/native_aig_bitblaster.h"
+
+#include "smt/smt_statistics_registry.h"
+#include "theory/bv/theory_bv_utils.h"
+#include "theory/rewriter.h"
+
+namespace cvc5 {
+namespace theory {
+namespace bv {
+
+NativeAigBitblaster::NativeAigBitblaster(prop::SatSolver* satSolver,
+                                         prop::CnfStream* cnfStream,
+                                         const std::string& name)
+    : TBitblaster<AigEdge>(),
+      d_satSolver(satSolver),
+      d_cnfStream(cnfStream),
+      d_statistics(name + "::NativeAig")
+{
+}
+
+NativeAigBitblaster::~NativeAigBitblaster() {}
+
+void NativeAigBitblaster::bbAtom(TNode node)
+{
+  node = node.getKind() == kind::NOT ? node[0] : node;
+  if (hasBBAtom(node))
+  {
+    return;
+  }
+
+  Debug("bitvector-bitblast") << "Bitblasting node " << node << "\n";
+
+  AigEdge atom_bb;
+  if (node.getKind() == kind::BITVECTOR_BITOF)
+  {
+    atom_bb = getBitInput(node);
+  }
+  else
+  {
+    Node normalized = Rewriter::rewrite(node);
+    if (normalized.getKind() == kind::CONST_BOOLEAN)
+    {
+      atom_bb = AigEdge::mkConst(normalized.getConst<bool>());
+    }
+    else if (normalized.getKind() == kind::BITVECTOR_BITOF)
+    {
+      atom_bb = getBitInput(normalized);
+    }
+    else
+    {
+      atom_bb = d_atomBBStrategies[normalized.getKind()](normalized, this);
+    }
+  }
+  storeBBAtom(node, atom_bb);
+}
+
+void NativeAigBitblaster::storeBBAtom(TNode atom, AigEdge atom_bb)
+{
+  d_bbAtoms.emplace(atom, atom_bb);
+}
+
+bool NativeAigBitblaster::hasBBAtom(TNode atom) const
+{
+  return d_bbAtoms.find(atom) != d_bbAtoms.end();
+}
+
+AigEdge NativeAigBitblaster::getBBAtom(TNode atom) const
+{
+  Assert(hasBBAtom(atom));
+  return d_bbAtoms.find(atom)->second;
+}
+
+void NativeAigBitblaster::bbTerm(TNode node, Bits& bits)
+{
+  Assert(node.getType().isBitVector());
+  if (hasBBTerm(node))
+  {
+    getBBTerm(node, bits);
+    return;
+  }
+  Debug("bitvector-bitblast") << "Bitblasting node " << node << "\n";
+  d_termBBStrategies[node.getKind()](node, bits, this);
+  Assert(bits.size() == utils::getSize(node));
+  storeBBTerm(node, bits);
+}
+
+void NativeAigBitblaster::makeVariable(TNode var, Bits& bits)
+{
+  Assert(bits.size() == 0);
+  for (unsigned i = 0; i < utils::getSize(var); ++i)
+  {
+    bits.push_back(getBitInput(utils::mkBitOf(var, i)));
+  }
+  d_variables.insert(var);
+}
+
+bool NativeAigBitblaster::isVariable(TNode node) const
+{
+  return d_variables.find(node) != d_variables.end();
+}
+
+AigEdge NativeAigBitblaster::getBitInput(TNode bit)
+{
+  Assert(bit.getKind() == kind::BITVECTOR_BITOF);
+  auto it = d_bitInputs.find(bit);
+  if (it != d_bitInputs.end())
+  {
+    return it->second;
+  }
+  AigEdge input = d_aig.mkInput();
+  d_bitInputs.emplace(bit, input);
+  d_inputBits.emplace(input.getId(), bit);
+  return input;
+}
+
+prop::SatLiteral NativeAigBitblaster::getAtomLiteral(TNode atom)
+{
+  bool negated = atom.getKind() == kind::NOT;
+  if (negated)
+  {
+    atom = atom[0];
+  }
+  bbAtom(atom);
+  prop::SatLiteral lit = encode(getBBAtom(atom));
+  updateStatistics();
+  return negated ? ~lit : lit;
+}
+
+bool NativeAigBitblaster::isInlinable(AigEdge e) const
+{
+  uint32_t id = e.getId();
+  return !e.isNegated() && !d_aig.isInput(id) && d_aig.getNumParents(id) == 1
+         && d_literals[id].isNull();
+}
+
+bool NativeAigBitblaster::getGate(uint32_t id,
+                                  std::vector<AigEdge>& fanins) const
+{
+  fanins.clear();
+  AigEdge c0 = d_aig.getChild0(id);
+  AigEdge c1 = d_aig.getChild1(id);
+
+  // ~(s & t) & ~(~s & e), which is ite(s, ~t, ~e), this includes xor
+  if (c0.isNegated() && c1.isNegated() && isInlinable(~c0)
+      && isInlinable(~c1))
+  {
+    AigEdge a[2] = {d_aig.getChild0(c0.getId()), d_aig.getChild1(c0.getId())};
+    AigEdge b[2] = {d_aig.getChild0(c1.getId()), d_aig.getChild1(c1.getId())};
+    for (size_t i = 0; i < 2; ++i)
+    {
+      for (size_t j = 0; j < 2; ++j)
+      {
+        if (a[i] == ~b[j])
+        {
+          fanins.push_back(a[i]);
+          fanins.push_back(~a[1 - i]);
+          fanins.push_back(~b[1 - j]);
+          return true;
+        }
+      }
+    }
+  }
+
+  // collect the leaves of the tree of AND nodes rooted at id
+  std::vector<AigEdge> visit{c1, c0};
+  while (!visit.empty())
+  {
+    AigEdge cur = visit.back();
+    visit.pop_back();
+    if (isInlinable(cur)
+        && fanins.size() + visit.size() + 2 <= s_maxAndLeaves)
+    {
+      visit.push_back(d_aig.getChild1(cur.getId()));
+      visit.push_back(d_aig.getChild0(cur.getId()));
+    }
+    else
+    {
+      fanins.push_back(cur);
+    }
+  }
+  return false;
+}
+
+prop::SatLiteral NativeAigBitblaster::getLiteral(AigEdge e) const
+{
+  Assert(!e.isConst());
+  prop::SatLiteral lit = d_literals[e.getId()];
+  Assert(!lit.isNull());
+  return e.isNegated() ? ~lit : lit;
+}
+
+void NativeAigBitblaster::addClause(prop::SatClause& clause)
+{
+  d_satSolver->addClause(clause, false);
+  ++d_statistics.d_numClauses;
+}
+
+prop::SatLiteral NativeAigBitblaster::encode(AigEdge e)
+{
+  if (e.isConst())
+  {
+    prop::SatLiteral t(d_satSolver->trueVar());
+    return e.isTrue() ? t : ~t;
+  }
+  d_literals.resize(d_aig.getNumNodes(), prop::undefSatLiteral);
+
+  std::vector<uint32_t> visit{e.getId()};
+  std::vector<AigEdge> fanins;
+  while (!visit.empty())
+  {
+    uint32_t id = visit.back();
+    if (!d_literals[id].isNull())
+    {
+      visit.pop_back();
+      continue;
+    }
+    if (d_aig.isInput(id))
+    {
+      visit.pop_back();
+      Node bit = d_inputBits[id];
+      d_cnfStream->ensureLiteral(bit);
+      d_literals[id] = d_cnfStream->getLiteral(bit);
+      continue;
+    }
+
+    bool isIte = getGate(id, fanins);
+    bool ready = true;
+    for (const AigEdge& f : fanins)
+    {
+      if (d_literals[f.getId()].isNull())
+      {
+        visit.push_back(f.getId());
+        ready = false;
+      }
+    }
+    if (!ready)
+    {
+      continue;
+    }
+    visit.pop_back();
+
+    prop::SatLiteral n(d_satSolver->newVar(false, false, false));
+    d_literals[id] = n;
+    ++d_statistics.d_numEncodedGates;
+    if (isIte)
+    {
+      prop::SatLiteral c = getLiteral(fanins[0]);
+      prop::SatLiteral t = getLiteral(fanins[1]);
+      prop::SatLiteral f = getLiteral(fanins[2]);
+      std::vector<prop::SatClause> clauses = {
+          {~n, ~c, t}, {~n, c, f}, {n, ~c, ~t}, {n, c, ~f}};
+      if (t != ~f)
+      {
+        // redundant clauses that improve propagation, tautologies for xor
+        clauses.push_back({~n, t, f});
+        clauses.push_back({n, ~t, ~f});
+      }
+      for (prop::SatClause& clause : clauses)
+      {
+        addClause(clause);
+      }
+    }
+    else
+    {
+      prop::SatClause big{n};
+      for (const AigEdge& f : fanins)
+      {
+        prop::SatLiteral l = getLiteral(f);
+        prop::SatClause clause{~n, l};
+        addClause(clause);
+        big.push_back(~l);
+      }
+      addClause(big);
+    }
+  }
+  return getLiteral(e);
+}
+
+Node NativeAigBitblaster::getModelValue(TNode term, bool fullModel)
+{
+  if (!hasBBTerm(term))
+  {
+    return fullModel ? utils::mkConst(utils::getSize(term), 0u) : Node();
+  }
+  Bits bits;
+  getBBTerm(term, bits);
+
+  // The bits of the term are evaluated on the AIG, since not all nodes may
+  // have been encoded, with 0 for unknown, 1 for false and 2 for true.
+  std::unordered_map<uint32_t, uint8_t> values;
+  std::vector<uint32_t> visit;
+  Integer value(0), one(1), zero(0);
+  for (size_t i = 0, size = bits.size(), j = size - 1; i < size; ++i, --j)
+  {
+    AigEdge b = bits[j];
+    bool bit = b.isTrue();
+    if (!b.isConst())
+    {
+      visit.push_back(b.getId());
+      while (!visit.empty())
+      {
+        uint32_t id = visit.back();
+        if (values.find(id) != values.end())
+        {
+          visit.pop_back();
+          continue;
+        }
+        prop::SatLiteral lit =
+            id < d_literals.size() ? d_literals[id] : prop::undefSatLiteral;
+        if (lit.isNull() && d_aig.isInput(id))
+        {
+          Node input = d_inputBits[id];
+          if (d_cnfStream->hasLiteral(input))
+          {
+            lit = d_cnfStream->getLiteral(input);
+          }
+        }
+        if (!lit.isNull())
+        {
+          prop::SatValue val = d_satSolver->modelValue(lit);
+          values[id] = val == prop::SAT_VALUE_TRUE
+                           ? 2
+                           : (val == prop::SAT_VALUE_FALSE ? 1 : 0);
+          visit.pop_back();
+          continue;
+        }
+        if (d_aig.isInput(id))
+        {
+          values[id] = 0;
+          visit.pop_back();
+          continue;
+        }
+        AigEdge c[2] = {d_aig.getChild0(id), d_aig.getChild1(id)};
+        bool ready = true;
+        for (const AigEdge& child : c)
+        {
+          if (values.find(child.getId()) == values.end())
+          {
+            visit.push_back(child.getId());
+            ready = false;
+          }
+        }
+        if (!ready)
+        {
+          continue;
+        }
+        visit.pop_back();
+        // an AND node is false if a child is false, even if the other one is
+        // unknown
+        uint8_t res = 2;
+        for (const AigEdge& child : c)
+        {
+          uint8_t v = values[child.getId()];
+          if (v != 0 && child.isNegated())
+          {
+            v = 3 - v;
+          }
+          if (v == 1)
+          {
+            res = 1;
+            break;
+          }
+          if (v == 0)
+          {
+            res = 0;
+          }
+        }
+        values[id] = res;
+      }
+      uint8_t v = values[b.getId()];
+      if (v == 0)
+      {
+        if (!fullModel)
+        {
+          return Node();
+        }
+        // unconstrained bits default to false
+        v = b.isNegated() ? 2 : 1;
+      }
+      else if (b.isNegated())
+      {
+        v = 3 - v;
+      }
+      bit = v == 2;
+    }
+    value = value * 2 + (bit ? one : zero);
+  }
+  return utils::mkConst(bits.size(), value);
+}
+
+void NativeAigBitblaster::updateStatistics()
+{
+  d_statistics.d_numInputs.set(d_aig.getNumInputs());
+  d_statistics.d_numAnds.set(d_aig.getNumAnds());
+  d_statistics.d_numRewrites.set(d_aig.getNumRewrites());
+  d_statistics.d_numHashHits.set(d_aig.getNumHashHits());
+}
+
+NativeAigBitblaster::Statistics::Statistics(const std::string& prefix)
+    : d_numInputs(prefix + "::NumInputs", 0),
+      d_numAnds(prefix + "::NumAnds", 0),
+      d_numRewrites(prefix + "::NumRewrites", 0),
+      d_numHashHits(prefix + "::NumHashHits", 0),
+      d_numEncodedGates(prefix + "::NumEncodedGates", 0),
+      d_numClauses(prefix + "::NumClauses", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_numInputs);
+  smtStatisticsRegistry()->registerStat(&d_numAnds);
+  smtStatisticsRegistry()->registerStat(&d_numRewrites);
+  smtStatisticsRegistry()->registerStat(&d_numHashHits);
+  smtStatisticsRegistry()->registerStat(&d_numEncodedGates);
+  smtStatisticsRegistry()->registerStat(&d_numClauses);
+}
+
+NativeAigBitblaster::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numInputs);
+  smtStatisticsRegistry()->unregisterStat(&d_numAnds);
+  smtStatisticsRegistry()->unregisterStat(&d_numRewrites);
+  smtStatisticsRegistry()->unregisterStat(&d_numHashHits);
+  smtStatisticsRegistry()->unregisterStat(&d_numEncodedGates);
+  smtStatisticsRegistry()->unregisterStat(&d_numClauses);
+}
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,217 @@
+/*********************                                                        */
+/*! \file native_aig_bitblaster.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Bit-blaster that bit-blasts to the built-in AIG.
+ **
+ ** Bit-blaster that bit-blasts to the built-in AIG (see aig.h) and encodes
+ ** the AIG into CNF, used with --bv-native-aig.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__BV__BITBLAST__NATIVE_AIG_BITBLASTER_H
+#define CVC4__THEORY__BV__BITBLAST__NATIVE_AIG_BITBLASTER_H
+
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include "theory/bv/bitblast/aig.h"
+#include "theory/bv/bitblast/bitblaster.h"
+#include "util/statistics_registry.h"
+
+namespace cvc5 {
+namespace theory {
+namespace bv {
+
+template <> inline
+std::string toString<AigEdge>(const std::vector<AigEdge>& bits) {
+  std::ostringstream os;
+  for (int i = bits.size() - 1; i >= 0; --i) {
+    if (bits[i].isConst()) {
+      os << (bits[i].isTrue() ? "1" : "0");
+    } else {
+      os << (bits[i].isNegated() ? "-" : "+") << bits[i].getId() << " ";
+    }
+  }
+  os << "\n";
+  return os.str();
+}
+
+template <> inline
+AigEdge mkTrue<AigEdge>() {
+  return AigEdge::mkConst(true);
+}
+
+template <> inline
+AigEdge mkFalse<AigEdge>() {
+  return AigEdge::mkConst(false);
+}
+
+template <> inline
+AigEdge mkNot<AigEdge>(AigEdge a) {
+  return ~a;
+}
+
+template <> inline
+AigEdge mkOr<AigEdge>(AigEdge a, AigEdge b) {
+  return Aig::mkOr(a, b);
+}
+
+template <> inline
+AigEdge mkOr<AigEdge>(const std::vector<AigEdge>& children) {
+  Assert(children.size());
+  AigEdge res = children[0];
+  for (size_t i = 1, size = children.size(); i < size; ++i) {
+    res = Aig::mkOr(res, children[i]);
+  }
+  return res;
+}
+
+template <> inline
+AigEdge mkAnd<AigEdge>(AigEdge a, AigEdge b) {
+  return Aig::mkAnd(a, b);
+}
+
+template <> inline
+AigEdge mkAnd<AigEdge>(const std::vector<AigEdge>& children) {
+  Assert(children.size());
+  AigEdge res = children[0];
+  for (size_t i = 1, size = children.size(); i < size; ++i) {
+    res = Aig::mkAnd(res, children[i]);
+  }
+  return res;
+}
+
+template <> inline
+AigEdge mkXor<AigEdge>(AigEdge a, AigEdge b) {
+  return Aig::mkXor(a, b);
+}
+
+template <> inline
+AigEdge mkIff<AigEdge>(AigEdge a, AigEdge b) {
+  return Aig::mkIff(a, b);
+}
+
+template <> inline
+AigEdge mkIte<AigEdge>(AigEdge cond, AigEdge a, AigEdge b) {
+  return Aig::mkIte(cond, a, b);
+}
+
+/**
+ * Bit-blaster that bit-blasts atoms to an AIG with the default bit-blasting
+ * strategies, and encodes the AIG nodes into CNF on demand.
+ *
+ * The inputs of the AIG are the bits of variables (BITVECTOR_BITOF nodes).
+ * Their SAT literals are the literals of the bits in the given CnfStream,
+ * such that bits that also occur in the Boolean structure of the input get
+ * the same literal. All other SAT variables are added to the SAT solver
+ * directly.
+ *
+ * The CNF encoding is cut-based: instead of one gate per AND node, trees of
+ * AND nodes without other parents are encoded as a single n-ary AND gate,
+ * and the three-node AIG pattern of an if-then-else or xor is encoded as a
+ * single if-then-else gate.
+ */
+class NativeAigBitblaster : public TBitblaster<AigEdge>
+{
+ public:
+  NativeAigBitblaster(prop::SatSolver* satSolver,
+                      prop::CnfStream* cnfStream,
+                      const std::string& name);
+  ~NativeAigBitblaster();
+
+  void bbAtom(TNode node) override;
+  void bbTerm(TNode node, Bits& bits) override;
+  void makeVariable(TNode var, Bits& bits) override;
+  AigEdge getBBAtom(TNode atom) const override;
+  bool hasBBAtom(TNode atom) const override;
+  void storeBBAtom(TNode atom, AigEdge atom_bb) override;
+
+  /**
+   * Bit-blast the (possibly negated) atom, encode its AIG into CNF and
+   * return the SAT literal that is equivalent to it.
+   */
+  prop::SatLiteral getAtomLiteral(TNode atom);
+
+  /**
+   * Get the value of the bit-blasted term 'term' in the current model of the
+   * SAT solver. If fullModel is true unconstrained bits are set to 0,
+   * otherwise the null node is returned for terms with unconstrained bits.
+   */
+  Node getModelValue(TNode term, bool fullModel);
+
+  /** Checks whether node is a variable introduced via `makeVariable`. */
+  bool isVariable(TNode node) const;
+  /** The variables introduced via `makeVariable`. */
+  const TNodeSet& getVariables() const { return d_variables; }
+
+ private:
+  Node getModelFromSatSolver(TNode node, bool fullModel) override
+  {
+    return getModelValue(node, fullModel);
+  }
+  prop::SatSolver* getSatSolver() override { return d_satSolver; }
+
+  /** Get the AIG input for the bit 'bit', a BITVECTOR_BITOF node. */
+  AigEdge getBitInput(TNode bit);
+  /** Encode the cone of e into CNF and return the literal of e. */
+  prop::SatLiteral encode(AigEdge e);
+  /**
+   * Get the gate of the AND node with the given id, i.e., its inputs in the
+   * CNF encoding. Returns true if the node is encoded as if-then-else of
+   * fanins[0], fanins[1] and fanins[2], and false if the node is encoded as
+   * the conjunction of fanins.
+   */
+  bool getGate(uint32_t id, std::vector<AigEdge>& fanins) const;
+  /** Is the node with the given id an AND node that can be inlined? */
+  bool isInlinable(AigEdge e) const;
+  /** The literal of an encoded edge. */
+  prop::SatLiteral getLiteral(AigEdge e) const;
+  void addClause(prop::SatClause& clause);
+  void updateStatistics();
+
+  /** The maximal number of leaves of an n-ary AND gate in the encoding. */
+  static const size_t s_maxAndLeaves = 16;
+
+  Aig d_aig;
+  prop::SatSolver* d_satSolver;
+  prop::CnfStream* d_cnfStream;
+  /** Stores bit-blasted atoms. */
+  std::unordered_map<Node, AigEdge, NodeHashFunction> d_bbAtoms;
+  /** Maps bits (BITVECTOR_BITOF nodes) to AIG inputs. */
+  std::unordered_map<Node, AigEdge, NodeHashFunction> d_bitInputs;
+  /** Maps the ids of AIG inputs to their bits. */
+  std::unordered_map<uint32_t, Node> d_inputBits;
+  /** The literals of encoded AIG nodes, indexed by id. */
+  std::vector<prop::SatLiteral> d_literals;
+  /** Caches variables for which we already created bits. */
+  TNodeSet d_variables;
+
+  class Statistics
+  {
+   public:
+    IntStat d_numInputs;
+    IntStat d_numAnds;
+    IntStat d_numRewrites;
+    IntStat d_numHashHits;
+    IntStat d_numEncodedGates;
+    IntStat d_numClauses;
+    Statistics(const std::string& prefix);
+    ~Statistics();
+  };
+
+  Statistics d_statistics;
+};
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__BV__BITBLAST__NATIVE_AIG_BITBLASTER_H */
@@ -14,6 +14,8 @@
  **/
 #include "theory/bv/bitblast/simple_bitblaster.h"
 
+#include "options/bv_options.h"
+#include "theory/bv/bitblast/bitblast_template_cache.h"
 #include "theory/theory_model.h"
 #include "theory/theory_state.h"
 
@@ -21,7 +23,15 @@ namespace cvc5 {
 namespace theory {
 namespace bv {
 
-BBSimple::BBSimple(TheoryState* s) : TBitblaster<Node>(), d_state(s) {}
+BBSimple::BBSimple(TheoryState* s)
+    : TBitblaster<Node>(),
+      d_state(s),
+      d_templates(
+          options::bvBitblastTemplates()
+              ? BitblastTemplateCache::get(options::bvBitblastTemplateFile())
+              : nullptr)
+{
+}
 
 void BBSimple::bbAtom(TNode node)
 {
@@ -81,7 +91,10 @@ void BBSimple::bbTerm(TNode node, Bits& bits)
     getBBTerm(node, bits);
     return;
   }
-  d_termBBStrategies[node.getKind()](node, bits, this);
+  if (d_templates == nullptr || !d_templates->bbTerm(node, this, bits))
+  {
+    d_termBBStrategies[node.getKind()](node, bits, this);
+  }
   Assert(bits.size() == utils::getSize(node));
   storeBBTerm(node, bits);
 }
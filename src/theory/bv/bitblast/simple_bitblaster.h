@@ -23,6 +23,8 @@ namespace cvc5 {
 namespace theory {
 namespace bv {
 
+class BitblastTemplateCache;
+
 /**
  * Implementation of a simple Node-based bit-blaster.
  *
@@ -71,6 +73,8 @@ class BBSimple : public TBitblaster<Node>
   std::unordered_map<Node, Node, NodeHashFunction> d_bbAtoms;
   /** Theory state. */
   TheoryState* d_state;
+  /** The bit-blasting templates with --bv-bitblast-templates, or null. */
+  BitblastTemplateCache* d_templates;
 };
 
 }  // namespace bv
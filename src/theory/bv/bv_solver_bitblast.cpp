@@ -64,6 +64,11 @@ BVSolverBitblast::BVSolverBitblast(TheoryState* s,
                                         d_nullContext.get(),
                                         nullptr,
                                         smt::currentResourceManager()));
+  if (options::bvNativeAig())
+  {
+    d_aigBitblaster.reset(new NativeAigBitblaster(
+        d_satSolver.get(), d_cnfStream.get(), "BVSolverBitblast"));
+  }
 }
 
 void BVSolverBitblast::postCheck(Theory::Effort level)
@@ -85,11 +90,18 @@ void BVSolverBitblast::postCheck(Theory::Effort level)
     /* Bit-blast fact and cache literal. */
     if (d_factLiteralCache.find(fact) == d_factLiteralCache.end())
     {
-      d_bitblaster->bbAtom(fact);
-      Node bb_fact = d_bitblaster->getStoredBBAtom(fact);
-      d_cnfStream->ensureLiteral(bb_fact);
-
-      prop::SatLiteral lit = d_cnfStream->getLiteral(bb_fact);
+      prop::SatLiteral lit;
+      if (d_aigBitblaster != nullptr)
+      {
+        lit = d_aigBitblaster->getAtomLiteral(fact);
+      }
+      else
+      {
+        d_bitblaster->bbAtom(fact);
+        Node bb_fact = d_bitblaster->getStoredBBAtom(fact);
+        d_cnfStream->ensureLiteral(bb_fact);
+        lit = d_cnfStream->getLiteral(bb_fact);
+      }
       d_factLiteralCache[fact] = lit;
       d_literalFactCache[lit] = fact;
     }
@@ -140,7 +152,10 @@ bool BVSolverBitblast::collectModelValues(TheoryModel* m,
 {
   for (const auto& term : termSet)
   {
-    if (!d_bitblaster->isVariable(term))
+    bool isVariable = d_aigBitblaster != nullptr
+                          ? d_aigBitblaster->isVariable(term)
+                          : d_bitblaster->isVariable(term);
+    if (!isVariable)
     {
       continue;
     }
@@ -183,10 +198,14 @@ Node BVSolverBitblast::getValueFromSatSolver(TNode node, bool initialize)
     return node;
   }
 
-  if (!d_bitblaster->hasBBTerm(node))
+  if (!hasBBTerm(node))
   {
     return initialize ? utils::mkConst(utils::getSize(node), 0u) : Node();
   }
+  if (d_aigBitblaster != nullptr)
+  {
+    return d_aigBitblaster->getModelValue(node, initialize);
+  }
 
   std::vector<Node> bits;
   d_bitblaster->getBBTerm(node, bits);
@@ -232,7 +251,7 @@ Node BVSolverBitblast::getValue(TNode node)
       continue;
     }
 
-    if (d_bitblaster->hasBBTerm(cur))
+    if (hasBBTerm(cur))
     {
       Node value = getValueFromSatSolver(cur, false);
       if (value.isConst())
@@ -279,6 +298,12 @@ Node BVSolverBitblast::getValue(TNode node)
   return it->second;
 }
 
+bool BVSolverBitblast::hasBBTerm(TNode node) const
+{
+  return d_aigBitblaster != nullptr ? d_aigBitblaster->hasBBTerm(node)
+                                    : d_bitblaster->hasBBTerm(node);
+}
+
 }  // namespace bv
 }  // namespace theory
 }  // namespace cvc5
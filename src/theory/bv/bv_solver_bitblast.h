@@ -24,6 +24,7 @@
 #include "context/cdqueue.h"
 #include "prop/cnf_stream.h"
 #include "prop/sat_solver.h"
+#include "theory/bv/bitblast/native_aig_bitblaster.h"
 #include "theory/bv/bitblast/simple_bitblaster.h"
 #include "theory/bv/bv_solver.h"
 #include "theory/bv/proof_checker.h"
@@ -88,6 +89,9 @@ class BVSolverBitblast : public BVSolver
    */
   Node getValue(TNode node);
 
+  /** Was `node` bit-blasted by the bit-blaster in use? */
+  bool hasBBTerm(TNode node) const;
+
   /**
    * Cache for getValue() calls.
    *
@@ -99,6 +103,9 @@ class BVSolverBitblast : public BVSolver
   /** Bit-blaster used to bit-blast atoms/terms. */
   std::unique_ptr<BBSimple> d_bitblaster;
 
+  /** Bit-blaster used instead of `d_bitblaster` with --bv-native-aig. */
+  std::unique_ptr<NativeAigBitblaster> d_aigBitblaster;
+
   /** Used for initializing `d_cnfStream`. */
   std::unique_ptr<prop::NullRegistrar> d_nullRegistrar;
   std::unique_ptr<context::Context> d_nullContext;
@@ -114,5 +114,12 @@ void EqEngineManagerDistributed::MasterNotifyClass::eqNotifyNewClass(TNode t)
   d_quantEngine->eqNotifyNewClass(t);
 }
 
+void EqEngineManagerDistributed::MasterNotifyClass::eqNotifyMerge(TNode t1,
+                                                                  TNode t2)
+{
+  // records the merge for incremental E-matching
+  d_quantEngine->eqNotifyMerge(t1, t2);
+}
+
 }  // namespace theory
 }  // namespace cvc5
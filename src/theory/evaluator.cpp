@@ -16,6 +16,8 @@
 
 #include "theory/evaluator.h"
 
+#include <functional>
+
 #include "theory/bv/theory_bv_utils.h"
 #include "theory/rewriter.h"
 #include "theory/strings/theory_strings_utils.h"
@@ -951,5 +953,547 @@ Node Evaluator::reconstruct(
   return nn;
 }
 
+uint64_t bvMask(unsigned width)
+{
+  return width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+}
+
+int64_t bvSigned(uint64_t v, unsigned width)
+{
+  uint64_t sign = uint64_t(1) << (width - 1);
+  return static_cast<int64_t>((v ^ sign) - sign);
+}
+
+namespace {
+
+/**
+ * The values of a term for all points of Evaluator::evalBatch. Boolean
+ * values are packed with one bit per point into 64-bit words, and bit-vector
+ * values of width at most 64 are stored as one word per point. All other
+ * values are stored as nodes.
+ */
+struct BatchValues
+{
+  enum
+  {
+    BOOL,
+    BITVECTOR,
+    NODE
+  } d_tag = NODE;
+  /** The bit-width of the values, if d_tag is BITVECTOR */
+  unsigned d_width = 0;
+  /** The packed values, if d_tag is BOOL or BITVECTOR */
+  std::vector<uint64_t> d_words;
+  /** The values, if d_tag is NODE */
+  std::vector<Node> d_nodes;
+
+  bool getBool(size_t i) const { return (d_words[i / 64] >> (i % 64)) & 1; }
+  void setBool(size_t i) { d_words[i / 64] |= uint64_t(1) << (i % 64); }
+
+  /** The value for point i as a node */
+  Node toNode(size_t i) const
+  {
+    NodeManager* nm = NodeManager::currentNM();
+    switch (d_tag)
+    {
+      case BOOL: return nm->mkConst(getBool(i));
+      case BITVECTOR:
+        return nm->mkConst(BitVector(d_width, Integer(d_words[i])));
+      default: return d_nodes[i];
+    }
+  }
+
+  /**
+   * Pack the values in d_nodes if they are all Boolean constants or all
+   * bit-vector constants of width at most 64.
+   */
+  void pack()
+  {
+    Assert(d_tag == NODE);
+    if (d_nodes.empty())
+    {
+      return;
+    }
+    Kind k = d_nodes[0].getKind();
+    for (const Node& v : d_nodes)
+    {
+      if (v.isNull() || v.getKind() != k)
+      {
+        return;
+      }
+    }
+    size_t numPoints = d_nodes.size();
+    if (k == kind::CONST_BOOLEAN)
+    {
+      d_tag = BOOL;
+      d_words.assign((numPoints + 63) / 64, 0);
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        if (d_nodes[i].getConst<bool>())
+        {
+          setBool(i);
+        }
+      }
+    }
+    else if (k == kind::CONST_BITVECTOR
+             && d_nodes[0].getConst<BitVector>().getSize() <= 64)
+    {
+      d_tag = BITVECTOR;
+      d_width = d_nodes[0].getConst<BitVector>().getSize();
+      d_words.resize(numPoints);
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        d_words[i] =
+            d_nodes[i].getConst<BitVector>().getValue().getUnsignedLong();
+      }
+    }
+    else
+    {
+      return;
+    }
+    d_nodes.clear();
+  }
+};
+
+/**
+ * Evaluate the predicate pred on the values of the two children for all
+ * points.
+ */
+template <class Pred>
+void evalBatchPred(const BatchValues& a,
+                   const BatchValues& b,
+                   size_t numPoints,
+                   BatchValues& res,
+                   Pred pred)
+{
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    if (pred(a.d_words[i], b.d_words[i]))
+    {
+      res.setBool(i);
+    }
+  }
+}
+
+/**
+ * Evaluate n for all points on the packed values cvals of its children.
+ * Returns false if a child is not packed, or if n is not supported on packed
+ * values.
+ */
+bool evalBatchPacked(TNode n,
+                     const std::vector<const BatchValues*>& cvals,
+                     size_t numPoints,
+                     BatchValues& res)
+{
+  for (const BatchValues* cv : cvals)
+  {
+    if (cv->d_tag == BatchValues::NODE)
+    {
+      return false;
+    }
+  }
+  Kind k = n.getKind();
+  TypeNode tn = n.getType();
+  if (tn.isBoolean())
+  {
+    size_t numWords = (numPoints + 63) / 64;
+    res.d_tag = BatchValues::BOOL;
+    res.d_words.assign(numWords, 0);
+    std::vector<uint64_t>& r = res.d_words;
+    switch (k)
+    {
+      case kind::NOT:
+      {
+        for (size_t w = 0; w < numWords; ++w)
+        {
+          r[w] = ~cvals[0]->d_words[w];
+        }
+        return true;
+      }
+      case kind::AND:
+      case kind::OR:
+      case kind::XOR:
+      {
+        r = cvals[0]->d_words;
+        for (size_t c = 1, nchildren = cvals.size(); c < nchildren; ++c)
+        {
+          const std::vector<uint64_t>& a = cvals[c]->d_words;
+          for (size_t w = 0; w < numWords; ++w)
+          {
+            r[w] = k == kind::AND ? r[w] & a[w]
+                                  : (k == kind::OR ? r[w] | a[w] : r[w] ^ a[w]);
+          }
+        }
+        return true;
+      }
+      case kind::IMPLIES:
+      {
+        for (size_t w = 0; w < numWords; ++w)
+        {
+          r[w] = ~cvals[0]->d_words[w] | cvals[1]->d_words[w];
+        }
+        return true;
+      }
+      case kind::ITE:
+      {
+        const std::vector<uint64_t>& c = cvals[0]->d_words;
+        for (size_t w = 0; w < numWords; ++w)
+        {
+          r[w] = (c[w] & cvals[1]->d_words[w]) | (~c[w] & cvals[2]->d_words[w]);
+        }
+        return true;
+      }
+      case kind::EQUAL:
+      {
+        if (cvals[0]->d_tag == BatchValues::BOOL)
+        {
+          for (size_t w = 0; w < numWords; ++w)
+          {
+            r[w] = ~(cvals[0]->d_words[w] ^ cvals[1]->d_words[w]);
+          }
+          return true;
+        }
+        evalBatchPred(*cvals[0],
+                      *cvals[1],
+                      numPoints,
+                      res,
+                      [](uint64_t a, uint64_t b) { return a == b; });
+        return true;
+      }
+      default: break;
+    }
+    if (cvals.size() != 2 || cvals[0]->d_tag != BatchValues::BITVECTOR)
+    {
+      return false;
+    }
+    unsigned w = cvals[0]->d_width;
+    switch (k)
+    {
+      case kind::BITVECTOR_ULT:
+        evalBatchPred(*cvals[0], *cvals[1], numPoints, res, std::less<>());
+        return true;
+      case kind::BITVECTOR_ULE:
+        evalBatchPred(
+            *cvals[0], *cvals[1], numPoints, res, std::less_equal<>());
+        return true;
+      case kind::BITVECTOR_UGT:
+        evalBatchPred(*cvals[0], *cvals[1], numPoints, res, std::greater<>());
+        return true;
+      case kind::BITVECTOR_UGE:
+        evalBatchPred(
+            *cvals[0], *cvals[1], numPoints, res, std::greater_equal<>());
+        return true;
+      case kind::BITVECTOR_SLT:
+        evalBatchPred(
+            *cvals[0], *cvals[1], numPoints, res, [w](uint64_t a, uint64_t b) {
+              return bvSigned(a, w) < bvSigned(b, w);
+            });
+        return true;
+      case kind::BITVECTOR_SLE:
+        evalBatchPred(
+            *cvals[0], *cvals[1], numPoints, res, [w](uint64_t a, uint64_t b) {
+              return bvSigned(a, w) <= bvSigned(b, w);
+            });
+        return true;
+      case kind::BITVECTOR_SGT:
+        evalBatchPred(
+            *cvals[0], *cvals[1], numPoints, res, [w](uint64_t a, uint64_t b) {
+              return bvSigned(a, w) > bvSigned(b, w);
+            });
+        return true;
+      case kind::BITVECTOR_SGE:
+        evalBatchPred(
+            *cvals[0], *cvals[1], numPoints, res, [w](uint64_t a, uint64_t b) {
+              return bvSigned(a, w) >= bvSigned(b, w);
+            });
+        return true;
+      default: return false;
+    }
+  }
+
+  if (!tn.isBitVector() || tn.getBitVectorSize() > 64)
+  {
+    return false;
+  }
+  unsigned width = tn.getBitVectorSize();
+  uint64_t mask = bvMask(width);
+  res.d_tag = BatchValues::BITVECTOR;
+  res.d_width = width;
+  res.d_words.resize(numPoints);
+  std::vector<uint64_t>& r = res.d_words;
+  switch (k)
+  {
+    case kind::BITVECTOR_NOT:
+    {
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        r[i] = ~cvals[0]->d_words[i] & mask;
+      }
+      return true;
+    }
+    case kind::BITVECTOR_NEG:
+    {
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        r[i] = (uint64_t(0) - cvals[0]->d_words[i]) & mask;
+      }
+      return true;
+    }
+    case kind::BITVECTOR_PLUS:
+    case kind::BITVECTOR_MULT:
+    case kind::BITVECTOR_AND:
+    case kind::BITVECTOR_OR:
+    case kind::BITVECTOR_XOR:
+    {
+      r = cvals[0]->d_words;
+      for (size_t c = 1, nchildren = cvals.size(); c < nchildren; ++c)
+      {
+        const std::vector<uint64_t>& a = cvals[c]->d_words;
+        switch (k)
+        {
+          case kind::BITVECTOR_PLUS:
+            for (size_t i = 0; i < numPoints; ++i)
+            {
+              r[i] = (r[i] + a[i]) & mask;
+            }
+            break;
+          case kind::BITVECTOR_MULT:
+            for (size_t i = 0; i < numPoints; ++i)
+            {
+              r[i] = (r[i] * a[i]) & mask;
+            }
+            break;
+          case kind::BITVECTOR_AND:
+            for (size_t i = 0; i < numPoints; ++i)
+            {
+              r[i] &= a[i];
+            }
+            break;
+          case kind::BITVECTOR_OR:
+            for (size_t i = 0; i < numPoints; ++i)
+            {
+              r[i] |= a[i];
+            }
+            break;
+          default:
+            for (size_t i = 0; i < numPoints; ++i)
+            {
+              r[i] ^= a[i];
+            }
+            break;
+        }
+      }
+      return true;
+    }
+    case kind::BITVECTOR_SUB:
+    {
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        r[i] = (cvals[0]->d_words[i] - cvals[1]->d_words[i]) & mask;
+      }
+      return true;
+    }
+    case kind::BITVECTOR_UDIV:
+    {
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        uint64_t b = cvals[1]->d_words[i];
+        r[i] = b == 0 ? mask : cvals[0]->d_words[i] / b;
+      }
+      return true;
+    }
+    case kind::BITVECTOR_UREM:
+    {
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        uint64_t a = cvals[0]->d_words[i];
+        uint64_t b = cvals[1]->d_words[i];
+        r[i] = b == 0 ? a : a % b;
+      }
+      return true;
+    }
+    case kind::BITVECTOR_SHL:
+    {
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        uint64_t b = cvals[1]->d_words[i];
+        r[i] = b >= width ? 0 : (cvals[0]->d_words[i] << b) & mask;
+      }
+      return true;
+    }
+    case kind::BITVECTOR_LSHR:
+    {
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        uint64_t b = cvals[1]->d_words[i];
+        r[i] = b >= width ? 0 : cvals[0]->d_words[i] >> b;
+      }
+      return true;
+    }
+    case kind::BITVECTOR_ASHR:
+    {
+      uint64_t sign = uint64_t(1) << (width - 1);
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        uint64_t a = cvals[0]->d_words[i];
+        uint64_t b = std::min<uint64_t>(cvals[1]->d_words[i], width - 1);
+        // shift in ones if the sign bit is set
+        r[i] = (a & sign) ? ~((~a & mask) >> b) & mask : a >> b;
+      }
+      return true;
+    }
+    case kind::BITVECTOR_EXTRACT:
+    {
+      unsigned lo = bv::utils::getExtractLow(n);
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        r[i] = (cvals[0]->d_words[i] >> lo) & mask;
+      }
+      return true;
+    }
+    case kind::BITVECTOR_CONCAT:
+    {
+      // since the concatenation has width at most 64, each child has width
+      // less than 64
+      r = cvals[0]->d_words;
+      for (size_t c = 1, nchildren = cvals.size(); c < nchildren; ++c)
+      {
+        unsigned cw = cvals[c]->d_width;
+        const std::vector<uint64_t>& a = cvals[c]->d_words;
+        for (size_t i = 0; i < numPoints; ++i)
+        {
+          r[i] = (r[i] << cw) | a[i];
+        }
+      }
+      return true;
+    }
+    case kind::ITE:
+    {
+      const BatchValues& c = *cvals[0];
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        r[i] = c.getBool(i) ? cvals[1]->d_words[i] : cvals[2]->d_words[i];
+      }
+      return true;
+    }
+    default: return false;
+  }
+}
+
+}  // namespace
+
+void Evaluator::evalBatch(TNode n,
+                          const std::vector<Node>& args,
+                          const std::vector<std::vector<Node>>& points,
+                          std::vector<Node>& results,
+                          bool useRewriter) const
+{
+  Trace("evaluator") << "Evaluating " << n << " for " << points.size()
+                     << " points of " << args << std::endl;
+  size_t numPoints = points.size();
+  std::unordered_map<TNode, size_t, TNodeHashFunction> argIndex;
+  for (size_t i = 0, nargs = args.size(); i < nargs; ++i)
+  {
+    // like eval, the first occurrence of a variable in args is used
+    argIndex.emplace(args[i], i);
+  }
+  std::unordered_map<TNode, BatchValues, TNodeHashFunction> values;
+  std::unordered_map<TNode, BatchValues, TNodeHashFunction>::iterator itv;
+  std::unordered_map<TNode, size_t, TNodeHashFunction>::iterator ita;
+  std::vector<TNode> visit;
+  std::vector<TNode> children;
+  std::vector<const BatchValues*> cvals;
+  std::unordered_map<Node, Node, NodeHashFunction> cvisited;
+  visit.push_back(n);
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    if (values.find(cur) != values.end())
+    {
+      visit.pop_back();
+      continue;
+    }
+    // The children whose values are needed first, including a non-constant
+    // operator. Closures are evaluated per point as a whole.
+    children.clear();
+    if (!cur.isClosure())
+    {
+      if (cur.getMetaKind() == kind::metakind::PARAMETERIZED
+          && !cur.getOperator().isConst())
+      {
+        children.push_back(cur.getOperator());
+      }
+      children.insert(children.end(), cur.begin(), cur.end());
+    }
+    bool childrenDone = true;
+    for (TNode child : children)
+    {
+      if (values.find(child) == values.end())
+      {
+        visit.push_back(child);
+        childrenDone = false;
+      }
+    }
+    if (!childrenDone)
+    {
+      continue;
+    }
+    visit.pop_back();
+
+    BatchValues& res = values[cur];
+    if (cur.isConst())
+    {
+      res.d_nodes.assign(numPoints, cur);
+      res.pack();
+      continue;
+    }
+    if (cur.isVar() && (ita = argIndex.find(cur)) != argIndex.end())
+    {
+      res.d_nodes.reserve(numPoints);
+      for (const std::vector<Node>& p : points)
+      {
+        res.d_nodes.push_back(p[ita->second]);
+      }
+      res.pack();
+      continue;
+    }
+    cvals.clear();
+    for (TNode child : children)
+    {
+      cvals.push_back(&values[child]);
+    }
+    if (!cvals.empty() && evalBatchPacked(cur, cvals, numPoints, res))
+    {
+      continue;
+    }
+    // evaluate per point, with the values of the children
+    Trace("evaluator") << "Evaluator: evaluate per point " << cur << std::endl;
+    res = BatchValues();
+    res.d_nodes.reserve(numPoints);
+    for (size_t i = 0; i < numPoints; ++i)
+    {
+      cvisited.clear();
+      for (size_t c = 0, nchildren = children.size(); c < nchildren; ++c)
+      {
+        Node cv = cvals[c]->toNode(i);
+        if (!cv.isNull())
+        {
+          cvisited[children[c]] = cv;
+        }
+      }
+      res.d_nodes.push_back(eval(cur, args, points[i], cvisited, useRewriter));
+    }
+    res.pack();
+  }
+
+  const BatchValues& nvals = values[n];
+  results.clear();
+  results.reserve(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    results.push_back(nvals.toNode(i));
+  }
+}
+
 }  // namespace theory
 }  // namespace cvc5
@@ -79,6 +79,15 @@ struct EvalResult
   Node toNode() const;
 };
 
+/** The mask of the lower width bits of a word, for 0 < width <= 64. */
+uint64_t bvMask(unsigned width);
+
+/**
+ * The value of the bit-vector v of the given width, for 0 < width <= 64, as a
+ * signed integer.
+ */
+int64_t bvSigned(uint64_t v, unsigned width);
+
 /**
  * The class that performs the actual evaluation of a term under a
  * substitution. Right now, the class does not cache anything between different
@@ -118,6 +127,24 @@ class Evaluator
             const std::vector<Node>& vals,
             const std::unordered_map<Node, Node, NodeHashFunction>& visited,
             bool useRewriter = true) const;
+  /**
+   * Evaluates node `n` under each of the substitutions of the variables
+   * `args` by the values `points[i]`, and stores the result for `points[i]`
+   * in `results[i]`. The result for each point is the same as the one of
+   * eval(n, args, points[i], useRewriter), except that it may be a constant
+   * where eval returns null because useRewriter is false.
+   *
+   * Unlike calling eval for each point, this traverses n once and computes
+   * the values of each subterm for all points at once. Boolean values and
+   * bit-vector values of width at most 64 are stored in packed arrays of
+   * machine words, such that the operators on them are evaluated in tight
+   * loops over all points. Other subterms are evaluated per point.
+   */
+  void evalBatch(TNode n,
+                 const std::vector<Node>& args,
+                 const std::vector<std::vector<Node>>& points,
+                 std::vector<Node>& results,
+                 bool useRewriter = true) const;
 
  private:
   /**
@@ -47,6 +47,7 @@ CandidateGeneratorQE::CandidateGeneratorQE(QuantifiersState& qs,
     : CandidateGenerator(qs, tr),
       d_term_iter(-1),
       d_term_iter_limit(0),
+      d_cands(nullptr),
       d_mode(cand_term_none)
 {
   d_op = d_treg.getTermDatabase()->getMatchOperator(pat);
@@ -62,15 +63,23 @@ void CandidateGeneratorQE::resetForOperator(Node eqc, Node op)
   d_op = op;
   d_term_iter_limit = d_treg.getTermDatabase()->getNumGroundTerms(d_op);
   if( eqc.isNull() ){
-    d_mode = cand_term_db;
+    if (d_cands != nullptr && d_exclude_eqc.empty())
+    {
+      d_term_iter_limit = d_cands->size();
+      d_mode = cand_term_list;
+    }
+    else
+    {
+      d_mode = cand_term_db;
+    }
   }else{
     if( isExcludedEqc( eqc ) ){
       d_mode = cand_term_none;
     }else{
       eq::EqualityEngine* ee = d_qs.getEqualityEngine();
       if( ee->hasTerm( eqc ) ){
-        TNodeTrie* tat = d_treg.getTermDatabase()->getTermArgTrie(eqc, op);
-        if( tat ){
+        TermArgTable* tat = d_treg.getTermDatabase()->getTermArgTable(op);
+        if( tat->hasTermsInEqc( eqc ) ){
           //create an equivalence class iterator in eq class eqc
           Node rep = ee->getRepresentative( eqc );
           d_eqc_iter = eq::EqClassIterator( rep, ee );
@@ -121,6 +130,14 @@ Node CandidateGeneratorQE::getNextCandidateInternal()
         }
       }
     }
+  }
+  else if (d_mode == cand_term_list)
+  {
+    // the candidates were checked to be legal when the list was computed
+    if (d_term_iter < d_term_iter_limit)
+    {
+      return (*d_cands)[d_term_iter++];
+    }
   }else if( d_mode==cand_term_eqc ){
     Debug("cand-gen-qe") << "...get next candidate in eqc" << std::endl;
     while( !d_eqc_iter.isFinished() ){
@@ -86,7 +86,10 @@ class CandidateGenerator {
  * (1) cand_term_db: iterate over all ground terms for the given operator,
  * (2) cand_term_ident: generate the given input term as a candidate,
  * (3) cand_term_eqc: iterate over all terms in an equivalence class, returning
- * those with the proper operator as candidates.
+ * those with the proper operator as candidates,
+ * (4) cand_term_list: iterate over a list of ground terms for the given
+ * operator that was computed for this generator by a TriggerIndex, which is
+ * used instead of (1) if set.
  */
 class CandidateGeneratorQE : public CandidateGenerator
 {
@@ -105,6 +108,14 @@ class CandidateGeneratorQE : public CandidateGenerator
   {
     return d_exclude_eqc.find(r) != d_exclude_eqc.end();
   }
+  /**
+   * Set the list of candidates to generate when this class is reset for all
+   * equivalence classes, which must be the legal and current ground terms of
+   * the operator that may match, in the order of the term database. If null,
+   * we iterate over all ground terms of the operator.
+   */
+  void setCandidates(const std::vector<Node>* cands) { d_cands = cands; }
+
  protected:
   /** reset this class for matching operator op in equivalence class eqc */
   void resetForOperator(Node eqc, Node op);
@@ -120,11 +131,14 @@ class CandidateGeneratorQE : public CandidateGenerator
   int d_term_iter_limit;
   /** the current equivalence class */
   Node d_eqc;
+  /** the list of candidates (for cand_term_list), if set */
+  const std::vector<Node>* d_cands;
   /** candidate generation modes */
   enum {
     cand_term_db,
     cand_term_ident,
     cand_term_eqc,
+    cand_term_list,
     cand_term_none,
   };
   /** the current mode of this candidate generator */
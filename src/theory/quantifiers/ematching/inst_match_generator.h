@@ -102,6 +102,8 @@ class CandidateGenerator;
 * ground terms not in the equivalence class of b.
 */
 class InstMatchGenerator : public IMGenerator {
+  friend class TriggerIndex;
+
  public:
   /** destructor */
   ~InstMatchGenerator() override;
@@ -14,12 +14,24 @@
 
 #include "theory/quantifiers/ematching/inst_strategy_e_matching.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "options/quantifiers_options.h"
+#include "options/uf_options.h"
+#include "smt/smt_engine_scope.h"
 #include "theory/quantifiers/ematching/pattern_term_selector.h"
 #include "theory/quantifiers/ematching/trigger_database.h"
+#include "theory/quantifiers/instantiate.h"
 #include "theory/quantifiers/quant_relevance.h"
 #include "theory/quantifiers/quantifiers_inference_manager.h"
 #include "theory/quantifiers/quantifiers_registry.h"
 #include "theory/quantifiers/quantifiers_state.h"
+#include "theory/quantifiers/term_database.h"
+#include "theory/quantifiers/term_registry.h"
 #include "util/random.h"
 
 using namespace cvc5::kind;
@@ -68,7 +80,7 @@ InstStrategyAutoGenTriggers::InstStrategyAutoGenTriggers(
     QuantifiersRegistry& qr,
     TermRegistry& tr,
     QuantRelevance* qrlv)
-    : InstStrategy(td, qs, qim, qr, tr), d_quant_rel(qrlv)
+    : InstStrategy(td, qs, qim, qr, tr), d_numThreads(1), d_quant_rel(qrlv)
 {
   //how to select trigger terms
   d_tr_strategy = options::triggerSelMode();
@@ -80,10 +92,24 @@ InstStrategyAutoGenTriggers::InstStrategyAutoGenTriggers(
     d_regenerate_frequency = 1;
     d_regenerate = false;
   }
+  if (options::triggerIndex())
+  {
+    d_index.reset(new inst::TriggerIndex(qs, tr));
+  }
+  // higher-order triggers modify their instantiations before sending them
+  if (!options::ufHo())
+  {
+    d_numThreads = options::quantThreads();
+  }
 }
 
 void InstStrategyAutoGenTriggers::processResetInstantiationRound( Theory::Effort effort ){
   Trace("inst-alg-debug") << "reset auto-gen triggers" << std::endl;
+  if (d_index != nullptr)
+  {
+    // compute the candidates of the indexed triggers before they are reset
+    d_index->resetInstantiationRound();
+  }
   //reset triggers
   for( unsigned r=0; r<2; r++ ){
     std::map<Node, std::map<inst::Trigger*, bool> >& agts =
@@ -100,6 +126,7 @@ void InstStrategyAutoGenTriggers::processResetInstantiationRound( Theory::Effort
     }
   }
   d_processed_trigger.clear();
+  d_tasks.clear();
   Trace("inst-alg-debug") << "done reset auto-gen triggers" << std::endl;
 }
 
@@ -180,7 +207,10 @@ InstStrategyStatus InstStrategyAutoGenTriggers::process(Node f,
     }
   }
 
-  bool hasInst = false;
+  // the enabled triggers that were not processed this round, in order
+  std::vector<Trigger*> triggers;
+  size_t numSingle = 0;
+  bool concurrent = d_numThreads > 1;
   for (unsigned r = 0; r < 2; r++)
   {
     std::map<Trigger*, bool>& agt = d_auto_gen_trigger[r][f];
@@ -198,27 +228,176 @@ InstStrategyStatus InstStrategyAutoGenTriggers::process(Node f,
         // trigger is already processed this round
         continue;
       }
+      triggers.push_back(tr);
+      concurrent = concurrent && tr->isConcurrent();
+    }
+    if (r == 0)
+    {
+      numSingle = triggers.size();
+    }
+  }
+  if (concurrent && !triggers.empty())
+  {
+    Trace("process-trigger") << "  Defer " << triggers.size() << " triggers"
+                             << std::endl;
+    for (Trigger* tr : triggers)
+    {
       d_processed_trigger[f][tr] = true;
-      Trace("process-trigger") << "  Process ";
-      tr->debugPrint("process-trigger");
-      Trace("process-trigger") << "..." << std::endl;
-      unsigned numInst = tr->addInstantiations();
-      hasInst = numInst > 0 || hasInst;
-      Trace("process-trigger")
-          << "  Done, numInst = " << numInst << "." << std::endl;
-      if (d_qstate.isInConflict())
-      {
-        break;
-      }
     }
-    if (d_qstate.isInConflict() || (hasInst && options::multiTriggerPriority()))
+    d_tasks.emplace_back();
+    MatchTask& t = d_tasks.back();
+    t.d_quant = f;
+    t.d_triggers.swap(triggers);
+    t.d_numSingle = numSingle;
+    t.d_buffers.resize(t.d_triggers.size());
+    t.d_numMatched = 0;
+    return InstStrategyStatus::STATUS_UNKNOWN;
+  }
+  bool hasInst = false;
+  for (size_t i = 0, ntriggers = triggers.size(); i < ntriggers; i++)
+  {
+    if (i == numSingle && hasInst && options::multiTriggerPriority())
     {
       break;
     }
+    Trigger* tr = triggers[i];
+    d_processed_trigger[f][tr] = true;
+    Trace("process-trigger") << "  Process ";
+    tr->debugPrint("process-trigger");
+    Trace("process-trigger") << "..." << std::endl;
+    unsigned numInst = tr->addInstantiations();
+    hasInst = numInst > 0 || hasInst;
+    Trace("process-trigger")
+        << "  Done, numInst = " << numInst << "." << std::endl;
+    if (d_qstate.isInConflict())
+    {
+      break;
+    }
+    if (d_index != nullptr)
+    {
+      // the generator of tr was exhausted, hence all its matches were sent
+      d_index->notifyMatched(tr);
+    }
   }
   return InstStrategyStatus::STATUS_UNKNOWN;
 }
 
+void InstStrategyAutoGenTriggers::match(MatchTask& t)
+{
+  bool hasInst = false;
+  for (size_t i = 0, ntriggers = t.d_triggers.size(); i < ntriggers; i++)
+  {
+    if (i == t.d_numSingle && hasInst && options::multiTriggerPriority())
+    {
+      break;
+    }
+    hasInst = t.d_triggers[i]->addInstantiations() > 0 || hasInst;
+    t.d_numMatched = i + 1;
+  }
+}
+
+void InstStrategyAutoGenTriggers::processDeferred()
+{
+  if (d_tasks.empty())
+  {
+    return;
+  }
+  TermDb* tdb = d_treg.getTermDatabase();
+  tdb->freeze();
+  size_t size = d_tasks.size();
+  size_t numThreads = std::min(d_numThreads, size);
+  std::exception_ptr error;
+  if (!d_qstate.isInConflict())
+  {
+    Trace("inst-alg") << "Match the triggers of " << size
+                      << " quantified formulas on " << numThreads << " threads"
+                      << std::endl;
+    for (MatchTask& t : d_tasks)
+    {
+      for (size_t i = 0, ntriggers = t.d_triggers.size(); i < ntriggers; i++)
+      {
+        t.d_triggers[i]->setInstBuffer(&t.d_buffers[i]);
+      }
+    }
+    std::atomic<size_t> next(0);
+    std::mutex errorMutex;
+    SmtEngine* smt = smt::currentSmtEngine();
+    auto work = [&]() {
+      smt::SmtScope scope(smt);
+      try
+      {
+        for (size_t i = next.fetch_add(1); i < size; i = next.fetch_add(1))
+        {
+          match(d_tasks[i]);
+        }
+      }
+      catch (...)
+      {
+        // stop the other threads and rethrow the first exception below
+        next.store(size);
+        std::lock_guard<std::mutex> guard(errorMutex);
+        if (!error)
+        {
+          error = std::current_exception();
+        }
+      }
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numThreads; ++i)
+    {
+      threads.emplace_back(work);
+    }
+    work();
+    for (std::thread& t : threads)
+    {
+      t.join();
+    }
+    for (MatchTask& t : d_tasks)
+    {
+      for (Trigger* tr : t.d_triggers)
+      {
+        tr->setInstBuffer(nullptr);
+      }
+    }
+  }
+  tdb->unfreeze();
+  if (error)
+  {
+    d_tasks.clear();
+    std::rethrow_exception(error);
+  }
+  // add the instantiations in the order of the quantified formulas
+  Instantiate* ie = d_qim.getInstantiate();
+  for (MatchTask& t : d_tasks)
+  {
+    for (size_t i = 0; i < t.d_numMatched && !d_qstate.isInConflict(); i++)
+    {
+      for (std::pair<std::vector<Node>, InferenceId>& inst :
+           t.d_buffers[i].d_insts)
+      {
+        ie->addInstantiation(t.d_quant, inst.first, inst.second);
+        if (d_qstate.isInConflict())
+        {
+          break;
+        }
+      }
+      if (d_index != nullptr && !d_qstate.isInConflict())
+      {
+        // the generator of the trigger was exhausted
+        d_index->notifyMatched(t.d_triggers[i]);
+      }
+    }
+    // the triggers that were not matched may be processed at a higher effort
+    for (size_t i = t.d_numMatched, ntriggers = t.d_triggers.size();
+         i < ntriggers;
+         i++)
+    {
+      d_processed_trigger[t.d_quant].erase(t.d_triggers[i]);
+    }
+  }
+  d_tasks.clear();
+}
+
 void InstStrategyAutoGenTriggers::generateTriggers( Node f ){
   Trace("auto-gen-trigger-debug") << "Generate triggers for " << f << ", #var=" << f[0].getNumChildren() << "..." << std::endl;
 
@@ -642,6 +821,10 @@ void InstStrategyAutoGenTriggers::addTrigger( inst::Trigger * tr, Node q ) {
   else
   {
     tindex = 0;
+    if (d_index != nullptr)
+    {
+      d_index->addTrigger(tr);
+    }
   }
   // making it during an instantiation round, so must reset
   std::map<Trigger*, bool>& agt = d_auto_gen_trigger[tindex][q];
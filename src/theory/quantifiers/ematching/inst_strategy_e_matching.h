@@ -17,8 +17,12 @@
 #ifndef CVC4__INST_STRATEGY_E_MATCHING_H
 #define CVC4__INST_STRATEGY_E_MATCHING_H
 
+#include <memory>
+#include <vector>
+
 #include "theory/quantifiers/ematching/inst_strategy.h"
 #include "theory/quantifiers/ematching/trigger.h"
+#include "theory/quantifiers/ematching/trigger_index.h"
 #include "theory/quantifiers/quant_relevance.h"
 
 namespace cvc5 {
@@ -63,6 +67,29 @@ class InstStrategyAutoGenTriggers : public InstStrategy
   std::map<Node, unsigned> d_num_trigger_vars;
   std::map<Node, Node> d_vc_partition[2];
   std::map<Node, Node> d_pat_to_mpat;
+  /** The index selecting the candidates of single triggers, if enabled */
+  std::unique_ptr<inst::TriggerIndex> d_index;
+  /**
+   * The triggers of a quantified formula that are matched on a worker thread,
+   * see processDeferred.
+   */
+  struct MatchTask
+  {
+    /** The quantified formula */
+    Node d_quant;
+    /** The single triggers followed by the multi triggers to match */
+    std::vector<inst::Trigger*> d_triggers;
+    /** The number of single triggers */
+    size_t d_numSingle;
+    /** The instantiations of each trigger */
+    std::vector<inst::InstBuffer> d_buffers;
+    /** The number of triggers that were matched */
+    size_t d_numMatched;
+  };
+  /** The number of threads used for matching, or one if not concurrent */
+  size_t d_numThreads;
+  /** The tasks of the current effort level that were not processed yet */
+  std::vector<MatchTask> d_tasks;
 
  private:
   /** process functions */
@@ -79,6 +106,8 @@ class InstStrategyAutoGenTriggers : public InstStrategy
   bool generatePatternTerms(Node q);
   void addPatternToPool(Node q, Node pat, unsigned num_fv, Node mpat);
   void addTrigger(inst::Trigger* tr, Node f);
+  /** Match the triggers of task t, which may be called on a worker thread */
+  static void match(MatchTask& t);
   /** has user patterns */
   bool hasUserPatterns(Node q);
   /** has user patterns */
@@ -102,6 +131,19 @@ class InstStrategyAutoGenTriggers : public InstStrategy
   }
   /** add pattern */
   void addUserNoPattern(Node q, Node pat);
+  /**
+   * Match the triggers that process deferred to the end of the current effort
+   * level.
+   *
+   * With --quant-threads=N for N > 1, process does not match the triggers of
+   * a quantified formula when they can all be matched concurrently, see
+   * Trigger::isConcurrent. Instead, it records them in a task. This method
+   * freezes the term database, matches the tasks on the calling thread and
+   * N - 1 worker threads, and then adds the instantiations of each task in
+   * order. Duplicate instantiations of a quantified formula are removed by the
+   * worker that finds them, and by Instantiate::addInstantiation otherwise.
+   */
+  void processDeferred();
 
  private:
   /**
@@ -109,6 +109,15 @@ void InstantiationEngine::doInstantiationRound( Theory::Effort effort ){
         }
       }
     }
+    if (d_i_ag != nullptr)
+    {
+      // match the auto-generated triggers that were deferred
+      d_i_ag->processDeferred();
+      if (d_qstate.isInConflict())
+      {
+        return;
+      }
+    }
     //do not consider another level if already added lemma at this level
     if (d_qim.numPendingLemmas() > lastWaiting)
     {
@@ -14,6 +14,8 @@
 
 #include "theory/quantifiers/ematching/trigger.h"
 
+#include <unordered_set>
+
 #include "expr/skolem_manager.h"
 #include "options/quantifiers_options.h"
 #include "theory/quantifiers/ematching/candidate_generator.h"
@@ -46,7 +48,13 @@ Trigger::Trigger(QuantifiersState& qs,
                  TermRegistry& tr,
                  Node q,
                  std::vector<Node>& nodes)
-    : d_qstate(qs), d_qim(qim), d_qreg(qr), d_treg(tr), d_quant(q)
+    : d_ufOnly(true),
+      d_instBuffer(nullptr),
+      d_qstate(qs),
+      d_qim(qim),
+      d_qreg(qr),
+      d_treg(tr),
+      d_quant(q)
 {
   // We must ensure that the ground subterms of the trigger have been
   // preprocessed.
@@ -56,6 +64,20 @@ Trigger::Trigger(QuantifiersState& qs,
     Node np = ensureGroundTermPreprocessed(val, n, d_groundTerms);
     d_nodes.push_back(np);
   }
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit(d_nodes.begin(), d_nodes.end());
+  while (d_ufOnly && !visit.empty())
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (cur.getKind() == INST_CONSTANT || !TermUtil::hasInstConstAttr(cur)
+        || !visited.insert(cur).second)
+    {
+      continue;
+    }
+    d_ufOnly = cur.getKind() == APPLY_UF;
+    visit.insert(visit.end(), cur.begin(), cur.end());
+  }
   if (Trace.isOn("trigger"))
   {
     QuantAttributes& qa = d_qreg.getQuantAttributes();
@@ -100,6 +122,15 @@ Trigger::~Trigger() {
   delete d_mg;
 }
 
+InstMatchGenerator* Trigger::getInstMatchGenerator()
+{
+  if (d_nodes.size() == 1 && !TriggerTermInfo::isSimpleTrigger(d_nodes[0]))
+  {
+    return static_cast<InstMatchGenerator*>(d_mg);
+  }
+  return nullptr;
+}
+
 void Trigger::resetInstantiationRound() { d_mg->resetInstantiationRound(); }
 
 void Trigger::reset(Node eqc) { d_mg->reset(eqc); }
@@ -147,6 +178,16 @@ uint64_t Trigger::addInstantiations()
 
 bool Trigger::sendInstantiation(std::vector<Node>& m, InferenceId id)
 {
+  if (d_instBuffer != nullptr)
+  {
+    if (!d_instBuffer->d_terms.insert(m).second)
+    {
+      // already sent
+      return false;
+    }
+    d_instBuffer->d_insts.emplace_back(m, id);
+    return true;
+  }
   return d_qim.getInstantiate()->addInstantiation(d_quant, m, id);
 }
 
@@ -226,6 +267,23 @@ void Trigger::debugPrint(const char* c) const
   Trace(c) << "TRIGGER( " << d_nodes << " )" << std::endl;
 }
 
+bool Trigger::isConcurrent() const
+{
+  if (!d_ufOnly)
+  {
+    return false;
+  }
+  eq::EqualityEngine* ee = d_qstate.getEqualityEngine();
+  for (const Node& gt : d_groundTerms)
+  {
+    if (!ee->hasTerm(gt))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace inst
 }  // namespace quantifiers
 }  // namespace theory
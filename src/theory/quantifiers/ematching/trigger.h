@@ -17,6 +17,10 @@
 #ifndef CVC4__THEORY__QUANTIFIERS__TRIGGER_H
 #define CVC4__THEORY__QUANTIFIERS__TRIGGER_H
 
+#include <set>
+#include <utility>
+#include <vector>
+
 #include "expr/node.h"
 #include "theory/inference_id.h"
 
@@ -37,6 +41,20 @@ namespace inst {
 
 class IMGenerator;
 class InstMatchGenerator;
+
+/**
+ * The instantiations sent by a trigger while it is matched on a worker
+ * thread, which are added on the thread owning the quantifiers engine once
+ * matching is done.
+ */
+struct InstBuffer
+{
+  /** The instantiations and their identifiers, in the order they were sent */
+  std::vector<std::pair<std::vector<Node>, InferenceId>> d_insts;
+  /** The terms of the above instantiations */
+  std::set<std::vector<Node>> d_terms;
+};
+
 /** A collection of nodes representing a trigger.
 *
 * This class encapsulates all implementations of E-matching in CVC4.
@@ -112,6 +130,12 @@ class Trigger {
   virtual ~Trigger();
   /** get the generator associated with this trigger */
   IMGenerator* getGenerator() { return d_mg; }
+  /**
+   * Get the generator associated with this trigger if it is a non-simple
+   * single trigger, whose generator is an InstMatchGenerator, or nullptr
+   * otherwise.
+   */
+  InstMatchGenerator* getInstMatchGenerator();
   /** Reset instantiation round.
    *
   * Called once at beginning of an instantiation round.
@@ -151,6 +175,21 @@ class Trigger {
   int getActiveScore();
   /** print debug information for the trigger */
   void debugPrint(const char* c) const;
+  /**
+   * Can addInstantiations be called on a worker thread, concurrently with
+   * other triggers? This is the case if the generators of this trigger only
+   * query the term database and the equality engine, which holds if the
+   * non-ground subterms of its nodes are variables and applications of
+   * uninterpreted functions, and if it adds no purification lemmas, which
+   * holds if its ground terms are in the equality engine. The term database
+   * must be frozen while matching, see TermDb::freeze.
+   */
+  bool isConcurrent() const;
+  /**
+   * Set the buffer that the instantiations of this trigger are added to
+   * instead of being sent, or nullptr to send them again.
+   */
+  void setInstBuffer(InstBuffer* b) { d_instBuffer = b; }
 
  protected:
   /** add an instantiation (called by InstMatchGenerator)
@@ -198,6 +237,13 @@ class Trigger {
    * This example would fail to match when f(a) is not registered.
    */
   std::vector<Node> d_groundTerms;
+  /**
+   * Whether the non-ground subterms of the nodes of this trigger are variables
+   * and applications of uninterpreted functions.
+   */
+  bool d_ufOnly;
+  /** The buffer set by setInstBuffer, if any */
+  InstBuffer* d_instBuffer;
   /** Reference to the quantifiers state */
   QuantifiersState& d_qstate;
   /** Reference to the quantifiers inference manager */
@@ -0,0 +1,350 @@
+/*********************                                                        */
+/*! \file trigger_index.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the discrimination tree over trigger patterns
+ **/
+
+#include "theory/quantifiers/ematching/trigger_index.h"
+
+#include <algorithm>
+
+#include "options/quantifiers_options.h"
+#include "options/uf_options.h"
+#include "theory/quantifiers/ematching/candidate_generator.h"
+#include "theory/quantifiers/ematching/inst_match_generator.h"
+#include "theory/quantifiers/ematching/trigger.h"
+#include "theory/quantifiers/quantifiers_state.h"
+#include "theory/quantifiers/term_database.h"
+#include "theory/quantifiers/term_registry.h"
+#include "theory/uf/equality_engine_iterator.h"
+
+using namespace cvc5::kind;
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+namespace inst {
+
+TriggerIndex::TriggerIndex(QuantifiersState& qs, TermRegistry& tr)
+    : d_qstate(qs), d_treg(tr), d_watermark(qs.getSatContext())
+{
+}
+
+bool TriggerIndex::isIndexable(const InstMatchGenerator* g)
+{
+  return g->d_cg != nullptr && g->d_match_pattern.getKind() == APPLY_UF
+         && g->d_pattern == g->d_match_pattern && g->d_eq_class_rel.isNull();
+}
+
+size_t TriggerIndex::getDepth(const InstMatchGenerator* g)
+{
+  size_t depth = 0;
+  for (const InstMatchGenerator* c : g->d_children)
+  {
+    depth = std::max(depth, getDepth(c));
+  }
+  return depth + 1;
+}
+
+void TriggerIndex::addTrigger(Trigger* tr)
+{
+  InstMatchGenerator* g = tr->getInstMatchGenerator();
+  if (g == nullptr || !isIndexable(g)
+      || d_genIndex.find(g) != d_genIndex.end())
+  {
+    return;
+  }
+  Node pat = g->d_match_pattern;
+  Trace("trigger-index") << "TriggerIndex: add " << pat << std::endl;
+  IndexNode* in = &d_trees[g->d_match_pattern_op];
+  for (size_t i = 0, nchild = pat.getNumChildren(); i < nchild; i++)
+  {
+    int64_t ct = g->d_children_types[i];
+    if (ct == -1)
+    {
+      in = &in->d_ground[pat[i]];
+      continue;
+    }
+    Node op;
+    if (ct == -2)
+    {
+      for (size_t k = 0, nmg = g->d_children.size(); k < nmg; k++)
+      {
+        if (g->d_children_index[k] == i)
+        {
+          if (isIndexable(g->d_children[k]))
+          {
+            op = g->d_children[k]->d_match_pattern_op;
+          }
+          break;
+        }
+      }
+    }
+    if (op.isNull())
+    {
+      if (in->d_any == nullptr)
+      {
+        in->d_any.reset(new IndexNode);
+      }
+      in = in->d_any.get();
+    }
+    else
+    {
+      in = &in->d_app[op];
+    }
+  }
+  d_genIndex[g] = d_gens.size();
+  in->d_triggers.push_back(d_gens.size());
+  d_gens.push_back(g);
+  d_depth.push_back(getDepth(g));
+  // until the next round, the generator is matched against all terms
+  d_roundStart.push_back(d_qstate.getNumModified());
+  d_cands.emplace_back();
+}
+
+void TriggerIndex::resetInstantiationRound()
+{
+  if (d_gens.empty())
+  {
+    return;
+  }
+  TermDb* tdb = d_treg.getTermDatabase();
+  for (std::vector<Node>& c : d_cands)
+  {
+    c.clear();
+  }
+  size_t nmod = d_qstate.getNumModified();
+  d_time.clear();
+  d_depthTime.clear();
+  if (options::eMatchingIncremental())
+  {
+    // only the modifications after the smallest watermark are relevant
+    size_t start = nmod;
+    size_t maxDepth = 1;
+    for (size_t i = 0, ngens = d_gens.size(); i < ngens; i++)
+    {
+      context::CDHashMap<size_t, size_t>::const_iterator it =
+          d_watermark.find(i);
+      if (it != d_watermark.end())
+      {
+        start = std::min(start, (*it).second);
+        maxDepth = std::max(maxDepth, d_depth[i]);
+      }
+    }
+    for (size_t i = start; i < nmod; i++)
+    {
+      // later modifications have larger stamps
+      d_time[d_qstate.getRepresentative(d_qstate.getModified(i))] = i + 1;
+    }
+    d_depthTime.resize(maxDepth - 1);
+  }
+  for (size_t& rs : d_roundStart)
+  {
+    rs = nmod;
+  }
+  std::vector<Node> reps;
+  for (std::pair<const Node, IndexNode>& t : d_trees)
+  {
+    computeGroundReps(&t.second);
+    // the terms of the table are the terms CandidateGeneratorQE returns, up
+    // to congruence
+    TermArgTable* tat = tdb->getTermArgTable(t.first);
+    for (size_t i = 0, nterms = tat->getNumTerms(); i < nterms; i++)
+    {
+      if (!isTermOf(tat->getTerm(i), t.first))
+      {
+        continue;
+      }
+      reps.clear();
+      for (size_t j = 0, nargs = tat->getNumArgs(i); j < nargs; j++)
+      {
+        reps.push_back(tat->getArg(i, j));
+      }
+      d_stamps.clear();
+      addCandidate(&t.second, tat->getTerm(i), reps, 0);
+    }
+    for (const Node& n : tat->getUnindexedTerms())
+    {
+      if (!isTermOf(n, t.first))
+      {
+        continue;
+      }
+      reps.clear();
+      for (const Node& nc : n)
+      {
+        reps.push_back(d_qstate.getRepresentative(nc));
+      }
+      d_stamps.clear();
+      addCandidate(&t.second, n, reps, 0);
+    }
+  }
+  for (size_t i = 0, ngens = d_gens.size(); i < ngens; i++)
+  {
+    Trace("trigger-index") << "TriggerIndex: " << d_cands[i].size()
+                           << " candidates for " << d_gens[i]->d_pattern
+                           << std::endl;
+    static_cast<CandidateGeneratorQE*>(d_gens[i]->d_cg)
+        ->setCandidates(&d_cands[i]);
+  }
+}
+
+void TriggerIndex::notifyMatched(Trigger* tr)
+{
+  if (!options::eMatchingIncremental())
+  {
+    return;
+  }
+  InstMatchGenerator* g = tr->getInstMatchGenerator();
+  std::unordered_map<InstMatchGenerator*, size_t>::iterator it =
+      d_genIndex.find(g);
+  if (it != d_genIndex.end())
+  {
+    d_watermark[it->second] = d_roundStart[it->second];
+  }
+}
+
+bool TriggerIndex::isTermOf(Node t, Node op)
+{
+  // in higher-order logic, the table of op also has the terms of the
+  // operators that are equal to it, which CandidateGeneratorQE does not return
+  return !options::ufHo()
+         || d_treg.getTermDatabase()->getMatchOperator(t) == op;
+}
+
+size_t TriggerIndex::getTime(Node r, size_t k)
+{
+  if (k == 0)
+  {
+    std::unordered_map<Node, size_t, NodeHashFunction>::iterator it =
+        d_time.find(r);
+    return it == d_time.end() ? 0 : it->second;
+  }
+  std::unordered_map<Node, size_t, NodeHashFunction>& dt = d_depthTime[k - 1];
+  std::unordered_map<Node, size_t, NodeHashFunction>::iterator it = dt.find(r);
+  if (it != dt.end())
+  {
+    return it->second;
+  }
+  size_t time = getTime(r, 0);
+  if (d_qstate.hasTerm(r))
+  {
+    eq::EqClassIterator eqc(r, d_qstate.getEqualityEngine());
+    while (!eqc.isFinished())
+    {
+      Node s = *eqc;
+      ++eqc;
+      if (s.isClosure())
+      {
+        continue;
+      }
+      for (const Node& sc : s)
+      {
+        time = std::max(time, getTime(d_qstate.getRepresentative(sc), k - 1));
+      }
+    }
+  }
+  dt[r] = time;
+  return time;
+}
+
+bool TriggerIndex::isModified(Node t, const std::vector<Node>& reps, size_t i)
+{
+  if (!options::eMatchingIncremental())
+  {
+    return true;
+  }
+  context::CDHashMap<size_t, size_t>::const_iterator it = d_watermark.find(i);
+  // terms that are not in the equality engine are not tracked
+  if (it == d_watermark.end() || !d_qstate.hasTerm(t))
+  {
+    return true;
+  }
+  size_t depth = d_depth[i];
+  std::map<size_t, size_t>::iterator its = d_stamps.find(depth);
+  if (its == d_stamps.end())
+  {
+    size_t stamp = getTime(d_qstate.getRepresentative(t), 0);
+    for (const Node& r : reps)
+    {
+      stamp = std::max(stamp, getTime(r, depth - 1));
+    }
+    its = d_stamps.insert(std::pair<size_t, size_t>(depth, stamp)).first;
+  }
+  return its->second > (*it).second;
+}
+
+void TriggerIndex::computeGroundReps(IndexNode* in)
+{
+  in->d_groundReps.clear();
+  for (std::pair<const Node, IndexNode>& g : in->d_ground)
+  {
+    Node r = d_qstate.getRepresentative(g.first);
+    in->d_groundReps[r].push_back(&g.second);
+    computeGroundReps(&g.second);
+  }
+  for (std::pair<const Node, IndexNode>& a : in->d_app)
+  {
+    computeGroundReps(&a.second);
+  }
+  if (in->d_any != nullptr)
+  {
+    computeGroundReps(in->d_any.get());
+  }
+}
+
+void TriggerIndex::addCandidate(IndexNode* in,
+                                Node t,
+                                const std::vector<Node>& reps,
+                                size_t argIndex)
+{
+  if (argIndex == reps.size())
+  {
+    for (size_t i : in->d_triggers)
+    {
+      if (isModified(t, reps, i))
+      {
+        d_cands[i].push_back(t);
+      }
+    }
+    return;
+  }
+  const Node& r = reps[argIndex];
+  if (in->d_any != nullptr)
+  {
+    addCandidate(in->d_any.get(), t, reps, argIndex + 1);
+  }
+  std::map<Node, std::vector<IndexNode*>>::iterator it =
+      in->d_groundReps.find(r);
+  if (it != in->d_groundReps.end())
+  {
+    for (IndexNode* c : it->second)
+    {
+      addCandidate(c, t, reps, argIndex + 1);
+    }
+  }
+  if (!in->d_app.empty())
+  {
+    // an argument that is not in the equality engine is only matched with
+    // itself, which we do not filter here
+    bool inEe = d_qstate.hasTerm(r);
+    TermDb* tdb = d_treg.getTermDatabase();
+    for (std::pair<const Node, IndexNode>& a : in->d_app)
+    {
+      if (!inEe || tdb->getTermArgTable(a.first)->hasTermsInEqc(r))
+      {
+        addCandidate(&a.second, t, reps, argIndex + 1);
+      }
+    }
+  }
+}
+
+}  // namespace inst
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
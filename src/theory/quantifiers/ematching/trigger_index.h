@@ -0,0 +1,194 @@
+/*********************                                                        */
+/*! \file trigger_index.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A discrimination tree over the patterns of triggers
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__QUANTIFIERS__TRIGGER_INDEX_H
+#define CVC4__THEORY__QUANTIFIERS__TRIGGER_INDEX_H
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "context/cdhashmap.h"
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+class QuantifiersState;
+class TermRegistry;
+
+namespace inst {
+
+class InstMatchGenerator;
+class Trigger;
+
+/**
+ * A discrimination tree over the patterns of non-simple single triggers,
+ * e.g. f(x, g(y), a), which selects the ground terms that each trigger is
+ * matched against in an instantiation round.
+ *
+ * Without this index, the generator of each such trigger iterates over all
+ * ground terms of its operator, and tries to match each of them, which is
+ * work proportional to the number of triggers times the number of terms per
+ * round. Instead, this class iterates once per round over the ground terms of
+ * each operator, and finds all triggers that may match a term t in a single
+ * traversal of the tree of the operator. Each level of the tree corresponds
+ * to an argument of the pattern, and is labelled with a constraint on the
+ * corresponding argument t_i of t:
+ * - variables do not constrain t_i,
+ * - ground arguments s require that t_i and s are equal,
+ * - nested applications g(...) require that the equivalence class of t_i
+ *   contains an application of g.
+ * These are exactly the conditions under which InstMatchGenerator::getMatch
+ * fails before it tries to match the nested patterns, hence the terms that
+ * are skipped would not have produced a match. The remaining terms are given
+ * to the candidate generator of the trigger as a list. The ground terms are
+ * taken from the TermArgTable of the operator, which has a single term per
+ * congruence class, and the representatives of its arguments. In
+ * higher-order logic, only the terms of the operator itself are taken from
+ * the table.
+ *
+ * With --e-matching-incremental, the candidates of a trigger are furthermore
+ * restricted to the terms whose match may have changed since the trigger was
+ * last fully matched in the current SAT context, based on the modifications
+ * of equivalence classes recorded by QuantifiersState. We remember, per
+ * trigger, the number of modifications at the beginning of the last round in
+ * which all its matches were sent (its watermark). A modification has time
+ * stamp i + 1 if it is the i-th one. The time of an equivalence class at
+ * depth 0 is the maximal stamp of its modifications, and at depth k > 0 it is
+ * the maximum of its time at depth 0 and the times at depth k - 1 of the
+ * arguments of its terms. The matches of a pattern of depth d against a term
+ * t only depend on the equivalence class of t, and of its arguments up to
+ * depth d - 1, hence t is a candidate only if the maximum of their times is
+ * greater than the watermark.
+ */
+class TriggerIndex
+{
+ public:
+  TriggerIndex(QuantifiersState& qs, TermRegistry& tr);
+
+  /**
+   * Add trigger tr to this index, if it is a non-simple single trigger whose
+   * pattern is an application of an uninterpreted function. Its candidates
+   * are computed from the next call to resetInstantiationRound() on.
+   */
+  void addTrigger(Trigger* tr);
+  /**
+   * Compute the candidates of all triggers in this index for the current
+   * instantiation round. This must be called after the term database is
+   * reset, and before the triggers are reset.
+   */
+  void resetInstantiationRound();
+  /**
+   * Notify that all matches of trigger tr were sent in the current round,
+   * which advances its watermark with --e-matching-incremental.
+   */
+  void notifyMatched(Trigger* tr);
+
+ private:
+  /** A node of the discrimination tree of an operator */
+  class IndexNode
+  {
+   public:
+    /** The child for arguments that are not constrained */
+    std::unique_ptr<IndexNode> d_any;
+    /** The children for ground arguments */
+    std::map<Node, IndexNode> d_ground;
+    /** The children for nested applications, by their match operator */
+    std::map<Node, IndexNode> d_app;
+    /** The triggers whose patterns end in this node, by their index */
+    std::vector<size_t> d_triggers;
+    /**
+     * The children in d_ground, by the representative of their ground
+     * argument in the current round
+     */
+    std::map<Node, std::vector<IndexNode*>> d_groundReps;
+  };
+  /**
+   * Is g a generator for an application of an uninterpreted function, which
+   * is matched against all ground terms of its operator by a
+   * CandidateGeneratorQE?
+   */
+  static bool isIndexable(const InstMatchGenerator* g);
+  /** Get the depth of the pattern of generator g */
+  static size_t getDepth(const InstMatchGenerator* g);
+  /**
+   * Is t a term of match operator op? In higher-order logic, the table of op
+   * in the term database also has the terms of the operators that are equal
+   * to op. These are skipped, since the candidate generator does not return
+   * them without this index either.
+   */
+  bool isTermOf(Node t, Node op);
+  /** Get the time of equivalence class r at depth k in the current round */
+  size_t getTime(Node r, size_t k);
+  /**
+   * Whether term t, with argument representatives reps, may have new matches
+   * for the i-th trigger since its watermark.
+   */
+  bool isModified(Node t, const std::vector<Node>& reps, size_t i);
+  /** Compute d_groundReps for the nodes of the tree rooted at in. */
+  void computeGroundReps(IndexNode* in);
+  /**
+   * Add t to the candidates of the triggers in the tree rooted at in that
+   * may match t, where reps are the representatives of the arguments of t
+   * and argIndex is the argument of the level of in.
+   */
+  void addCandidate(IndexNode* in,
+                    Node t,
+                    const std::vector<Node>& reps,
+                    size_t argIndex);
+  /** Reference to the quantifiers state */
+  QuantifiersState& d_qstate;
+  /** Reference to the term registry */
+  TermRegistry& d_treg;
+  /** The generators of the triggers in this index */
+  std::vector<InstMatchGenerator*> d_gens;
+  /** Maps the generators in d_gens to their index */
+  std::unordered_map<InstMatchGenerator*, size_t> d_genIndex;
+  /** The depths of the patterns of the generators in d_gens */
+  std::vector<size_t> d_depth;
+  /**
+   * The number of modifications when the candidates of the generators in
+   * d_gens were computed
+   */
+  std::vector<size_t> d_roundStart;
+  /**
+   * The watermarks of the generators in d_gens, by index. A generator has no
+   * watermark if it was not fully matched in this SAT context.
+   */
+  context::CDHashMap<size_t, size_t> d_watermark;
+  /** The times of equivalence classes at depth 0 in the current round */
+  std::unordered_map<Node, size_t, NodeHashFunction> d_time;
+  /** The times of equivalence classes at depth k + 1, computed lazily */
+  std::vector<std::unordered_map<Node, size_t, NodeHashFunction>> d_depthTime;
+  /** The times of the current candidate, by depth of the pattern */
+  std::map<size_t, size_t> d_stamps;
+  /**
+   * The candidates of the generators in d_gens in the current round, which
+   * are referenced by their candidate generators
+   */
+  std::deque<std::vector<Node>> d_cands;
+  /** The discrimination trees, by match operator */
+  std::map<Node, IndexNode> d_trees;
+};
+
+}  // namespace inst
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__QUANTIFIERS__TRIGGER_INDEX_H */
@@ -0,0 +1,297 @@
+/*********************                                                        */
+/*! \file inst_match_store.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the flat hash-based instantiation stores
+ **/
+
+#include "theory/quantifiers/inst_match_store.h"
+
+#include <ostream>
+
+#include "base/check.h"
+#include "theory/quantifiers/quantifiers_state.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+InstMatchStore::InstMatchStore(size_t arity) : d_arity(arity) {}
+
+uint32_t InstMatchStore::hash(const std::vector<Node>& m)
+{
+  // FNV-1a over the ids of the terms
+  uint64_t h = 14695981039346656037ULL;
+  for (const Node& n : m)
+  {
+    h = (h ^ n.getId()) * 1099511628211ULL;
+  }
+  return static_cast<uint32_t>(h ^ (h >> 32));
+}
+
+bool InstMatchStore::isTuple(size_t i, const std::vector<Node>& m) const
+{
+  for (size_t j = 0; j < d_arity; j++)
+  {
+    if (d_terms[i * d_arity + j] != m[j])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t InstMatchStore::findSlot(const std::vector<Node>& m, uint32_t h) const
+{
+  Assert(!d_slots.empty());
+  size_t mask = d_slots.size() - 1;
+  size_t pos = h & mask;
+  while (d_slots[pos] != 0)
+  {
+    size_t i = d_slots[pos] - 1;
+    if (d_hashes[i] == h && !d_removed[i] && isTuple(i, m))
+    {
+      break;
+    }
+    pos = (pos + 1) & mask;
+  }
+  return pos;
+}
+
+void InstMatchStore::eraseSlot(size_t pos)
+{
+  size_t mask = d_slots.size() - 1;
+  d_slots[pos] = 0;
+  size_t next = pos;
+  for (;;)
+  {
+    next = (next + 1) & mask;
+    if (d_slots[next] == 0)
+    {
+      return;
+    }
+    // the slot where the tuple at next would be inserted
+    size_t home = d_hashes[d_slots[next] - 1] & mask;
+    // it stays if home is cyclically in (pos, next]
+    bool stays = pos <= next ? (pos < home && home <= next)
+                             : (pos < home || home <= next);
+    if (!stays)
+    {
+      d_slots[pos] = d_slots[next];
+      d_slots[next] = 0;
+      pos = next;
+    }
+  }
+}
+
+void InstMatchStore::grow()
+{
+  std::vector<uint32_t> slots(d_slots.empty() ? 16 : 2 * d_slots.size(), 0);
+  d_slots.swap(slots);
+  size_t mask = d_slots.size() - 1;
+  for (uint32_t s : slots)
+  {
+    if (s != 0)
+    {
+      size_t pos = d_hashes[s - 1] & mask;
+      while (d_slots[pos] != 0)
+      {
+        pos = (pos + 1) & mask;
+      }
+      d_slots[pos] = s;
+    }
+  }
+}
+
+bool InstMatchStore::existsInstMatch(QuantifiersState& qs,
+                                     Node q,
+                                     const std::vector<Node>& m,
+                                     bool modEq)
+{
+  Assert(m.size() == d_arity);
+  sync();
+  if (!d_slots.empty() && d_slots[findSlot(m, hash(m))] != 0)
+  {
+    return true;
+  }
+  if (modEq)
+  {
+    for (size_t i = 0, ntuples = getNumTuples(); i < ntuples; i++)
+    {
+      if (d_removed[i])
+      {
+        continue;
+      }
+      bool eq = true;
+      for (size_t j = 0; j < d_arity && eq; j++)
+      {
+        eq = qs.areEqual(d_terms[i * d_arity + j], m[j]);
+      }
+      if (eq)
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool InstMatchStore::addInstMatch(QuantifiersState& qs,
+                                  Node q,
+                                  const std::vector<Node>& m,
+                                  bool modEq)
+{
+  if (existsInstMatch(qs, q, m, modEq))
+  {
+    return false;
+  }
+  // keep the load factor of the table at most 1/2
+  if (2 * (getNumTuples() + 1) > d_slots.size())
+  {
+    grow();
+  }
+  uint32_t h = hash(m);
+  size_t pos = findSlot(m, h);
+  Assert(d_slots[pos] == 0);
+  size_t i = getNumTuples();
+  d_terms.insert(d_terms.end(), m.begin(), m.end());
+  d_hashes.push_back(h);
+  d_removed.push_back(false);
+  d_slots[pos] = static_cast<uint32_t>(i + 1);
+  notifyAdded(i);
+  return true;
+}
+
+bool InstMatchStore::removeInstMatch(Node q, const std::vector<Node>& m)
+{
+  Assert(m.size() == d_arity);
+  sync();
+  if (d_slots.empty())
+  {
+    return false;
+  }
+  size_t pos = findSlot(m, hash(m));
+  if (d_slots[pos] == 0)
+  {
+    return false;
+  }
+  size_t i = d_slots[pos] - 1;
+  d_removed[i] = true;
+  notifyRemoved(i);
+  return true;
+}
+
+void InstMatchStore::truncate(size_t n)
+{
+  size_t mask = d_slots.size() - 1;
+  for (size_t i = getNumTuples(); i > n;)
+  {
+    i--;
+    // find the slot of the last tuple, and empty it
+    size_t pos = d_hashes[i] & mask;
+    while (d_slots[pos] != i + 1)
+    {
+      pos = (pos + 1) & mask;
+    }
+    eraseSlot(pos);
+    d_terms.resize(i * d_arity);
+    d_hashes.pop_back();
+    d_removed.pop_back();
+  }
+}
+
+void InstMatchStore::getInstantiations(Node q,
+                                       std::vector<std::vector<Node>>& insts)
+{
+  sync();
+  for (size_t i = 0, ntuples = getNumTuples(); i < ntuples; i++)
+  {
+    if (!d_removed[i])
+    {
+      insts.emplace_back(d_terms.begin() + i * d_arity,
+                         d_terms.begin() + (i + 1) * d_arity);
+    }
+  }
+}
+
+void InstMatchStore::clear()
+{
+  d_terms.clear();
+  d_hashes.clear();
+  d_removed.clear();
+  d_slots.clear();
+}
+
+void InstMatchStore::print(std::ostream& out, Node q)
+{
+  sync();
+  for (size_t i = 0, ntuples = getNumTuples(); i < ntuples; i++)
+  {
+    if (d_removed[i])
+    {
+      continue;
+    }
+    out << "  ( ";
+    for (size_t j = 0; j < d_arity; j++)
+    {
+      if (j > 0)
+      {
+        out << ", ";
+      }
+      out << d_terms[i * d_arity + j];
+    }
+    out << " )" << std::endl;
+  }
+}
+
+size_t InstMatchStore::getMemoryUsage() const
+{
+  return d_terms.capacity() * sizeof(Node)
+         + d_hashes.capacity() * sizeof(uint32_t)
+         + d_removed.capacity() / 8 + d_slots.capacity() * sizeof(uint32_t);
+}
+
+CDInstMatchStore::CDInstMatchStore(context::Context* c, size_t arity)
+    : InstMatchStore(arity), d_numTuples(c, 0), d_numRemoved(c, 0)
+{
+}
+
+void CDInstMatchStore::sync()
+{
+  // restore the tuples that were removed in popped contexts
+  while (d_removedTuples.size() > d_numRemoved.get())
+  {
+    size_t i = d_removedTuples.back();
+    d_removedTuples.pop_back();
+    if (i < getNumTuples())
+    {
+      setRemoved(i, false);
+    }
+  }
+  // forget the tuples that were added in popped contexts
+  if (getNumTuples() > d_numTuples.get())
+  {
+    truncate(d_numTuples.get());
+  }
+}
+
+void CDInstMatchStore::notifyAdded(size_t i)
+{
+  Assert(i == d_numTuples.get());
+  d_numTuples = i + 1;
+}
+
+void CDInstMatchStore::notifyRemoved(size_t i)
+{
+  d_removedTuples.push_back(i);
+  d_numRemoved = d_removedTuples.size();
+}
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
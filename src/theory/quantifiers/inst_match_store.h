@@ -0,0 +1,153 @@
+/*********************                                                        */
+/*! \file inst_match_store.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Flat hash-based stores for the instantiations of a quantified
+ ** formula
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__QUANTIFIERS__INST_MATCH_STORE_H
+#define CVC4__THEORY__QUANTIFIERS__INST_MATCH_STORE_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "context/cdo.h"
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+class QuantifiersState;
+
+/**
+ * A store for the instantiations of a quantified formula q, which is an
+ * alternative to InstMatchTrie with the same interface.
+ *
+ * The instantiations are tuples of terms whose size is the number of
+ * variables of q. They are kept contiguously in a single array, in the order
+ * in which they were added, together with their hash values. An
+ * open-addressed hash table with linear probing maps the hash values to the
+ * indices of the tuples. Compared to a trie, which allocates a map node per
+ * term of each tuple, this uses a constant number of allocations, and a
+ * lookup inspects a few consecutive slots of the table.
+ *
+ * Removed tuples are marked, and stay in the array and the table.
+ */
+class InstMatchStore
+{
+ public:
+  InstMatchStore(size_t arity);
+  virtual ~InstMatchStore() {}
+  /**
+   * Does m exist in this store? If modEq is true, we check for duplication
+   * modulo the current equalities in the equality engine of qs.
+   */
+  bool existsInstMatch(QuantifiersState& qs,
+                       Node q,
+                       const std::vector<Node>& m,
+                       bool modEq = false);
+  /**
+   * Add m to this store. Returns true if and only if m did not already exist
+   * in this store, where modEq is as above.
+   */
+  bool addInstMatch(QuantifiersState& qs,
+                    Node q,
+                    const std::vector<Node>& m,
+                    bool modEq = false);
+  /**
+   * Remove m from this store. Returns true if and only if m existed in this
+   * store.
+   */
+  bool removeInstMatch(Node q, const std::vector<Node>& m);
+  /** Adds the instantiations of this store into insts. */
+  void getInstantiations(Node q, std::vector<std::vector<Node>>& insts);
+  /** clear the data of this class */
+  void clear();
+  /** print this class */
+  void print(std::ostream& out, Node q);
+  /** Get the number of bytes allocated by this store */
+  size_t getMemoryUsage() const;
+
+ protected:
+  /** Called before each access to the tuples of this store */
+  virtual void sync() {}
+  /** Called after the i-th tuple was added */
+  virtual void notifyAdded(size_t i) {}
+  /** Called after the i-th tuple was removed */
+  virtual void notifyRemoved(size_t i) {}
+  /** Get the number of tuples in this store, including the removed ones */
+  size_t getNumTuples() const { return d_hashes.size(); }
+  /** Remove the tuples after the first n ones, which are forgotten */
+  void truncate(size_t n);
+  /** Set whether the i-th tuple is removed */
+  void setRemoved(size_t i, bool removed) { d_removed[i] = removed; }
+
+ private:
+  /** The hash value of m */
+  static uint32_t hash(const std::vector<Node>& m);
+  /** Is the i-th tuple equal to m? */
+  bool isTuple(size_t i, const std::vector<Node>& m) const;
+  /**
+   * Get the position in d_slots of the tuple m, which is not removed, or of
+   * the empty slot where it would be inserted if it does not exist.
+   */
+  size_t findSlot(const std::vector<Node>& m, uint32_t h) const;
+  /** Empty slot pos and move the slots of its cluster accordingly */
+  void eraseSlot(size_t pos);
+  /** Double the size of d_slots, or allocate it if it is empty */
+  void grow();
+  /** The number of terms per tuple */
+  size_t d_arity;
+  /** The terms of the tuples, d_arity per tuple */
+  std::vector<Node> d_terms;
+  /** The hash values of the tuples */
+  std::vector<uint32_t> d_hashes;
+  /** Whether each tuple is removed */
+  std::vector<bool> d_removed;
+  /**
+   * The hash table, whose size is zero or a power of two. Each slot is zero
+   * if it is empty, or the index of a tuple plus one.
+   */
+  std::vector<uint32_t> d_slots;
+};
+
+/**
+ * A context-dependent version of the above class. Tuples that were added in
+ * a context are forgotten, and tuples that were removed in a context are
+ * restored, when the context is popped. This happens lazily at the next
+ * access of the store.
+ */
+class CDInstMatchStore : public InstMatchStore
+{
+ public:
+  CDInstMatchStore(context::Context* c, size_t arity);
+
+ protected:
+  void sync() override;
+  void notifyAdded(size_t i) override;
+  void notifyRemoved(size_t i) override;
+
+ private:
+  /** The number of tuples in the current context */
+  context::CDO<size_t> d_numTuples;
+  /** The removed tuples, in the order they were removed */
+  std::vector<size_t> d_removedTuples;
+  /** The size of d_removedTuples in the current context */
+  context::CDO<size_t> d_numRemoved;
+};
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__QUANTIFIERS__INST_MATCH_STORE_H */
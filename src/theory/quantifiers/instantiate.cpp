@@ -52,6 +52,7 @@ Instantiate::Instantiate(QuantifiersState& qs,
       d_pnm(pnm),
       d_insts(qs.getUserContext()),
       d_c_inst_match_trie_dom(qs.getUserContext()),
+      d_inst_store_memory(0),
       d_pfInst(pnm ? new CDProof(pnm) : nullptr)
 {
 }
@@ -490,6 +491,16 @@ bool Instantiate::existsInstantiation(Node q,
                                       std::vector<Node>& terms,
                                       bool modEq)
 {
+  if (options::instStoreMode() == options::InstStoreMode::HASH)
+  {
+    std::map<Node, std::unique_ptr<InstMatchStore>>::iterator it =
+        d_inst_match_store.find(q);
+    if (it != d_inst_match_store.end())
+    {
+      return it->second->existsInstMatch(d_qstate, q, terms, modEq);
+    }
+    return false;
+  }
   if (options::incrementalSolving())
   {
     std::map<Node, CDInstMatchTrie*>::iterator it = d_c_inst_match_trie.find(q);
@@ -562,6 +573,17 @@ bool Instantiate::recordInstantiationInternal(Node q,
                                               std::vector<Node>& terms,
                                               bool modEq)
 {
+  if (options::instStoreMode() == options::InstStoreMode::HASH)
+  {
+    Trace("inst-add-debug") << "Adding into inst store" << std::endl;
+    InstMatchStore* ims = getOrMkInstMatchStore(q);
+    size_t prevMemory = ims->getMemoryUsage();
+    bool ret = ims->addInstMatch(d_qstate, q, terms, modEq);
+    // the memory of a store does not shrink
+    d_inst_store_memory += ims->getMemoryUsage() - prevMemory;
+    d_statistics.d_inst_store_memory.set(d_inst_store_memory);
+    return ret;
+  }
   if (options::incrementalSolving())
   {
     Trace("inst-add-debug")
@@ -587,6 +609,16 @@ bool Instantiate::recordInstantiationInternal(Node q,
 
 bool Instantiate::removeInstantiationInternal(Node q, std::vector<Node>& terms)
 {
+  if (options::instStoreMode() == options::InstStoreMode::HASH)
+  {
+    std::map<Node, std::unique_ptr<InstMatchStore>>::iterator it =
+        d_inst_match_store.find(q);
+    if (it != d_inst_match_store.end())
+    {
+      return it->second->removeInstMatch(q, terms);
+    }
+    return false;
+  }
   if (options::incrementalSolving())
   {
     std::map<Node, CDInstMatchTrie*>::iterator it = d_c_inst_match_trie.find(q);
@@ -612,7 +644,16 @@ void Instantiate::getInstantiatedQuantifiedFormulas(std::vector<Node>& qs) const
 void Instantiate::getInstantiationTermVectors(
     Node q, std::vector<std::vector<Node> >& tvecs)
 {
-
+  if (options::instStoreMode() == options::InstStoreMode::HASH)
+  {
+    std::map<Node, std::unique_ptr<InstMatchStore>>::const_iterator it =
+        d_inst_match_store.find(q);
+    if (it != d_inst_match_store.end())
+    {
+      it->second->getInstantiations(q, tvecs);
+    }
+    return;
+  }
   if (options::incrementalSolving())
   {
     std::map<Node, CDInstMatchTrie*>::const_iterator it =
@@ -636,7 +677,14 @@ void Instantiate::getInstantiationTermVectors(
 void Instantiate::getInstantiationTermVectors(
     std::map<Node, std::vector<std::vector<Node> > >& insts)
 {
-  if (options::incrementalSolving())
+  if (options::instStoreMode() == options::InstStoreMode::HASH)
+  {
+    for (const auto& t : d_inst_match_store)
+    {
+      getInstantiationTermVectors(t.first, insts[t.first]);
+    }
+  }
+  else if (options::incrementalSolving())
   {
     for (const auto& t : d_c_inst_match_trie)
     {
@@ -738,16 +786,35 @@ InstLemmaList* Instantiate::getOrMkInstLemmaList(TNode q)
   return ill.get();
 }
 
+InstMatchStore* Instantiate::getOrMkInstMatchStore(Node q)
+{
+  std::map<Node, std::unique_ptr<InstMatchStore>>::iterator it =
+      d_inst_match_store.find(q);
+  if (it != d_inst_match_store.end())
+  {
+    return it->second.get();
+  }
+  size_t arity = q[0].getNumChildren();
+  InstMatchStore* ims =
+      options::incrementalSolving()
+          ? new CDInstMatchStore(d_qstate.getUserContext(), arity)
+          : new InstMatchStore(arity);
+  d_inst_match_store[q].reset(ims);
+  return ims;
+}
+
 Instantiate::Statistics::Statistics()
     : d_instantiations("Instantiate::Instantiations_Total", 0),
       d_inst_duplicate("Instantiate::Duplicate_Inst", 0),
       d_inst_duplicate_eq("Instantiate::Duplicate_Inst_Eq", 0),
-      d_inst_duplicate_ent("Instantiate::Duplicate_Inst_Entailed", 0)
+      d_inst_duplicate_ent("Instantiate::Duplicate_Inst_Entailed", 0),
+      d_inst_store_memory("Instantiate::Inst_Store_Memory", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_instantiations);
   smtStatisticsRegistry()->registerStat(&d_inst_duplicate);
   smtStatisticsRegistry()->registerStat(&d_inst_duplicate_eq);
   smtStatisticsRegistry()->registerStat(&d_inst_duplicate_ent);
+  smtStatisticsRegistry()->registerStat(&d_inst_store_memory);
 }
 
 Instantiate::Statistics::~Statistics()
@@ -756,6 +823,7 @@ Instantiate::Statistics::~Statistics()
   smtStatisticsRegistry()->unregisterStat(&d_inst_duplicate);
   smtStatisticsRegistry()->unregisterStat(&d_inst_duplicate_eq);
   smtStatisticsRegistry()->unregisterStat(&d_inst_duplicate_ent);
+  smtStatisticsRegistry()->unregisterStat(&d_inst_store_memory);
 }
 
 }  // namespace quantifiers
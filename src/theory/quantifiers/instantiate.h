@@ -18,11 +18,13 @@
 #define CVC4__THEORY__QUANTIFIERS__INSTANTIATE_H
 
 #include <map>
+#include <memory>
 
 #include "context/cdhashset.h"
 #include "expr/node.h"
 #include "expr/proof.h"
 #include "theory/inference_id.h"
+#include "theory/quantifiers/inst_match_store.h"
 #include "theory/quantifiers/inst_match_trie.h"
 #include "theory/quantifiers/quant_util.h"
 #include "util/statistics_registry.h"
@@ -288,6 +290,8 @@ class Instantiate : public QuantifiersUtil
     IntStat d_inst_duplicate;
     IntStat d_inst_duplicate_eq;
     IntStat d_inst_duplicate_ent;
+    /** The number of bytes allocated by the stores of --inst-store=hash */
+    IntStat d_inst_store_memory;
     Statistics();
     ~Statistics();
   }; /* class Instantiate::Statistics */
@@ -311,6 +315,8 @@ class Instantiate : public QuantifiersUtil
   static Node ensureType(Node n, TypeNode tn);
   /** Get or make the instantiation list for quantified formula q */
   InstLemmaList* getOrMkInstLemmaList(TNode q);
+  /** Get or make the instantiation store for q, for --inst-store=hash */
+  InstMatchStore* getOrMkInstMatchStore(Node q);
 
   /** Reference to the quantifiers state */
   QuantifiersState& d_qstate;
@@ -353,6 +359,14 @@ class Instantiate : public QuantifiersUtil
    * is valid.
    */
   context::CDHashSet<Node, NodeHashFunction> d_c_inst_match_trie_dom;
+  /**
+   * The instantiation stores used instead of the tries above with
+   * --inst-store=hash, which are context-dependent if incremental solving is
+   * enabled.
+   */
+  std::map<Node, std::unique_ptr<InstMatchStore>> d_inst_match_store;
+  /** The total memory usage of the stores in d_inst_match_store */
+  size_t d_inst_store_memory;
   /**
    * A CDProof storing instantiation steps.
    */
@@ -25,7 +25,12 @@ QuantifiersState::QuantifiersState(context::Context* c,
                                    context::UserContext* u,
                                    Valuation val,
                                    const LogicInfo& logicInfo)
-    : TheoryState(c, u, val), d_ierCounterc(c), d_logicInfo(logicInfo)
+    : TheoryState(c, u, val),
+      d_ierCounterc(c),
+      d_logicInfo(logicInfo),
+      d_modified(c),
+      d_mergeStamp(c, 0),
+      d_numMerges(0)
 {
   // allow theory combination to go first, once initially
   d_ierCounter = options::instWhenTcFirst() ? 0 : 1;
@@ -158,6 +163,16 @@ const LogicInfo& QuantifiersState::getLogicInfo() const { return d_logicInfo; }
 
 QuantifiersStatistics& QuantifiersState::getStats() { return d_statistics; }
 
+void QuantifiersState::notifyModified(TNode t) { d_modified.push_back(t); }
+
+size_t QuantifiersState::getNumModified() const { return d_modified.size(); }
+
+Node QuantifiersState::getModified(size_t i) const { return d_modified[i]; }
+
+void QuantifiersState::notifyMerge() { d_mergeStamp = ++d_numMerges; }
+
+uint64_t QuantifiersState::getMergeStamp() const { return d_mergeStamp.get(); }
+
 }  // namespace quantifiers
 }  // namespace theory
 }  // namespace cvc5
@@ -17,6 +17,7 @@
 #ifndef CVC4__THEORY__QUANTIFIERS__QUANTIFIERS_STATE_H
 #define CVC4__THEORY__QUANTIFIERS__QUANTIFIERS_STATE_H
 
+#include "context/cdlist.h"
 #include "theory/quantifiers/quantifiers_statistics.h"
 #include "theory/theory.h"
 #include "theory/theory_state.h"
@@ -59,6 +60,30 @@ class QuantifiersState : public TheoryState
   const LogicInfo& getLogicInfo() const;
   /** get the stats */
   QuantifiersStatistics& getStats();
+  /**
+   * Notify that the equivalence class of t was modified in the master
+   * equality engine, i.e. t was added to it, or it was merged with another
+   * class.
+   */
+  void notifyModified(TNode t);
+  /**
+   * Get the number of modifications of equivalence classes in this SAT
+   * context. The index of a modification serves as its time stamp.
+   */
+  size_t getNumModified() const;
+  /** Get the term of the i-th modification */
+  Node getModified(size_t i) const;
+  /**
+   * Notify that two equivalence classes were merged in the master equality
+   * engine.
+   */
+  void notifyMerge();
+  /**
+   * Get the merge stamp. Two calls return the same stamp if and only if no
+   * merge that happened in between is still asserted in the SAT context of
+   * the second call.
+   */
+  uint64_t getMergeStamp() const;
 
  private:
   /** The number of instantiation rounds in this SAT context */
@@ -82,6 +107,12 @@ class QuantifiersState : public TheoryState
   const LogicInfo& d_logicInfo;
   /** The statistics */
   QuantifiersStatistics d_statistics;
+  /** The terms whose equivalence class was modified, in order */
+  context::CDList<Node> d_modified;
+  /** The stamp of the last merge in this SAT context */
+  context::CDO<uint64_t> d_mergeStamp;
+  /** The total number of merges */
+  uint64_t d_numMerges;
 };
 
 }  // namespace quantifiers
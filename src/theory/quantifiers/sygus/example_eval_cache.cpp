@@ -91,6 +91,17 @@ void ExampleEvalCache::evaluateVec(Node bv,
 void ExampleEvalCache::evaluateVecInternal(Node bv,
                                            std::vector<Node>& exOut) const
 {
+  TypeNode tn = bv.getType();
+  if (tn.isBoolean() || (tn.isBitVector() && tn.getBitVectorSize() <= 64))
+  {
+    // Boolean and bit-vector terms are evaluated on all examples at once,
+    // which is faster than sharing the results of examples that agree on the
+    // relevant variables
+    std::vector<Node> res;
+    d_tds->evaluateBuiltinBatch(d_stn, bv, d_examples, res);
+    exOut.insert(exOut.end(), res.begin(), res.end());
+    return;
+  }
   // use ExampleMinEval
   SygusTypeInfo& ti = d_tds->getTypeInfo(d_stn);
   const std::vector<Node>& varlist = ti.getVarList();
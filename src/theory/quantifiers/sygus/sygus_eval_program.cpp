@@ -0,0 +1,481 @@
+/*********************                                                        */
+/*! \file sygus_eval_program.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Compiled evaluation of terms on points
+ **/
+
+#include "theory/quantifiers/sygus/sygus_eval_program.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "base/output.h"
+#include "expr/node_manager.h"
+#include "theory/evaluator.h"
+#include "util/bitvector.h"
+#include "util/rational.h"
+
+using namespace cvc5::kind;
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+SygusEvalProgram::SygusEvalProgram()
+    : d_compiled(false),
+      d_numConsts(0),
+      d_result(0),
+      d_resultType(ValueType::BOOL),
+      d_resultWidth(0)
+{
+}
+
+bool SygusEvalProgram::compile(Node n, const std::vector<Node>& vars)
+{
+  d_compiled = false;
+  d_vars = vars;
+  d_inputs.clear();
+  d_instrs.clear();
+  d_regs.clear();
+  if (!getValueType(n, d_resultType, d_resultWidth))
+  {
+    return false;
+  }
+  std::unordered_map<TNode, uint32_t, TNodeHashFunction> varIndex;
+  for (uint32_t i = 0, nvars = vars.size(); i < nvars; ++i)
+  {
+    varIndex[vars[i]] = i;
+  }
+  // collect the constants, the variables and the applications of n, the
+  // latter in post-order
+  std::vector<TNode> consts;
+  std::vector<TNode> apps;
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<std::pair<TNode, bool>> visit;
+  visit.emplace_back(n, false);
+  while (!visit.empty())
+  {
+    TNode cur = visit.back().first;
+    bool childrenDone = visit.back().second;
+    visit.pop_back();
+    if (childrenDone)
+    {
+      apps.push_back(cur);
+      continue;
+    }
+    if (!visited.insert(cur).second)
+    {
+      continue;
+    }
+    if (cur.isConst())
+    {
+      consts.push_back(cur);
+      continue;
+    }
+    if (cur.getNumChildren() == 0)
+    {
+      auto it = varIndex.find(cur);
+      if (it == varIndex.end())
+      {
+        return false;
+      }
+      Input in;
+      in.d_index = it->second;
+      if (!getValueType(cur, in.d_type, in.d_width))
+      {
+        return false;
+      }
+      d_inputs.push_back(in);
+      continue;
+    }
+    visit.emplace_back(cur, true);
+    for (const Node& child : cur)
+    {
+      visit.emplace_back(child, false);
+    }
+  }
+
+  // the constant pool
+  std::unordered_map<TNode, uint32_t, TNodeHashFunction> regs;
+  for (TNode c : consts)
+  {
+    ValueType vt;
+    unsigned width;
+    uint64_t value;
+    if (!getValueType(c, vt, width) || !getRegister(c, vt, width, value))
+    {
+      return false;
+    }
+    regs[c] = d_regs.size();
+    d_regs.push_back(value);
+  }
+  d_numConsts = d_regs.size();
+  // the variables
+  d_regs.resize(d_numConsts + vars.size(), 0);
+  for (const Input& in : d_inputs)
+  {
+    regs[vars[in.d_index]] = d_numConsts + in.d_index;
+  }
+  // the instructions
+  std::vector<uint32_t> cregs;
+  for (TNode a : apps)
+  {
+    cregs.clear();
+    for (const Node& child : a)
+    {
+      Assert(regs.find(child) != regs.end());
+      cregs.push_back(regs[child]);
+    }
+    uint32_t reg;
+    if (!compileApp(a, cregs, reg))
+    {
+      Trace("sygus-eval-program")
+          << "cannot compile " << a.getKind() << std::endl;
+      return false;
+    }
+    regs[a] = reg;
+  }
+  d_result = regs[n];
+  d_compiled = true;
+  Trace("sygus-eval-program")
+      << "compiled " << n << " to " << d_instrs.size() << " instructions, "
+      << d_numConsts << " constants" << std::endl;
+  return true;
+}
+
+bool SygusEvalProgram::compileApp(TNode n,
+                                  const std::vector<uint32_t>& cregs,
+                                  uint32_t& reg)
+{
+  ValueType vt;
+  unsigned width;
+  if (!getValueType(n, vt, width))
+  {
+    return false;
+  }
+  ValueType ct;
+  unsigned cwidth;
+  if (!getValueType(n[0], ct, cwidth))
+  {
+    return false;
+  }
+  bool isBv = ct == ValueType::BITVECTOR;
+  bool isInt = ct == ValueType::INTEGER;
+  // the operator, whether the operands are swapped, and whether the operator
+  // is n-ary, in which case it is compiled to a chain of instructions
+  Op op;
+  bool swap = false;
+  bool nary = false;
+  Kind k = n.getKind();
+  switch (k)
+  {
+    case NOT: op = Op::NOT; break;
+    case AND: op = Op::AND, nary = true; break;
+    case OR: op = Op::OR, nary = true; break;
+    case XOR: op = Op::XOR; break;
+    case IMPLIES: op = Op::IMPLIES; break;
+    case EQUAL: op = Op::EQUAL; break;
+    case ITE: op = Op::ITE; break;
+    case BITVECTOR_NOT: op = Op::BV_NOT; break;
+    case BITVECTOR_NEG: op = Op::BV_NEG; break;
+    case BITVECTOR_PLUS: op = Op::BV_ADD, nary = true; break;
+    case BITVECTOR_SUB: op = Op::BV_SUB; break;
+    case BITVECTOR_MULT: op = Op::BV_MUL, nary = true; break;
+    case BITVECTOR_AND: op = Op::BV_AND, nary = true; break;
+    case BITVECTOR_OR: op = Op::BV_OR, nary = true; break;
+    case BITVECTOR_XOR: op = Op::BV_XOR, nary = true; break;
+    case BITVECTOR_UDIV: op = Op::BV_UDIV; break;
+    case BITVECTOR_UREM: op = Op::BV_UREM; break;
+    case BITVECTOR_SHL: op = Op::BV_SHL; break;
+    case BITVECTOR_LSHR: op = Op::BV_LSHR; break;
+    case BITVECTOR_ASHR: op = Op::BV_ASHR; break;
+    case BITVECTOR_EXTRACT:
+    {
+      unsigned low = n.getOperator().getConst<BitVectorExtract>().d_low;
+      reg = addInstr(Op::BV_EXTRACT, width, cregs[0], low, 0);
+      return true;
+    }
+    case BITVECTOR_CONCAT:
+    {
+      reg = cregs[0];
+      for (size_t i = 1, nchildren = cregs.size(); i < nchildren; ++i)
+      {
+        unsigned w = n[i].getType().getBitVectorSize();
+        reg = addInstr(Op::BV_CONCAT, w, reg, cregs[i], 0);
+      }
+      return true;
+    }
+    case BITVECTOR_ULT: op = Op::BV_ULT; break;
+    case BITVECTOR_ULE: op = Op::BV_ULE; break;
+    case BITVECTOR_UGT: op = Op::BV_ULT, swap = true; break;
+    case BITVECTOR_UGE: op = Op::BV_ULE, swap = true; break;
+    case BITVECTOR_SLT: op = Op::BV_SLT, width = cwidth; break;
+    case BITVECTOR_SLE: op = Op::BV_SLE, width = cwidth; break;
+    case BITVECTOR_SGT: op = Op::BV_SLT, width = cwidth, swap = true; break;
+    case BITVECTOR_SGE: op = Op::BV_SLE, width = cwidth, swap = true; break;
+    case PLUS: op = Op::INT_ADD, nary = true; break;
+    case MINUS: op = Op::INT_SUB; break;
+    case UMINUS: op = Op::INT_NEG; break;
+    case MULT:
+    case NONLINEAR_MULT: op = Op::INT_MUL, nary = true; break;
+    case ABS: op = Op::INT_ABS; break;
+    case LT: op = Op::INT_LT; break;
+    case LEQ: op = Op::INT_LEQ; break;
+    case GT: op = Op::INT_LT, swap = true; break;
+    case GEQ: op = Op::INT_LEQ, swap = true; break;
+    default: return false;
+  }
+  // the bit-vector and integer operators must be applied to bit-vectors and
+  // integers, in particular, integer operators must not be applied to reals
+  if ((op >= Op::BV_NOT && op <= Op::BV_SLE && !isBv)
+      || (op >= Op::INT_ADD && !isInt))
+  {
+    return false;
+  }
+  if (nary)
+  {
+    reg = cregs[0];
+    for (size_t i = 1, nchildren = cregs.size(); i < nchildren; ++i)
+    {
+      reg = addInstr(op, width, reg, cregs[i], 0);
+    }
+    return true;
+  }
+  uint32_t args[3] = {0, 0, 0};
+  std::copy(cregs.begin(), cregs.end(), args);
+  if (swap)
+  {
+    std::swap(args[0], args[1]);
+  }
+  reg = addInstr(op, width, args[0], args[1], args[2]);
+  return true;
+}
+
+uint32_t SygusEvalProgram::addInstr(
+    Op op, unsigned width, uint32_t a, uint32_t b, uint32_t c)
+{
+  d_instrs.push_back(Instr{op, width, {a, b, c}});
+  d_regs.push_back(0);
+  return d_regs.size() - 1;
+}
+
+Node SygusEvalProgram::eval(const std::vector<Node>& args)
+{
+  Assert(d_compiled);
+  Assert(args.size() == d_vars.size());
+  for (const Input& in : d_inputs)
+  {
+    if (!getRegister(args[in.d_index],
+                     in.d_type,
+                     in.d_width,
+                     d_regs[d_numConsts + in.d_index]))
+    {
+      return Node::null();
+    }
+  }
+  uint64_t* r = d_regs.data();
+  uint64_t* dst = r + d_numConsts + d_vars.size();
+  for (const Instr& in : d_instrs)
+  {
+    uint64_t a = r[in.d_args[0]];
+    uint64_t mask = bvMask(in.d_width);
+    int64_t ia = static_cast<int64_t>(a);
+    int64_t ires;
+    switch (in.d_op)
+    {
+      case Op::NOT: *dst = a ^ 1; break;
+      case Op::AND: *dst = a & r[in.d_args[1]]; break;
+      case Op::OR: *dst = a | r[in.d_args[1]]; break;
+      case Op::XOR: *dst = a ^ r[in.d_args[1]]; break;
+      case Op::IMPLIES: *dst = (a ^ 1) | r[in.d_args[1]]; break;
+      case Op::EQUAL: *dst = a == r[in.d_args[1]]; break;
+      case Op::ITE: *dst = a ? r[in.d_args[1]] : r[in.d_args[2]]; break;
+      case Op::BV_NOT: *dst = ~a & mask; break;
+      case Op::BV_NEG: *dst = (~a + 1) & mask; break;
+      case Op::BV_ADD: *dst = (a + r[in.d_args[1]]) & mask; break;
+      case Op::BV_SUB: *dst = (a - r[in.d_args[1]]) & mask; break;
+      case Op::BV_MUL: *dst = (a * r[in.d_args[1]]) & mask; break;
+      case Op::BV_AND: *dst = a & r[in.d_args[1]]; break;
+      case Op::BV_OR: *dst = a | r[in.d_args[1]]; break;
+      case Op::BV_XOR: *dst = a ^ r[in.d_args[1]]; break;
+      case Op::BV_UDIV:
+      {
+        uint64_t b = r[in.d_args[1]];
+        *dst = b == 0 ? mask : a / b;
+        break;
+      }
+      case Op::BV_UREM:
+      {
+        uint64_t b = r[in.d_args[1]];
+        *dst = b == 0 ? a : a % b;
+        break;
+      }
+      case Op::BV_SHL:
+      {
+        uint64_t b = r[in.d_args[1]];
+        *dst = b >= in.d_width ? 0 : (a << b) & mask;
+        break;
+      }
+      case Op::BV_LSHR:
+      {
+        uint64_t b = r[in.d_args[1]];
+        *dst = b >= in.d_width ? 0 : a >> b;
+        break;
+      }
+      case Op::BV_ASHR:
+      {
+        uint64_t b = r[in.d_args[1]];
+        bool sign = (a >> (in.d_width - 1)) & 1;
+        if (b >= in.d_width)
+        {
+          *dst = sign ? mask : 0;
+        }
+        else
+        {
+          *dst = sign ? ~((~a & mask) >> b) & mask : a >> b;
+        }
+        break;
+      }
+      case Op::BV_EXTRACT: *dst = (a >> in.d_args[1]) & mask; break;
+      case Op::BV_CONCAT: *dst = (a << in.d_width) | r[in.d_args[1]]; break;
+      case Op::BV_ULT: *dst = a < r[in.d_args[1]]; break;
+      case Op::BV_ULE: *dst = a <= r[in.d_args[1]]; break;
+      case Op::BV_SLT:
+        *dst = bvSigned(a, in.d_width) < bvSigned(r[in.d_args[1]], in.d_width);
+        break;
+      case Op::BV_SLE:
+        *dst =
+            bvSigned(a, in.d_width) <= bvSigned(r[in.d_args[1]], in.d_width);
+        break;
+      case Op::INT_ADD:
+        if (__builtin_add_overflow(
+                ia, static_cast<int64_t>(r[in.d_args[1]]), &ires))
+        {
+          return Node::null();
+        }
+        *dst = static_cast<uint64_t>(ires);
+        break;
+      case Op::INT_SUB:
+        if (__builtin_sub_overflow(
+                ia, static_cast<int64_t>(r[in.d_args[1]]), &ires))
+        {
+          return Node::null();
+        }
+        *dst = static_cast<uint64_t>(ires);
+        break;
+      case Op::INT_NEG:
+        if (__builtin_sub_overflow(int64_t(0), ia, &ires))
+        {
+          return Node::null();
+        }
+        *dst = static_cast<uint64_t>(ires);
+        break;
+      case Op::INT_MUL:
+        if (__builtin_mul_overflow(
+                ia, static_cast<int64_t>(r[in.d_args[1]]), &ires))
+        {
+          return Node::null();
+        }
+        *dst = static_cast<uint64_t>(ires);
+        break;
+      case Op::INT_ABS:
+        if (ia < 0 && __builtin_sub_overflow(int64_t(0), ia, &ia))
+        {
+          return Node::null();
+        }
+        *dst = static_cast<uint64_t>(ia);
+        break;
+      case Op::INT_LT: *dst = ia < static_cast<int64_t>(r[in.d_args[1]]); break;
+      case Op::INT_LEQ:
+        *dst = ia <= static_cast<int64_t>(r[in.d_args[1]]);
+        break;
+    }
+    ++dst;
+  }
+  uint64_t res = r[d_result];
+  NodeManager* nm = NodeManager::currentNM();
+  switch (d_resultType)
+  {
+    case ValueType::BOOL: return nm->mkConst(res != 0);
+    case ValueType::BITVECTOR:
+      return nm->mkConst(BitVector(d_resultWidth, Integer(res)));
+    default:
+      return nm->mkConst(Rational(Integer(static_cast<int64_t>(res))));
+  }
+}
+
+bool SygusEvalProgram::getValueType(TNode n, ValueType& vt, unsigned& width)
+{
+  TypeNode tn = n.getType();
+  width = 0;
+  if (tn.isBoolean())
+  {
+    vt = ValueType::BOOL;
+    return true;
+  }
+  if (tn.isBitVector())
+  {
+    vt = ValueType::BITVECTOR;
+    width = tn.getBitVectorSize();
+    return width <= 64;
+  }
+  if (tn.isInteger())
+  {
+    vt = ValueType::INTEGER;
+    return true;
+  }
+  return false;
+}
+
+bool SygusEvalProgram::getRegister(TNode c,
+                                   ValueType vt,
+                                   unsigned width,
+                                   uint64_t& reg)
+{
+  switch (vt)
+  {
+    case ValueType::BOOL:
+      if (c.getKind() != CONST_BOOLEAN)
+      {
+        return false;
+      }
+      reg = c.getConst<bool>();
+      return true;
+    case ValueType::BITVECTOR:
+    {
+      if (c.getKind() != CONST_BITVECTOR)
+      {
+        return false;
+      }
+      const BitVector& bv = c.getConst<BitVector>();
+      Assert(bv.getSize() == width);
+      reg = bv.getValue().getUnsignedLong();
+      return true;
+    }
+    default:
+    {
+      if (c.getKind() != CONST_RATIONAL)
+      {
+        return false;
+      }
+      const Rational& q = c.getConst<Rational>();
+      if (!q.isIntegral() || !q.getNumerator().fitsSignedLong())
+      {
+        return false;
+      }
+      reg = static_cast<uint64_t>(
+          static_cast<int64_t>(q.getNumerator().getLong()));
+      return true;
+    }
+  }
+}
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,191 @@
+/*********************                                                        */
+/*! \file sygus_eval_program.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Compiled evaluation of terms on points
+ **
+ ** A term compiled into a register program, for evaluating the same term on
+ ** many points in sygus without traversing it.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__QUANTIFIERS__SYGUS__SYGUS_EVAL_PROGRAM_H
+#define CVC4__THEORY__QUANTIFIERS__SYGUS__SYGUS_EVAL_PROGRAM_H
+
+#include <cstdint>
+#include <vector>
+
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+/**
+ * A term compiled into a straight-line program over 64-bit registers.
+ *
+ * The registers hold Booleans (as 0 or 1), bit-vectors of width at most 64
+ * and integers that fit into 64 bits. The first registers are the pool of
+ * the constants of the term, followed by one register per variable, and one
+ * register per instruction, which stores the result of the instruction.
+ * Constants are pooled, and each subterm of the term is computed once, even
+ * if it occurs several times.
+ *
+ * For example, the term (ite (< x 0) (- x) (+ x 1)) over variables (x) is
+ * compiled to:
+ *   r0 := 0, r1 := 1 (constants)
+ *   r2 := x (variable)
+ *   r3 := lt r2 r0
+ *   r4 := neg r2
+ *   r5 := add r2 r1
+ *   r6 := ite r3 r4 r5
+ */
+class SygusEvalProgram
+{
+ public:
+  SygusEvalProgram();
+
+  /**
+   * Compile n over the variables vars. Returns false if n contains a
+   * variable not in vars, an operator that is not supported, or a value that
+   * does not fit into a register. Supported are the Boolean connectives,
+   * equality and ite, the bit-vector operators that do not change the
+   * width, extract, concat and the bit-vector comparisons, and the integer
+   * operators +, -, *, abs and the integer comparisons.
+   */
+  bool compile(Node n, const std::vector<Node>& vars);
+  /** Whether the last call to compile succeeded. */
+  bool isCompiled() const { return d_compiled; }
+  /** The variables this program was last compiled for. */
+  const std::vector<Node>& getVariables() const { return d_vars; }
+  /**
+   * Evaluate the program on the point args, which are the values of the
+   * variables. Returns the value of the term, which is the constant that
+   * substituting args into it and rewriting gives. Returns null if a value
+   * of args is not a constant that fits into a register, or if an integer
+   * operation overflows.
+   */
+  Node eval(const std::vector<Node>& args);
+
+ private:
+  /** The type of the value of a register. */
+  enum class ValueType : uint8_t
+  {
+    BOOL,
+    BITVECTOR,
+    INTEGER
+  };
+  /**
+   * The operators of instructions. The bit-vector and integer comparisons
+   * that are not listed are compiled to these with swapped operands.
+   */
+  enum class Op : uint8_t
+  {
+    NOT,
+    AND,
+    OR,
+    XOR,
+    IMPLIES,
+    EQUAL,
+    ITE,
+    BV_NOT,
+    BV_NEG,
+    BV_ADD,
+    BV_SUB,
+    BV_MUL,
+    BV_AND,
+    BV_OR,
+    BV_XOR,
+    BV_UDIV,
+    BV_UREM,
+    BV_SHL,
+    BV_LSHR,
+    BV_ASHR,
+    BV_EXTRACT,
+    BV_CONCAT,
+    BV_ULT,
+    BV_ULE,
+    BV_SLT,
+    BV_SLE,
+    INT_ADD,
+    INT_SUB,
+    INT_NEG,
+    INT_MUL,
+    INT_ABS,
+    INT_LT,
+    INT_LEQ
+  };
+  /**
+   * An instruction, which stores its result in the register after those of
+   * the previous instructions.
+   */
+  struct Instr
+  {
+    Op d_op;
+    /**
+     * The bit-width of the result for bit-vector operators, except for
+     * BV_CONCAT where it is the width of the second operand, and BV_SLT and
+     * BV_SLE where it is the width of the operands.
+     */
+    unsigned d_width;
+    /**
+     * The registers of the operands, except for BV_EXTRACT where the second
+     * one is the index of the lowest extracted bit.
+     */
+    uint32_t d_args[3];
+  };
+  /** A variable that occurs in the compiled term. */
+  struct Input
+  {
+    /** The index of the variable */
+    uint32_t d_index;
+    ValueType d_type;
+    unsigned d_width;
+  };
+  /** The type of the values of n, false if it has no register type. */
+  static bool getValueType(TNode n, ValueType& vt, unsigned& width);
+  /**
+   * Get the register value of constant c of the given type, false if c is not
+   * a constant of that type or does not fit into a register.
+   */
+  static bool getRegister(TNode c,
+                          ValueType vt,
+                          unsigned width,
+                          uint64_t& reg);
+  /**
+   * Compile the application n with children registers cregs into reg, return
+   * false if it is not supported.
+   */
+  bool compileApp(TNode n, const std::vector<uint32_t>& cregs, uint32_t& reg);
+  /** Add an instruction, return its register. */
+  uint32_t addInstr(Op op, unsigned width, uint32_t a, uint32_t b, uint32_t c);
+
+  /** Whether the last call to compile succeeded */
+  bool d_compiled;
+  /** The variables */
+  std::vector<Node> d_vars;
+  /** The variables that occur in the term */
+  std::vector<Input> d_inputs;
+  /** The instructions */
+  std::vector<Instr> d_instrs;
+  /** The registers, whose prefix are the constants */
+  std::vector<uint64_t> d_regs;
+  /** The number of constants */
+  uint32_t d_numConsts;
+  /** The register of the result, and the type of its value */
+  uint32_t d_result;
+  ValueType d_resultType;
+  unsigned d_resultWidth;
+};
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__QUANTIFIERS__SYGUS__SYGUS_EVAL_PROGRAM_H */
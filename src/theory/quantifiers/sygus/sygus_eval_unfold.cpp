@@ -180,7 +180,21 @@ void SygusEvalUnfold::registerModelValue(Node a,
           Node conj = nm->mkNode(DT_SYGUS_EVAL, eval_children);
           eval_children[0] = vn;
           Node eval_fun = nm->mkNode(DT_SYGUS_EVAL, eval_children);
-          res = d_tds->evaluateWithUnfolding(eval_fun);
+          if (options::sygusEvalCompile())
+          {
+            // The builtin term has no symbolic constructors, hence if the
+            // arguments are constants, running its compiled program gives
+            // the same value as unfolding. This returns null otherwise.
+            SygusEvalProgram* p = d_tds->getEvalProgram(bTerm, vars);
+            if (p != nullptr)
+            {
+              res = p->eval(it->second[i]);
+            }
+          }
+          if (res.isNull())
+          {
+            res = d_tds->evaluateWithUnfolding(eval_fun);
+          }
           Trace("sygus-eval-unfold")
               << "Evaluate with unfolding returns " << res << std::endl;
           esit.init(conj, n, res);
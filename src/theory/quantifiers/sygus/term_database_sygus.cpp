@@ -998,6 +998,21 @@ Node TermDbSygus::evaluateBuiltin(TypeNode tn,
   Node res;
   if (tryEval && options::sygusEvalOpt())
   {
+    if (options::sygusEvalCompile())
+    {
+      // Try running the compiled program of bn, which does not traverse bn
+      // again for each point. Its result is a constant, which need not be
+      // rewritten.
+      SygusEvalProgram* p = getEvalProgram(bn, varlist);
+      if (p != nullptr)
+      {
+        res = p->eval(args);
+        if (!res.isNull())
+        {
+          return res;
+        }
+      }
+    }
     // Try evaluating, which is much faster than substitution+rewriting.
     // This may fail if there is a subterm of bn under the
     // substitution that is not constant, or if an operator in bn is not
@@ -1015,6 +1030,64 @@ Node TermDbSygus::evaluateBuiltin(TypeNode tn,
   return rewriteNode(res);
 }
 
+void TermDbSygus::evaluateBuiltinBatch(
+    TypeNode tn,
+    Node bn,
+    const std::vector<std::vector<Node>>& points,
+    std::vector<Node>& results)
+{
+  results.clear();
+  if (!options::sygusEvalOpt())
+  {
+    for (const std::vector<Node>& pt : points)
+    {
+      results.push_back(evaluateBuiltin(tn, bn, pt));
+    }
+    return;
+  }
+  Assert(isRegistered(tn));
+  SygusTypeInfo& ti = getTypeInfo(tn);
+  d_eval->evalBatch(bn, ti.getVarList(), points, results);
+  for (Node& res : results)
+  {
+    // as in evaluateBuiltin, there may be recursive function applications
+    res = rewriteNode(res);
+  }
+}
+
+SygusEvalProgram* TermDbSygus::getEvalProgram(Node bn,
+                                              const std::vector<Node>& vars)
+{
+  auto it = d_evalProgramIndex.find(bn);
+  if (it != d_evalProgramIndex.end())
+  {
+    // move the entry to the front
+    d_evalPrograms.splice(d_evalPrograms.begin(), d_evalPrograms, it->second);
+    SygusEvalProgram* p = it->second->second.get();
+    if (p->getVariables() == vars || p->compile(bn, vars))
+    {
+      return p;
+    }
+    d_evalPrograms.erase(it->second);
+    d_evalProgramIndex.erase(it);
+    return nullptr;
+  }
+  std::unique_ptr<SygusEvalProgram> p(new SygusEvalProgram);
+  if (!p->compile(bn, vars))
+  {
+    return nullptr;
+  }
+  if (d_evalPrograms.size() == s_evalProgramCacheSize)
+  {
+    // evict the least recently used program
+    d_evalProgramIndex.erase(d_evalPrograms.back().first);
+    d_evalPrograms.pop_back();
+  }
+  d_evalPrograms.emplace_front(bn, std::move(p));
+  d_evalProgramIndex[bn] = d_evalPrograms.begin();
+  return d_evalPrograms.front().second.get();
+}
+
 Node TermDbSygus::evaluateWithUnfolding(
     Node n, std::unordered_map<Node, Node, NodeHashFunction>& visited)
 {
@@ -17,12 +17,14 @@
 #ifndef CVC4__THEORY__QUANTIFIERS__TERM_DATABASE_SYGUS_H
 #define CVC4__THEORY__QUANTIFIERS__TERM_DATABASE_SYGUS_H
 
+#include <list>
 #include <unordered_set>
 
 #include "expr/dtype.h"
 #include "theory/evaluator.h"
 #include "theory/quantifiers/extended_rewrite.h"
 #include "theory/quantifiers/fun_def_evaluator.h"
+#include "theory/quantifiers/sygus/sygus_eval_program.h"
 #include "theory/quantifiers/sygus/sygus_eval_unfold.h"
 #include "theory/quantifiers/sygus/sygus_explain.h"
 #include "theory/quantifiers/sygus/type_info.h"
@@ -270,6 +272,23 @@ class TermDbSygus {
                        Node bn,
                        const std::vector<Node>& args,
                        bool tryEval = true);
+  /**
+   * Same as calling evaluateBuiltin(tn, bn, points[i]) for each i and storing
+   * the result in results[i], but evaluates bn for all points in a single
+   * traversal using Evaluator::evalBatch.
+   */
+  void evaluateBuiltinBatch(TypeNode tn,
+                            Node bn,
+                            const std::vector<std::vector<Node>>& points,
+                            std::vector<Node>& results);
+  /**
+   * Get the program compiled from the builtin term bn over the variables
+   * vars, or null if bn cannot be compiled. The program is compiled the
+   * first time it is requested for bn and vars. The programs of the
+   * s_evalProgramCacheSize most recently requested terms are cached, terms
+   * that cannot be compiled are not.
+   */
+  SygusEvalProgram* getEvalProgram(Node bn, const std::vector<Node>& vars);
   /** evaluate with unfolding
    *
    * n is any term that may involve sygus evaluation functions. This function
@@ -328,6 +347,20 @@ class TermDbSygus {
   std::unique_ptr<ExtendedRewriter> d_ext_rw;
   /** evaluator */
   std::unique_ptr<Evaluator> d_eval;
+  /** the number of compiled programs cached by getEvalProgram */
+  static const size_t s_evalProgramCacheSize = 4096;
+  /** a builtin term and its compiled program */
+  using EvalProgramEntry = std::pair<Node, std::unique_ptr<SygusEvalProgram>>;
+  /**
+   * the compiled programs of builtin terms, most recently used first, see
+   * getEvalProgram
+   */
+  std::list<EvalProgramEntry> d_evalPrograms;
+  /** maps builtin terms to their entry in d_evalPrograms */
+  std::unordered_map<Node,
+                     std::list<EvalProgramEntry>::iterator,
+                     NodeHashFunction>
+      d_evalProgramIndex;
   /** (recursive) function evaluator utility */
   std::unique_ptr<FunDefEvaluator> d_funDefEval;
   /** evaluation function unfolding utility */
@@ -473,6 +473,22 @@ Node SygusSampler::evaluate(Node n, unsigned index)
   Assert(index < d_samples.size());
   // do beta-reductions in n first
   n = Rewriter::rewrite(n);
+  if (d_tds != nullptr && options::sygusEvalCompile())
+  {
+    // use the compiled program of n, which is shared by all sample points
+    SygusEvalProgram* p = d_tds->getEvalProgram(n, d_vars);
+    if (p != nullptr)
+    {
+      Node ev = p->eval(d_samples[index]);
+      if (!ev.isNull())
+      {
+        Trace("sygus-sample-ev")
+            << "Evaluate ( " << n << ", " << index << " ) -> " << ev
+            << std::endl;
+        return ev;
+      }
+    }
+  }
   // use efficient rewrite for substitution + rewrite
   Node ev = d_eval.eval(n, d_vars, d_samples[index]);
   Trace("sygus-sample-ev") << "Evaluate ( " << n << ", " << index << " ) -> ";
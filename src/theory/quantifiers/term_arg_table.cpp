@@ -0,0 +1,259 @@
+/*********************                                                        */
+/*! \file term_arg_table.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the flat index of the ground applications of an
+ ** operator
+ **/
+
+#include "theory/quantifiers/term_arg_table.h"
+
+#include <algorithm>
+
+#include "base/check.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+TermArgTable::TermArgTable()
+    : d_argStart(1, 0),
+      d_domSize(0),
+      d_domUnindexed(true),
+      d_trieSize(0),
+      d_eqcTrieSize(0),
+      d_eqcTrieUnindexed(false)
+{
+}
+
+void TermArgTable::clear()
+{
+  d_terms.clear();
+  d_reps.clear();
+  d_args.clear();
+  d_argStart.resize(1);
+  d_hashes.clear();
+  std::fill(d_slots.begin(), d_slots.end(), 0);
+  d_uterms.clear();
+  d_ureps.clear();
+  d_uargs.clear();
+  d_relDom.clear();
+  d_eqcs.clear();
+  d_domSize = 0;
+  d_domUnindexed = true;
+  d_trie.clear();
+  d_trieSize = 0;
+  d_eqcTrie.clear();
+  d_eqcTrieSize = 0;
+  d_eqcTrieUnindexed = false;
+}
+
+uint32_t TermArgTable::hash(const std::vector<TNode>& reps)
+{
+  // FNV-1a over the ids of the representatives
+  uint64_t h = 14695981039346656037ULL;
+  for (const TNode& r : reps)
+  {
+    h = (h ^ r.getId()) * 1099511628211ULL;
+  }
+  return static_cast<uint32_t>(h ^ (h >> 32));
+}
+
+size_t TermArgTable::findSlot(const std::vector<TNode>& reps, uint32_t h) const
+{
+  Assert(!d_slots.empty());
+  size_t mask = d_slots.size() - 1;
+  size_t pos = h & mask;
+  while (d_slots[pos] != 0)
+  {
+    size_t i = d_slots[pos] - 1;
+    if (d_hashes[i] == h && getNumArgs(i) == reps.size()
+        && std::equal(reps.begin(), reps.end(), d_args.begin() + d_argStart[i]))
+    {
+      break;
+    }
+    pos = (pos + 1) & mask;
+  }
+  return pos;
+}
+
+void TermArgTable::grow()
+{
+  std::vector<uint32_t> slots(d_slots.empty() ? 16 : 2 * d_slots.size(), 0);
+  d_slots.swap(slots);
+  size_t mask = d_slots.size() - 1;
+  for (uint32_t s : slots)
+  {
+    if (s != 0)
+    {
+      size_t pos = d_hashes[s - 1] & mask;
+      while (d_slots[pos] != 0)
+      {
+        pos = (pos + 1) & mask;
+      }
+      d_slots[pos] = s;
+    }
+  }
+}
+
+TNode TermArgTable::addOrGetTerm(Node n,
+                                 const std::vector<TNode>& reps,
+                                 TNode r)
+{
+  // keep the load factor of the table at most 1/2
+  if (2 * (d_terms.size() + 1) > d_slots.size())
+  {
+    grow();
+  }
+  uint32_t h = hash(reps);
+  size_t pos = findSlot(reps, h);
+  if (d_slots[pos] != 0)
+  {
+    return d_terms[d_slots[pos] - 1];
+  }
+  d_slots[pos] = static_cast<uint32_t>(d_terms.size() + 1);
+  d_terms.push_back(n);
+  d_reps.push_back(r);
+  d_args.insert(d_args.end(), reps.begin(), reps.end());
+  d_argStart.push_back(static_cast<uint32_t>(d_args.size()));
+  d_hashes.push_back(h);
+  return n;
+}
+
+TNode TermArgTable::existsTerm(const std::vector<TNode>& reps) const
+{
+  if (d_slots.empty())
+  {
+    return TNode::null();
+  }
+  size_t pos = findSlot(reps, hash(reps));
+  return d_slots[pos] == 0 ? TNode::null() : TNode(d_terms[d_slots[pos] - 1]);
+}
+
+void TermArgTable::computeDomains()
+{
+  if (!d_domUnindexed)
+  {
+    // the representatives of the unindexed terms may have been removed
+    d_relDom.clear();
+    d_eqcs.assign(d_ureps.begin(), d_ureps.end());
+    d_domSize = 0;
+    d_domUnindexed = true;
+  }
+  else if (d_domSize == d_terms.size())
+  {
+    return;
+  }
+  for (size_t i = d_domSize, nterms = d_terms.size(); i < nterms; i++)
+  {
+    size_t nargs = getNumArgs(i);
+    if (d_relDom.size() < nargs)
+    {
+      d_relDom.resize(nargs);
+    }
+    for (size_t j = 0; j < nargs; j++)
+    {
+      d_relDom[j].push_back(getArg(i, j));
+    }
+    d_eqcs.push_back(d_reps[i]);
+  }
+  for (std::vector<TNode>& rd : d_relDom)
+  {
+    std::sort(rd.begin(), rd.end());
+    rd.erase(std::unique(rd.begin(), rd.end()), rd.end());
+  }
+  std::sort(d_eqcs.begin(), d_eqcs.end());
+  d_eqcs.erase(std::unique(d_eqcs.begin(), d_eqcs.end()), d_eqcs.end());
+  d_domSize = d_terms.size();
+}
+
+bool TermArgTable::inRelevantDomain(size_t i, TNode r)
+{
+  computeDomains();
+  return i < d_relDom.size()
+         && std::binary_search(d_relDom[i].begin(), d_relDom[i].end(), r);
+}
+
+bool TermArgTable::hasTermsInEqc(TNode r)
+{
+  computeDomains();
+  return std::binary_search(d_eqcs.begin(), d_eqcs.end(), r);
+}
+
+void TermArgTable::addUnindexedTerm(Node n,
+                                    const std::vector<TNode>& reps,
+                                    TNode r)
+{
+  Assert(reps.size() == n.getNumChildren());
+  d_uterms.push_back(n);
+  d_ureps.push_back(r);
+  d_uargs.insert(d_uargs.end(), reps.begin(), reps.end());
+  d_domUnindexed = false;
+  d_eqcTrieUnindexed = false;
+}
+
+void TermArgTable::takeUnindexedTerms(std::vector<Node>& terms)
+{
+  terms.insert(terms.end(), d_uterms.begin(), d_uterms.end());
+  d_uterms.clear();
+  d_ureps.clear();
+  d_uargs.clear();
+  d_domUnindexed = false;
+  d_eqcTrieUnindexed = false;
+}
+
+TNodeTrie* TermArgTable::getTrie()
+{
+  std::vector<TNode> reps;
+  for (size_t nterms = d_terms.size(); d_trieSize < nterms; d_trieSize++)
+  {
+    reps.assign(d_args.begin() + d_argStart[d_trieSize],
+                d_args.begin() + d_argStart[d_trieSize + 1]);
+    d_trie.addTerm(d_terms[d_trieSize], reps);
+  }
+  return &d_trie;
+}
+
+TNodeTrie* TermArgTable::getEqcTrie()
+{
+  std::vector<TNode> reps;
+  if (!d_eqcTrieUnindexed)
+  {
+    // the entries of the unindexed terms may have been removed
+    d_eqcTrie.clear();
+    d_eqcTrieSize = 0;
+    std::vector<TNode>::const_iterator it = d_uargs.begin();
+    for (size_t i = 0, nuterms = d_uterms.size(); i < nuterms; i++)
+    {
+      size_t nargs = d_uterms[i].getNumChildren();
+      reps.assign(it, it + nargs);
+      it += nargs;
+      d_eqcTrie.d_data[d_ureps[i]].addTerm(d_uterms[i], reps);
+    }
+    d_eqcTrieUnindexed = true;
+  }
+  for (size_t nterms = d_terms.size(); d_eqcTrieSize < nterms; d_eqcTrieSize++)
+  {
+    reps.assign(d_args.begin() + d_argStart[d_eqcTrieSize],
+                d_args.begin() + d_argStart[d_eqcTrieSize + 1]);
+    d_eqcTrie.d_data[d_reps[d_eqcTrieSize]].addTerm(d_terms[d_eqcTrieSize],
+                                                    reps);
+  }
+  return &d_eqcTrie;
+}
+
+void TermArgTable::prepare()
+{
+  computeDomains();
+  getTrie();
+  getEqcTrie();
+}
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
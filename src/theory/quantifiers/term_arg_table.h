@@ -0,0 +1,161 @@
+/*********************                                                        */
+/*! \file term_arg_table.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Flat index of the ground applications of an operator
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__QUANTIFIERS__TERM_ARG_TABLE_H
+#define CVC4__THEORY__QUANTIFIERS__TERM_ARG_TABLE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/node_trie.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+/**
+ * The index of the ground applications of an operator f, which the term
+ * database uses for computing the congruence classes of f-applications.
+ *
+ * Each indexed term f(t1, ..., tn) is stored together with the
+ * representatives r1, ..., rn of its arguments and the representative of its
+ * own equivalence class, in flat arrays in the order in which the terms were
+ * added. An open-addressed hash table over (r1, ..., rn) finds the indexed
+ * term that is congruent to a given term, hence no two indexed terms are
+ * congruent.
+ *
+ * Terms that cannot be indexed are kept separately, with the representatives
+ * of their arguments. These are the terms that are not in the equality
+ * engine, and the terms that are congruent to an indexed term without being
+ * equal to it.
+ *
+ * Clients that iterate over the arguments one at a time may access the terms
+ * through TNodeTrie objects, which are constructed on demand and extended
+ * with the terms added since they were last accessed.
+ */
+class TermArgTable
+{
+ public:
+  TermArgTable();
+  /** Clear this table, keeping the allocated memory */
+  void clear();
+  /** Get the number of indexed terms */
+  size_t getNumTerms() const { return d_terms.size(); }
+  /** Get the i-th indexed term */
+  TNode getTerm(size_t i) const { return d_terms[i]; }
+  /** Get the number of arguments of the i-th indexed term */
+  size_t getNumArgs(size_t i) const
+  {
+    return d_argStart[i + 1] - d_argStart[i];
+  }
+  /** Get the representative of the j-th argument of the i-th indexed term */
+  TNode getArg(size_t i, size_t j) const { return d_args[d_argStart[i] + j]; }
+  /** Get the representative of the i-th indexed term */
+  TNode getRepresentative(size_t i) const { return d_reps[i]; }
+  /**
+   * Add the term n, where reps are the representatives of its arguments and r
+   * is its representative. If an indexed term is congruent to n, it is
+   * returned and n is not added. Otherwise, n is added and returned.
+   */
+  TNode addOrGetTerm(Node n, const std::vector<TNode>& reps, TNode r);
+  /** Get the indexed term whose arguments have representatives reps, if any */
+  TNode existsTerm(const std::vector<TNode>& reps) const;
+  /** Is r the representative of the i-th argument of an indexed term? */
+  bool inRelevantDomain(size_t i, TNode r);
+  /** Is r the representative of an indexed or unindexed term? */
+  bool hasTermsInEqc(TNode r);
+  /**
+   * Add the term n that cannot be indexed, where reps are the representatives
+   * of its arguments and r is its representative, or n itself if it is not
+   * in the equality engine.
+   */
+  void addUnindexedTerm(Node n, const std::vector<TNode>& reps, TNode r);
+  /** Get the terms that cannot be indexed */
+  const std::vector<Node>& getUnindexedTerms() const { return d_uterms; }
+  /** Move the terms that cannot be indexed to the end of terms */
+  void takeUnindexedTerms(std::vector<Node>& terms);
+  /** Get the trie over the arguments of the indexed terms */
+  TNodeTrie* getTrie();
+  /**
+   * Get the trie over the representatives of the indexed and unindexed terms,
+   * followed by their arguments.
+   */
+  TNodeTrie* getEqcTrie();
+  /**
+   * Compute the domains and the tries of this table, after which the above
+   * queries do not modify it until terms are added or removed. Hence, they
+   * may then be made concurrently.
+   */
+  void prepare();
+
+ private:
+  /** The hash value of reps */
+  static uint32_t hash(const std::vector<TNode>& reps);
+  /**
+   * Get the position in d_slots of the indexed term whose arguments have
+   * representatives reps, or of the empty slot where it would be inserted.
+   */
+  size_t findSlot(const std::vector<TNode>& reps, uint32_t h) const;
+  /** Double the size of d_slots, or allocate it if it is empty */
+  void grow();
+  /** Update d_relDom and d_eqcs with the terms added since */
+  void computeDomains();
+  /** The indexed terms */
+  std::vector<Node> d_terms;
+  /** The representatives of the indexed terms */
+  std::vector<TNode> d_reps;
+  /** The representatives of the arguments of all indexed terms */
+  std::vector<TNode> d_args;
+  /**
+   * The arguments of the i-th indexed term are d_args[d_argStart[i]] up to
+   * d_args[d_argStart[i + 1]].
+   */
+  std::vector<uint32_t> d_argStart;
+  /** The hash values of the indexed terms */
+  std::vector<uint32_t> d_hashes;
+  /**
+   * The hash table, whose size is zero or a power of two. Each slot is zero
+   * if it is empty, or the index of a term plus one.
+   */
+  std::vector<uint32_t> d_slots;
+  /** The terms that cannot be indexed */
+  std::vector<Node> d_uterms;
+  /** The representatives of the above terms */
+  std::vector<TNode> d_ureps;
+  /** The representatives of the arguments of the above terms, in order */
+  std::vector<TNode> d_uargs;
+  /** The sorted representatives of each argument of the indexed terms */
+  std::vector<std::vector<TNode>> d_relDom;
+  /** The sorted representatives of the indexed and unindexed terms */
+  std::vector<TNode> d_eqcs;
+  /** The number of indexed terms when the above vectors were computed */
+  size_t d_domSize;
+  /** Whether d_eqcs contains the representatives of the unindexed terms */
+  bool d_domUnindexed;
+  /** The trie returned by getTrie, and the number of terms it contains */
+  TNodeTrie d_trie;
+  size_t d_trieSize;
+  /** The trie returned by getEqcTrie, and the number of terms it contains */
+  TNodeTrie d_eqcTrie;
+  size_t d_eqcTrieSize;
+  /** Whether d_eqcTrie contains the terms that are not indexed */
+  bool d_eqcTrieUnindexed;
+};
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__QUANTIFIERS__TERM_ARG_TABLE_H */
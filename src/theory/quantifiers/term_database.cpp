@@ -46,9 +46,13 @@ TermDb::TermDb(QuantifiersState& qs, QuantifiersRegistry& qr)
       d_typeMap(d_termsContextUse),
       d_ops(d_termsContextUse),
       d_opMap(d_termsContextUse),
-      d_inactive_map(qs.getSatContext())
+      d_inactive_map(qs.getSatContext()),
+      d_round(0),
+      d_opIndexStamp(0),
+      d_frozen(false)
 {
   d_consistent_ee = true;
+  d_emptyTable.prepare();
   d_true = NodeManager::currentNM()->mkConst(true);
   d_false = NodeManager::currentNM()->mkConst(false);
   if (!options::termDbCd())
@@ -185,6 +189,11 @@ Node TermDb::getMatchOperator( Node n ) {
     //since it is parametric, use a particular one as op
     TypeNode tn = n[0].getType();
     Node op = n.getOperator();
+    std::unique_lock<std::mutex> lock(d_parOpMutex, std::defer_lock);
+    if (d_frozen)
+    {
+      lock.lock();
+    }
     std::map< Node, std::map< TypeNode, Node > >::iterator ito = d_par_op_map.find( op );
     if( ito!=d_par_op_map.end() ){
       std::map< TypeNode, Node >::iterator it = ito->second.find( tn );
@@ -271,25 +280,38 @@ DbList* TermDb::getOrMkDbListForOp(TNode op)
   return dl.get();
 }
 
-void TermDb::computeArgReps( TNode n ) {
-  if (d_arg_reps.find(n) == d_arg_reps.end())
+void TermDb::computeArgReps(TNode n, std::vector<TNode>& reps)
+{
+  reps.clear();
+  eq::EqualityEngine* ee = d_qstate.getEqualityEngine();
+  for (const TNode& nc : n)
   {
-    eq::EqualityEngine* ee = d_qstate.getEqualityEngine();
-    for (const TNode& nc : n)
-    {
-      TNode r = ee->hasTerm(nc) ? ee->getRepresentative(nc) : nc;
-      d_arg_reps[n].push_back( r );
-    }
+    reps.push_back(ee->hasTerm(nc) ? ee->getRepresentative(nc) : nc);
   }
 }
 
-void TermDb::computeUfEqcTerms( TNode f ) {
+OpIndex* TermDb::computeUfTerms(TNode f)
+{
   Assert(f == getOperatorRepresentative(f));
-  if (d_func_map_eqc_trie.find(f) != d_func_map_eqc_trie.end())
+  OpIndex* oi;
+  std::unordered_map<Node, size_t, NodeHashFunction>::iterator itoi =
+      d_opIndexId.find(f);
+  if (itoi == d_opIndexId.end())
   {
-    return;
+    d_opIndexId[f] = d_opIndex.size();
+    d_opIndex.emplace_back(new OpIndex(d_qstate.getSatContext()));
+    oi = d_opIndex.back().get();
   }
-  d_func_map_eqc_trie[f].clear();
+  else
+  {
+    oi = d_opIndex[itoi->second].get();
+    if (oi->d_round == d_round)
+    {
+      // already computed
+      return oi;
+    }
+  }
+  oi->d_round = d_round;
   // get the matchable operators in the equivalence class of f
   std::vector<TNode> ops;
   ops.push_back(f);
@@ -297,166 +319,179 @@ void TermDb::computeUfEqcTerms( TNode f ) {
   {
     ops.insert(ops.end(), d_ho_op_slaves[f].begin(), d_ho_op_slaves[f].end());
   }
-  eq::EqualityEngine* ee = d_qstate.getEqualityEngine();
-  for (TNode ff : ops)
+  Trace("term-db-debug") << "computeUfTerms for " << f << std::endl;
+  TermArgTable& tat = oi->d_table;
+  NodeDbListMap::iterator it = d_opMap.find(f);
+  size_t nprocessed = it == d_opMap.end() ? 0 : it->second->d_list.size();
+  // The table can be extended if no context it was computed in was popped and
+  // no classes were merged since, since then its terms are still in the
+  // equality engine, and the representatives it stores are still current.
+  // Terms that were not relevant or active at that time are not either now.
+  std::vector<Node> uterms;
+  size_t start = 0;
+  if (oi->d_lastStamp != 0 && oi->d_stamp.get() == oi->d_lastStamp
+      && oi->d_mergeStamp == d_qstate.getMergeStamp()
+      && oi->d_numProcessed <= nprocessed && ops.size() == 1
+      && options::termDbMode() == options::TermDbMode::ALL)
   {
-    DbList* dbl = getOrMkDbListForOp(ff);
-    for (const Node& n : dbl->d_list)
-    {
-      if (hasTermCurrent(n) && isTermActive(n))
-      {
-        computeArgReps(n);
-        TNode r = ee->hasTerm(n) ? ee->getRepresentative(n) : TNode(n);
-        d_func_map_eqc_trie[f].d_data[r].addTerm(n, d_arg_reps[n]);
-      }
-    }
+    Trace("term-db-debug") << "...extend with "
+                           << (nprocessed - oi->d_numProcessed) << " new terms"
+                           << std::endl;
+    // unindexed terms may be indexed now
+    tat.takeUnindexedTerms(uterms);
+    start = oi->d_numProcessed;
   }
-}
-
-void TermDb::computeUfTerms( TNode f ) {
-  if (d_op_nonred_count.find(f) != d_op_nonred_count.end())
+  else
   {
-    // already computed
-    return;
+    tat.clear();
   }
-  Assert(f == getOperatorRepresentative(f));
-  d_op_nonred_count[f] = 0;
-  // get the matchable operators in the equivalence class of f
-  std::vector<TNode> ops;
-  ops.push_back(f);
-  if (options::ufHo())
+  std::vector<TNode> terms(uterms.begin(), uterms.end());
+  for (TNode ff : ops)
   {
-    ops.insert(ops.end(), d_ho_op_slaves[f].begin(), d_ho_op_slaves[f].end());
+    NodeDbListMap::iterator itf = d_opMap.find(ff);
+    if (itf == d_opMap.end())
+    {
+      // no terms for this operator
+      continue;
+    }
+    Trace("term-db-debug") << "Adding terms for operator " << ff << std::endl;
+    const NodeList& list = itf->second->d_list;
+    for (size_t i = ff == f ? start : 0, size = list.size(); i < size; i++)
+    {
+      terms.push_back(list[i]);
+    }
   }
-  Trace("term-db-debug") << "computeUfTerms for " << f << std::endl;
+  oi->d_numProcessed = nprocessed;
+  oi->d_lastStamp = ++d_opIndexStamp;
+  oi->d_stamp = oi->d_lastStamp;
+  oi->d_mergeStamp = d_qstate.getMergeStamp();
   unsigned congruentCount = 0;
   unsigned nonCongruentCount = 0;
   unsigned alreadyCongruentCount = 0;
   unsigned relevantCount = 0;
   NodeManager* nm = NodeManager::currentNM();
-  for (TNode ff : ops)
+  std::vector<TNode> reps;
+  for (TNode n : terms)
   {
-    NodeDbListMap::iterator it = d_opMap.find(ff);
-    if (it == d_opMap.end())
+    // to be added to term index, term must be relevant
+    if (!hasTermCurrent(n))
     {
-      // no terms for this operator
+      Trace("term-db-debug") << n << " is not relevant." << std::endl;
       continue;
     }
-    Trace("term-db-debug") << "Adding terms for operator " << ff << std::endl;
-    for (const Node& n : it->second->d_list)
+    if (!isTermActive(n))
+    {
+      Trace("term-db-debug") << n << " is already redundant." << std::endl;
+      alreadyCongruentCount++;
+      continue;
+    }
+    computeArgReps(n, reps);
+    // and exist in EE
+    if (!d_qstate.hasTerm(n))
+    {
+      Trace("term-db-debug") << n << " is not in the EE." << std::endl;
+      tat.addUnindexedTerm(n, reps, n);
+      continue;
+    }
+    relevantCount++;
+    if (Trace.isOn("term-db-debug"))
     {
-      // to be added to term index, term must be relevant, and exist in EE
-      if (!hasTermCurrent(n) || !d_qstate.hasTerm(n))
-      {
-        Trace("term-db-debug") << n << " is not relevant." << std::endl;
-        continue;
-      }
-
-      relevantCount++;
-      if (!isTermActive(n))
-      {
-        Trace("term-db-debug") << n << " is already redundant." << std::endl;
-        alreadyCongruentCount++;
-        continue;
-      }
-
-      computeArgReps(n);
       Trace("term-db-debug") << "Adding term " << n << " with arg reps : ";
-      for (unsigned i = 0, size = d_arg_reps[n].size(); i < size; i++)
+      for (const TNode& r : reps)
       {
-        Trace("term-db-debug") << d_arg_reps[n][i] << " ";
-        if (std::find(d_func_map_rel_dom[f][i].begin(),
-                      d_func_map_rel_dom[f][i].end(),
-                      d_arg_reps[n][i])
-            == d_func_map_rel_dom[f][i].end())
-        {
-          d_func_map_rel_dom[f][i].push_back(d_arg_reps[n][i]);
-        }
+        Trace("term-db-debug") << r << " ";
       }
       Trace("term-db-debug") << std::endl;
-      Assert(d_qstate.hasTerm(n));
-      Trace("term-db-debug")
-          << "  and value : " << d_qstate.getRepresentative(n) << std::endl;
-      Node at = d_func_map_trie[f].addOrGetTerm(n, d_arg_reps[n]);
-      Assert(d_qstate.hasTerm(at));
-      Trace("term-db-debug2") << "...add term returned " << at << std::endl;
-      if (at != n && d_qstate.areEqual(at, n))
-      {
-        setTermInactive(n);
-        Trace("term-db-debug") << n << " is redundant." << std::endl;
-        congruentCount++;
-        continue;
-      }
-      if (d_qstate.areDisequal(at, n))
+    }
+    TNode r = d_qstate.getRepresentative(n);
+    Trace("term-db-debug") << "  and value : " << r << std::endl;
+    TNode at = tat.addOrGetTerm(n, reps, r);
+    Assert(d_qstate.hasTerm(at));
+    Trace("term-db-debug2") << "...add term returned " << at << std::endl;
+    if (at == n)
+    {
+      nonCongruentCount++;
+      continue;
+    }
+    if (d_qstate.areEqual(at, n))
+    {
+      setTermInactive(n);
+      Trace("term-db-debug") << n << " is redundant." << std::endl;
+      congruentCount++;
+      continue;
+    }
+    if (d_qstate.areDisequal(at, n))
+    {
+      std::vector<Node> lits;
+      lits.push_back(nm->mkNode(EQUAL, at, n));
+      bool success = true;
+      if (options::ufHo())
       {
-        std::vector<Node> lits;
-        lits.push_back(nm->mkNode(EQUAL, at, n));
-        bool success = true;
-        if (options::ufHo())
+        // operators might be disequal
+        if (ops.size() > 1)
         {
-          // operators might be disequal
-          if (ops.size() > 1)
+          Node atf = getMatchOperator(at);
+          Node nf = getMatchOperator(n);
+          if (atf != nf)
           {
-            Node atf = getMatchOperator(at);
-            Node nf = getMatchOperator(n);
-            if (atf != nf)
+            if (at.getKind() == APPLY_UF && n.getKind() == APPLY_UF)
             {
-              if (at.getKind() == APPLY_UF && n.getKind() == APPLY_UF)
-              {
-                lits.push_back(atf.eqNode(nf).negate());
-              }
-              else
-              {
-                success = false;
-                Assert(false);
-              }
+              lits.push_back(atf.eqNode(nf).negate());
+            }
+            else
+            {
+              success = false;
+              Assert(false);
             }
           }
         }
-        if (success)
+      }
+      if (success)
+      {
+        Assert(at.getNumChildren() == n.getNumChildren());
+        for (unsigned k = 0, size = at.getNumChildren(); k < size; k++)
         {
-          Assert(at.getNumChildren() == n.getNumChildren());
-          for (unsigned k = 0, size = at.getNumChildren(); k < size; k++)
+          if (at[k] != n[k])
           {
-            if (at[k] != n[k])
-            {
-              lits.push_back(nm->mkNode(EQUAL, at[k], n[k]).negate());
-            }
+            lits.push_back(nm->mkNode(EQUAL, at[k], n[k]).negate());
           }
-          Node lem = lits.size() == 1 ? lits[0] : nm->mkNode(OR, lits);
-          if (Trace.isOn("term-db-lemma"))
+        }
+        Node lem = lits.size() == 1 ? lits[0] : nm->mkNode(OR, lits);
+        if (Trace.isOn("term-db-lemma"))
+        {
+          Trace("term-db-lemma") << "Disequal congruent terms : " << at << " "
+                                 << n << "!!!!" << std::endl;
+          if (!d_qstate.getValuation().needCheck())
           {
-            Trace("term-db-lemma") << "Disequal congruent terms : " << at << " "
-                                   << n << "!!!!" << std::endl;
-            if (!d_qstate.getValuation().needCheck())
-            {
-              Trace("term-db-lemma") << "  all theories passed with no lemmas."
-                                     << std::endl;
-              // we should be a full effort check, prior to theory combination
-            }
-            Trace("term-db-lemma") << "  add lemma : " << lem << std::endl;
+            Trace("term-db-lemma") << "  all theories passed with no lemmas."
+                                   << std::endl;
+            // we should be a full effort check, prior to theory combination
           }
-          d_qim->addPendingLemma(lem, InferenceId::UNKNOWN);
-          d_qstate.notifyInConflict();
-          d_consistent_ee = false;
-          return;
+          Trace("term-db-lemma") << "  add lemma : " << lem << std::endl;
         }
+        d_qim->addPendingLemma(lem, InferenceId::UNKNOWN);
+        d_qstate.notifyInConflict();
+        d_consistent_ee = false;
+        // the table is incomplete, recompute it in the next round
+        oi->d_lastStamp = 0;
+        return oi;
       }
-      nonCongruentCount++;
-      d_op_nonred_count[f]++;
-    }
-    if (Trace.isOn("tdb"))
-    {
-      Trace("tdb") << "Term db size [" << f << "] : " << nonCongruentCount
-                   << " / ";
-      Trace("tdb") << (nonCongruentCount + congruentCount) << " / "
-                   << (nonCongruentCount + congruentCount
-                       + alreadyCongruentCount)
-                   << " / ";
-      Trace("tdb") << relevantCount << " / " << it->second->d_list.size()
-                   << std::endl;
     }
+    // congruent to at without being equal to it, it stays active
+    tat.addUnindexedTerm(n, reps, r);
+    nonCongruentCount++;
+  }
+  if (Trace.isOn("tdb"))
+  {
+    Trace("tdb") << "Term db size [" << f << "] : " << nonCongruentCount
+                 << " / ";
+    Trace("tdb") << (nonCongruentCount + congruentCount) << " / "
+                 << (nonCongruentCount + congruentCount
+                     + alreadyCongruentCount)
+                 << " / ";
+    Trace("tdb") << relevantCount << " / " << terms.size() << std::endl;
   }
+  return oi;
 }
 
 void TermDb::addTermHo(Node n)
@@ -526,20 +561,10 @@ bool TermDb::inRelevantDomain( TNode f, unsigned i, TNode r ) {
   if( options::ufHo() ){
     f = getOperatorRepresentative( f );
   }
-  computeUfTerms( f );
+  OpIndex* oi = computeUfTerms(f);
   Assert(!d_qstate.getEqualityEngine()->hasTerm(r)
          || d_qstate.getEqualityEngine()->getRepresentative(r) == r);
-  std::map< Node, std::map< unsigned, std::vector< Node > > >::iterator it = d_func_map_rel_dom.find( f );
-  if( it != d_func_map_rel_dom.end() ){
-    std::map< unsigned, std::vector< Node > >::iterator it2 = it->second.find( i );
-    if( it2!=it->second.end() ){
-      return std::find( it2->second.begin(), it2->second.end(), r )!=it2->second.end();
-    }else{
-      return false;
-    }
-  }else{
-    return false;
-  }
+  return oi->d_table.inRelevantDomain(i, r);
 }
 
 Node TermDb::evaluateTerm2(TNode n,
@@ -998,15 +1023,17 @@ void TermDb::presolve() {
   {
     d_termsContext.pop();
     d_termsContext.push();
+    // the lists of terms were cleared, recompute the indices
+    for (std::unique_ptr<OpIndex>& oi : d_opIndex)
+    {
+      oi->d_lastStamp = 0;
+    }
   }
 }
 
 bool TermDb::reset( Theory::Effort effort ){
-  d_op_nonred_count.clear();
-  d_arg_reps.clear();
-  d_func_map_trie.clear();
-  d_func_map_eqc_trie.clear();
-  d_func_map_rel_dom.clear();
+  // the indices of the operators are recomputed or extended lazily
+  d_round++;
   d_consistent_ee = true;
 
   eq::EqualityEngine* ee = d_qstate.getEqualityEngine();
@@ -1156,64 +1183,71 @@ bool TermDb::reset( Theory::Effort effort ){
   return true;
 }
 
-TNodeTrie* TermDb::getTermArgTrie(Node f)
+TermArgTable* TermDb::getTermArgTable(Node f)
 {
   if( options::ufHo() ){
     f = getOperatorRepresentative( f );
   }
-  computeUfTerms( f );
-  std::map<Node, TNodeTrie>::iterator itut = d_func_map_trie.find(f);
-  if( itut!=d_func_map_trie.end() ){
-    return &itut->second;
-  }else{
-    return NULL;
+  if (d_frozen)
+  {
+    // the tables of all operators with terms were computed by freeze
+    std::unordered_map<Node, size_t, NodeHashFunction>::const_iterator itoi =
+        d_opIndexId.find(f);
+    if (itoi != d_opIndexId.end()
+        && d_opIndex[itoi->second]->d_round == d_round)
+    {
+      return &d_opIndex[itoi->second]->d_table;
+    }
+    Assert(getNumGroundTerms(f) == 0);
+    return &d_emptyTable;
   }
+  return &computeUfTerms(f)->d_table;
+}
+
+TNodeTrie* TermDb::getTermArgTrie(Node f)
+{
+  return getTermArgTable(f)->getTrie();
 }
 
 TNodeTrie* TermDb::getTermArgTrie(Node eqc, Node f)
 {
-  if( options::ufHo() ){
-    f = getOperatorRepresentative( f );
+  TNodeTrie* tat = getTermArgTable(f)->getEqcTrie();
+  if( eqc.isNull() ){
+    return tat;
   }
-  computeUfEqcTerms( f );
-  std::map<Node, TNodeTrie>::iterator itut = d_func_map_eqc_trie.find(f);
-  if( itut==d_func_map_eqc_trie.end() ){
-    return NULL;
-  }else{
-    if( eqc.isNull() ){
-      return &itut->second;
-    }else{
-      std::map<TNode, TNodeTrie>::iterator itute =
-          itut->second.d_data.find(eqc);
-      if( itute!=itut->second.d_data.end() ){
-        return &itute->second;
-      }else{
-        return NULL;
-      }
+  std::map<TNode, TNodeTrie>::iterator itute = tat->d_data.find(eqc);
+  if (itute != tat->d_data.end())
+  {
+    return &itute->second;
+  }
+  return nullptr;
+}
+
+void TermDb::freeze()
+{
+  Assert(!d_frozen);
+  for (const Node& op : d_ops)
+  {
+    Node f = options::ufHo() ? getOperatorRepresentative(op) : op;
+    computeUfTerms(f)->d_table.prepare();
+    if (d_qstate.isInConflict())
+    {
+      break;
     }
   }
+  d_frozen = true;
 }
 
+void TermDb::unfreeze() { d_frozen = false; }
+
 TNode TermDb::getCongruentTerm( Node f, Node n ) {
-  if( options::ufHo() ){
-    f = getOperatorRepresentative( f );
-  }
-  computeUfTerms( f );
-  std::map<Node, TNodeTrie>::iterator itut = d_func_map_trie.find(f);
-  if( itut!=d_func_map_trie.end() ){
-    computeArgReps( n );
-    return itut->second.existsTerm( d_arg_reps[n] );
-  }else{
-    return TNode::null();
-  }
+  std::vector<TNode> reps;
+  computeArgReps(n, reps);
+  return getTermArgTable(f)->existsTerm(reps);
 }
 
 TNode TermDb::getCongruentTerm( Node f, std::vector< TNode >& args ) {
-  if( options::ufHo() ){
-    f = getOperatorRepresentative( f );
-  }
-  computeUfTerms( f );
-  return d_func_map_trie[f].existsTerm( args );
+  return getTermArgTable(f)->existsTerm(args);
 }
 
 Node TermDb::getHoTypeMatchPredicate(TypeNode tn)
@@ -18,13 +18,17 @@
 #define CVC4__THEORY__QUANTIFIERS__TERM_DATABASE_H
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #include "context/cdhashmap.h"
 #include "context/cdhashset.h"
+#include "context/cdo.h"
 #include "expr/attribute.h"
 #include "expr/node_trie.h"
 #include "theory/quantifiers/quant_util.h"
+#include "theory/quantifiers/term_arg_table.h"
 #include "theory/theory.h"
 #include "theory/type_enumerator.h"
 
@@ -45,6 +49,38 @@ class DbList
   context::CDList<Node> d_list;
 };
 
+/**
+ * The index of the ground terms of an operator, together with what is needed
+ * to extend it in later rounds instead of recomputing it.
+ */
+class OpIndex
+{
+ public:
+  OpIndex(context::Context* c)
+      : d_round(0),
+        d_numProcessed(0),
+        d_stamp(c, 0),
+        d_lastStamp(0),
+        d_mergeStamp(0)
+  {
+  }
+  /** The table of the terms */
+  TermArgTable d_table;
+  /** The round in which the table was last computed */
+  size_t d_round;
+  /** The number of terms of the operator that were processed */
+  size_t d_numProcessed;
+  /**
+   * The stamp of the last computation, which is restored to an earlier stamp
+   * when the SAT context is popped below the level of that computation.
+   */
+  context::CDO<uint64_t> d_stamp;
+  /** The stamp of the last computation */
+  uint64_t d_lastStamp;
+  /** The merge stamp of the quantifiers state at the last computation */
+  uint64_t d_mergeStamp;
+};
+
 /** Term Database
  *
  * This class is a key utility used by
@@ -55,13 +91,15 @@ class DbList
  * The primary responsibilities for this class are to :
  * (1) Maintain a list of all ground terms that exist in the quantifier-free
  *     solvers, as notified through the master equality engine.
- * (2) Build TNodeTrie objects that index all ground terms, per operator.
+ * (2) Build TermArgTable objects that index all ground terms, per operator.
  *
  * Like other utilities, its reset(...) function is called
  * at the beginning of full or last call effort checks.
  * This initializes the database for the round. However,
- * notice that TNodeTrie objects are computed
- * lazily for performance reasons.
+ * notice that TermArgTable objects are computed
+ * lazily for performance reasons. When no equivalence classes were merged
+ * since the table of an operator was last computed, it is extended with the
+ * new terms of the operator instead of being recomputed.
  */
 class TermDb : public QuantifiersUtil {
   using NodeBoolMap = context::CDHashMap<Node, bool, NodeHashFunction>;
@@ -151,11 +189,24 @@ class TermDb : public QuantifiersUtil {
   * then this function returns Node::null().
   */
   Node getMatchOperator(Node n);
+  /** get the table of all f-applications in the current context */
+  TermArgTable* getTermArgTable(Node f);
   /** get term arg index for all f-applications in the current context */
   TNodeTrie* getTermArgTrie(Node f);
   /** get the term arg trie for f-applications in the equivalence class of eqc.
    */
   TNodeTrie* getTermArgTrie(Node eqc, Node f);
+  /**
+   * Compute the tables of all operators for this round, after which the
+   * queries used by E-matching do not modify this database until unfreeze is
+   * called. These are getMatchOperator, getNumGroundTerms, getGroundTerm,
+   * getTermArgTable, getTermArgTrie, isTermActive and hasTermCurrent, which
+   * may then be made concurrently. This may add a lemma for disequal
+   * congruent terms, in which case we are in conflict.
+   */
+  void freeze();
+  /** Allow the above queries to compute the tables of operators again */
+  void unfreeze();
   /** get congruent term
   * If possible, returns a term t such that:
   * (1) t is a term that is currently indexed by this database,
@@ -318,15 +369,20 @@ class TermDb : public QuantifiersUtil {
   std::unordered_map<TypeNode, Node, TypeNodeHashFunction> d_type_fv;
   /** inactive map */
   NodeBoolMap d_inactive_map;
-  /** count of the number of non-redundant ground terms per operator */
-  std::map< Node, int > d_op_nonred_count;
-  /** mapping from terms to representatives of their arguments */
-  std::map< TNode, std::vector< TNode > > d_arg_reps;
-  /** map from operators to trie */
-  std::map<Node, TNodeTrie> d_func_map_trie;
-  std::map<Node, TNodeTrie> d_func_map_eqc_trie;
-  /** mapping from operators to their representative relevant domains */
-  std::map< Node, std::map< unsigned, std::vector< Node > > > d_func_map_rel_dom;
+  /** map from operators to their identifier in d_opIndex */
+  std::unordered_map<Node, size_t, NodeHashFunction> d_opIndexId;
+  /** the indices of the operators, by identifier */
+  std::vector<std::unique_ptr<OpIndex>> d_opIndex;
+  /** the number of calls to reset */
+  size_t d_round;
+  /** the last stamp given to an operator index */
+  uint64_t d_opIndexStamp;
+  /** whether freeze was called and unfreeze was not since */
+  bool d_frozen;
+  /** the table of the operators without terms while frozen */
+  TermArgTable d_emptyTable;
+  /** protects d_par_op_map while frozen */
+  std::mutex d_parOpMutex;
   /** has map */
   std::map< Node, bool > d_has_map;
   /** map from reps to a term in eqc in d_has_map */
@@ -356,18 +412,14 @@ class TermDb : public QuantifiersUtil {
                    bool subsRep,
                    bool hasSubs,
                    bool pol);
-  /** compute uf eqc terms :
-  * Ensure entries for f are in d_func_map_eqc_trie for all equivalence classes
-  */
-  void computeUfEqcTerms( TNode f );
   /** compute uf terms
-  * Ensure that an entry for f is in d_func_map_trie
+  * Ensure that the index of f is computed for this round, and return it
   */
-  void computeUfTerms( TNode f );
+  OpIndex* computeUfTerms(TNode f);
   /** compute arg reps
-  * Ensure that an entry for n is in d_arg_reps
+  * Set reps to the representatives of the arguments of n
   */
-  void computeArgReps(TNode n);
+  void computeArgReps(TNode n, std::vector<TNode>& reps);
   //------------------------------higher-order term indexing
   /**
    * Map from non-variable function terms to the operator used to purify it in
@@ -597,7 +597,24 @@ void QuantifiersEngine::assertQuantifier( Node f, bool pol ){
   d_treg.addTerm(d_qreg.getInstConstantBody(f), true);
 }
 
-void QuantifiersEngine::eqNotifyNewClass(TNode t) { d_treg.addTerm(t); }
+void QuantifiersEngine::eqNotifyNewClass(TNode t)
+{
+  d_treg.addTerm(t);
+  if (options::eMatchingIncremental())
+  {
+    d_qstate.notifyModified(t);
+  }
+}
+
+void QuantifiersEngine::eqNotifyMerge(TNode t1, TNode t2)
+{
+  d_qstate.notifyMerge();
+  if (options::eMatchingIncremental())
+  {
+    // t1 is the representative of the merged class
+    d_qstate.notifyModified(t1);
+  }
+}
 
 void QuantifiersEngine::markRelevant( Node q ) {
   d_model->markRelevant( q );
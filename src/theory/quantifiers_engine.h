@@ -119,6 +119,8 @@ private:
 public:
  /** notification when master equality engine is updated */
  void eqNotifyNewClass(TNode t);
+ /** notification when two classes are merged in master equality engine */
+ void eqNotifyMerge(TNode t1, TNode t2);
  /** mark relevant quantified formula, this will indicate it should be checked
   * before the others */
  void markRelevant(Node q);
@@ -194,10 +194,12 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId,
 #ifdef CVC4_ASSERTIONS
   bool isEquality = node.getKind() == kind::EQUAL && (!node[0].getType().isBoolean());
 
+#ifndef CVC4_THREAD_SAFE_NODES
   if (d_rewriteStack == nullptr)
   {
     d_rewriteStack.reset(new std::unordered_set<Node, NodeHashFunction>());
   }
+#endif
 #endif
 
   Trace("rewriter") << "Rewriter::rewriteTo(" << theoryId << "," << node << ")"<< std::endl;
@@ -328,15 +330,16 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId,
         {
           // In the post rewrite if we've changed theories, we must do a full rewrite
           Assert(response.d_node != rewriteStackTop.d_node);
-          //TODO: this is not thread-safe - should make this assertion dependent on sequential build
-#ifdef CVC4_ASSERTIONS
+          // the loop check is not thread-safe, skip it in builds where
+          // several threads may rewrite at the same time
+#if defined(CVC4_ASSERTIONS) && !defined(CVC4_THREAD_SAFE_NODES)
           Assert(d_rewriteStack->find(response.d_node)
                  == d_rewriteStack->end());
           d_rewriteStack->insert(response.d_node);
 #endif
           Node rewritten = rewriteTo(newTheoryId, response.d_node, tcpg);
           rewriteStackTop.d_node = rewritten;
-#ifdef CVC4_ASSERTIONS
+#if defined(CVC4_ASSERTIONS) && !defined(CVC4_THREAD_SAFE_NODES)
           d_rewriteStack->erase(response.d_node);
 #endif
           break;
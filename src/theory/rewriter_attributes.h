@@ -29,8 +29,14 @@ struct RewriteCacheTag {};
 template <theory::TheoryId theoryId>
 struct RewriteAttibute {
 
-  typedef expr::Attribute< RewriteCacheTag<true, theoryId>, Node> pre_rewrite;
-  typedef expr::Attribute< RewriteCacheTag<false, theoryId>, Node> post_rewrite;
+  /**
+   * The caches are consulted for every (sub)term that is rewritten and set on
+   * almost all of them, hence they are stored densely by node id.
+   */
+  typedef expr::DenseAttribute<RewriteCacheTag<true, theoryId>, Node>
+      pre_rewrite;
+  typedef expr::DenseAttribute<RewriteCacheTag<false, theoryId>, Node>
+      post_rewrite;
 
   /**
    * Get the value of the pre-rewrite cache.
@@ -38,9 +44,8 @@ struct RewriteAttibute {
   static Node getPreRewriteCache(TNode node)
   {
     Node cache;
-    if (node.hasAttribute(pre_rewrite())) {
-      node.getAttribute(pre_rewrite(), cache);
-    } else {
+    if (!node.getAttribute(pre_rewrite(), cache))
+    {
       return Node::null();
     }
     if (cache.isNull()) {
@@ -71,9 +76,8 @@ struct RewriteAttibute {
   static Node getPostRewriteCache(TNode node)
   {
     Node cache;
-    if (node.hasAttribute(post_rewrite())) {
-      node.getAttribute(post_rewrite(), cache);
-    } else {
+    if (!node.getAttribute(post_rewrite(), cache))
+    {
       return Node::null();
     }
     if (cache.isNull()) {
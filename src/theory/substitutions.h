@@ -162,6 +162,8 @@ public:
     return d_substitutions.empty();
   }
 
+  size_t size() const { return d_substitutions.size(); }
+
   /**
    * Print to the output stream
    */
@@ -11,35 +11,123 @@
  **
  ** \brief A fixed-size bit-vector.
  **
- ** A fixed-size bit-vector, implemented as a wrapper around Integer.
+ ** A fixed-size bit-vector, implemented as a machine word for sizes up to 64
+ ** bits and as a wrapper around Integer otherwise.
  **
  ** \todo document this file
  **/
 
 #include "util/bitvector.h"
 
+#include <algorithm>
+
+#include "base/check.h"
 #include "base/exception.h"
 
 namespace cvc5 {
 
+BitVector::BitVector(unsigned size, const BitVector& q)
+    : d_size(size), d_word(0)
+{
+  if (isSmall() && q.isSmall())
+  {
+    d_word = q.d_word;
+  }
+  else
+  {
+    setValue(q.getValue());
+  }
+}
+
+BitVector::BitVector(const std::string& num, unsigned base) : d_word(0)
+{
+  CheckArgument(base == 2 || base == 10 || base == 16, base);
+  Integer value(num, base);
+  switch (base)
+  {
+    case 10: d_size = value.length(); break;
+    case 16: d_size = num.size() * 4; break;
+    default: d_size = num.size();
+  }
+  setValue(value);
+}
+
+void BitVector::setValue(const Integer& val)
+{
+  if (isSmall())
+  {
+    d_word = d_size == 0 ? 0 : val.modByPow2(d_size).getUnsignedLong();
+    d_value.reset();
+  }
+  else
+  {
+    d_value.reset(new Integer(val.modByPow2(d_size)));
+  }
+}
+
+int64_t BitVector::toSignedWord() const
+{
+  Assert(isSmall() && d_size > 0);
+  // sign-extend to 64 bits
+  uint64_t word = d_word;
+  if ((word >> (d_size - 1)) & 1)
+  {
+    word |= ~mask(d_size);
+  }
+  return static_cast<int64_t>(word);
+}
+
+uint64_t BitVector::getShiftAmount(const BitVector& y) const
+{
+  if (y.isSmall())
+  {
+    return std::min(y.d_word, uint64_t(d_size));
+  }
+  if (*y.d_value >= Integer(d_size))
+  {
+    return d_size;
+  }
+  return y.d_value->getUnsignedLong();
+}
+
 unsigned BitVector::getSize() const { return d_size; }
 
-const Integer& BitVector::getValue() const { return d_value; }
+Integer BitVector::getValue() const
+{
+  return isSmall() ? Integer(d_word) : *d_value;
+}
 
-Integer BitVector::toInteger() const { return d_value; }
+Integer BitVector::toInteger() const { return getValue(); }
 
 Integer BitVector::toSignedInteger() const
 {
+  if (isSmall() && d_size > 0)
+  {
+    return Integer(toSignedWord());
+  }
   unsigned size = d_size;
-  Integer sign_bit = d_value.extractBitRange(1, size - 1);
-  Integer val = d_value.extractBitRange(size - 1, 0);
+  Integer value = getValue();
+  Integer sign_bit = value.extractBitRange(1, size - 1);
+  Integer val = value.extractBitRange(size - 1, 0);
   Integer res = Integer(-1) * sign_bit.multiplyByPow2(size - 1) + val;
   return res;
 }
 
 std::string BitVector::toString(unsigned int base) const
 {
-  std::string str = d_value.toString(base);
+  if (base == 2 && isSmall() && d_size > 0)
+  {
+    std::string str(d_size, '0');
+    for (unsigned i = 0; i < d_size; ++i)
+    {
+      if ((d_word >> i) & 1)
+      {
+        str[d_size - 1 - i] = '1';
+      }
+    }
+    return str;
+  }
+  std::string str = getValue().toString(base);
   if (base == 2 && d_size > str.size())
   {
     std::string zeroes;
@@ -57,25 +145,53 @@ std::string BitVector::toString(unsigned int base) const
 
 size_t BitVector::hash() const
 {
-  return d_value.hash() + d_size;
+  // for small bit-vectors, this coincides with the hash of the Integer value
+  // for 64-bit limbs
+  return (isSmall() ? d_word : d_value->hash()) + d_size;
 }
 
 BitVector& BitVector::setBit(uint32_t i, bool value)
 {
   CheckArgument(i < d_size, i);
-  d_value.setBit(i, value);
+  if (isSmall())
+  {
+    if (value)
+    {
+      d_word |= uint64_t(1) << i;
+    }
+    else
+    {
+      d_word &= ~(uint64_t(1) << i);
+    }
+  }
+  else
+  {
+    d_value->setBit(i, value);
+  }
   return *this;
 }
 
 bool BitVector::isBitSet(uint32_t i) const
 {
   CheckArgument(i < d_size, i);
-  return d_value.isBitSet(i);
+  if (isSmall())
+  {
+    return (d_word >> i) & 1;
+  }
+  return d_value->isBitSet(i);
 }
 
 unsigned BitVector::isPow2() const
 {
-  return d_value.isPow2();
+  if (isSmall())
+  {
+    if (d_word == 0 || (d_word & (d_word - 1)) != 0)
+    {
+      return 0;
+    }
+    return __builtin_ctzll(d_word) + 1;
+  }
+  return d_value->isPow2();
 }
 
 /* -----------------------------------------------------------------------
@@ -86,16 +202,28 @@ unsigned BitVector::isPow2() const
 
 BitVector BitVector::concat(const BitVector& other) const
 {
-  return BitVector(d_size + other.d_size,
-                   (d_value.multiplyByPow2(other.d_size)) + other.d_value);
+  unsigned size = d_size + other.d_size;
+  if (size <= MAX_SMALL_SIZE)
+  {
+    // other.d_size < 64 unless d_size is zero
+    uint64_t high = other.d_size < 64 ? d_word << other.d_size : 0;
+    return BitVector(size, high | other.d_word);
+  }
+  return BitVector(size,
+                   (getValue().multiplyByPow2(other.d_size))
+                       + other.getValue());
 }
 
 BitVector BitVector::extract(unsigned high, unsigned low) const
 {
   CheckArgument(high < d_size, high);
   CheckArgument(low <= high, low);
+  if (isSmall())
+  {
+    return BitVector(high - low + 1, d_word >> low);
+  }
   return BitVector(high - low + 1,
-                   d_value.extractBitRange(high - low + 1, low));
+                   d_value->extractBitRange(high - low + 1, low));
 }
 
 /* (Dis)Equality --------------------------------------------------------- */
@@ -103,51 +231,75 @@ BitVector BitVector::extract(unsigned high, unsigned low) const
 bool BitVector::operator==(const BitVector& y) const
 {
   if (d_size != y.d_size) return false;
-  return d_value == y.d_value;
+  return isSmall() ? d_word == y.d_word : *d_value == *y.d_value;
 }
 
 bool BitVector::operator!=(const BitVector& y) const
 {
   if (d_size != y.d_size) return true;
-  return d_value != y.d_value;
+  return isSmall() ? d_word != y.d_word : *d_value != *y.d_value;
 }
 
 /* Unsigned Inequality --------------------------------------------------- */
 
 bool BitVector::operator<(const BitVector& y) const
 {
-  return d_value < y.d_value;
+  if (isSmall() && y.isSmall())
+  {
+    return d_word < y.d_word;
+  }
+  return getValue() < y.getValue();
 }
 
 bool BitVector::operator<=(const BitVector& y) const
 {
-  return d_value <= y.d_value;
+  if (isSmall() && y.isSmall())
+  {
+    return d_word <= y.d_word;
+  }
+  return getValue() <= y.getValue();
 }
 
 bool BitVector::operator>(const BitVector& y) const
 {
-  return d_value > y.d_value;
+  if (isSmall() && y.isSmall())
+  {
+    return d_word > y.d_word;
+  }
+  return getValue() > y.getValue();
 }
 
 bool BitVector::operator>=(const BitVector& y) const
 {
-  return d_value >= y.d_value;
+  if (isSmall() && y.isSmall())
+  {
+    return d_word >= y.d_word;
+  }
+  return getValue() >= y.getValue();
 }
 
 bool BitVector::unsignedLessThan(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value >= 0, y);
-  return d_value < y.d_value;
+  if (isSmall())
+  {
+    return d_word < y.d_word;
+  }
+  CheckArgument(*d_value >= 0, this);
+  CheckArgument(*y.d_value >= 0, y);
+  return *d_value < *y.d_value;
 }
 
 bool BitVector::unsignedLessThanEq(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, this);
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value >= 0, y);
-  return d_value <= y.d_value;
+  if (isSmall())
+  {
+    return d_word <= y.d_word;
+  }
+  CheckArgument(*d_value >= 0, this);
+  CheckArgument(*y.d_value >= 0, y);
+  return *d_value <= *y.d_value;
 }
 
 /* Signed Inequality ----------------------------------------------------- */
@@ -155,8 +307,10 @@ bool BitVector::unsignedLessThanEq(const BitVector& y) const
 bool BitVector::signedLessThan(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value >= 0, y);
+  if (isSmall() && d_size > 0)
+  {
+    return toSignedWord() < y.toSignedWord();
+  }
   Integer a = (*this).toSignedInteger();
   Integer b = y.toSignedInteger();
 
@@ -166,8 +320,10 @@ bool BitVector::signedLessThan(const BitVector& y) const
 bool BitVector::signedLessThanEq(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value >= 0, y);
+  if (isSmall() && d_size > 0)
+  {
+    return toSignedWord() <= y.toSignedWord();
+  }
   Integer a = (*this).toSignedInteger();
   Integer b = y.toSignedInteger();
 
@@ -179,24 +335,40 @@ bool BitVector::signedLessThanEq(const BitVector& y) const
 BitVector BitVector::operator^(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  return BitVector(d_size, d_value.bitwiseXor(y.d_value));
+  if (isSmall())
+  {
+    return BitVector(d_size, d_word ^ y.d_word);
+  }
+  return BitVector(d_size, d_value->bitwiseXor(*y.d_value));
 }
 
 BitVector BitVector::operator|(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  return BitVector(d_size, d_value.bitwiseOr(y.d_value));
+  if (isSmall())
+  {
+    return BitVector(d_size, d_word | y.d_word);
+  }
+  return BitVector(d_size, d_value->bitwiseOr(*y.d_value));
 }
 
 BitVector BitVector::operator&(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  return BitVector(d_size, d_value.bitwiseAnd(y.d_value));
+  if (isSmall())
+  {
+    return BitVector(d_size, d_word & y.d_word);
+  }
+  return BitVector(d_size, d_value->bitwiseAnd(*y.d_value));
 }
 
 BitVector BitVector::operator~() const
 {
-  return BitVector(d_size, d_value.bitwiseNot());
+  if (isSmall())
+  {
+    return BitVector(d_size, ~d_word);
+  }
+  return BitVector(d_size, d_value->bitwiseNot());
 }
 
 /* Arithmetic operations ------------------------------------------------- */
@@ -204,13 +376,22 @@ BitVector BitVector::operator~() const
 BitVector BitVector::operator+(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  Integer sum = d_value + y.d_value;
+  if (isSmall())
+  {
+    // wraps around modulo 2^64, hence also modulo 2^d_size
+    return BitVector(d_size, d_word + y.d_word);
+  }
+  Integer sum = *d_value + *y.d_value;
   return BitVector(d_size, sum);
 }
 
 BitVector BitVector::operator-(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isSmall())
+  {
+    return BitVector(d_size, d_word - y.d_word);
+  }
   // to maintain the invariant that we are only adding BitVectors of the
   // same size
   BitVector one(d_size, Integer(1));
@@ -219,6 +400,10 @@ BitVector BitVector::operator-(const BitVector& y) const
 
 BitVector BitVector::operator-() const
 {
+  if (isSmall())
+  {
+    return BitVector(d_size, uint64_t(0) - d_word);
+  }
   BitVector one(d_size, Integer(1));
   return ~(*this) + one;
 }
@@ -226,50 +411,72 @@ BitVector BitVector::operator-() const
 BitVector BitVector::operator*(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  Integer prod = d_value * y.d_value;
+  if (isSmall())
+  {
+    return BitVector(d_size, d_word * y.d_word);
+  }
+  Integer prod = *d_value * *y.d_value;
   return BitVector(d_size, prod);
 }
 
 BitVector BitVector::unsignedDivTotal(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isSmall())
+  {
+    /* d_word / 0 = -1 = 2^d_size - 1 */
+    return BitVector(d_size, y.d_word == 0 ? mask(d_size) : d_word / y.d_word);
+  }
   /* d_value / 0 = -1 = 2^d_size - 1 */
-  if (y.d_value == 0)
+  if (*y.d_value == 0)
   {
     return BitVector(d_size, Integer(1).oneExtend(1, d_size - 1));
   }
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value > 0, y);
-  return BitVector(d_size, d_value.floorDivideQuotient(y.d_value));
+  CheckArgument(*d_value >= 0, this);
+  CheckArgument(*y.d_value > 0, y);
+  return BitVector(d_size, d_value->floorDivideQuotient(*y.d_value));
 }
 
 BitVector BitVector::unsignedRemTotal(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  if (y.d_value == 0)
+  if (isSmall())
+  {
+    return BitVector(d_size, y.d_word == 0 ? d_word : d_word % y.d_word);
+  }
+  if (*y.d_value == 0)
   {
-    return BitVector(d_size, d_value);
+    return *this;
   }
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value > 0, y);
-  return BitVector(d_size, d_value.floorDivideRemainder(y.d_value));
+  CheckArgument(*d_value >= 0, this);
+  CheckArgument(*y.d_value > 0, y);
+  return BitVector(d_size, d_value->floorDivideRemainder(*y.d_value));
 }
 
 /* Extend operations ----------------------------------------------------- */
 
 BitVector BitVector::zeroExtend(unsigned n) const
 {
-  return BitVector(d_size + n, d_value);
+  if (d_size + n <= MAX_SMALL_SIZE)
+  {
+    return BitVector(d_size + n, d_word);
+  }
+  return BitVector(d_size + n, getValue());
 }
 
 BitVector BitVector::signExtend(unsigned n) const
 {
-  Integer sign_bit = d_value.extractBitRange(1, d_size - 1);
+  if (d_size + n <= MAX_SMALL_SIZE && d_size > 0)
+  {
+    return BitVector(d_size + n, static_cast<uint64_t>(toSignedWord()));
+  }
+  Integer value = getValue();
+  Integer sign_bit = value.extractBitRange(1, d_size - 1);
   if (sign_bit == Integer(0))
   {
-    return BitVector(d_size + n, d_value);
+    return BitVector(d_size + n, value);
   }
-  Integer val = d_value.oneExtend(d_size, n);
+  Integer val = value.oneExtend(d_size, n);
   return BitVector(d_size + n, val);
 }
 
@@ -277,38 +484,60 @@ BitVector BitVector::signExtend(unsigned n) const
 
 BitVector BitVector::leftShift(const BitVector& y) const
 {
-  if (y.d_value > Integer(d_size))
+  if (isSmall())
+  {
+    uint64_t amount = getShiftAmount(y);
+    return BitVector(d_size, amount >= d_size ? 0 : d_word << amount);
+  }
+  Integer amountValue = y.getValue();
+  if (amountValue > Integer(d_size))
   {
     return BitVector(d_size, Integer(0));
   }
-  if (y.d_value == 0)
+  if (amountValue == 0)
   {
     return *this;
   }
   // making sure we don't lose information casting
-  CheckArgument(y.d_value < Integer(1).multiplyByPow2(32), y);
-  uint32_t amount = y.d_value.toUnsignedInt();
-  Integer res = d_value.multiplyByPow2(amount);
+  CheckArgument(amountValue < Integer(1).multiplyByPow2(32), y);
+  uint32_t amount = amountValue.toUnsignedInt();
+  Integer res = d_value->multiplyByPow2(amount);
   return BitVector(d_size, res);
 }
 
 BitVector BitVector::logicalRightShift(const BitVector& y) const
 {
-  if (y.d_value > Integer(d_size))
+  if (isSmall())
+  {
+    uint64_t amount = getShiftAmount(y);
+    return BitVector(d_size, amount >= d_size ? 0 : d_word >> amount);
+  }
+  Integer amountValue = y.getValue();
+  if (amountValue > Integer(d_size))
   {
     return BitVector(d_size, Integer(0));
   }
   // making sure we don't lose information casting
-  CheckArgument(y.d_value < Integer(1).multiplyByPow2(32), y);
-  uint32_t amount = y.d_value.toUnsignedInt();
-  Integer res = d_value.divByPow2(amount);
+  CheckArgument(amountValue < Integer(1).multiplyByPow2(32), y);
+  uint32_t amount = amountValue.toUnsignedInt();
+  Integer res = d_value->divByPow2(amount);
   return BitVector(d_size, res);
 }
 
 BitVector BitVector::arithRightShift(const BitVector& y) const
 {
-  Integer sign_bit = d_value.extractBitRange(1, d_size - 1);
-  if (y.d_value > Integer(d_size))
+  if (isSmall() && d_size > 0)
+  {
+    uint64_t amount = getShiftAmount(y);
+    int64_t value = toSignedWord();
+    // an arithmetic shift of the sign-extended value, by at most 63 bits
+    uint64_t res = static_cast<uint64_t>(
+        amount >= d_size ? (value < 0 ? -1 : 0) : value >> amount);
+    return BitVector(d_size, res);
+  }
+  Integer amountValue = y.getValue();
+  Integer sign_bit = d_value->extractBitRange(1, d_size - 1);
+  if (amountValue > Integer(d_size))
   {
     if (sign_bit == Integer(0))
     {
@@ -320,16 +549,16 @@ BitVector BitVector::arithRightShift(const BitVector& y) const
     }
   }
 
-  if (y.d_value == 0)
+  if (amountValue == 0)
   {
     return *this;
   }
 
   // making sure we don't lose information casting
-  CheckArgument(y.d_value < Integer(1).multiplyByPow2(32), y);
+  CheckArgument(amountValue < Integer(1).multiplyByPow2(32), y);
 
-  uint32_t amount = y.d_value.toUnsignedInt();
-  Integer rest = d_value.divByPow2(amount);
+  uint32_t amount = amountValue.toUnsignedInt();
+  Integer rest = d_value->divByPow2(amount);
 
   if (sign_bit == Integer(0))
   {
@@ -358,6 +587,10 @@ BitVector BitVector::mkOne(unsigned size)
 BitVector BitVector::mkOnes(unsigned size)
 {
   CheckArgument(size > 0, size);
+  if (size <= MAX_SMALL_SIZE)
+  {
+    return BitVector(size, mask(size));
+  }
   return BitVector(1, Integer(1)).signExtend(size - 1);
 }
 
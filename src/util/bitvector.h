@@ -19,8 +19,10 @@
 #ifndef CVC4__BITVECTOR_H
 #define CVC4__BITVECTOR_H
 
+#include <cstdint>
 #include <iosfwd>
 #include <iostream>
+#include <memory>
 
 #include "base/exception.h"
 #include "util/integer.h"
@@ -30,12 +32,18 @@ namespace cvc5 {
 class BitVector
 {
  public:
-  BitVector(unsigned size, const Integer& val)
-      : d_size(size), d_value(val.modByPow2(size))
+  BitVector(unsigned size, const Integer& val) : d_size(size), d_word(0)
   {
+    setValue(val);
   }
 
-  BitVector(unsigned size = 0) : d_size(size), d_value(0) {}
+  BitVector(unsigned size = 0) : d_size(size), d_word(0)
+  {
+    if (!isSmall())
+    {
+      d_value.reset(new Integer(0));
+    }
+  }
 
   /**
    * BitVector constructor using a 32-bit unsigned integer for the value.
@@ -44,10 +52,7 @@ class BitVector
    * platforms (long is 32-bit when compiling 64-bit binaries on
    * Windows but 64-bit on Linux) and to prevent ambiguous overloads.
    */
-  BitVector(unsigned size, uint32_t z) : d_size(size), d_value(z)
-  {
-    d_value = d_value.modByPow2(size);
-  }
+  BitVector(unsigned size, uint32_t z) : BitVector(size, uint64_t(z)) {}
 
   /**
    * BitVector constructor using a 64-bit unsigned integer for the value.
@@ -56,15 +61,19 @@ class BitVector
    * platforms (long is 32-bit when compiling 64-bit binaries on
    * Windows but 64-bit on Linux) and to prevent ambiguous overloads.
    */
-  BitVector(unsigned size, uint64_t z) : d_size(size), d_value(z)
+  BitVector(unsigned size, uint64_t z) : d_size(size), d_word(0)
   {
-    d_value = d_value.modByPow2(size);
+    if (isSmall())
+    {
+      d_word = z & mask(size);
+    }
+    else
+    {
+      d_value.reset(new Integer(z));
+    }
   }
 
-  BitVector(unsigned size, const BitVector& q)
-      : d_size(size), d_value(q.d_value)
-  {
-  }
+  BitVector(unsigned size, const BitVector& q);
 
   /**
    * BitVector constructor.
@@ -79,32 +88,34 @@ class BitVector
    * @param num The value of the bit-vector in string representation.
    * @param base The base of the string representation.
    */
-  BitVector(const std::string& num, unsigned base = 2)
+  BitVector(const std::string& num, unsigned base = 2);
+
+  BitVector(const BitVector& x)
+      : d_size(x.d_size),
+        d_word(x.d_word),
+        d_value(x.d_value == nullptr ? nullptr : new Integer(*x.d_value))
   {
-    CheckArgument(base == 2 || base == 10 || base == 16, base);
-    d_value = Integer(num, base);
-    switch (base)
-    {
-      case 10: d_size = d_value.length(); break;
-      case 16: d_size = num.size() * 4; break;
-      default: d_size = num.size();
-    }
   }
 
+  BitVector(BitVector&& x) = default;
+
   ~BitVector() {}
 
   BitVector& operator=(const BitVector& x)
   {
     if (this == &x) return *this;
     d_size = x.d_size;
-    d_value = x.d_value;
+    d_word = x.d_word;
+    d_value.reset(x.d_value == nullptr ? nullptr : new Integer(*x.d_value));
     return *this;
   }
 
+  BitVector& operator=(BitVector&& x) = default;
+
   /* Get size (bit-width). */
   unsigned getSize() const;
   /* Get value. */
-  const Integer& getValue() const;
+  Integer getValue() const;
 
   /* Return value. */
   Integer toInteger() const;
@@ -264,14 +275,50 @@ class BitVector
   static BitVector mkMaxSigned(unsigned size);
 
  private:
+  /**
+   * Bit-vectors of at most this size keep their value in a machine word
+   * (d_word), larger ones in an Integer (d_value).  Constant folding mostly
+   * deals with small bit-vectors, which thus never allocate.
+   */
+  static const unsigned MAX_SMALL_SIZE = 64;
+
+  /** Return true if the value of this bit-vector is stored in d_word. */
+  bool isSmall() const { return d_size <= MAX_SMALL_SIZE; }
+
+  /** Return a word with the 'size' least significant bits set. */
+  static uint64_t mask(unsigned size)
+  {
+    return size >= 64 ? ~uint64_t(0) : (uint64_t(1) << size) - 1;
+  }
+
+  /** Set the value of this bit-vector to val modulo 2^d_size. */
+  void setValue(const Integer& val);
+
+  /**
+   * Return the two's complement interpretation of this, which must be a small
+   * bit-vector of non-zero size.
+   */
+  int64_t toSignedWord() const;
+
+  /**
+   * Return the value of y as a shift amount for this bit-vector, saturated at
+   * d_size.
+   */
+  uint64_t getShiftAmount(const BitVector& y) const;
+
   /**
    * Class invariants:
-   *  - no overflows: 2^d_size < d_value
-   *  - no negative numbers: d_value >= 0
+   *  - no overflows: 2^d_size < value
+   *  - no negative numbers: value >= 0
+   *  - d_value is set iff d_size > MAX_SMALL_SIZE, otherwise d_word is the
+   *    value
    */
 
   unsigned d_size;
-  Integer d_value;
+  /** The value, if this is a small bit-vector */
+  uint64_t d_word;
+  /** The value, if this is not a small bit-vector */
+  std::unique_ptr<Integer> d_value;
 
 }; /* class BitVector */
 
@@ -16,6 +16,7 @@
 #include "util/rational.h"
 
 #include <cmath>
+#include <numeric>
 #include <sstream>
 #include <string>
 
@@ -91,11 +92,145 @@ Maybe<Rational> Rational::fromDouble(double d)
 {
   using namespace std;
   if(isfinite(d)){
-    Rational q;
-    mpq_set_d(q.d_value.get_mpq_t(), d);
-    return q;
+    mpq_class value;
+    mpq_set_d(value.get_mpq_t(), d);
+    return Rational(value);
   }
   return Maybe<Rational>();
 }
 
+double Rational::getDouble() const
+{
+  // integers of up to 53 bits are exactly representable, all other values go
+  // through GMP since its rounding (truncation) differs from that of double
+  // division
+  const int64_t maxExact = int64_t(1) << 53;
+  if (isSmall() && d_den == 1 && d_num <= maxExact && d_num >= -maxExact)
+  {
+    return static_cast<double>(d_num);
+  }
+  return getValue().get_d();
+}
+
+std::string Rational::toString(int base) const
+{
+  if (isSmall() && base == 10)
+  {
+    std::string res = std::to_string(d_num);
+    if (d_den != 1)
+    {
+      res += "/" + std::to_string(d_den);
+    }
+    return res;
+  }
+  return getValue().get_str(base);
+}
+
+bool Rational::setSmall(int64_t n, int64_t d)
+{
+  const int64_t min = std::numeric_limits<int64_t>::min();
+  if (d == 0 || n == min || d == min)
+  {
+    return false;
+  }
+  if (d < 0)
+  {
+    n = -n;
+    d = -d;
+  }
+  if (d != 1)
+  {
+    int64_t g = std::gcd(n, d);
+    n /= g;
+    d /= g;
+  }
+  d_num = n;
+  d_den = d;
+  d_value.reset();
+  return true;
+}
+
+void Rational::setValue(const mpq_class& value)
+{
+  const mpz_srcptr num = value.get_num_mpz_t();
+  const mpz_srcptr den = value.get_den_mpz_t();
+  if (mpz_fits_slong_p(num) && mpz_fits_slong_p(den)
+      && mpz_get_si(num) != std::numeric_limits<int64_t>::min())
+  {
+    d_num = mpz_get_si(num);
+    d_den = mpz_get_si(den);
+    d_value.reset();
+  }
+  else
+  {
+    d_num = 0;
+    d_den = 1;
+    d_value.reset(new mpq_class(value));
+  }
+}
+
+bool Rational::addSmall(const Rational& x,
+                        const Rational& y,
+                        bool sub,
+                        Rational& res)
+{
+  Assert(x.isSmall() && y.isSmall());
+  // y.d_num != INT64_MIN, hence this does not overflow
+  const int64_t ynum = sub ? -y.d_num : y.d_num;
+  int64_t n, d;
+  if (x.d_den == y.d_den)
+  {
+    if (__builtin_add_overflow(x.d_num, ynum, &n))
+    {
+      return false;
+    }
+    d = x.d_den;
+  }
+  else
+  {
+    int64_t l, r;
+    if (__builtin_mul_overflow(x.d_num, y.d_den, &l)
+        || __builtin_mul_overflow(ynum, x.d_den, &r)
+        || __builtin_add_overflow(l, r, &n)
+        || __builtin_mul_overflow(x.d_den, y.d_den, &d))
+    {
+      return false;
+    }
+  }
+  return res.setSmall(n, d);
+}
+
+bool Rational::mulSmall(const Rational& x,
+                        const Rational& y,
+                        bool div,
+                        Rational& res)
+{
+  Assert(x.isSmall() && y.isSmall());
+  if (div && y.d_num == 0)
+  {
+    return false;
+  }
+  // the numerator and denominator of y, or of its inverse if div is true
+  const int64_t ynum = div ? (y.d_num < 0 ? -y.d_den : y.d_den) : y.d_num;
+  const int64_t yden = div ? (y.d_num < 0 ? -y.d_num : y.d_num) : y.d_den;
+  if (x.d_num == 0 || ynum == 0)
+  {
+    return res.setSmall(0, 1);
+  }
+  // cancel before multiplying, such that the result is canonical
+  const int64_t g1 = std::gcd(x.d_num, yden);
+  const int64_t g2 = std::gcd(ynum, x.d_den);
+  int64_t n, d;
+  if (__builtin_mul_overflow(x.d_num / g1, ynum / g2, &n)
+      || __builtin_mul_overflow(x.d_den / g2, yden / g1, &d)
+      || n == std::numeric_limits<int64_t>::min())
+  {
+    return false;
+  }
+  res.d_num = n;
+  res.d_den = d;
+  res.d_value.reset();
+  return true;
+}
+
 }  // namespace cvc5
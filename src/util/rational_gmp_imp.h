@@ -13,6 +13,8 @@
  ** rational.
  **
  ** Multiprecision rational constants; wraps a GMP multiprecision rational.
+ ** Values whose numerator and denominator fit into 64 bits are kept in
+ ** machine words and only promoted to GMP on overflow.
  **/
 
 #include "cvc4_public.h"
@@ -22,6 +24,9 @@
 
 #include <gmp.h>
 
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <string>
 
 #include "cvc4_export.h"  // remove when Cvc language support is removed
@@ -55,7 +60,7 @@ class CVC4_EXPORT Rational
    * Assumes that the value is in canonical form, and thus does not
    * have to call canonicalize() on the value.
    */
-  Rational(const mpq_class& val) : d_value(val) {}
+  Rational(const mpq_class& val) : d_num(0), d_den(1) { setValue(val); }
 
   /**
    * Creates a rational from a decimal string (e.g., <code>"1.5"</code>).
@@ -66,7 +71,7 @@ class CVC4_EXPORT Rational
   static Rational fromDecimal(const std::string& dec);
 
   /** Constructs a rational with the value 0/1. */
-  Rational() : d_value(0) { d_value.canonicalize(); }
+  Rational() : d_num(0), d_den(1) {}
 
   /**
    * Constructs a Rational from a C string in a given base (defaults to 10).
@@ -75,96 +80,159 @@ class CVC4_EXPORT Rational
    * For more information about what is a valid rational string,
    * see GMP's documentation for mpq_set_str().
    */
-  explicit Rational(const char* s, unsigned base = 10) : d_value(s, base)
+  explicit Rational(const char* s, unsigned base = 10) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    mpq_class value(s, base);
+    value.canonicalize();
+    setValue(value);
   }
-  Rational(const std::string& s, unsigned base = 10) : d_value(s, base)
+  Rational(const std::string& s, unsigned base = 10) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    mpq_class value(s, base);
+    value.canonicalize();
+    setValue(value);
   }
 
   /**
    * Creates a Rational from another Rational, q, by performing a deep copy.
    */
-  Rational(const Rational& q) : d_value(q.d_value) { d_value.canonicalize(); }
+  Rational(const Rational& q)
+      : d_num(q.d_num),
+        d_den(q.d_den),
+        d_value(q.isSmall() ? nullptr : new mpq_class(*q.d_value))
+  {
+  }
+
+  Rational(Rational&& q) = default;
 
   /**
    * Constructs a canonical Rational from a numerator.
    */
-  Rational(signed int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(unsigned int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(signed long int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(unsigned long int n) : d_value(n, 1) { d_value.canonicalize(); }
-
-#ifdef CVC4_NEED_INT64_T_OVERLOADS
-  Rational(int64_t n) : d_value(static_cast<long>(n), 1)
+  Rational(signed int n) : Rational(static_cast<signed long>(n)) {}
+  Rational(unsigned int n) : Rational(static_cast<unsigned long>(n)) {}
+  Rational(signed long int n) : d_num(n), d_den(1)
   {
-    d_value.canonicalize();
+    if (n == std::numeric_limits<int64_t>::min())
+    {
+      setValue(mpq_class(n, 1));
+    }
   }
-  Rational(uint64_t n) : d_value(static_cast<unsigned long>(n), 1)
+  Rational(unsigned long int n) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    if (n <= static_cast<unsigned long>(std::numeric_limits<int64_t>::max()))
+    {
+      d_num = static_cast<int64_t>(n);
+    }
+    else
+    {
+      setValue(mpq_class(n, 1));
+    }
   }
+
+#ifdef CVC4_NEED_INT64_T_OVERLOADS
+  Rational(int64_t n) : Rational(static_cast<long>(n)) {}
+  Rational(uint64_t n) : Rational(static_cast<unsigned long>(n)) {}
 #endif /* CVC4_NEED_INT64_T_OVERLOADS */
 
   /**
    * Constructs a canonical Rational from a numerator and denominator.
    */
-  Rational(signed int n, signed int d) : d_value(n, d)
+  Rational(signed int n, signed int d)
+      : Rational(static_cast<signed long>(n), static_cast<signed long>(d))
   {
-    d_value.canonicalize();
   }
-  Rational(unsigned int n, unsigned int d) : d_value(n, d)
+  Rational(unsigned int n, unsigned int d)
+      : Rational(static_cast<unsigned long>(n), static_cast<unsigned long>(d))
   {
-    d_value.canonicalize();
   }
-  Rational(signed long int n, signed long int d) : d_value(n, d)
+  Rational(signed long int n, signed long int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    if (!setSmall(n, d))
+    {
+      mpq_class value(n, d);
+      value.canonicalize();
+      setValue(value);
+    }
   }
-  Rational(unsigned long int n, unsigned long int d) : d_value(n, d)
+  Rational(unsigned long int n, unsigned long int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    const unsigned long max = std::numeric_limits<int64_t>::max();
+    if (n > max || d > max
+        || !setSmall(static_cast<int64_t>(n), static_cast<int64_t>(d)))
+    {
+      mpq_class value(n, d);
+      value.canonicalize();
+      setValue(value);
+    }
   }
 
 #ifdef CVC4_NEED_INT64_T_OVERLOADS
   Rational(int64_t n, int64_t d)
-      : d_value(static_cast<long>(n), static_cast<long>(d))
+      : Rational(static_cast<long>(n), static_cast<long>(d))
   {
-    d_value.canonicalize();
   }
   Rational(uint64_t n, uint64_t d)
-      : d_value(static_cast<unsigned long>(n), static_cast<unsigned long>(d))
+      : Rational(static_cast<unsigned long>(n), static_cast<unsigned long>(d))
   {
-    d_value.canonicalize();
   }
 #endif /* CVC4_NEED_INT64_T_OVERLOADS */
 
-  Rational(const Integer& n, const Integer& d)
-      : d_value(n.get_mpz(), d.get_mpz())
+  Rational(const Integer& n, const Integer& d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    if (!n.fitsSignedLong() || !d.fitsSignedLong()
+        || !setSmall(n.getLong(), d.getLong()))
+    {
+      mpq_class value(n.get_mpz(), d.get_mpz());
+      value.canonicalize();
+      setValue(value);
+    }
+  }
+  Rational(const Integer& n) : d_num(0), d_den(1)
+  {
+    if (n.fitsSignedLong()
+        && n.getLong() != std::numeric_limits<int64_t>::min())
+    {
+      d_num = n.getLong();
+    }
+    else
+    {
+      setValue(mpq_class(n.get_mpz()));
+    }
   }
-  Rational(const Integer& n) : d_value(n.get_mpz()) { d_value.canonicalize(); }
   ~Rational() {}
 
   /**
-   * Returns a copy of d_value to enable public access of GMP data.
+   * Returns a copy of the value as a GMP rational.
    */
-  const mpq_class& getValue() const { return d_value; }
+  mpq_class getValue() const
+  {
+    if (isSmall())
+    {
+      mpq_class value(static_cast<long>(d_num), static_cast<long>(d_den));
+      return value;
+    }
+    return *d_value;
+  }
 
   /**
    * Returns the value of numerator of the Rational.
    * Note that this makes a deep copy of the numerator.
    */
-  Integer getNumerator() const { return Integer(d_value.get_num()); }
+  Integer getNumerator() const
+  {
+    return isSmall() ? Integer(static_cast<long>(d_num))
+                     : Integer(d_value->get_num());
+  }
 
   /**
    * Returns the value of denominator of the Rational.
    * Note that this makes a deep copy of the denominator.
    */
-  Integer getDenominator() const { return Integer(d_value.get_den()); }
+  Integer getDenominator() const
+  {
+    return isSmall() ? Integer(static_cast<long>(d_den))
+                     : Integer(d_value->get_den());
+  }
 
   static Maybe<Rational> fromDouble(double d);
 
@@ -173,29 +241,57 @@ class CVC4_EXPORT Rational
    * approximate: truncation may occur, overflow may result in
    * infinity, and underflow may result in zero.
    */
-  double getDouble() const { return d_value.get_d(); }
+  double getDouble() const;
 
   Rational inverse() const
   {
+    if (isSmall() && d_num != 0)
+    {
+      Rational res;
+      res.d_num = d_num < 0 ? -d_den : d_den;
+      res.d_den = d_num < 0 ? -d_num : d_num;
+      return res;
+    }
     return Rational(getDenominator(), getNumerator());
   }
 
   int cmp(const Rational& x) const
   {
+    if (isSmall() && x.isSmall())
+    {
+      if (d_den == x.d_den)
+      {
+        return d_num < x.d_num ? -1 : (d_num == x.d_num ? 0 : 1);
+      }
+      int64_t l, r;
+      if (!__builtin_mul_overflow(d_num, x.d_den, &l)
+          && !__builtin_mul_overflow(x.d_num, d_den, &r))
+      {
+        return l < r ? -1 : (l == r ? 0 : 1);
+      }
+    }
     // Don't use mpq_class's cmp() function.
     // The name ends up conflicting with this function.
-    return mpq_cmp(d_value.get_mpq_t(), x.d_value.get_mpq_t());
+    return mpq_cmp(getValue().get_mpq_t(), x.getValue().get_mpq_t());
   }
 
-  int sgn() const { return mpq_sgn(d_value.get_mpq_t()); }
+  int sgn() const
+  {
+    if (isSmall())
+    {
+      return d_num < 0 ? -1 : (d_num == 0 ? 0 : 1);
+    }
+    return mpq_sgn(d_value->get_mpq_t());
+  }
 
   bool isZero() const { return sgn() == 0; }
 
-  bool isOne() const { return mpq_cmp_si(d_value.get_mpq_t(), 1, 1) == 0; }
+  // values that are not small are never 1 or -1
+  bool isOne() const { return isSmall() && d_num == 1 && d_den == 1; }
 
   bool isNegativeOne() const
   {
-    return mpq_cmp_si(d_value.get_mpq_t(), -1, 1) == 0;
+    return isSmall() && d_num == -1 && d_den == 1;
   }
 
   Rational abs() const
@@ -212,15 +308,35 @@ class CVC4_EXPORT Rational
 
   Integer floor() const
   {
+    if (isSmall())
+    {
+      int64_t q = d_num / d_den;
+      if (d_num % d_den != 0 && d_num < 0)
+      {
+        --q;
+      }
+      return Integer(static_cast<long>(q));
+    }
     mpz_class q;
-    mpz_fdiv_q(q.get_mpz_t(), d_value.get_num_mpz_t(), d_value.get_den_mpz_t());
+    mpz_fdiv_q(
+        q.get_mpz_t(), d_value->get_num_mpz_t(), d_value->get_den_mpz_t());
     return Integer(q);
   }
 
   Integer ceiling() const
   {
+    if (isSmall())
+    {
+      int64_t q = d_num / d_den;
+      if (d_num % d_den != 0 && d_num > 0)
+      {
+        ++q;
+      }
+      return Integer(static_cast<long>(q));
+    }
     mpz_class q;
-    mpz_cdiv_q(q.get_mpz_t(), d_value.get_num_mpz_t(), d_value.get_den_mpz_t());
+    mpz_cdiv_q(
+        q.get_mpz_t(), d_value->get_num_mpz_t(), d_value->get_den_mpz_t());
     return Integer(q);
   }
 
@@ -229,69 +345,115 @@ class CVC4_EXPORT Rational
   Rational& operator=(const Rational& x)
   {
     if (this == &x) return *this;
-    d_value = x.d_value;
+    d_num = x.d_num;
+    d_den = x.d_den;
+    d_value.reset(x.isSmall() ? nullptr : new mpq_class(*x.d_value));
     return *this;
   }
 
-  Rational operator-() const { return Rational(-(d_value)); }
+  Rational& operator=(Rational&& x) = default;
+
+  Rational operator-() const
+  {
+    if (isSmall())
+    {
+      Rational res;
+      res.d_num = -d_num;
+      res.d_den = d_den;
+      return res;
+    }
+    return Rational(-(*d_value));
+  }
 
-  bool operator==(const Rational& y) const { return d_value == y.d_value; }
+  /* Canonical values are small if and only if they fit, hence values with
+   * different representations are never equal. */
+  bool operator==(const Rational& y) const
+  {
+    if (isSmall() || y.isSmall())
+    {
+      return isSmall() && y.isSmall() && d_num == y.d_num && d_den == y.d_den;
+    }
+    return *d_value == *y.d_value;
+  }
 
-  bool operator!=(const Rational& y) const { return d_value != y.d_value; }
+  bool operator!=(const Rational& y) const { return !(*this == y); }
 
-  bool operator<(const Rational& y) const { return d_value < y.d_value; }
+  bool operator<(const Rational& y) const { return cmp(y) < 0; }
 
-  bool operator<=(const Rational& y) const { return d_value <= y.d_value; }
+  bool operator<=(const Rational& y) const { return cmp(y) <= 0; }
 
-  bool operator>(const Rational& y) const { return d_value > y.d_value; }
+  bool operator>(const Rational& y) const { return cmp(y) > 0; }
 
-  bool operator>=(const Rational& y) const { return d_value >= y.d_value; }
+  bool operator>=(const Rational& y) const { return cmp(y) >= 0; }
 
   Rational operator+(const Rational& y) const
   {
-    return Rational(d_value + y.d_value);
+    Rational res;
+    if (!isSmall() || !y.isSmall() || !addSmall(*this, y, false, res))
+    {
+      res.setValue(getValue() + y.getValue());
+    }
+    return res;
   }
   Rational operator-(const Rational& y) const
   {
-    return Rational(d_value - y.d_value);
+    Rational res;
+    if (!isSmall() || !y.isSmall() || !addSmall(*this, y, true, res))
+    {
+      res.setValue(getValue() - y.getValue());
+    }
+    return res;
   }
 
   Rational operator*(const Rational& y) const
   {
-    return Rational(d_value * y.d_value);
+    Rational res;
+    if (!isSmall() || !y.isSmall() || !mulSmall(*this, y, false, res))
+    {
+      res.setValue(getValue() * y.getValue());
+    }
+    return res;
   }
   Rational operator/(const Rational& y) const
   {
-    return Rational(d_value / y.d_value);
+    Rational res;
+    if (!isSmall() || !y.isSmall() || !mulSmall(*this, y, true, res))
+    {
+      res.setValue(getValue() / y.getValue());
+    }
+    return res;
   }
 
   Rational& operator+=(const Rational& y)
   {
-    d_value += y.d_value;
+    *this = *this + y;
     return (*this);
   }
   Rational& operator-=(const Rational& y)
   {
-    d_value -= y.d_value;
+    *this = *this - y;
     return (*this);
   }
 
   Rational& operator*=(const Rational& y)
   {
-    d_value *= y.d_value;
+    *this = *this * y;
     return (*this);
   }
 
   Rational& operator/=(const Rational& y)
   {
-    d_value /= y.d_value;
+    *this = *this / y;
     return (*this);
   }
 
-  bool isIntegral() const { return getDenominator() == 1; }
+  bool isIntegral() const
+  {
+    return isSmall() ? d_den == 1 : getDenominator() == 1;
+  }
 
   /** Returns a string representing the rational in the given base. */
-  std::string toString(int base = 10) const { return d_value.get_str(base); }
+  std::string toString(int base = 10) const;
 
   /**
    * Computes the hash of the rational from hashes of the numerator and the
@@ -299,8 +461,14 @@ class CVC4_EXPORT Rational
    */
   size_t hash() const
   {
-    size_t numeratorHash = gmpz_hash(d_value.get_num_mpz_t());
-    size_t denominatorHash = gmpz_hash(d_value.get_den_mpz_t());
+    if (isSmall())
+    {
+      // coincides with the hash of the GMP representation for 64-bit limbs
+      return static_cast<size_t>(d_num < 0 ? -d_num : d_num)
+             xor static_cast<size_t>(d_den);
+    }
+    size_t numeratorHash = gmpz_hash(d_value->get_num_mpz_t());
+    size_t denominatorHash = gmpz_hash(d_value->get_den_mpz_t());
 
     return numeratorHash xor denominatorHash;
   }
@@ -316,11 +484,50 @@ class CVC4_EXPORT Rational
   int absCmp(const Rational& q) const;
 
  private:
+  /** Returns true if the value is stored in d_num and d_den. */
+  bool isSmall() const { return d_value == nullptr; }
+
+  /**
+   * Set this to the canonical form of n/d, if it can be stored in d_num and
+   * d_den.  Returns false and leaves this unchanged otherwise, or if d is 0.
+   */
+  bool setSmall(int64_t n, int64_t d);
+
+  /** Set this to the canonical value, in the small form if it fits. */
+  void setValue(const mpq_class& value);
+
+  /**
+   * Set res to x + y (or x - y if sub is true) for small x and y.  Returns
+   * false if an intermediate result overflows.
+   */
+  static bool addSmall(const Rational& x,
+                       const Rational& y,
+                       bool sub,
+                       Rational& res);
+
+  /**
+   * Set res to x * y (or x / y if div is true) for small x and y.  Returns
+   * false if an intermediate result overflows, or on division by zero.
+   */
+  static bool mulSmall(const Rational& x,
+                       const Rational& y,
+                       bool div,
+                       Rational& res);
+
+  /**
+   * Most coefficients and bounds of arithmetic fit into 64 bits.  Such
+   * values are stored as numerator d_num and denominator d_den, with
+   * d_den > 0, gcd(d_num, d_den) = 1 and d_num != INT64_MIN, and arithmetic
+   * on them does not allocate.  All other values are stored in d_value, in
+   * which case d_num is 0 and d_den is 1.
+   */
+  int64_t d_num;
+  int64_t d_den;
   /**
-   * Stores the value of the rational is stored in a C++ GMP rational class.
-   * Using this instead of mpq_t allows for easier destruction.
+   * Stores the value of the rational in a C++ GMP rational class, if it does
+   * not fit into d_num and d_den.
    */
-  mpq_class d_value;
+  std::unique_ptr<mpq_class> d_value;
 
 }; /* class Rational */
 
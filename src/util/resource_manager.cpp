@@ -17,6 +17,7 @@
 #include "util/resource_manager.h"
 
 #include <algorithm>
+#include <mutex>
 #include <ostream>
 
 #include "base/check.h"
@@ -90,6 +91,13 @@ struct ResourceManager::Statistics
   IntStat d_numRewriteStep;
   IntStat d_numSatConflictStep;
   IntStat d_numTheoryCheckStep;
+#ifdef CVC4_THREAD_SAFE_NODES
+  /**
+   * Protects spending resources, which happens concurrently when
+   * preprocessing passes run on several threads (--pp-threads).
+   */
+  std::mutex d_mutex;
+#endif
   Statistics(StatisticsRegistry& stats);
   ~Statistics();
 
@@ -259,6 +267,9 @@ void ResourceManager::spendResource(unsigned amount)
 
 void ResourceManager::spendResource(Resource r)
 {
+#ifdef CVC4_THREAD_SAFE_NODES
+  std::lock_guard<std::mutex> guard(d_statistics->d_mutex);
+#endif
   uint32_t amount = 0;
   switch (r)
   {
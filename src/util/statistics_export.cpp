@@ -0,0 +1,114 @@
+/*********************                                                        */
+/*! \file statistics_export.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Export of samples of statistics for monitoring tools
+ **/
+
+#include "util/statistics_export.h"
+
+#include <iomanip>
+#include <ostream>
+
+namespace cvc5 {
+
+namespace {
+
+/** The number of significant digits of the printed values */
+const int s_precision = 15;
+
+/** Print s as a JSON string. */
+void printJsonString(std::ostream& out, const std::string& s)
+{
+  out << '"';
+  for (char c : s)
+  {
+    if (c == '"' || c == '\\')
+    {
+      out << '\\' << c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+          << static_cast<int>(c) << std::dec << std::setfill(' ');
+    }
+    else
+    {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+/** Is c allowed in the name of a Prometheus metric (except the first)? */
+bool isMetricChar(char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+         || (c >= '0' && c <= '9') || c == '_';
+}
+
+}  // namespace
+
+void printStatisticsJson(
+    std::ostream& out,
+    const std::vector<std::pair<std::string, double>>& values)
+{
+  std::ios_base::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision(s_precision);
+  out.unsetf(std::ios_base::floatfield);
+  out << '{';
+  for (size_t i = 0, size = values.size(); i < size; ++i)
+  {
+    out << (i == 0 ? "\n  " : ",\n  ");
+    printJsonString(out, values[i].first);
+    out << ": " << values[i].second;
+  }
+  out << "\n}\n";
+  out.precision(precision);
+  out.flags(flags);
+}
+
+void printStatisticsPrometheus(
+    std::ostream& out,
+    const std::vector<std::pair<std::string, double>>& values)
+{
+  std::ios_base::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision(s_precision);
+  out.unsetf(std::ios_base::floatfield);
+  for (const std::pair<std::string, double>& v : values)
+  {
+    std::string name = "cvc4_";
+    for (char c : v.first)
+    {
+      name.push_back(isMetricChar(c) ? c : '_');
+    }
+    // the help text is the name of the statistic, in which backslashes and
+    // line breaks must be escaped
+    out << "# HELP " << name << ' ';
+    for (char c : v.first)
+    {
+      if (c == '\\')
+      {
+        out << "\\\\";
+      }
+      else if (c == '\n')
+      {
+        out << "\\n";
+      }
+      else
+      {
+        out << c;
+      }
+    }
+    out << '\n' << name << ' ' << v.second << '\n';
+  }
+  out.precision(precision);
+  out.flags(flags);
+}
+
+}  // namespace cvc5
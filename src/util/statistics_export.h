@@ -0,0 +1,50 @@
+/*********************                                                        */
+/*! \file statistics_export.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Export of samples of statistics for monitoring tools
+ **
+ ** Printing of the samples taken by StatisticsRegistry::sample() as JSON or
+ ** in the text format of Prometheus.
+ **/
+
+#include "cvc4_private_library.h"
+
+#ifndef CVC4__UTIL__STATISTICS_EXPORT_H
+#define CVC4__UTIL__STATISTICS_EXPORT_H
+
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cvc4_export.h"
+
+namespace cvc5 {
+
+/**
+ * Print the given sample as a JSON object that maps the name of each
+ * statistic to its value.
+ */
+void CVC4_EXPORT
+printStatisticsJson(std::ostream& out,
+                    const std::vector<std::pair<std::string, double>>& values);
+
+/**
+ * Print the given sample in the text exposition format of Prometheus, with
+ * one untyped metric per statistic. The name of the metric is the name of the
+ * statistic prefixed by "cvc4_", where each character that may not occur in
+ * the name of a metric is replaced by '_'.
+ */
+void CVC4_EXPORT printStatisticsPrometheus(
+    std::ostream& out,
+    const std::vector<std::pair<std::string, double>>& values);
+
+}  // namespace cvc5
+
+#endif /* CVC4__UTIL__STATISTICS_EXPORT_H */
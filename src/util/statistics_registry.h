@@ -46,7 +46,8 @@
  * ReferenceStat holds a reference (conceptually, it is implemented as a 
  * const pointer) to some data that is stored outside of the statistic.
  * 
- * IntStat is a BackedStat<std::int64_t>.
+ * IntStat stores a std::int64_t in a relaxed atomic, so that it can be
+ * sampled by another thread.
  * 
  * SizeStat holds a const reference to some container and provides the
  * size of this container.
@@ -60,10 +61,10 @@
  * for types that are (convertible to) integral. This allows to use a 
  * std::vector<std::uint64_t> instead of a std::map.
  * 
- * TimerStat uses std::chrono to collect timing information. It is
- * implemented as BackedStat<std::chrono::duration> and provides methods
- * start() and stop(), accumulating times it was activated. It provides
- * the convenience class CodeTimer to allow for RAII-style usage.
+ * TimerStat uses std::chrono to collect timing information. It provides
+ * methods start() and stop(), accumulating times it was activated, and may
+ * be sampled by another thread like IntStat. It provides the convenience
+ * class CodeTimer to allow for RAII-style usage.
  * 
  * 
  * All statistic classes should protect their custom methods using
@@ -87,7 +88,10 @@
 #include <ctime>
 #include <iomanip>
 #include <map>
+#include <mutex>
 #include <sstream>
+#include <string>
+#include <utility>
 #include <vector>
 
 #ifdef CVC4_STATISTICS_ON
@@ -177,6 +181,19 @@ public:
   /** Unregister a new statistic */
   void unregisterStat(Stat* s);
 
+  /**
+   * Add the name and the current value of each statistic that may be sampled
+   * (see Stat::sample()) to values. Unlike the other methods of this class,
+   * this may be called by another thread while the statistics are updated.
+   */
+  void sample(std::vector<std::pair<std::string, double>>& values) const;
+
+ private:
+  /**
+   * Protects the set of statistics against (un)registration while another
+   * thread samples it.
+   */
+  mutable std::mutex d_mutex;
 }; /* class StatisticsRegistry */
 
 /**
@@ -31,27 +31,19 @@ Stat::Stat(const std::string& name) : d_name(name)
 }
 
 IntStat::IntStat(const std::string& name, int64_t init)
-    : BackedStat<int64_t>(name, init)
+    : Stat(name), d_data(init)
 {
 }
 
 /** Increment the underlying integer statistic. */
 IntStat& IntStat::operator++()
 {
-  if (CVC4_USE_STATISTICS)
-  {
-    ++d_data;
-  }
-  return *this;
+  return *this += 1;
 }
 /** Increment the underlying integer statistic. */
 IntStat& IntStat::operator++(int)
 {
-  if (CVC4_USE_STATISTICS)
-  {
-    ++d_data;
-  }
-  return *this;
+  return *this += 1;
 }
 
 /** Increment the underlying integer statistic by the given amount. */
@@ -59,7 +51,12 @@ IntStat& IntStat::operator+=(int64_t val)
 {
   if (CVC4_USE_STATISTICS)
   {
-    d_data += val;
+#ifdef CVC4_THREAD_SAFE_NODES
+    d_data.fetch_add(val, std::memory_order_relaxed);
+#else
+    d_data.store(d_data.load(std::memory_order_relaxed) + val,
+                 std::memory_order_relaxed);
+#endif
   }
   return *this;
 }
@@ -69,9 +66,11 @@ void IntStat::maxAssign(int64_t val)
 {
   if (CVC4_USE_STATISTICS)
   {
-    if (d_data < val)
+    int64_t cur = d_data.load(std::memory_order_relaxed);
+    while (cur < val
+           && !d_data.compare_exchange_weak(
+               cur, val, std::memory_order_relaxed))
     {
-      d_data = val;
     }
   }
 }
@@ -81,9 +80,11 @@ void IntStat::minAssign(int64_t val)
 {
   if (CVC4_USE_STATISTICS)
   {
-    if (d_data > val)
+    int64_t cur = d_data.load(std::memory_order_relaxed);
+    while (cur > val
+           && !d_data.compare_exchange_weak(
+               cur, val, std::memory_order_relaxed))
     {
-      d_data = val;
     }
   }
 }
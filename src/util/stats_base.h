@@ -19,6 +19,7 @@
 #ifndef CVC4__UTIL__STATS_BASE_H
 #define CVC4__UTIL__STATS_BASE_H
 
+#include <atomic>
 #include <iomanip>
 #include <sstream>
 #include <string>
@@ -81,6 +82,13 @@ class CVC4_EXPORT Stat
     return SExpr(ss.str());
   }
 
+  /**
+   * Get the current value of this statistic as a number, if it may be read
+   * by another thread while it is being updated, see
+   * StatisticsRegistry::sample(). Returns false if it may not.
+   */
+  virtual bool sample(double& value) const { return false; }
+
  protected:
   /** The name of this statistic */
   std::string d_name;
@@ -189,10 +197,14 @@ class ReferenceStat : public Stat
 
 /**
  * A backed integer-valued (64-bit signed) statistic.
- * This doesn't functionally differ from its base class BackedStat<int64_t>,
- * except for adding convenience functions for dealing with integers.
+ *
+ * The value is kept in a relaxed atomic, so that it may be sampled by another
+ * thread while the solver runs. Updates are made by the thread owning the
+ * statistic and therefore compile to a plain load and store, unless nodes may
+ * be used by several threads (CVC4_THREAD_SAFE_NODES), in which case they are
+ * atomic read-modify-write operations.
  */
-class IntStat : public BackedStat<int64_t>
+class IntStat : public Stat
 {
  public:
   /**
@@ -201,6 +213,17 @@ class IntStat : public BackedStat<int64_t>
    */
   IntStat(const std::string& name, int64_t init);
 
+  /** Set the underlying integer statistic to the given value. */
+  void set(int64_t val)
+  {
+    if (CVC4_USE_STATISTICS)
+    {
+      d_data.store(val, std::memory_order_relaxed);
+    }
+  }
+
+  int64_t get() const { return d_data.load(std::memory_order_relaxed); }
+
   /** Increment the underlying integer statistic. */
   IntStat& operator++();
   /** Increment the underlying integer statistic. */
@@ -215,8 +238,24 @@ class IntStat : public BackedStat<int64_t>
   /** Keep the minimum of the current statistic value and the given one. */
   void minAssign(int64_t val);
 
-  SExpr getValue() const override { return SExpr(Integer(d_data)); }
+  void flushInformation(std::ostream& out) const override { out << get(); }
 
+  void safeFlushInformation(int fd) const override
+  {
+    safe_print<int64_t>(fd, get());
+  }
+
+  SExpr getValue() const override { return SExpr(Integer(get())); }
+
+  bool sample(double& value) const override
+  {
+    value = static_cast<double>(get());
+    return true;
+  }
+
+ private:
+  /** The internally-kept statistic value */
+  std::atomic<int64_t> d_data;
 }; /* class IntStat */
 
 /**
@@ -20,6 +20,7 @@
 #define CVC4__UTIL__STATS_HISTOGRAM_H
 
 #include <map>
+#include <mutex>
 #include <vector>
 
 #include "util/stats_base.h"
@@ -99,6 +100,9 @@ class IntegralHistogramStat : public Stat
   {
     if (CVC4_USE_STATISTICS)
     {
+#ifdef CVC4_THREAD_SAFE_NODES
+      std::lock_guard<std::mutex> guard(d_mutex);
+#endif
       int64_t v = static_cast<int64_t>(val);
       if (d_hist.empty())
       {
@@ -121,6 +125,10 @@ class IntegralHistogramStat : public Stat
  private:
   std::vector<uint64_t> d_hist;
   int64_t d_offset;
+#ifdef CVC4_THREAD_SAFE_NODES
+  /** Protects d_hist, rewriters record rewrites from several threads. */
+  std::mutex d_mutex;
+#endif
 }; /* class IntegralHistogramStat */
 
 }  // namespace cvc5
@@ -31,13 +31,28 @@ void safe_print(int fd, const timer_stat_detail::duration& t)
   safe_print_right_aligned(fd, (t % std::chrono::seconds(1)).count(), 9);
 }
 
+namespace {
+
+/** Get the current time, in nanoseconds since the epoch of the clock. */
+int64_t nowNanoseconds()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             timer_stat_detail::clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
 void TimerStat::start()
 {
   if (CVC4_USE_STATISTICS)
   {
-    PrettyCheckArgument(!d_running, *this, "timer already running");
-    d_start = timer_stat_detail::clock::now();
-    d_running = true;
+    PrettyCheckArgument(!running(), *this, "timer already running");
+    uint64_t seq = d_seq.load(std::memory_order_relaxed);
+    d_seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    d_start.store(nowNanoseconds(), std::memory_order_relaxed);
+    d_seq.store(seq + 2, std::memory_order_release);
   }
 }
 
@@ -45,43 +60,68 @@ void TimerStat::stop()
 {
   if (CVC4_USE_STATISTICS)
   {
-    AlwaysAssert(d_running) << "timer not running";
-    d_data += timer_stat_detail::clock::now() - d_start;
-    d_running = false;
+    AlwaysAssert(running()) << "timer not running";
+    int64_t now = nowNanoseconds();
+    uint64_t seq = d_seq.load(std::memory_order_relaxed);
+    d_seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    d_total.store(d_total.load(std::memory_order_relaxed) + now
+                      - d_start.load(std::memory_order_relaxed),
+                  std::memory_order_relaxed);
+    d_start.store(0, std::memory_order_relaxed);
+    d_seq.store(seq + 2, std::memory_order_release);
   }
 }
 
-bool TimerStat::running() const { return d_running; }
+bool TimerStat::running() const
+{
+  return d_start.load(std::memory_order_relaxed) != 0;
+}
 
-timer_stat_detail::duration TimerStat::get() const
+timer_stat_detail::duration TimerStat::accumulated(int64_t total,
+                                                   int64_t start)
 {
-  auto data = d_data;
-  if (CVC4_USE_STATISTICS && d_running)
+  timer_stat_detail::duration data = timer_stat_detail::duration();
+  data += std::chrono::nanoseconds(total);
+  if (CVC4_USE_STATISTICS && start != 0)
   {
-    data += timer_stat_detail::clock::now() - d_start;
+    data += std::chrono::nanoseconds(nowNanoseconds() - start);
   }
   return data;
 }
 
+timer_stat_detail::duration TimerStat::get() const
+{
+  return accumulated(d_total.load(std::memory_order_relaxed),
+                     d_start.load(std::memory_order_relaxed));
+}
+
 SExpr TimerStat::getValue() const
 {
-  auto data = d_data;
-  if (CVC4_USE_STATISTICS && d_running)
-  {
-    data += timer_stat_detail::clock::now() - d_start;
-  }
   std::stringstream ss;
-  ss << std::fixed << std::setprecision(8) << data;
+  ss << std::fixed << std::setprecision(8) << get();
   return SExpr(Rational::fromDecimal(ss.str()));
 }
 
+bool TimerStat::sample(double& value) const
+{
+  uint64_t seq;
+  int64_t total, start;
+  do
+  {
+    seq = d_seq.load(std::memory_order_acquire);
+    total = d_total.load(std::memory_order_relaxed);
+    start = d_start.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((seq & 1) != 0 || seq != d_seq.load(std::memory_order_relaxed));
+  value = std::chrono::duration<double>(accumulated(total, start)).count();
+  return true;
+}
+
 void TimerStat::flushInformation(std::ostream& out) const { out << get(); }
 
 void TimerStat::safeFlushInformation(int fd) const
 {
-  // Overwrite the implementation in the superclass because we cannot use
-  // getDataRef(): it might return stale data if the timer is currently
-  // running.
   safe_print<timer_stat_detail::duration>(fd, get());
 }
 
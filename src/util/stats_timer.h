@@ -19,6 +19,7 @@
 #ifndef CVC4__UTIL__STATS_TIMER_H
 #define CVC4__UTIL__STATS_TIMER_H
 
+#include <atomic>
 #include <chrono>
 
 #include "cvc4_export.h"
@@ -42,8 +43,13 @@ class CodeTimer;
  * A timer statistic.  The timer can be started and stopped
  * arbitrarily, like a stopwatch; the value of the statistic at the
  * end is the accumulated time over all (start,stop) pairs.
+ *
+ * The timer is started and stopped by the thread owning it, but may be
+ * sampled by another thread. Its state is therefore kept in relaxed atomics
+ * that are guarded by a sequence number, which is odd while the owning thread
+ * updates them.
  */
-class CVC4_EXPORT TimerStat : public BackedStat<timer_stat_detail::duration>
+class CVC4_EXPORT TimerStat : public Stat
 {
  public:
   typedef cvc5::CodeTimer CodeTimer;
@@ -53,10 +59,7 @@ class CVC4_EXPORT TimerStat : public BackedStat<timer_stat_detail::duration>
    * timers have a 0.0 value and are not running.
    */
   TimerStat(const std::string& name)
-      : BackedStat<timer_stat_detail::duration>(name,
-                                                timer_stat_detail::duration()),
-        d_start(),
-        d_running(false)
+      : Stat(name), d_seq(0), d_total(0), d_start(0)
   {
   }
 
@@ -79,12 +82,22 @@ class CVC4_EXPORT TimerStat : public BackedStat<timer_stat_detail::duration>
 
   SExpr getValue() const override;
 
+  /** Get the accumulated time in seconds, including the current run. */
+  bool sample(double& value) const override;
+
  private:
-  /** The last start time of this timer */
-  timer_stat_detail::time_point d_start;
+  /** Get the accumulated time, given the total and the start time. */
+  static timer_stat_detail::duration accumulated(int64_t total, int64_t start);
 
-  /** Whether this timer is currently running */
-  bool d_running;
+  /** The sequence number of the updates of d_total and d_start */
+  std::atomic<uint64_t> d_seq;
+  /** The accumulated time of the finished runs, in nanoseconds */
+  std::atomic<int64_t> d_total;
+  /**
+   * The last start time of this timer, in nanoseconds since the epoch of the
+   * clock, or zero if it is not running
+   */
+  std::atomic<int64_t> d_start;
 }; /* class TimerStat */
 
 /**
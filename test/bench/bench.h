@@ -0,0 +1,223 @@
+/*********************                                                        */
+/*! \file bench.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Minimal micro-benchmark framework.
+ **
+ ** Benchmarks are registered with CVC4_BENCHMARK and measure the body of a
+ ** range-based for loop over their State, in the style of google-benchmark:
+ **
+ **   CVC4_BENCHMARK(node_manager, mk_node)
+ **   {
+ **     BenchSmt smt(state);
+ **     for (auto _ : state)
+ **     {
+ **       ...
+ **     }
+ **   }
+ **
+ ** The number of iterations is increased until a run takes at least the
+ ** minimum time given on the command line of bench_main.cpp.
+ **/
+
+#ifndef CVC4__TEST__BENCH__BENCH_H
+#define CVC4__TEST__BENCH__BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "expr/node_manager.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+
+namespace cvc5 {
+namespace bench {
+
+/**
+ * The state of a single run of a benchmark, which determines how often the
+ * measured loop is executed and accumulates the time spent in it.
+ */
+class State
+{
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  class Iterator
+  {
+   public:
+    Iterator(State* state, uint64_t remaining)
+        : d_state(state), d_remaining(remaining)
+    {
+    }
+    /** The loop variable, unused by benchmarks. */
+    struct [[maybe_unused]] Value
+    {
+    };
+    Value operator*() const { return Value(); }
+    Iterator& operator++()
+    {
+      --d_remaining;
+      return *this;
+    }
+    bool operator!=(const Iterator&)
+    {
+      if (d_remaining > 0)
+      {
+        return true;
+      }
+      d_state->finishLoop();
+      return false;
+    }
+
+   private:
+    State* d_state;
+    uint64_t d_remaining;
+  };
+
+  State(uint64_t iterations)
+      : d_iterations(iterations), d_elapsed(0), d_running(false), d_items(0)
+  {
+  }
+
+  /** Start the measured loop. */
+  Iterator begin()
+  {
+    resumeTiming();
+    return Iterator(this, d_iterations);
+  }
+  Iterator end() { return Iterator(this, 0); }
+
+  /** Exclude the following code from the measurement, e.g., setup code. */
+  void pauseTiming()
+  {
+    if (d_running)
+    {
+      d_elapsed += Clock::now() - d_start;
+      d_running = false;
+    }
+  }
+  /** Measure the following code again. */
+  void resumeTiming()
+  {
+    if (!d_running)
+    {
+      d_start = Clock::now();
+      d_running = true;
+    }
+  }
+
+  /** The number of iterations of the measured loop. */
+  uint64_t iterations() const { return d_iterations; }
+  /** The time spent in the measured loop. */
+  Clock::duration elapsed() const { return d_elapsed; }
+
+  /**
+   * Set the number of items (e.g., nodes, clauses, pivots) processed in the
+   * measured loop, reported as throughput.
+   */
+  void setItemsProcessed(uint64_t items) { d_items = items; }
+  uint64_t itemsProcessed() const { return d_items; }
+
+  /** Set a named counter that is reported with the results of this run. */
+  void setCounter(const std::string& name, double value)
+  {
+    d_counters[name] = value;
+  }
+  const std::map<std::string, double>& counters() const { return d_counters; }
+
+ private:
+  void finishLoop() { pauseTiming(); }
+
+  uint64_t d_iterations;
+  Clock::duration d_elapsed;
+  Clock::time_point d_start;
+  bool d_running;
+  uint64_t d_items;
+  std::map<std::string, double> d_counters;
+};
+
+/** A registered benchmark. */
+struct Benchmark
+{
+  /** The name of the benchmark, "<group>/<name>" */
+  std::string d_name;
+  /** The benchmark function */
+  std::function<void(State&)> d_fun;
+};
+
+/** Get the list of registered benchmarks. */
+inline std::vector<Benchmark>& getBenchmarks()
+{
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+/** Registers a benchmark during static initialization. */
+struct Registration
+{
+  Registration(const char* group,
+               const char* name,
+               std::function<void(State&)> fun)
+  {
+    getBenchmarks().push_back({std::string(group) + "/" + name, fun});
+  }
+};
+
+#define CVC4_BENCHMARK(group, name)                                           \
+  static void bench_##group##_##name(cvc5::bench::State& state);              \
+  static cvc5::bench::Registration bench_registration_##group##_##name(       \
+      #group, #name, bench_##group##_##name);                                 \
+  static void bench_##group##_##name(cvc5::bench::State& state)
+
+/**
+ * A node manager and an SmtEngine in scope, for benchmarks that need the
+ * rewriter, the theory engine or the resource manager. Reports the number of
+ * node values in the pool of the node manager as counter "node_values" of
+ * the given state when it goes out of scope.
+ */
+class BenchSmt
+{
+ public:
+  BenchSmt(State& state)
+      : d_state(state),
+        d_nodeManager(new NodeManager()),
+        d_nmScope(new NodeManagerScope(d_nodeManager.get())),
+        d_smtEngine(new SmtEngine(d_nodeManager.get()))
+  {
+    d_smtEngine->finishInit();
+    d_smtScope.reset(new smt::SmtScope(d_smtEngine.get()));
+  }
+  ~BenchSmt()
+  {
+    d_state.setCounter("node_values", d_nodeManager->poolSize());
+    d_smtScope.reset(nullptr);
+    d_smtEngine.reset(nullptr);
+    d_nmScope.reset(nullptr);
+    d_nodeManager.reset(nullptr);
+  }
+
+  NodeManager* nm() { return d_nodeManager.get(); }
+  SmtEngine* smt() { return d_smtEngine.get(); }
+
+ private:
+  State& d_state;
+  std::unique_ptr<NodeManager> d_nodeManager;
+  std::unique_ptr<NodeManagerScope> d_nmScope;
+  std::unique_ptr<SmtEngine> d_smtEngine;
+  std::unique_ptr<smt::SmtScope> d_smtScope;
+};
+
+}  // namespace bench
+}  // namespace cvc5
+
+#endif /* CVC4__TEST__BENCH__BENCH_H */
@@ -0,0 +1,162 @@
+/*********************                                                        */
+/*! \file bench_main.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Driver of the micro-benchmarks.
+ **
+ ** Usage: micro-bench [--list] [--filter=SUBSTRING] [--min-time=SECONDS]
+ **
+ ** Runs all benchmarks whose name contains the filter and prints their
+ ** results as JSON to stdout. The peak resident set size is the one of this
+ ** process, run_benchmarks.py runs each benchmark in a separate process to
+ ** get the peak RSS per benchmark.
+ **/
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "base/configuration.h"
+#include "bench.h"
+
+using namespace cvc5;
+using namespace cvc5::bench;
+
+namespace {
+
+/** The peak resident set size of this process in KiB. */
+long getPeakRss()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+/** Escape s as JSON string. */
+std::string jsonString(const std::string& s)
+{
+  std::string res = "\"";
+  for (char c : s)
+  {
+    if (c == '"' || c == '\\')
+    {
+      res += '\\';
+    }
+    res += c;
+  }
+  return res + "\"";
+}
+
+/**
+ * Run the given benchmark with an increasing number of iterations until a
+ * run takes at least minTime seconds and print the result of the last run.
+ */
+void runBenchmark(const Benchmark& b, double minTime, bool first)
+{
+  uint64_t iterations = 1;
+  while (true)
+  {
+    State state(iterations);
+    b.d_fun(state);
+    double secs = std::chrono::duration<double>(state.elapsed()).count();
+    if (secs >= minTime || iterations >= (uint64_t(1) << 40))
+    {
+      double nsPerIter = secs * 1e9 / iterations;
+      std::cout << (first ? "" : ",") << "\n    {\"name\": "
+                << jsonString(b.d_name) << ", \"iterations\": " << iterations
+                << ", \"ns_per_iter\": " << std::fixed << std::setprecision(1)
+                << nsPerIter;
+      if (state.itemsProcessed() > 0)
+      {
+        std::cout << ", \"items_per_second\": " << std::setprecision(1)
+                  << state.itemsProcessed() / secs;
+      }
+      std::cout << ", \"peak_rss_kb\": " << getPeakRss();
+      for (const auto& c : state.counters())
+      {
+        std::cout << ", " << jsonString(c.first) << ": "
+                  << std::setprecision(0) << c.second;
+      }
+      std::cout << "}" << std::flush;
+      return;
+    }
+    // aim for 1.4 times the minimum time, but do not grow by more than a
+    // factor of 10 per run, like google-benchmark does
+    double factor = secs > 0 ? (minTime * 1.4 / secs) : 10.0;
+    factor = std::min(std::max(factor, 2.0), 10.0);
+    iterations = static_cast<uint64_t>(iterations * factor);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  std::string filter;
+  double minTime = 0.5;
+  bool list = false;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::strncmp(argv[i], "--filter=", 9) == 0)
+    {
+      filter = argv[i] + 9;
+    }
+    else if (std::strncmp(argv[i], "--min-time=", 11) == 0)
+    {
+      minTime = std::atof(argv[i] + 11);
+    }
+    else if (std::strcmp(argv[i], "--list") == 0)
+    {
+      list = true;
+    }
+    else
+    {
+      std::cerr << "usage: " << argv[0]
+                << " [--list] [--filter=SUBSTRING] [--min-time=SECONDS]"
+                << std::endl;
+      return 1;
+    }
+  }
+
+  std::vector<Benchmark> benchmarks = getBenchmarks();
+  std::sort(benchmarks.begin(),
+            benchmarks.end(),
+            [](const Benchmark& a, const Benchmark& b) {
+              return a.d_name < b.d_name;
+            });
+  if (list)
+  {
+    for (const Benchmark& b : benchmarks)
+    {
+      std::cout << b.d_name << std::endl;
+    }
+    return 0;
+  }
+
+  std::cout << "{\n  \"assertions\": "
+            << (Configuration::isAssertionBuild() ? "true" : "false")
+            << ",\n  \"min_time\": " << minTime << ",\n  \"benchmarks\": [";
+  bool first = true;
+  for (const Benchmark& b : benchmarks)
+  {
+    if (b.d_name.find(filter) == std::string::npos)
+    {
+      continue;
+    }
+    runBenchmark(b, minTime, first);
+    first = false;
+  }
+  std::cout << "\n  ]\n}" << std::endl;
+  return 0;
+}
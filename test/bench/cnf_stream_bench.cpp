@@ -0,0 +1,153 @@
+/*********************                                                        */
+/*! \file cnf_stream_bench.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Micro-benchmarks of CnfStream::convertAndAssert.
+ **/
+
+#include <vector>
+
+#include "bench.h"
+#include "context/context.h"
+#include "expr/node.h"
+#include "prop/cnf_stream.h"
+#include "prop/registrar.h"
+#include "prop/sat_solver.h"
+
+namespace cvc5 {
+namespace bench {
+
+using namespace prop;
+
+namespace {
+
+/** A SAT solver that only counts the clauses added to it. */
+class CountingSatSolver : public SatSolver
+{
+ public:
+  CountingSatSolver() : d_nextVar(0), d_numClauses(0) {}
+
+  SatVariable newVar(bool theoryAtom, bool preRegister, bool canErase) override
+  {
+    return d_nextVar++;
+  }
+  SatVariable trueVar() override { return d_nextVar++; }
+  SatVariable falseVar() override { return d_nextVar++; }
+  ClauseId addClause(SatClause& c, bool lemma) override
+  {
+    ++d_numClauses;
+    return ClauseIdUndef;
+  }
+  ClauseId addXorClause(SatClause& clause, bool rhs, bool removable) override
+  {
+    ++d_numClauses;
+    return ClauseIdUndef;
+  }
+  bool nativeXor() override { return false; }
+  unsigned getAssertionLevel() const override { return 0; }
+  void interrupt() override {}
+  SatValue solve() override { return SAT_VALUE_UNKNOWN; }
+  SatValue solve(long unsigned int& resource) override
+  {
+    return SAT_VALUE_UNKNOWN;
+  }
+  SatValue value(SatLiteral l) override { return SAT_VALUE_UNKNOWN; }
+  SatValue modelValue(SatLiteral l) override { return SAT_VALUE_UNKNOWN; }
+  bool ok() const override { return true; }
+
+  uint64_t getNumClauses() const { return d_numClauses; }
+
+ private:
+  SatVariable d_nextVar;
+  uint64_t d_numClauses;
+};
+
+/**
+ * (=> (and a b) (= (or c d) (not (xor e (ite a f c))))) over fresh Boolean
+ * variables a, ..., f.
+ */
+Node mkFormula(NodeManager* nm)
+{
+  std::vector<Node> v;
+  for (size_t i = 0; i < 6; ++i)
+  {
+    v.push_back(nm->mkVar(nm->booleanType()));
+  }
+  Node ite = nm->mkNode(kind::ITE, v[0], v[5], v[2]);
+  return nm->mkNode(
+      kind::IMPLIES,
+      nm->mkNode(kind::AND, v[0], v[1]),
+      nm->mkNode(kind::EQUAL,
+                 nm->mkNode(kind::OR, v[2], v[3]),
+                 nm->mkNode(kind::NOT, nm->mkNode(kind::XOR, v[4], ite))));
+}
+
+}  // namespace
+
+/** Conversion of small formulas over fresh atoms. */
+CVC4_BENCHMARK(cnf_stream, convert_and_assert)
+{
+  BenchSmt smt(state);
+  CountingSatSolver satSolver;
+  context::Context context;
+  NullRegistrar registrar;
+  CnfStream cnf(&satSolver,
+                &registrar,
+                &context,
+                &smt.smt()->getOutputManager(),
+                smt.smt()->getResourceManager());
+  for (auto _ : state)
+  {
+    state.pauseTiming();
+    Node f = mkFormula(smt.nm());
+    state.resumeTiming();
+    cnf.convertAndAssert(f, false, false);
+  }
+  state.setItemsProcessed(satSolver.getNumClauses());
+  state.setCounter("clauses", satSolver.getNumClauses());
+}
+
+/** Conversion of a wide conjunction of shared subformulas. */
+CVC4_BENCHMARK(cnf_stream, shared_subformulas)
+{
+  BenchSmt smt(state);
+  NodeManager* nm = smt.nm();
+  CountingSatSolver satSolver;
+  context::Context context;
+  NullRegistrar registrar;
+  CnfStream cnf(&satSolver,
+                &registrar,
+                &context,
+                &smt.smt()->getOutputManager(),
+                smt.smt()->getResourceManager());
+  for (auto _ : state)
+  {
+    state.pauseTiming();
+    std::vector<Node> vars;
+    for (size_t i = 0; i < 32; ++i)
+    {
+      vars.push_back(nm->mkVar(nm->booleanType()));
+    }
+    std::vector<Node> conj;
+    for (size_t i = 0; i < 32; ++i)
+    {
+      for (size_t j = i + 1; j < 32; j += 7)
+      {
+        conj.push_back(nm->mkNode(kind::OR, vars[i], vars[j].notNode()));
+      }
+    }
+    Node f = nm->mkNode(kind::AND, conj);
+    state.resumeTiming();
+    cnf.convertAndAssert(f, false, false);
+  }
+  state.setItemsProcessed(satSolver.getNumClauses());
+  state.setCounter("clauses", satSolver.getNumClauses());
+}
+
+}  // namespace bench
+}  // namespace cvc5
@@ -0,0 +1,84 @@
+/*********************                                                        */
+/*! \file equality_engine_bench.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Micro-benchmarks of merges in the EqualityEngine.
+ **/
+
+#include <vector>
+
+#include "bench.h"
+#include "context/context.h"
+#include "expr/node.h"
+#include "theory/uf/equality_engine.h"
+
+namespace cvc5 {
+namespace bench {
+
+using namespace theory::eq;
+
+namespace {
+
+/**
+ * Assert x_0 = x_1, ..., x_{n-1} = x_n in a new context level and pop it
+ * again. With withCongruence, the terms f(x_0), ..., f(x_n) are registered,
+ * which are merged by congruence.
+ */
+void benchMerges(State& state, bool withCongruence)
+{
+  BenchSmt smt(state);
+  NodeManager* nm = smt.nm();
+  const size_t n = 256;
+  context::Context context;
+  EqualityEngine ee(&context, "bench", false);
+  ee.addFunctionKind(kind::APPLY_UF);
+  TypeNode u = nm->mkSort("U");
+  Node f = nm->mkVar("f", nm->mkFunctionType(u, u));
+  std::vector<Node> vars;
+  for (size_t i = 0; i <= n; ++i)
+  {
+    vars.push_back(nm->mkVar(u));
+    ee.addTerm(vars.back());
+    if (withCongruence)
+    {
+      ee.addTerm(nm->mkNode(kind::APPLY_UF, f, vars.back()));
+    }
+  }
+  std::vector<Node> eqs;
+  for (size_t i = 0; i < n; ++i)
+  {
+    eqs.push_back(vars[i].eqNode(vars[i + 1]));
+  }
+  for (auto _ : state)
+  {
+    context.push();
+    for (const Node& eq : eqs)
+    {
+      ee.assertEquality(eq, true, eq);
+    }
+    context.pop();
+  }
+  state.setItemsProcessed(state.iterations() * n);
+}
+
+}  // namespace
+
+/** Merges of variables asserted equal. */
+CVC4_BENCHMARK(equality_engine, merge)
+{
+  benchMerges(state, false);
+}
+
+/** Merges of variables, with the implied merges of their applications. */
+CVC4_BENCHMARK(equality_engine, merge_congruence)
+{
+  benchMerges(state, true);
+}
+
+}  // namespace bench
+}  // namespace cvc5
@@ -0,0 +1,91 @@
+/*********************                                                        */
+/*! \file node_manager_bench.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Micro-benchmarks of NodeManager::mkNode.
+ **/
+
+#include <vector>
+
+#include "bench.h"
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace bench {
+
+namespace {
+
+/** Make n Boolean variables. */
+std::vector<Node> mkBoolVars(NodeManager* nm, size_t n)
+{
+  std::vector<Node> vars;
+  for (size_t i = 0; i < n; ++i)
+  {
+    vars.push_back(nm->mkVar(nm->booleanType()));
+  }
+  return vars;
+}
+
+}  // namespace
+
+/** Construction of nodes that are not in the node pool yet. */
+CVC4_BENCHMARK(node_manager, mk_node_new)
+{
+  BenchSmt smt(state);
+  NodeManager* nm = smt.nm();
+  std::vector<Node> vars = mkBoolVars(nm, 4096);
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    Node n = nm->mkNode(
+        kind::AND, vars[i % vars.size()], vars[(i / vars.size()) % vars.size()]);
+    ++i;
+  }
+  state.setItemsProcessed(state.iterations());
+}
+
+/** Construction of nodes that are already in the node pool. */
+CVC4_BENCHMARK(node_manager, mk_node_existing)
+{
+  BenchSmt smt(state);
+  NodeManager* nm = smt.nm();
+  std::vector<Node> vars = mkBoolVars(nm, 64);
+  std::vector<Node> nodes;
+  for (size_t i = 0; i < vars.size(); ++i)
+  {
+    nodes.push_back(nm->mkNode(kind::OR, vars[i], vars[(i + 1) % vars.size()]));
+  }
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    Node n =
+        nm->mkNode(kind::OR, vars[i % vars.size()], vars[(i + 1) % vars.size()]);
+    ++i;
+  }
+  state.setItemsProcessed(state.iterations());
+}
+
+/** Construction of a deep term, bottom-up. */
+CVC4_BENCHMARK(node_manager, mk_node_chain)
+{
+  BenchSmt smt(state);
+  NodeManager* nm = smt.nm();
+  std::vector<Node> vars = mkBoolVars(nm, 2);
+  for (auto _ : state)
+  {
+    Node n = vars[0];
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      n = nm->mkNode(kind::XOR, n, vars[i % 2]);
+    }
+  }
+  state.setItemsProcessed(state.iterations() * 1000);
+}
+
+}  // namespace bench
+}  // namespace cvc5
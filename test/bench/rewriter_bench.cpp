@@ -0,0 +1,101 @@
+/*********************                                                        */
+/*! \file rewriter_bench.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Micro-benchmarks of Rewriter::rewrite.
+ **/
+
+#include <vector>
+
+#include "bench.h"
+#include "expr/node.h"
+#include "theory/rewriter.h"
+#include "util/bitvector.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+namespace bench {
+
+using namespace theory;
+
+namespace {
+
+/** (+ (* 2 x) (* 3 (- y x)) (* -1 y) 5) with x, y fresh. */
+Node mkArithTerm(NodeManager* nm)
+{
+  Node x = nm->mkVar(nm->integerType());
+  Node y = nm->mkVar(nm->integerType());
+  std::vector<Node> children;
+  children.push_back(nm->mkNode(kind::MULT, nm->mkConst(Rational(2)), x));
+  children.push_back(nm->mkNode(
+      kind::MULT, nm->mkConst(Rational(3)), nm->mkNode(kind::MINUS, y, x)));
+  children.push_back(nm->mkNode(kind::MULT, nm->mkConst(Rational(-1)), y));
+  children.push_back(nm->mkConst(Rational(5)));
+  return nm->mkNode(kind::PLUS, children);
+}
+
+/** (bvadd (bvmul x #x00000003) (bvand x (bvnot x)) (bvsub y x)), x, y fresh */
+Node mkBvTerm(NodeManager* nm)
+{
+  TypeNode bv32 = nm->mkBitVectorType(32);
+  Node x = nm->mkVar(bv32);
+  Node y = nm->mkVar(bv32);
+  std::vector<Node> children;
+  children.push_back(
+      nm->mkNode(kind::BITVECTOR_MULT, x, nm->mkConst(BitVector(32, 3u))));
+  children.push_back(nm->mkNode(
+      kind::BITVECTOR_AND, x, nm->mkNode(kind::BITVECTOR_NOT, x)));
+  children.push_back(nm->mkNode(kind::BITVECTOR_SUB, y, x));
+  return nm->mkNode(kind::BITVECTOR_PLUS, children);
+}
+
+}  // namespace
+
+/** Rewriting of arithmetic terms that are not in the rewrite cache. */
+CVC4_BENCHMARK(rewriter, arith_fresh)
+{
+  BenchSmt smt(state);
+  for (auto _ : state)
+  {
+    state.pauseTiming();
+    Node n = mkArithTerm(smt.nm());
+    state.resumeTiming();
+    Rewriter::rewrite(n);
+  }
+  state.setItemsProcessed(state.iterations());
+}
+
+/** Rewriting of bit-vector terms that are not in the rewrite cache. */
+CVC4_BENCHMARK(rewriter, bv_fresh)
+{
+  BenchSmt smt(state);
+  for (auto _ : state)
+  {
+    state.pauseTiming();
+    Node n = mkBvTerm(smt.nm());
+    state.resumeTiming();
+    Rewriter::rewrite(n);
+  }
+  state.setItemsProcessed(state.iterations());
+}
+
+/** Rewriting of a term that is in the rewrite cache. */
+CVC4_BENCHMARK(rewriter, cached)
+{
+  BenchSmt smt(state);
+  Node n = mkArithTerm(smt.nm());
+  Rewriter::rewrite(n);
+  for (auto _ : state)
+  {
+    Rewriter::rewrite(n);
+  }
+  state.setItemsProcessed(state.iterations());
+}
+
+}  // namespace bench
+}  // namespace cvc5
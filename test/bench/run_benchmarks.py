@@ -0,0 +1,215 @@
+#!/usr/bin/env python3
+#####################
+## run_benchmarks.py
+## This file is part of the CVC4 project.
+## Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+## in the top-level source directory and their institutional affiliations.
+## All rights reserved.  See the file COPYING in the top-level source
+## directory for licensing information.
+##
+"""
+Runs the micro-benchmarks and the macro-benchmarks and writes their timing
+and memory usage as JSON, or compares two such JSON files.
+
+  run_benchmarks.py run --cvc4 BIN [--micro BIN] [--output FILE] LIST
+  run_benchmarks.py compare OLD NEW [--threshold T]
+
+LIST contains the macro-benchmarks, one path relative to the regression test
+directory per line. They are run with the options of their first
+COMMAND-LINE directive.
+"""
+
+import argparse
+import json
+import os
+import re
+import shlex
+import subprocess
+import sys
+import threading
+import time
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+REGRESS_DIR = os.path.join(SCRIPT_DIR, os.pardir, 'regress')
+
+
+def run_micro(micro, min_time):
+    """Runs each micro-benchmark in its own process, such that the peak RSS
+    is the one of the benchmark."""
+    names = subprocess.check_output([micro, '--list'],
+                                    universal_newlines=True).split()
+    results = []
+    for name in names:
+        print('micro: {}'.format(name), file=sys.stderr)
+        output = subprocess.check_output(
+            [micro, '--filter=' + name, '--min-time=' + str(min_time)],
+            universal_newlines=True)
+        # the filter is a substring match, keep the exact match only
+        results.extend(b for b in json.loads(output)['benchmarks']
+                       if b['name'] == name)
+    return results
+
+
+def get_command_line(benchmark):
+    """Returns the options of the first COMMAND-LINE directive."""
+    comment = '%' if benchmark.endswith('.cvc') else ';'
+    with open(benchmark) as f:
+        for line in f:
+            m = re.match(r'^\s*{}\s*COMMAND-LINE:(.*)$'.format(comment), line)
+            if m:
+                return shlex.split(m.group(1))
+    return []
+
+
+def run_process(args, timeout):
+    """Runs args and returns its exit code (None on timeout), stdout, stderr
+    and resource usage. The process is reaped with wait4 to get the resource
+    usage of this process alone."""
+    proc = subprocess.Popen(args,
+                            stdout=subprocess.PIPE,
+                            stderr=subprocess.PIPE,
+                            universal_newlines=True)
+    timed_out = []
+
+    def kill():
+        timed_out.append(True)
+        proc.kill()
+
+    timer = threading.Timer(timeout, kill)
+    timer.start()
+    output = {}
+
+    def read(name, stream):
+        output[name] = stream.read()
+
+    readers = [
+        threading.Thread(target=read, args=('out', proc.stdout)),
+        threading.Thread(target=read, args=('err', proc.stderr))
+    ]
+    for reader in readers:
+        reader.start()
+    for reader in readers:
+        reader.join()
+    _, status, usage = os.wait4(proc.pid, 0)
+    timer.cancel()
+    # tell Popen that the process was reaped
+    proc.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -1
+    exit_code = None if timed_out else proc.returncode
+    return exit_code, output['out'], output['err'], usage
+
+
+def run_macro(cvc4, benchmarks, timeout):
+    """Runs cvc4 on each benchmark, measures the wall time, the CPU time and
+    the peak RSS of the process and reads the size of the node pool from the
+    statistics."""
+    results = []
+    for benchmark in benchmarks:
+        print('macro: {}'.format(benchmark), file=sys.stderr)
+        path = os.path.join(REGRESS_DIR, benchmark)
+        args = [cvc4, '--stats'] + get_command_line(path) + [path]
+        start = time.perf_counter()
+        exit_code, out, err, usage = run_process(args, timeout)
+        wall_time = time.perf_counter() - start
+        if exit_code is None:
+            status = 'timeout'
+        elif exit_code in (0, 10, 20):
+            status = 'ok'
+        else:
+            status = 'error'
+        result = {
+            'name': benchmark,
+            'status': status,
+            'result': out.split('\n', 1)[0].strip(),
+            'wall_time': round(wall_time, 4),
+            'cpu_time': round(usage.ru_utime + usage.ru_stime, 4),
+            # KiB on Linux
+            'peak_rss_kb': usage.ru_maxrss,
+        }
+        for line in err.splitlines():
+            m = re.match(r'^driver::(nodeValues|maxNodeValues), (\d+)$', line)
+            if m:
+                result[m.group(1)] = int(m.group(2))
+        results.append(result)
+    return results
+
+
+def compare(old, new, threshold):
+    """Prints the relative change of the time and memory of the benchmarks in
+    both files. Returns the number of changes above the threshold."""
+    num_regressions = 0
+    for kind, keys in (('micro', ['ns_per_iter', 'peak_rss_kb']),
+                       ('macro', ['cpu_time', 'peak_rss_kb',
+                                  'maxNodeValues'])):
+        old_results = {b['name']: b for b in old.get(kind, [])}
+        for b in new.get(kind, []):
+            o = old_results.get(b['name'])
+            if o is None:
+                continue
+            changes = []
+            for key in keys:
+                if key not in o or key not in b or o[key] == 0:
+                    continue
+                change = b[key] / o[key] - 1.0
+                if change > threshold:
+                    num_regressions += 1
+                changes.append('{} {:+.1%}{}'.format(
+                    key, change, ' !' if change > threshold else ''))
+            print('{:<60} {}'.format(b['name'], ', '.join(changes)))
+    return num_regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Runs or compares the CVC4 benchmarks.')
+    sub = parser.add_subparsers(dest='command')
+    run = sub.add_parser('run')
+    run.add_argument('--cvc4', required=True, help='the cvc4 binary')
+    run.add_argument('--micro', help='the micro-benchmark binary')
+    run.add_argument('--output', help='the JSON file to write')
+    run.add_argument('--timeout', type=float, default=600.0)
+    run.add_argument('--min-time', type=float, default=0.5)
+    run.add_argument('list', help='the list of macro-benchmarks')
+    cmp = sub.add_parser('compare')
+    cmp.add_argument('old')
+    cmp.add_argument('new')
+    cmp.add_argument('--threshold',
+                     type=float,
+                     default=0.05,
+                     help='relative increase that is reported as regression')
+    args = parser.parse_args()
+
+    if args.command == 'compare':
+        with open(args.old) as f:
+            old = json.load(f)
+        with open(args.new) as f:
+            new = json.load(f)
+        return 1 if compare(old, new, args.threshold) > 0 else 0
+    if args.command != 'run':
+        parser.print_help()
+        return 1
+
+    with open(args.list) as f:
+        benchmarks = [
+            l.strip() for l in f if l.strip() and not l.startswith('#')
+        ]
+    commit = subprocess.run(['git', 'rev-parse', 'HEAD'],
+                            cwd=SCRIPT_DIR,
+                            stdout=subprocess.PIPE,
+                            stderr=subprocess.DEVNULL,
+                            universal_newlines=True).stdout.strip()
+    results = {'commit': commit}
+    if args.micro:
+        results['micro'] = run_micro(args.micro, args.min_time)
+    results['macro'] = run_macro(args.cvc4, benchmarks, args.timeout)
+    output = json.dumps(results, indent=2)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(output + '\n')
+        print('wrote {}'.format(args.output), file=sys.stderr)
+    else:
+        print(output)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
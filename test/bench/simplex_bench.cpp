@@ -0,0 +1,93 @@
+/*********************                                                        */
+/*! \file simplex_bench.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Micro-benchmarks of pivots in the simplex tableau.
+ **/
+
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "theory/arith/tableau.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+namespace bench {
+
+using namespace theory::arith;
+
+namespace {
+
+/**
+ * Pivots on a sparse tableau with 100 rows over 300 variables. Every
+ * iteration pivots a random basic variable with a variable of its row and
+ * back, such that the coefficients do not grow over time. If csr is true,
+ * the tableau uses the compressed-row layout (--tableau-layout=csr).
+ */
+void pivot(State& state, bool csr)
+{
+  // the tableau reads its options from the SmtEngine in scope
+  BenchSmt smt(state);
+  const size_t numRows = 100;
+  const size_t numVars = 300;
+  std::mt19937 rng(42);
+  Tableau tableau;
+  tableau.setCompactRows(csr);
+  tableau.increaseSizeTo(numVars + numRows);
+  std::vector<ArithVar> basics;
+  for (size_t r = 0; r < numRows; ++r)
+  {
+    std::vector<Rational> coeffs;
+    std::vector<ArithVar> vars;
+    for (ArithVar v = 0; v < numVars; ++v)
+    {
+      if (rng() % 20 == 0)
+      {
+        int c = static_cast<int>(rng() % 9) - 4;
+        coeffs.push_back(Rational(c == 0 ? 1 : c));
+        vars.push_back(v);
+      }
+    }
+    ArithVar basic = numVars + r;
+    tableau.addRow(basic, coeffs, vars);
+    basics.push_back(basic);
+  }
+  NoEffectCCCB cb;
+  for (auto _ : state)
+  {
+    ArithVar basic = basics[rng() % numRows];
+    std::vector<ArithVar> candidates;
+    for (Tableau::RowIterator i = tableau.basicRowIterator(basic); !i.atEnd();
+         ++i)
+    {
+      if ((*i).getColVar() != basic)
+      {
+        candidates.push_back((*i).getColVar());
+      }
+    }
+    if (candidates.empty())
+    {
+      continue;
+    }
+    ArithVar entering = candidates[rng() % candidates.size()];
+    tableau.pivot(basic, entering, cb);
+    tableau.pivot(entering, basic, cb);
+  }
+  state.setItemsProcessed(2 * state.iterations());
+  state.setCounter("entries", tableau.getNumEntriesInTableau());
+}
+
+}  // namespace
+
+CVC4_BENCHMARK(simplex, pivot) { pivot(state, false); }
+
+CVC4_BENCHMARK(simplex, pivot_csr) { pivot(state, true); }
+
+}  // namespace bench
+}  // namespace cvc5
@@ -0,0 +1,22 @@
+; COMMAND-LINE: --tableau-layout=csr
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LRA)
+(set-option :incremental true)
+
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(declare-fun w () Real)
+
+(assert (<= (+ x y z w) 10))
+(assert (>= (- x y) 1))
+(assert (>= (+ y (* 2 z)) 3))
+(assert (>= (- (* 3 w) x) 2))
+(assert (<= (+ (* 2 x) z) 8))
+
+(check-sat)
+
+(assert (>= (+ x y z w) 11))
+
+(check-sat)
@@ -0,0 +1,17 @@
+; COMMAND-LINE: --bv-bitblast-templates
+; COMMAND-LINE: --bv-bitblast-templates --bitblast=eager
+; COMMAND-LINE: --bv-bitblast-templates --bv-solver=bitblast
+; EXPECT: sat
+; EXPECT: ((x #x0f) (y #x03))
+(set-option :produce-models true)
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(declare-fun z () (_ BitVec 8))
+(assert (= (bvmul x #x11) #xff))
+(assert (= (bvmul y z) #x2d))
+(assert (= (bvudiv x y) #x05))
+(assert (= (bvurem x y) #x00))
+(assert (bvult y #x04))
+(check-sat)
+(get-value (x y))
@@ -0,0 +1,13 @@
+; COMMAND-LINE: --bv-native-aig --bitblast=eager
+; COMMAND-LINE: --bv-native-aig --bv-solver=bitblast
+; EXPECT: sat
+; EXPECT: ((x #b00000110) (y #b00000000))
+(set-option :produce-models true)
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (= (bvmul x #x07) #x2a))
+(assert (= y (bvxor x (bvand x #x0f))))
+(assert (not (bvult (bvadd x y) x)))
+(check-sat)
+(get-value (x y))
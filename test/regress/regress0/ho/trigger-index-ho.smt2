@@ -0,0 +1,18 @@
+; COMMAND-LINE: --uf-ho
+; COMMAND-LINE: --uf-ho --no-trigger-index
+; EXPECT: unsat
+(set-logic ALL)
+(declare-sort U 0)
+(declare-fun f (U U) U)
+(declare-fun g (U U) U)
+(declare-fun P (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+; the terms of g are in the table of f in the term database, but only the
+; terms of f are matched against the trigger f x a
+(assert (= f g))
+(assert (P (g c b)))
+(assert (forall ((x U)) (P (f x a))))
+(assert (or (not (P (f b a))) (not (P (g c a)))))
+(check-sat)
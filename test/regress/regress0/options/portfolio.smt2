@@ -0,0 +1,9 @@
+; COMMAND-LINE: --portfolio=3
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (> (+ x y) 10))
+(assert (< x 3))
+(assert (< y 3))
+(check-sat)
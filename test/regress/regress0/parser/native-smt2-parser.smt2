@@ -0,0 +1,26 @@
+; COMMAND-LINE: --native-smt2-parser --incremental
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: a |quoted| "string"
+; EXPECT: sat
+; EXPECT: ((x #b0101))
+(set-logic ALL)
+(set-option :produce-models true)
+(declare-datatypes ((Lst 0)) (((cons (hd Int) (tl Lst)) (nil))))
+(declare-fun l () Lst)
+(declare-const |quoted sym| Int)
+(define-fun f ((a Int) (b Int)) Int (+ a (* 2 b)))
+(assert (let ((h (hd l)) (t (tl l))) (and ((_ is cons) t) (> h (f 1 |quoted sym|)))))
+(assert (! (>= |quoted sym| 0.5) :named pos))
+(assert (forall ((y Int)) (! (>= (f y y) (* 3 y)) :pattern ((f y y)))))
+(check-sat)
+(push 2)
+(assert (< (hd l) 0))
+(assert (match l ((nil false) ((cons h t) (> |quoted sym| 10)))))
+(check-sat)
+(pop 2)
+(echo "a |quoted| ""string""")
+(declare-fun x () (_ BitVec 4))
+(assert (= ((_ extract 3 0) (bvadd x #x1)) #b0110))
+(check-sat)
+(get-value (x))
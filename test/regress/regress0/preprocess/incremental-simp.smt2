@@ -0,0 +1,26 @@
+; COMMAND-LINE: --incremental --incremental-simp --unconstrained-simp
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(declare-fun z () (_ BitVec 8))
+; x and y are unconstrained here, and constrained by the assertions below
+(assert (= (bvadd x y) #x05))
+(assert (= (bvmul z z) #x04))
+(check-sat)
+(push 1)
+(assert (= x #x01))
+(assert (= y #x01))
+(check-sat)
+(pop 1)
+(check-sat)
+(push 1)
+; uses the constant propagation of the first call
+(assert (or (= (bvmul z z) #x05) (= (bvmul z z) #x06)))
+(check-sat)
+(pop 1)
+(check-sat)
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --pp-profile --incremental
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (= x (+ y 1)))
+(assert (or (> z x) (< z y)))
+(check-sat)
+(push 1)
+(assert (and (> z x) (< z y)))
+(check-sat)
+(pop 1)
@@ -0,0 +1,24 @@
+; COMMAND-LINE: --e-matching-incremental
+; COMMAND-LINE: --no-e-matching-incremental
+; EXPECT: unsat
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U U) U)
+(declare-fun h (U) U)
+(declare-fun R (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(assert (forall ((x U)) (=> (R (f x a)) (R (f (h x) a)))))
+(push 1)
+(assert (R (f b a)))
+(assert (not (R (f (h (h b)) a))))
+(check-sat)
+(pop 1)
+; each round adds a term to the chain from b, which is the only term matched
+; by the next round with --e-matching-incremental
+(assert (= c (h b)))
+(assert (R (f b a)))
+(assert (not (R (f (h (h (h (h c)))) a))))
+(check-sat)
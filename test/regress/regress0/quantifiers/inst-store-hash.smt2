@@ -0,0 +1,16 @@
+; COMMAND-LINE: --inst-store=hash --incremental
+; EXPECT: unsat
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun P (U) Bool)
+(declare-fun a () U)
+(assert (forall ((x U)) (=> (P x) (P (f x)))))
+(assert (P a))
+(push 1)
+(assert (not (P (f (f a)))))
+(check-sat)
+(pop 1)
+(assert (not (P (f (f (f a))))))
+(check-sat)
@@ -0,0 +1,19 @@
+; REQUIRES: thread-safe-nodes
+; COMMAND-LINE: --quant-threads=1
+; COMMAND-LINE: --quant-threads=4
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun g (U) U)
+(declare-fun P (U) Bool)
+(declare-fun Q (U) Bool)
+(declare-fun R (U) Bool)
+(declare-fun a () U)
+(assert (forall ((x U)) (=> (P x) (P (f x)))))
+(assert (forall ((x U)) (=> (P x) (Q (g x)))))
+(assert (forall ((x U)) (=> (Q x) (R x))))
+(assert (forall ((x U)) (=> (R (g x)) (R (f x)))))
+(assert (P a))
+(assert (not (R (f (f (f a))))))
+(check-sat)
@@ -0,0 +1,32 @@
+; COMMAND-LINE:
+; COMMAND-LINE: --no-trigger-index
+; EXPECT: unsat
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U U) U)
+(declare-fun g (U) U)
+(declare-fun P (U) Bool)
+(declare-fun Q (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(declare-fun d () U)
+(declare-fun e () U)
+; f x a only matches the terms of f whose second argument is equal to a, and
+; f x (g y) those whose second argument is equal to an application of g
+(assert (forall ((x U)) (P (f x a))))
+(assert (forall ((x U) (y U)) (Q (f x (g y)))))
+(assert (P (f b c)))
+(assert (Q (f a b)))
+(push 1)
+(assert (= d a))
+(assert (= e (g c)))
+(assert (or (not (P (f b d))) (not (Q (f c e)))))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= e (g b)))
+(assert (not (Q (f a e))))
+(check-sat)
+(pop 1)
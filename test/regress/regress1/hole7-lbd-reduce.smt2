@@ -0,0 +1,268 @@
+; COMMAND-LINE: --lbd-reduce
+; COMMAND-LINE: --restart-mode=glucose --lbd-reduce
+; EXPECT: unsat
+; pigeonhole principle with 8 pigeons and 7 holes, large enough for the
+; learnt clauses to outgrow the problem clauses so that the clause database
+; is reduced several times
+(set-logic QF_UF)
+(declare-fun p0h0 () Bool)
+(declare-fun p0h1 () Bool)
+(declare-fun p0h2 () Bool)
+(declare-fun p0h3 () Bool)
+(declare-fun p0h4 () Bool)
+(declare-fun p0h5 () Bool)
+(declare-fun p0h6 () Bool)
+(declare-fun p1h0 () Bool)
+(declare-fun p1h1 () Bool)
+(declare-fun p1h2 () Bool)
+(declare-fun p1h3 () Bool)
+(declare-fun p1h4 () Bool)
+(declare-fun p1h5 () Bool)
+(declare-fun p1h6 () Bool)
+(declare-fun p2h0 () Bool)
+(declare-fun p2h1 () Bool)
+(declare-fun p2h2 () Bool)
+(declare-fun p2h3 () Bool)
+(declare-fun p2h4 () Bool)
+(declare-fun p2h5 () Bool)
+(declare-fun p2h6 () Bool)
+(declare-fun p3h0 () Bool)
+(declare-fun p3h1 () Bool)
+(declare-fun p3h2 () Bool)
+(declare-fun p3h3 () Bool)
+(declare-fun p3h4 () Bool)
+(declare-fun p3h5 () Bool)
+(declare-fun p3h6 () Bool)
+(declare-fun p4h0 () Bool)
+(declare-fun p4h1 () Bool)
+(declare-fun p4h2 () Bool)
+(declare-fun p4h3 () Bool)
+(declare-fun p4h4 () Bool)
+(declare-fun p4h5 () Bool)
+(declare-fun p4h6 () Bool)
+(declare-fun p5h0 () Bool)
+(declare-fun p5h1 () Bool)
+(declare-fun p5h2 () Bool)
+(declare-fun p5h3 () Bool)
+(declare-fun p5h4 () Bool)
+(declare-fun p5h5 () Bool)
+(declare-fun p5h6 () Bool)
+(declare-fun p6h0 () Bool)
+(declare-fun p6h1 () Bool)
+(declare-fun p6h2 () Bool)
+(declare-fun p6h3 () Bool)
+(declare-fun p6h4 () Bool)
+(declare-fun p6h5 () Bool)
+(declare-fun p6h6 () Bool)
+(declare-fun p7h0 () Bool)
+(declare-fun p7h1 () Bool)
+(declare-fun p7h2 () Bool)
+(declare-fun p7h3 () Bool)
+(declare-fun p7h4 () Bool)
+(declare-fun p7h5 () Bool)
+(declare-fun p7h6 () Bool)
+(assert (or p0h0 p0h1 p0h2 p0h3 p0h4 p0h5 p0h6))
+(assert (or p1h0 p1h1 p1h2 p1h3 p1h4 p1h5 p1h6))
+(assert (or p2h0 p2h1 p2h2 p2h3 p2h4 p2h5 p2h6))
+(assert (or p3h0 p3h1 p3h2 p3h3 p3h4 p3h5 p3h6))
+(assert (or p4h0 p4h1 p4h2 p4h3 p4h4 p4h5 p4h6))
+(assert (or p5h0 p5h1 p5h2 p5h3 p5h4 p5h5 p5h6))
+(assert (or p6h0 p6h1 p6h2 p6h3 p6h4 p6h5 p6h6))
+(assert (or p7h0 p7h1 p7h2 p7h3 p7h4 p7h5 p7h6))
+(assert (not (and p0h0 p1h0)))
+(assert (not (and p0h0 p2h0)))
+(assert (not (and p0h0 p3h0)))
+(assert (not (and p0h0 p4h0)))
+(assert (not (and p0h0 p5h0)))
+(assert (not (and p0h0 p6h0)))
+(assert (not (and p0h0 p7h0)))
+(assert (not (and p1h0 p2h0)))
+(assert (not (and p1h0 p3h0)))
+(assert (not (and p1h0 p4h0)))
+(assert (not (and p1h0 p5h0)))
+(assert (not (and p1h0 p6h0)))
+(assert (not (and p1h0 p7h0)))
+(assert (not (and p2h0 p3h0)))
+(assert (not (and p2h0 p4h0)))
+(assert (not (and p2h0 p5h0)))
+(assert (not (and p2h0 p6h0)))
+(assert (not (and p2h0 p7h0)))
+(assert (not (and p3h0 p4h0)))
+(assert (not (and p3h0 p5h0)))
+(assert (not (and p3h0 p6h0)))
+(assert (not (and p3h0 p7h0)))
+(assert (not (and p4h0 p5h0)))
+(assert (not (and p4h0 p6h0)))
+(assert (not (and p4h0 p7h0)))
+(assert (not (and p5h0 p6h0)))
+(assert (not (and p5h0 p7h0)))
+(assert (not (and p6h0 p7h0)))
+(assert (not (and p0h1 p1h1)))
+(assert (not (and p0h1 p2h1)))
+(assert (not (and p0h1 p3h1)))
+(assert (not (and p0h1 p4h1)))
+(assert (not (and p0h1 p5h1)))
+(assert (not (and p0h1 p6h1)))
+(assert (not (and p0h1 p7h1)))
+(assert (not (and p1h1 p2h1)))
+(assert (not (and p1h1 p3h1)))
+(assert (not (and p1h1 p4h1)))
+(assert (not (and p1h1 p5h1)))
+(assert (not (and p1h1 p6h1)))
+(assert (not (and p1h1 p7h1)))
+(assert (not (and p2h1 p3h1)))
+(assert (not (and p2h1 p4h1)))
+(assert (not (and p2h1 p5h1)))
+(assert (not (and p2h1 p6h1)))
+(assert (not (and p2h1 p7h1)))
+(assert (not (and p3h1 p4h1)))
+(assert (not (and p3h1 p5h1)))
+(assert (not (and p3h1 p6h1)))
+(assert (not (and p3h1 p7h1)))
+(assert (not (and p4h1 p5h1)))
+(assert (not (and p4h1 p6h1)))
+(assert (not (and p4h1 p7h1)))
+(assert (not (and p5h1 p6h1)))
+(assert (not (and p5h1 p7h1)))
+(assert (not (and p6h1 p7h1)))
+(assert (not (and p0h2 p1h2)))
+(assert (not (and p0h2 p2h2)))
+(assert (not (and p0h2 p3h2)))
+(assert (not (and p0h2 p4h2)))
+(assert (not (and p0h2 p5h2)))
+(assert (not (and p0h2 p6h2)))
+(assert (not (and p0h2 p7h2)))
+(assert (not (and p1h2 p2h2)))
+(assert (not (and p1h2 p3h2)))
+(assert (not (and p1h2 p4h2)))
+(assert (not (and p1h2 p5h2)))
+(assert (not (and p1h2 p6h2)))
+(assert (not (and p1h2 p7h2)))
+(assert (not (and p2h2 p3h2)))
+(assert (not (and p2h2 p4h2)))
+(assert (not (and p2h2 p5h2)))
+(assert (not (and p2h2 p6h2)))
+(assert (not (and p2h2 p7h2)))
+(assert (not (and p3h2 p4h2)))
+(assert (not (and p3h2 p5h2)))
+(assert (not (and p3h2 p6h2)))
+(assert (not (and p3h2 p7h2)))
+(assert (not (and p4h2 p5h2)))
+(assert (not (and p4h2 p6h2)))
+(assert (not (and p4h2 p7h2)))
+(assert (not (and p5h2 p6h2)))
+(assert (not (and p5h2 p7h2)))
+(assert (not (and p6h2 p7h2)))
+(assert (not (and p0h3 p1h3)))
+(assert (not (and p0h3 p2h3)))
+(assert (not (and p0h3 p3h3)))
+(assert (not (and p0h3 p4h3)))
+(assert (not (and p0h3 p5h3)))
+(assert (not (and p0h3 p6h3)))
+(assert (not (and p0h3 p7h3)))
+(assert (not (and p1h3 p2h3)))
+(assert (not (and p1h3 p3h3)))
+(assert (not (and p1h3 p4h3)))
+(assert (not (and p1h3 p5h3)))
+(assert (not (and p1h3 p6h3)))
+(assert (not (and p1h3 p7h3)))
+(assert (not (and p2h3 p3h3)))
+(assert (not (and p2h3 p4h3)))
+(assert (not (and p2h3 p5h3)))
+(assert (not (and p2h3 p6h3)))
+(assert (not (and p2h3 p7h3)))
+(assert (not (and p3h3 p4h3)))
+(assert (not (and p3h3 p5h3)))
+(assert (not (and p3h3 p6h3)))
+(assert (not (and p3h3 p7h3)))
+(assert (not (and p4h3 p5h3)))
+(assert (not (and p4h3 p6h3)))
+(assert (not (and p4h3 p7h3)))
+(assert (not (and p5h3 p6h3)))
+(assert (not (and p5h3 p7h3)))
+(assert (not (and p6h3 p7h3)))
+(assert (not (and p0h4 p1h4)))
+(assert (not (and p0h4 p2h4)))
+(assert (not (and p0h4 p3h4)))
+(assert (not (and p0h4 p4h4)))
+(assert (not (and p0h4 p5h4)))
+(assert (not (and p0h4 p6h4)))
+(assert (not (and p0h4 p7h4)))
+(assert (not (and p1h4 p2h4)))
+(assert (not (and p1h4 p3h4)))
+(assert (not (and p1h4 p4h4)))
+(assert (not (and p1h4 p5h4)))
+(assert (not (and p1h4 p6h4)))
+(assert (not (and p1h4 p7h4)))
+(assert (not (and p2h4 p3h4)))
+(assert (not (and p2h4 p4h4)))
+(assert (not (and p2h4 p5h4)))
+(assert (not (and p2h4 p6h4)))
+(assert (not (and p2h4 p7h4)))
+(assert (not (and p3h4 p4h4)))
+(assert (not (and p3h4 p5h4)))
+(assert (not (and p3h4 p6h4)))
+(assert (not (and p3h4 p7h4)))
+(assert (not (and p4h4 p5h4)))
+(assert (not (and p4h4 p6h4)))
+(assert (not (and p4h4 p7h4)))
+(assert (not (and p5h4 p6h4)))
+(assert (not (and p5h4 p7h4)))
+(assert (not (and p6h4 p7h4)))
+(assert (not (and p0h5 p1h5)))
+(assert (not (and p0h5 p2h5)))
+(assert (not (and p0h5 p3h5)))
+(assert (not (and p0h5 p4h5)))
+(assert (not (and p0h5 p5h5)))
+(assert (not (and p0h5 p6h5)))
+(assert (not (and p0h5 p7h5)))
+(assert (not (and p1h5 p2h5)))
+(assert (not (and p1h5 p3h5)))
+(assert (not (and p1h5 p4h5)))
+(assert (not (and p1h5 p5h5)))
+(assert (not (and p1h5 p6h5)))
+(assert (not (and p1h5 p7h5)))
+(assert (not (and p2h5 p3h5)))
+(assert (not (and p2h5 p4h5)))
+(assert (not (and p2h5 p5h5)))
+(assert (not (and p2h5 p6h5)))
+(assert (not (and p2h5 p7h5)))
+(assert (not (and p3h5 p4h5)))
+(assert (not (and p3h5 p5h5)))
+(assert (not (and p3h5 p6h5)))
+(assert (not (and p3h5 p7h5)))
+(assert (not (and p4h5 p5h5)))
+(assert (not (and p4h5 p6h5)))
+(assert (not (and p4h5 p7h5)))
+(assert (not (and p5h5 p6h5)))
+(assert (not (and p5h5 p7h5)))
+(assert (not (and p6h5 p7h5)))
+(assert (not (and p0h6 p1h6)))
+(assert (not (and p0h6 p2h6)))
+(assert (not (and p0h6 p3h6)))
+(assert (not (and p0h6 p4h6)))
+(assert (not (and p0h6 p5h6)))
+(assert (not (and p0h6 p6h6)))
+(assert (not (and p0h6 p7h6)))
+(assert (not (and p1h6 p2h6)))
+(assert (not (and p1h6 p3h6)))
+(assert (not (and p1h6 p4h6)))
+(assert (not (and p1h6 p5h6)))
+(assert (not (and p1h6 p6h6)))
+(assert (not (and p1h6 p7h6)))
+(assert (not (and p2h6 p3h6)))
+(assert (not (and p2h6 p4h6)))
+(assert (not (and p2h6 p5h6)))
+(assert (not (and p2h6 p6h6)))
+(assert (not (and p2h6 p7h6)))
+(assert (not (and p3h6 p4h6)))
+(assert (not (and p3h6 p5h6)))
+(assert (not (and p3h6 p6h6)))
+(assert (not (and p3h6 p7h6)))
+(assert (not (and p4h6 p5h6)))
+(assert (not (and p4h6 p6h6)))
+(assert (not (and p4h6 p7h6)))
+(assert (not (and p5h6 p6h6)))
+(assert (not (and p5h6 p7h6)))
+(assert (not (and p6h6 p7h6)))
+(check-sat)
@@ -171,13 +171,14 @@ def run_benchmark(dump, wrapper, scrubber, error_scrubber, cvc4_binary,
 
 def run_regression(check_unsat_cores, check_proofs, dump, use_skip_return_code,
                    skip_timeout, wrapper, cvc4_binary, benchmark_path,
-                   timeout):
+                   timeout, extra_options):
     """Determines the expected output for a benchmark, runs CVC4 on it and then
     checks whether the output corresponds to the expected output. Optionally
     uses a wrapper `wrapper`, tests unsat cores (if check_unsat_cores is true),
     checks proofs (if check_proofs is true), or dumps a benchmark and uses that as
     the input (if dump is true). `use_skip_return_code` enables/disables
-    returning 77 when a test is skipped."""
+    returning 77 when a test is skipped. The options `extra_options` are added
+    to every command line."""
 
     if not os.access(cvc4_binary, os.X_OK):
         sys.exit(
@@ -187,7 +188,7 @@ def run_regression(check_unsat_cores, check_proofs, dump, use_skip_return_code,
 
     cvc4_features, cvc4_disabled_features = get_cvc4_features(cvc4_binary)
 
-    basic_command_line_args = []
+    basic_command_line_args = extra_options[:]
 
     benchmark_basename = os.path.basename(benchmark_path)
     benchmark_filename, benchmark_ext = os.path.splitext(benchmark_basename)
@@ -440,6 +441,8 @@ def main():
     parser.add_argument('--check-proofs', action='store_true', default=True)
     parser.add_argument('--no-check-proofs', dest='check_proofs',
                         action='store_false')
+    parser.add_argument('--cvc4-option', action='append', default=[],
+                        dest='cvc4_options')
     parser.add_argument('wrapper', nargs='*')
     parser.add_argument('cvc4_binary')
     parser.add_argument('benchmark')
@@ -461,7 +464,8 @@ def main():
 
     return run_regression(args.check_unsat_cores, args.check_proofs, args.dump,
                           args.use_skip_return_code, args.skip_timeout,
-                          wrapper, cvc4_binary, args.benchmark, timeout)
+                          wrapper, cvc4_binary, args.benchmark, timeout,
+                          args.cvc4_options)
 
 
 if __name__ == "__main__":
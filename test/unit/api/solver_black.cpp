@@ -1265,6 +1265,195 @@ TEST_F(TestApiBlackSolver, uFIteration)
   }
 }
 
+TEST_F(TestApiBlackSolver, exportImportTerms)
+{
+  Sort intSort = d_solver.getIntegerSort();
+  Sort uSort = d_solver.mkUninterpretedSort("u");
+  Sort bvSort = d_solver.mkBitVectorSort(8);
+  DatatypeDecl listDecl = d_solver.mkDatatypeDecl("list");
+  DatatypeConstructorDecl cons = d_solver.mkDatatypeConstructorDecl("cons");
+  cons.addSelector("head", intSort);
+  cons.addSelectorSelf("tail");
+  listDecl.addConstructor(cons);
+  DatatypeConstructorDecl nil = d_solver.mkDatatypeConstructorDecl("nil");
+  listDecl.addConstructor(nil);
+  Sort listSort = d_solver.mkDatatypeSort(listDecl);
+  Datatype list = listSort.getDatatype();
+
+  Term x = d_solver.mkConst(intSort, "x");
+  Term f = d_solver.mkConst(d_solver.mkFunctionSort(uSort, intSort), "f");
+  Term a = d_solver.mkConst(uSort, "a");
+  Term l = d_solver.mkConst(listSort, "l");
+  Term b = d_solver.mkConst(bvSort, "b");
+  Term s = d_solver.mkConst(d_solver.getStringSort(), "s");
+  Term arr =
+      d_solver.mkConst(d_solver.mkArraySort(intSort, intSort), "arr");
+  Term y = d_solver.mkVar(intSort, "y");
+  Term nilTerm =
+      d_solver.mkTerm(APPLY_CONSTRUCTOR, list["nil"].getConstructorTerm());
+  Term consTerm = d_solver.mkTerm(
+      APPLY_CONSTRUCTOR, list["cons"].getConstructorTerm(), x, nilTerm);
+  Term extract = d_solver.mkTerm(d_solver.mkOp(BITVECTOR_EXTRACT, 3, 0), b);
+  std::vector<Term> terms = {
+      d_solver.mkTerm(GT,
+                      d_solver.mkTerm(PLUS, x, d_solver.mkTerm(APPLY_UF, f, a)),
+                      d_solver.mkInteger(3)),
+      d_solver.mkTerm(EQUAL, l, consTerm),
+      d_solver.mkTerm(
+          AND,
+          d_solver.mkTerm(APPLY_TESTER, list["cons"].getTesterTerm(), l),
+          d_solver.mkTerm(
+              EQUAL,
+              d_solver.mkTerm(
+                  APPLY_SELECTOR, list["cons"].getSelectorTerm("head"), l),
+              d_solver.mkInteger(-1))),
+      d_solver.mkTerm(EQUAL, extract, d_solver.mkBitVector("1010", 2)),
+      d_solver.mkTerm(EQUAL,
+                      d_solver.mkTerm(STRING_LENGTH, s),
+                      d_solver.mkTerm(SELECT, arr, x)),
+      d_solver.mkTerm(
+          FORALL,
+          d_solver.mkTerm(BOUND_VAR_LIST, y),
+          d_solver.mkTerm(
+              GEQ, d_solver.mkTerm(MULT, y, y), d_solver.mkReal(0)))};
+
+  std::stringstream ss;
+  ASSERT_NO_THROW(d_solver.exportTerms(terms, ss));
+  std::string data = ss.str();
+
+  Solver slv;
+  std::vector<Term> symbols;
+  std::vector<Sort> sorts;
+  std::vector<Term> imported =
+      slv.importTerms(data.data(), data.size(), symbols, sorts);
+  ASSERT_EQ(imported.size(), terms.size());
+  for (size_t i = 0, size = terms.size(); i < size; ++i)
+  {
+    ASSERT_EQ(imported[i].toString(), terms[i].toString());
+  }
+  std::set<std::string> names;
+  for (const Term& sym : symbols)
+  {
+    names.insert(sym.toString());
+  }
+  ASSERT_EQ(names,
+            std::set<std::string>({"x", "f", "a", "l", "b", "s", "arr"}));
+  ASSERT_EQ(sorts.size(), 2u);
+  ASSERT_TRUE(slv.checkSatAssuming(imported[2]).isSat());
+
+  // terms of another solver, and malformed data
+  ASSERT_THROW(slv.exportTerms(terms, ss), CVC4ApiException);
+  ASSERT_THROW(slv.importTerms("CVC4DAG", 7, symbols, sorts),
+               CVC4ApiException);
+  ASSERT_THROW(
+      slv.importTerms(data.data(), data.size() / 2, symbols, sorts),
+      CVC4ApiException);
+}
+
+TEST_F(TestApiBlackSolver, saveRestoreCheckpoint)
+{
+  std::stringstream ss;
+  ASSERT_THROW(d_solver.saveCheckpoint(ss), CVC4ApiException);
+
+  Solver slv;
+  for (Solver* s : {&d_solver, &slv})
+  {
+    s->setLogic("QF_UFLIA");
+    s->setOption("checkpoints", "true");
+    s->setOption("produce-models", "true");
+    s->setOption("produce-assertions", "true");
+  }
+  Sort intSort = d_solver.getIntegerSort();
+  Term x = d_solver.mkConst(intSort, "x");
+  Term y = d_solver.mkConst(intSort, "y");
+  Term f = d_solver.mkConst(d_solver.mkFunctionSort(intSort, intSort), "f");
+  Term one = d_solver.mkInteger(1);
+  // x is eliminated by a top-level substitution
+  d_solver.assertFormula(
+      d_solver.mkTerm(EQUAL, x, d_solver.mkTerm(PLUS, y, one)));
+  d_solver.assertFormula(d_solver.mkTerm(
+      OR,
+      d_solver.mkTerm(GT, d_solver.mkTerm(APPLY_UF, f, x), y),
+      d_solver.mkTerm(LT, y, d_solver.mkInteger(0))));
+  d_solver.push();
+  d_solver.assertFormula(d_solver.mkTerm(GT, y, d_solver.mkInteger(10)));
+  ASSERT_TRUE(d_solver.checkSat().isSat());
+  ASSERT_NO_THROW(d_solver.saveCheckpoint(ss, true));
+  std::string data = ss.str();
+
+  std::vector<Term> symbols;
+  std::vector<Sort> sorts;
+  ASSERT_NO_THROW(
+      slv.restoreCheckpoint(data.data(), data.size(), symbols, sorts));
+  ASSERT_TRUE(sorts.empty());
+  std::map<std::string, Term> syms;
+  for (const Term& sym : symbols)
+  {
+    syms[sym.toString()] = sym;
+  }
+  ASSERT_EQ(syms.size(), 3u);
+  Term x2 = syms["x"];
+  Term y2 = syms["y"];
+  ASSERT_EQ(slv.getAssertions().size(), 3u);
+  ASSERT_TRUE(slv.checkSat().isSat());
+  ASSERT_EQ(slv.getValue(x2),
+            slv.getValue(slv.mkTerm(PLUS, y2, slv.mkInteger(1))));
+  // the substitution of x applies to later assertions
+  slv.push();
+  slv.assertFormula(slv.mkTerm(EQUAL, x2, slv.mkInteger(5)));
+  ASSERT_TRUE(slv.checkSat().isUnsat());
+  slv.pop();
+  ASSERT_TRUE(slv.checkSat().isSat());
+
+  // a restored checkpoint is saved again with the same assertions
+  std::stringstream ss2;
+  ASSERT_NO_THROW(slv.saveCheckpoint(ss2, true));
+  std::string data2 = ss2.str();
+  Solver slv3;
+  slv3.setLogic("QF_UFLIA");
+  slv3.setOption("checkpoints", "true");
+  slv3.setOption("produce-assertions", "true");
+  std::vector<Term> symbols3;
+  ASSERT_NO_THROW(
+      slv3.restoreCheckpoint(data2.data(), data2.size(), symbols3, sorts));
+  ASSERT_EQ(symbols3.size(), 3u);
+  ASSERT_EQ(slv3.getAssertions().size(), 3u);
+  ASSERT_TRUE(slv3.checkSat().isSat());
+  for (const Term& sym : symbols3)
+  {
+    if (sym.toString() == "x")
+    {
+      slv3.assertFormula(slv3.mkTerm(EQUAL, sym, slv3.mkInteger(5)));
+    }
+  }
+  ASSERT_TRUE(slv3.checkSat().isUnsat());
+
+  // another logic, and malformed data
+  Solver slv2;
+  slv2.setLogic("QF_LIA");
+  slv2.setOption("checkpoints", "true");
+  ASSERT_THROW(
+      slv2.restoreCheckpoint(data.data(), data.size(), symbols, sorts),
+      CVC4ApiException);
+  ASSERT_THROW(slv.restoreCheckpoint("CVC4CKPT", 8, symbols, sorts),
+               CVC4ApiException);
+}
+
+TEST_F(TestApiBlackSolver, getStatisticsSnapshot)
+{
+  Sort intSort = d_solver.getIntegerSort();
+  Term x = d_solver.mkConst(intSort, "x");
+  d_solver.assertFormula(d_solver.mkTerm(GT, x, d_solver.mkInteger(0)));
+  ASSERT_TRUE(d_solver.checkSat().isSat());
+  std::map<std::string, double> snapshot = d_solver.getStatisticsSnapshot();
+#ifdef CVC4_STATISTICS_ON
+  ASSERT_NE(snapshot.find("smt::SmtEngine::solveTime"), snapshot.end());
+  ASSERT_GT(snapshot["smt::SmtEngine::solveTime"], 0);
+#else
+  ASSERT_TRUE(snapshot.empty());
+#endif
+}
+
 TEST_F(TestApiBlackSolver, getInfo)
 {
   ASSERT_NO_THROW(d_solver.getInfo("name"));
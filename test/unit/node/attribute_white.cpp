@@ -54,6 +54,9 @@ using TestFlag3 = Attribute<Test3, bool>;
 using TestFlag4 = Attribute<Test4, bool>;
 using TestFlag5 = Attribute<Test5, bool>;
 
+using TestDenseAttr1 = DenseAttribute<Test1, Node>;
+using TestDenseAttr2 = DenseAttribute<Test2, Node>;
+
 class TestNodeWhiteAttribute : public TestNode
 {
  protected:
@@ -107,6 +110,11 @@ TEST_F(TestNodeWhiteAttribute, attribute_ids)
 
   lastId = attr::LastAttributeId<TypeNode, false>::getId();
   ASSERT_LT(TypeAttr::s_id, lastId);
+
+  lastId = attr::LastAttributeId<AttrDenseTable<Node>, false>::getId();
+  ASSERT_LT(TestDenseAttr1::s_id, lastId);
+  ASSERT_LT(TestDenseAttr2::s_id, lastId);
+  ASSERT_NE(TestDenseAttr1::s_id, TestDenseAttr2::s_id);
 }
 
 TEST_F(TestNodeWhiteAttribute, attributes)
@@ -444,5 +452,73 @@ TEST_F(TestNodeWhiteAttribute, attributes)
 
   ASSERT_FALSE(unnamed.hasAttribute(VarNameAttr()));
 }
+
+TEST_F(TestNodeWhiteAttribute, dense_attributes)
+{
+  Node a = d_nodeManager->mkVar(*d_booleanType);
+  Node b = d_nodeManager->mkVar(*d_booleanType);
+  Node n = d_nodeManager->mkNode(AND, a, b);
+
+  ASSERT_FALSE(a.hasAttribute(TestDenseAttr1()));
+  ASSERT_TRUE(a.getAttribute(TestDenseAttr1()).isNull());
+
+  // null is a value that is distinct from not having the attribute
+  a.setAttribute(TestDenseAttr1(), Node::null());
+  n.setAttribute(TestDenseAttr1(), b);
+  n.setAttribute(TestDenseAttr2(), a);
+  ASSERT_TRUE(a.hasAttribute(TestDenseAttr1()));
+  ASSERT_FALSE(a.hasAttribute(TestDenseAttr2()));
+  ASSERT_FALSE(b.hasAttribute(TestDenseAttr1()));
+  Node ret;
+  ASSERT_TRUE(a.getAttribute(TestDenseAttr1(), ret));
+  ASSERT_TRUE(ret.isNull());
+  ASSERT_EQ(n.getAttribute(TestDenseAttr1()), b);
+  ASSERT_EQ(n.getAttribute(TestDenseAttr2()), a);
+
+  // deleting an attribute does not affect the others
+  AttributeUniqueId id = AttributeManager::getAttributeId(TestDenseAttr1());
+  ASSERT_EQ(id.getTableId(), AttrTableDenseNode);
+  d_nodeManager->deleteAttributes({&id});
+  ASSERT_FALSE(a.hasAttribute(TestDenseAttr1()));
+  ASSERT_FALSE(n.hasAttribute(TestDenseAttr1()));
+  ASSERT_EQ(n.getAttribute(TestDenseAttr2()), a);
+
+  // attributes of reclaimed nodes are deleted with the node, without
+  // affecting other nodes
+  a.setAttribute(TestDenseAttr2(), n);
+  n.setAttribute(TestFlag1(), true);
+  n = Node::null();
+  d_nodeManager->reclaimAllZombies();
+  ASSERT_FALSE(a.getAttribute(TestDenseAttr2()).isNull());
+  a.setAttribute(TestDenseAttr2(), b);
+  d_nodeManager->reclaimAllZombies();
+  ASSERT_EQ(a.getAttribute(TestDenseAttr2()), b);
+}
+
+TEST_F(TestNodeWhiteAttribute, paged_array)
+{
+  AttrPagedArray<uint64_t> arr;
+  ASSERT_EQ(arr.find(1), nullptr);
+  arr[0] = 1;
+  arr[1] = ~uint64_t(0);
+  ASSERT_EQ(arr.size(), 2u);
+  // an erased entry is inserted again with the default value, while its page
+  // is kept alive by the other entry
+  arr.erase(1);
+  ASSERT_EQ(arr.find(1), nullptr);
+  ASSERT_EQ(arr[1], 0u);
+  ASSERT_EQ(*arr.find(0), 1u);
+  arr.erase(0);
+  arr.erase(1);
+  ASSERT_TRUE(arr.empty());
+
+  // flags of new nodes are unset, even if other flags are set on their page
+  Node a = d_nodeManager->mkVar(*d_booleanType);
+  a.setAttribute(TestFlag1(), true);
+  Node b = d_nodeManager->mkVar(*d_booleanType);
+  b.setAttribute(TestFlag2(), true);
+  ASSERT_FALSE(b.getAttribute(TestFlag1()));
+  ASSERT_FALSE(a.getAttribute(TestFlag2()));
+}
 }  // namespace test
 }  // namespace cvc5
@@ -16,6 +16,9 @@
 
 #include <string>
 #include <vector>
+#ifdef CVC4_THREAD_SAFE_NODES
+#include <thread>
+#endif
 
 #include "base/output.h"
 #include "expr/node_manager.h"
@@ -329,5 +332,41 @@ TEST_F(TestNodeBlackNodeManager, mkNode_too_many_children)
   ASSERT_DEATH(d_nodeManager->mkNode(AND, vars), "toSize > d_nvMaxChildren");
 #endif
 }
+
+#ifdef CVC4_THREAD_SAFE_NODES
+TEST_F(TestNodeBlackNodeManager, mkNode_concurrent)
+{
+  Node x = d_nodeManager->mkSkolem("x", d_nodeManager->booleanType());
+  Node y = d_nodeManager->mkSkolem("y", d_nodeManager->booleanType());
+  Node expected =
+      d_nodeManager->mkNode(AND, x, d_nodeManager->mkNode(OR, x, y));
+  std::vector<std::thread> threads;
+  std::vector<int> results(4, 0);
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    threads.emplace_back([&, i]() {
+      NodeManagerScope scope(d_nodeManager.get());
+      bool res = true;
+      for (size_t j = 0; j < 1000; ++j)
+      {
+        // nodes are created and released again, which also exercises the
+        // reclamation of zombies that are concurrently looked up
+        Node n =
+            d_nodeManager->mkNode(AND, x, d_nodeManager->mkNode(OR, x, y));
+        res = res && n == expected;
+      }
+      results[i] = res;
+    });
+  }
+  for (std::thread& t : threads)
+  {
+    t.join();
+  }
+  for (int res : results)
+  {
+    ASSERT_TRUE(res);
+  }
+}
+#endif
 }  // namespace test
 }  // namespace cvc5
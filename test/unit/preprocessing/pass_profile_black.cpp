@@ -0,0 +1,143 @@
+/*********************                                                        */
+/*! \file pass_profile_black.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of the profile of preprocessing passes.
+ **
+ ** Black box testing of the statistics and the output file of --pp-profile.
+ **/
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "api/cvc4cpp.h"
+#include "test.h"
+
+namespace cvc5 {
+
+using namespace api;
+
+namespace test {
+
+class TestPPBlackProfile : public TestInternal
+{
+ protected:
+  /**
+   * Solve a problem where non-clausal simplification eliminates x with
+   * profiling enabled, writing the profile to file, and return the
+   * statistics.
+   */
+  std::map<std::string, double> solve(const std::string& file)
+  {
+    Solver solver;
+    solver.setLogic("QF_LIA");
+    solver.setOption("pp-profile", "true");
+    solver.setOption("pp-profile-file", file);
+    Sort intSort = solver.getIntegerSort();
+    Term x = solver.mkConst(intSort, "x");
+    Term y = solver.mkConst(intSort, "y");
+    Term z = solver.mkConst(intSort, "z");
+    solver.assertFormula(
+        solver.mkTerm(EQUAL, x, solver.mkTerm(PLUS, y, solver.mkInteger(1))));
+    solver.assertFormula(solver.mkTerm(
+        OR, solver.mkTerm(GT, z, x), solver.mkTerm(LT, z, y)));
+    EXPECT_TRUE(solver.checkSat().isSat());
+    return solver.getStatisticsSnapshot();
+  }
+
+  /**
+   * Get the value of the field key of the JSON object line, written without
+   * nesting as by --pp-profile-file.
+   */
+  std::string getField(const std::string& line, const std::string& key)
+  {
+    std::string prefix = "\"" + key + "\": ";
+    size_t start = line.find(prefix);
+    if (start == std::string::npos)
+    {
+      return "";
+    }
+    start += prefix.size();
+    size_t end = line.find_first_of(",}", start);
+    return line.substr(start, end - start);
+  }
+};
+
+TEST_F(TestPPBlackProfile, statistics_and_file)
+{
+  char filename[] = "ppprofileXXXXXX";
+  int fd = mkstemp(filename);
+  ASSERT_NE(fd, -1);
+  close(fd);
+
+  // two solvers write to the same file
+  std::map<std::string, double> stats = solve(filename);
+  solve(filename);
+
+#ifdef CVC4_STATISTICS_ON
+  const std::string ncs = "preprocessing::non-clausal-simp::";
+  ASSERT_EQ(stats[ncs + "invocations"], 1);
+  // the two assertions and the placeholder for new ones
+  ASSERT_EQ(stats[ncs + "assertionsBefore"], 3);
+  ASSERT_GT(stats[ncs + "dagSizeBefore"], stats[ncs + "assertionsBefore"]);
+  ASSERT_GE(stats[ncs + "newSubstitutions"], 1);
+  ASSERT_EQ(stats[ncs + "newSkolems"], 0);
+  ASSERT_GE(stats["preprocessing::rewrite::invocations"], 1);
+#else
+  ASSERT_TRUE(stats.empty());
+#endif
+
+  // one JSON object per line and invocation, keyed by the solver, each
+  // with all fields
+  std::ifstream in(filename);
+  std::string line;
+  std::set<std::string> engines;
+  std::vector<std::string> substs;
+  const std::vector<std::string> fields = {"engine",
+                                           "pass",
+                                           "invocation",
+                                           "time",
+                                           "assertionsBefore",
+                                           "assertionsAfter",
+                                           "dagSizeBefore",
+                                           "dagSizeAfter",
+                                           "newSkolems",
+                                           "newSubstitutions",
+                                           "conflict"};
+  while (std::getline(in, line))
+  {
+    ASSERT_EQ(line.front(), '{');
+    ASSERT_EQ(line.back(), '}');
+    for (const std::string& f : fields)
+    {
+      ASSERT_NE(getField(line, f), "") << line;
+    }
+    ASSERT_EQ(getField(line, "conflict"), "false");
+    engines.insert(getField(line, "engine"));
+    if (getField(line, "pass") == "\"non-clausal-simp\"")
+    {
+      substs.push_back(getField(line, "newSubstitutions"));
+    }
+  }
+  std::remove(filename);
+  ASSERT_EQ(engines.size(), 2u);
+  ASSERT_EQ(substs.size(), 2u);
+  for (const std::string& s : substs)
+  {
+    ASSERT_NE(s, "0");
+  }
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,121 @@
+/*********************                                                        */
+/*! \file pass_rewrite_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the rewrite preprocessing pass.
+ **
+ ** White box testing of the rewrite preprocessing pass.
+ **/
+
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "options/smt_options.h"
+#include "preprocessing/assertion_pipeline.h"
+#include "preprocessing/preprocessing_pass.h"
+#include "smt/preprocessor.h"
+#include "smt/process_assertions.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+#include "test_smt.h"
+#include "util/bitvector.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+
+using namespace kind;
+using namespace preprocessing;
+
+namespace test {
+
+class TestPPWhiteRewrite : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    d_scope.reset(new smt::SmtScope(d_smtEngine.get()));
+    d_pass = d_smtEngine->d_pp->d_processor.d_passes["rewrite"].get();
+  }
+
+  void TearDown() override
+  {
+    d_scope.reset();
+    TestSmt::TearDown();
+  }
+
+  /** Apply the rewrite pass on threads threads, return the result. */
+  std::vector<Node> rewriteAll(const std::vector<Node>& assertions,
+                               unsigned threads)
+  {
+    options::ppThreads.set(threads);
+    AssertionPipeline pipeline;
+    for (const Node& a : assertions)
+    {
+      pipeline.push_back(a);
+    }
+    d_pass->apply(&pipeline);
+    options::ppThreads.set(1);
+    return pipeline.ref();
+  }
+
+  std::unique_ptr<smt::SmtScope> d_scope;
+  PreprocessingPass* d_pass;
+};
+
+TEST_F(TestPPWhiteRewrite, sequential)
+{
+  Node x = d_nodeManager->mkVar("x", d_nodeManager->integerType());
+  Node zero = d_nodeManager->mkConst(Rational(0));
+  Node a = d_nodeManager->mkNode(GEQ, d_nodeManager->mkNode(PLUS, x, zero), x);
+  std::vector<Node> res = rewriteAll({a, a.notNode()}, 1);
+  ASSERT_EQ(res.size(), 2u);
+  ASSERT_EQ(res[0], d_nodeManager->mkConst(true));
+  ASSERT_EQ(res[1], d_nodeManager->mkConst(false));
+}
+
+#ifdef CVC4_THREAD_SAFE_NODES
+TEST_F(TestPPWhiteRewrite, parallel)
+{
+  // more assertions than fit into a single chunk of replaceEach()
+  std::vector<Node> assertions;
+  Node y = d_nodeManager->mkVar("y", d_nodeManager->integerType());
+  Node z = d_nodeManager->mkVar("z", d_nodeManager->mkBitVectorType(8));
+  for (unsigned i = 0; i < 1000; ++i)
+  {
+    Node x = d_nodeManager->mkVar("x", d_nodeManager->integerType());
+    Node c = d_nodeManager->mkConst(Rational(i));
+    Node sum = d_nodeManager->mkNode(
+        PLUS, d_nodeManager->mkNode(MULT, c, x), y, c);
+    Node arith = d_nodeManager->mkNode(
+        GEQ, sum, d_nodeManager->mkNode(MINUS, y, x));
+    Node bv = d_nodeManager->mkNode(
+        EQUAL,
+        d_nodeManager->mkNode(BITVECTOR_PLUS,
+                              z,
+                              d_nodeManager->mkConst(BitVector(8, i % 256))),
+        d_nodeManager->mkNode(BITVECTOR_NOT, z));
+    assertions.push_back(
+        i % 2 == 0 ? d_nodeManager->mkNode(OR, arith, bv.notNode())
+                   : d_nodeManager->mkNode(AND, arith.notNode(), bv));
+  }
+  std::vector<Node> expected = rewriteAll(assertions, 1);
+  for (unsigned threads : {2u, 4u})
+  {
+    std::vector<Node> res = rewriteAll(assertions, threads);
+    ASSERT_EQ(res.size(), assertions.size());
+    for (size_t i = 0, size = res.size(); i < size; ++i)
+    {
+      ASSERT_EQ(res[i], expected[i]);
+    }
+  }
+}
+#endif
+}  // namespace test
+}  // namespace cvc5
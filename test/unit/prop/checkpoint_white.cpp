@@ -0,0 +1,102 @@
+/*********************                                                        */
+/*! \file checkpoint_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of checkpoints of the prop engine.
+ **
+ ** White box testing of the formulas that the prop engine records for
+ ** checkpoints (--checkpoints).
+ **/
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "expr/type_node.h"
+#include "smt/checkpoint.h"
+#include "smt/smt_engine.h"
+#include "test_smt.h"
+
+namespace cvc5 {
+
+using namespace kind;
+using namespace smt;
+
+namespace test {
+
+class TestPropWhiteCheckpoint : public TestSmtNoFinishInit
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmtNoFinishInit::SetUp();
+    d_smtEngine->setOption("checkpoints", "true");
+    d_smtEngine->setLogic("QF_UF");
+  }
+
+  /** Save a checkpoint of d_smtEngine and read it back. */
+  Checkpoint save(bool learnedClauses)
+  {
+    std::stringstream ss;
+    d_smtEngine->saveCheckpoint(ss, learnedClauses);
+    std::string data = ss.str();
+    Checkpoint cp;
+    cp.read(data.data(), data.size());
+    return cp;
+  }
+
+  /** The string representations of the formulas of v. */
+  std::vector<std::string> toStrings(const std::vector<Node>& v)
+  {
+    std::vector<std::string> res;
+    for (const Node& n : v)
+    {
+      res.push_back(n.toString());
+    }
+    return res;
+  }
+};
+
+TEST_F(TestPropWhiteCheckpoint, save_restore_save)
+{
+  TypeNode boolType = d_nodeManager->booleanType();
+  Node a = d_nodeManager->mkVar("a", boolType);
+  Node b = d_nodeManager->mkVar("b", boolType);
+  Node c = d_nodeManager->mkVar("c", boolType);
+  Checkpoint cp;
+  cp.d_logic = d_smtEngine->getLogicInfo().getLogicString();
+  cp.d_ppAssertions.push_back(d_nodeManager->mkNode(OR, a, b));
+  cp.d_lemmas.push_back(d_nodeManager->mkNode(OR, a.notNode(), c));
+  cp.d_learnedClauses.push_back(d_nodeManager->mkNode(OR, b, c));
+  std::stringstream ss;
+  cp.write(ss);
+  std::string data = ss.str();
+  std::vector<Node> symbols;
+  std::vector<TypeNode> sorts;
+  d_smtEngine->restoreCheckpoint(data.data(), data.size(), symbols, sorts);
+  ASSERT_EQ(symbols.size(), 3u);
+
+  // the restored lemma and learned clause are saved again in their own lists,
+  // not as preprocessed assertions
+  Checkpoint cp2 = save(true);
+  ASSERT_EQ(toStrings(cp2.d_ppAssertions), toStrings(cp.d_ppAssertions));
+  ASSERT_EQ(toStrings(cp2.d_lemmas), toStrings(cp.d_lemmas));
+  ASSERT_FALSE(cp2.d_learnedClauses.empty());
+  ASSERT_EQ(cp2.d_learnedClauses[0].toString(),
+            cp.d_learnedClauses[0].toString());
+
+  Checkpoint cp3 = save(false);
+  ASSERT_EQ(toStrings(cp3.d_ppAssertions), toStrings(cp.d_ppAssertions));
+  ASSERT_EQ(toStrings(cp3.d_lemmas), toStrings(cp.d_lemmas));
+  ASSERT_TRUE(cp3.d_learnedClauses.empty());
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -15,18 +15,21 @@
  ** \todo document this file
  **/
 
+#include <cstdint>
 #include <vector>
 
 #include "expr/node.h"
 #include "test_smt.h"
 #include "theory/bv/theory_bv_utils.h"
 #include "theory/evaluator.h"
+#include "theory/quantifiers/sygus/sygus_eval_program.h"
 #include "theory/rewriter.h"
 #include "util/rational.h"
 
 namespace cvc5 {
 
 using namespace theory;
+using namespace theory::quantifiers;
 
 namespace test {
 
@@ -155,5 +158,169 @@ TEST_F(TestTheoryWhiteEvaluator, code)
     ASSERT_EQ(r, d_nodeManager->mkConst(Rational(-1)));
   }
 }
+
+TEST_F(TestTheoryWhiteEvaluator, batch)
+{
+  TypeNode bv8Type = d_nodeManager->mkBitVectorType(8);
+  Node x = d_nodeManager->mkVar("x", bv8Type);
+  Node y = d_nodeManager->mkVar("y", bv8Type);
+  Node b = d_nodeManager->mkVar("b", d_nodeManager->booleanType());
+  Node s = d_nodeManager->mkVar("s", d_nodeManager->stringType());
+  Node three = d_nodeManager->mkConst(BitVector(8, 3u));
+
+  std::vector<Node> terms;
+  for (Kind k : {kind::BITVECTOR_PLUS,
+                 kind::BITVECTOR_SUB,
+                 kind::BITVECTOR_MULT,
+                 kind::BITVECTOR_UDIV,
+                 kind::BITVECTOR_UREM,
+                 kind::BITVECTOR_AND,
+                 kind::BITVECTOR_OR,
+                 kind::BITVECTOR_XOR,
+                 kind::BITVECTOR_SHL,
+                 kind::BITVECTOR_LSHR,
+                 kind::BITVECTOR_ASHR,
+                 kind::BITVECTOR_CONCAT,
+                 kind::BITVECTOR_ULT,
+                 kind::BITVECTOR_ULE,
+                 kind::BITVECTOR_UGE,
+                 kind::BITVECTOR_SLT,
+                 kind::BITVECTOR_SLE,
+                 kind::BITVECTOR_SGT,
+                 kind::BITVECTOR_SGE,
+                 kind::EQUAL})
+  {
+    terms.push_back(d_nodeManager->mkNode(k, x, y));
+  }
+  terms.push_back(bv::utils::mkExtract(
+      d_nodeManager->mkNode(kind::BITVECTOR_NEG, x), 6, 2));
+  // a Boolean combination with a subterm that is evaluated per point
+  Node len = d_nodeManager->mkNode(kind::STRING_LENGTH, s);
+  Node cmp = d_nodeManager->mkNode(
+      kind::GT, len, d_nodeManager->mkConst(Rational(2)));
+  Node ite = d_nodeManager->mkNode(
+      kind::ITE,
+      d_nodeManager->mkNode(kind::XOR, b, cmp),
+      d_nodeManager->mkNode(kind::BITVECTOR_NOT, x),
+      d_nodeManager->mkNode(kind::BITVECTOR_MULT, y, three));
+  terms.push_back(ite);
+  terms.push_back(d_nodeManager->mkNode(
+      kind::IMPLIES, b, d_nodeManager->mkNode(kind::BITVECTOR_SGT, ite, y)));
+
+  // more than 64 points, such that Booleans are packed into several words
+  std::vector<Node> args = {x, y, b, s};
+  std::vector<std::vector<Node>> points;
+  for (unsigned i = 0; i < 100; ++i)
+  {
+    points.push_back(
+        {d_nodeManager->mkConst(BitVector(8, (i * 37u) % 256)),
+         d_nodeManager->mkConst(BitVector(8, (i * 11u) % 9)),
+         d_nodeManager->mkConst(i % 3 == 0),
+         d_nodeManager->mkConst(String(std::string(i % 5, 'a')))});
+  }
+
+  Evaluator eval;
+  for (const Node& t : terms)
+  {
+    std::vector<Node> results;
+    eval.evalBatch(t, args, points, results);
+    ASSERT_EQ(results.size(), points.size());
+    for (size_t i = 0, size = points.size(); i < size; ++i)
+    {
+      ASSERT_EQ(results[i], eval.eval(t, args, points[i]));
+    }
+  }
+
+  // the compiled programs of sygus give the same values, except for the terms
+  // with strings, which are not compiled
+  for (size_t j = 0, nterms = terms.size(); j < nterms; ++j)
+  {
+    SygusEvalProgram p;
+    ASSERT_EQ(p.compile(terms[j], args), j + 2 < nterms) << terms[j];
+    if (!p.isCompiled())
+    {
+      continue;
+    }
+    for (const std::vector<Node>& pt : points)
+    {
+      ASSERT_EQ(p.eval(pt), eval.eval(terms[j], args, pt)) << terms[j];
+    }
+  }
+}
+
+TEST_F(TestTheoryWhiteEvaluator, evalProgramInteger)
+{
+  Node x = d_nodeManager->mkVar("x", d_nodeManager->integerType());
+  Node y = d_nodeManager->mkVar("y", d_nodeManager->integerType());
+  Node two = d_nodeManager->mkConst(Rational(2));
+
+  // shared subterms are computed once
+  Node sum = d_nodeManager->mkNode(kind::PLUS, x, y, two);
+  std::vector<Node> terms = {
+      d_nodeManager->mkNode(kind::MINUS, sum, x),
+      d_nodeManager->mkNode(kind::MULT, sum, sum),
+      d_nodeManager->mkNode(kind::ABS, d_nodeManager->mkNode(kind::UMINUS, y)),
+      d_nodeManager->mkNode(
+          kind::ITE,
+          d_nodeManager->mkNode(
+              kind::AND,
+              d_nodeManager->mkNode(kind::GEQ, x, y),
+              d_nodeManager->mkNode(kind::LT, sum, two)),
+          x,
+          sum),
+      d_nodeManager->mkNode(
+          kind::OR,
+          d_nodeManager->mkNode(kind::EQUAL, x, two),
+          d_nodeManager->mkNode(kind::GT, y, x))};
+
+  std::vector<Node> args = {x, y};
+  Evaluator eval;
+  for (const Node& t : terms)
+  {
+    SygusEvalProgram p;
+    ASSERT_TRUE(p.compile(t, args)) << t;
+    for (int i = -5; i <= 5; ++i)
+    {
+      for (int j = -3; j <= 3; ++j)
+      {
+        std::vector<Node> pt = {d_nodeManager->mkConst(Rational(i * 7)),
+                                d_nodeManager->mkConst(Rational(j))};
+        ASSERT_EQ(p.eval(pt), eval.eval(t, args, pt)) << t;
+      }
+    }
+  }
+
+  // integer overflows are not evaluated
+  SygusEvalProgram p;
+  ASSERT_TRUE(p.compile(terms[1], args));
+  Node big = d_nodeManager->mkConst(Rational(Integer(INT64_MAX)));
+  ASSERT_TRUE(p.eval({big, big}).isNull());
+  // neither are values that do not fit into a register
+  Node huge =
+      d_nodeManager->mkConst(Rational(Integer("100000000000000000000")));
+  ASSERT_TRUE(p.eval({huge, two}).isNull());
+}
+
+TEST_F(TestTheoryWhiteEvaluator, evalProgramUnsupported)
+{
+  Node x = d_nodeManager->mkVar("x", d_nodeManager->integerType());
+  Node r = d_nodeManager->mkVar("r", d_nodeManager->realType());
+  Node s = d_nodeManager->mkVar("s", d_nodeManager->stringType());
+  SygusEvalProgram p;
+  // a variable that is not an argument
+  ASSERT_FALSE(p.compile(d_nodeManager->mkNode(kind::PLUS, x, x), {}));
+  ASSERT_FALSE(p.isCompiled());
+  // real arithmetic
+  ASSERT_FALSE(p.compile(d_nodeManager->mkNode(kind::LT, x, r), {x, r}));
+  // an operator that is not supported
+  ASSERT_FALSE(
+      p.compile(d_nodeManager->mkNode(kind::STRING_LENGTH, s), {x, r, s}));
+  // variables of unsupported types may be given if they do not occur
+  ASSERT_TRUE(p.compile(d_nodeManager->mkNode(kind::UMINUS, x), {r, x, s}));
+  ASSERT_EQ(p.eval({d_nodeManager->mkConst(Rational(1, 2)),
+                    d_nodeManager->mkConst(Rational(3)),
+                    d_nodeManager->mkConst(String("a"))}),
+            d_nodeManager->mkConst(Rational(-3)));
+}
 }  // namespace test
 }  // namespace cvc5
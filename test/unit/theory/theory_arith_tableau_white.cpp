@@ -0,0 +1,197 @@
+/*********************                                                        */
+/*! \file theory_arith_tableau_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the compressed-row layout of the tableau.
+ **
+ ** White box testing of the compressed-row layout of the simplex tableau
+ ** (--tableau-layout=csr).
+ **/
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "smt/smt_engine_scope.h"
+#include "test_smt.h"
+#include "theory/arith/tableau.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+
+using namespace theory::arith;
+
+namespace test {
+
+class TestTheoryWhiteArithTableau : public TestSmt
+{
+ protected:
+  using Entries = std::vector<std::tuple<RowIndex, ArithVar, Rational>>;
+
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    d_scope.reset(new smt::SmtScope(d_smtEngine.get()));
+  }
+
+  void TearDown() override
+  {
+    d_scope.reset();
+    TestSmt::TearDown();
+  }
+
+  /** The entries of the rows of basics, in the order of the rows. */
+  Entries rowEntries(const Tableau& t, const std::vector<ArithVar>& basics)
+  {
+    Entries entries;
+    for (ArithVar basic : basics)
+    {
+      for (Tableau::RowIterator i = t.basicRowIterator(basic); !i.atEnd(); ++i)
+      {
+        entries.emplace_back(
+            (*i).getRowIndex(), (*i).getColVar(), (*i).getCoefficient());
+      }
+    }
+    return entries;
+  }
+
+  /** The entries of all columns, in the order of the columns. */
+  Entries colEntries(const Tableau& t)
+  {
+    Entries entries;
+    for (ArithVar v = 0, n = t.getNumColumns(); v < n; ++v)
+    {
+      for (Tableau::ColIterator i = t.colIterator(v); !i.atEnd(); ++i)
+      {
+        entries.emplace_back(
+            (*i).getRowIndex(), (*i).getColVar(), (*i).getCoefficient());
+      }
+    }
+    return entries;
+  }
+
+  /** Are the entries of each row stored contiguously, in row order? */
+  bool isRowMajor(const Tableau& t)
+  {
+    EntryID next = 0;
+    for (const RowVector<Rational>& row : t.d_rows)
+    {
+      for (Tableau::RowIterator i = row.begin(); !i.atEnd(); ++i, ++next)
+      {
+        if (i.getID() != next)
+        {
+          return false;
+        }
+      }
+    }
+    return next == t.d_entries.numAllocated();
+  }
+
+  std::unique_ptr<smt::SmtScope> d_scope;
+};
+
+TEST_F(TestTheoryWhiteArithTableau, compaction)
+{
+  // two tableaux that are updated in the same way, only the second one is
+  // compacted
+  const size_t numRows = 40;
+  const size_t numVars = 60;
+  Tableau plain;
+  Tableau csr;
+  plain.setCompactRows(false);
+  csr.setCompactRows(true);
+  plain.increaseSizeTo(numVars + numRows);
+  csr.increaseSizeTo(numVars + numRows);
+
+  // 40 rows of 31 entries, the 34th row exceeds the threshold of 1024 added
+  // entries
+  std::mt19937 rng(7);
+  std::vector<ArithVar> basics;
+  auto addRow = [&](size_t r) {
+    std::vector<Rational> coeffs;
+    std::vector<ArithVar> vars;
+    for (ArithVar v = r % 2; v < numVars; v += 2)
+    {
+      coeffs.push_back(Rational(static_cast<int>(rng() % 7) - 10));
+      vars.push_back(v);
+    }
+    plain.addRow(basics[r], coeffs, vars);
+    csr.addRow(basics[r], coeffs, vars);
+    Entries expected;
+    for (size_t i = 0; i < vars.size(); ++i)
+    {
+      expected.emplace_back(r, vars[i], coeffs[i]);
+    }
+    expected.emplace_back(r, basics[r], Rational(-1));
+    // the row has the entries it was created with, the basic variable has
+    // coefficient -1
+    Entries row = rowEntries(csr, {basics[r]});
+    std::sort(row.begin(), row.end());
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(row, expected);
+  };
+  for (size_t r = 0; r < numRows; ++r)
+  {
+    basics.push_back(numVars + r);
+    addRow(r);
+  }
+  ASSERT_GT(csr.getNumEntriesInTableau(), 1024u);
+  ASSERT_LT(csr.d_entriesAddedSinceCompaction, csr.getNumEntriesInTableau());
+  ASSERT_EQ(plain.d_entriesAddedSinceCompaction,
+            plain.getNumEntriesInTableau());
+
+  // pivot and replace rows until several more compactions happened, the
+  // compacted tableau keeps the order of rows and columns and the
+  // coefficients
+  NoEffectCCCB cb;
+  size_t numCompactions = 0;
+  uint32_t added = csr.d_entriesAddedSinceCompaction;
+  auto checkCompacted = [&]() {
+    if (csr.d_entriesAddedSinceCompaction < added)
+    {
+      ++numCompactions;
+      ASSERT_TRUE(isRowMajor(csr));
+    }
+    added = csr.d_entriesAddedSinceCompaction;
+  };
+  for (size_t k = 0; numCompactions < 3; ++k)
+  {
+    ASSERT_LT(k, 1000u);
+    size_t r = rng() % numRows;
+    ArithVar basic = basics[r];
+    std::vector<ArithVar> candidates;
+    for (Tableau::RowIterator i = plain.basicRowIterator(basic); !i.atEnd();
+         ++i)
+    {
+      if ((*i).getColVar() != basic)
+      {
+        candidates.push_back((*i).getColVar());
+      }
+    }
+    ArithVar entering = candidates[rng() % candidates.size()];
+    plain.pivot(basic, entering, cb);
+    csr.pivot(basic, entering, cb);
+    checkCompacted();
+    plain.pivot(entering, basic, cb);
+    csr.pivot(entering, basic, cb);
+    checkCompacted();
+    r = rng() % numRows;
+    plain.removeBasicRow(basics[r]);
+    csr.removeBasicRow(basics[r]);
+    addRow(r);
+    checkCompacted();
+    ASSERT_EQ(csr.getNumEntriesInTableau(), plain.getNumEntriesInTableau());
+    ASSERT_EQ(rowEntries(csr, basics), rowEntries(plain, basics));
+    ASSERT_EQ(colEntries(csr), colEntries(plain));
+  }
+}
+
+}  // namespace test
+}  // namespace cvc5
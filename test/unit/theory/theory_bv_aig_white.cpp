@@ -0,0 +1,167 @@
+/*********************                                                        */
+/*! \file theory_bv_aig_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the built-in and-inverter graph
+ **
+ ** White box testing of the built-in and-inverter graph used by the native
+ ** AIG bit-blaster.
+ **/
+
+#include <cstdint>
+#include <vector>
+
+#include "test.h"
+#include "theory/bv/bitblast/aig.h"
+
+namespace cvc5 {
+
+using namespace theory::bv;
+
+namespace test {
+
+class TestTheoryWhiteBvAig : public TestInternal
+{
+ protected:
+  /**
+   * Evaluate e under all assignments to the (at most four) inputs of the
+   * AIG, where input i of d_inputs takes the values of d_patterns[i].
+   */
+  uint16_t eval(const Aig& aig, AigEdge e)
+  {
+    if (e.isConst())
+    {
+      return e.isTrue() ? 0xffff : 0;
+    }
+    uint32_t id = e.getId();
+    uint16_t res;
+    if (aig.isInput(id))
+    {
+      res = 0;
+      for (size_t i = 0; i < d_inputs.size(); ++i)
+      {
+        if (d_inputs[i].getId() == id)
+        {
+          res = d_patterns[i];
+        }
+      }
+    }
+    else
+    {
+      res = eval(aig, aig.getChild0(id)) & eval(aig, aig.getChild1(id));
+    }
+    return e.isNegated() ? ~res : res;
+  }
+
+  std::vector<AigEdge> d_inputs;
+  const uint16_t d_patterns[4] = {0xaaaa, 0xcccc, 0xf0f0, 0xff00};
+};
+
+TEST_F(TestTheoryWhiteBvAig, constants)
+{
+  Aig aig;
+  AigEdge a = aig.mkInput();
+  AigEdge t = AigEdge::mkConst(true);
+  AigEdge f = AigEdge::mkConst(false);
+  ASSERT_EQ(~t, f);
+  ASSERT_EQ(Aig::mkAnd(a, t), a);
+  ASSERT_EQ(Aig::mkAnd(f, a), f);
+  ASSERT_EQ(Aig::mkOr(a, t), t);
+  ASSERT_EQ(Aig::mkXor(a, t), ~a);
+  ASSERT_EQ(Aig::mkIte(t, a, f), a);
+  ASSERT_EQ(aig.getNumAnds(), 0u);
+}
+
+TEST_F(TestTheoryWhiteBvAig, structural_hashing)
+{
+  Aig aig;
+  AigEdge a = aig.mkInput();
+  AigEdge b = aig.mkInput();
+  AigEdge ab = Aig::mkAnd(a, b);
+  ASSERT_EQ(Aig::mkAnd(b, a), ab);
+  ASSERT_EQ(Aig::mkAnd(a, ~b), Aig::mkAnd(~b, a));
+  ASSERT_NE(Aig::mkAnd(a, ~b), ab);
+  ASSERT_EQ(aig.getNumAnds(), 2u);
+  ASSERT_EQ(aig.getNumHashHits(), 3u);
+  ASSERT_EQ(aig.getNumParents(a.getId()), 2u);
+}
+
+TEST_F(TestTheoryWhiteBvAig, rewriting)
+{
+  Aig aig;
+  AigEdge a = aig.mkInput();
+  AigEdge b = aig.mkInput();
+  AigEdge c = aig.mkInput();
+  AigEdge f = AigEdge::mkConst(false);
+  AigEdge ab = Aig::mkAnd(a, b);
+  // level one
+  ASSERT_EQ(Aig::mkAnd(a, a), a);
+  ASSERT_EQ(Aig::mkAnd(a, ~a), f);
+  // contradiction
+  ASSERT_EQ(Aig::mkAnd(ab, ~a), f);
+  ASSERT_EQ(Aig::mkAnd(ab, Aig::mkAnd(~b, c)), f);
+  // idempotence
+  ASSERT_EQ(Aig::mkAnd(ab, b), ab);
+  // subsumption
+  ASSERT_EQ(Aig::mkAnd(~ab, ~a), ~a);
+  ASSERT_EQ(Aig::mkAnd(ab, ~Aig::mkAnd(~a, c)), ab);
+  // substitution
+  ASSERT_EQ(Aig::mkAnd(~ab, a), Aig::mkAnd(a, ~b));
+  // resolution
+  ASSERT_EQ(Aig::mkAnd(~ab, ~Aig::mkAnd(a, ~b)), ~a);
+  ASSERT_GT(aig.getNumRewrites(), 0u);
+}
+
+TEST_F(TestTheoryWhiteBvAig, equivalence)
+{
+  Aig aig;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    d_inputs.push_back(aig.mkInput());
+  }
+  std::vector<AigEdge> edges = d_inputs;
+  std::vector<uint16_t> values(d_patterns, d_patterns + 4);
+  // deterministically combine edges and compare their truth tables with
+  // the expected ones
+  uint32_t seed = 1;
+  for (size_t i = 0; i < 500; ++i)
+  {
+    seed = seed * 1103515245 + 12345;
+    size_t j = (seed >> 8) % edges.size();
+    size_t k = (seed >> 16) % edges.size();
+    AigEdge a = seed & 1 ? ~edges[j] : edges[j];
+    uint16_t va = seed & 1 ? ~values[j] : values[j];
+    AigEdge b = seed & 2 ? ~edges[k] : edges[k];
+    uint16_t vb = seed & 2 ? ~values[k] : values[k];
+    AigEdge res;
+    uint16_t vres;
+    switch ((seed >> 24) % 3)
+    {
+      case 0:
+        res = Aig::mkAnd(a, b);
+        vres = va & vb;
+        break;
+      case 1:
+        res = Aig::mkXor(a, b);
+        vres = va ^ vb;
+        break;
+      default:
+      {
+        size_t l = (seed >> 4) % edges.size();
+        res = Aig::mkIte(edges[l], a, b);
+        vres = (values[l] & va) | (~values[l] & vb);
+      }
+    }
+    ASSERT_EQ(eval(aig, res), vres);
+    edges.push_back(res);
+    values.push_back(vres);
+  }
+}
+
+}  // namespace test
+}  // namespace cvc5
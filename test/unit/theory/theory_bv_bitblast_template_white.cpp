@@ -0,0 +1,174 @@
+/*********************                                                        */
+/*! \file theory_bv_bitblast_template_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of bit-blasting templates
+ **
+ ** White box testing of bit-blasting templates.
+ **/
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "smt/smt_engine_scope.h"
+#include "test_smt.h"
+#include "theory/bv/bitblast/bitblast_template_cache.h"
+#include "theory/bv/bitblast/simple_bitblaster.h"
+#include "theory/bv/theory_bv_utils.h"
+
+namespace cvc5 {
+
+using namespace theory::bv;
+
+namespace test {
+
+class TestTheoryWhiteBvBitblastTemplate : public TestSmt
+{
+ protected:
+  /** The bits of the bit-vector variable x. */
+  std::vector<Node> mkBits(Node x)
+  {
+    std::vector<Node> bits;
+    for (unsigned i = 0, size = utils::getSize(x); i < size; ++i)
+    {
+      bits.push_back(utils::mkBitOf(x, i));
+    }
+    return bits;
+  }
+};
+
+TEST_F(TestTheoryWhiteBvBitblastTemplate, instantiate)
+{
+  TypeNode type = d_nodeManager->mkBitVectorType(6);
+  Node x = d_nodeManager->mkSkolem("x", type);
+  Node y = d_nodeManager->mkSkolem("y", type);
+  Node a = d_nodeManager->mkSkolem("a", type);
+  Node b = d_nodeManager->mkSkolem("b", type);
+  smt::SmtScope scope(d_smtEngine.get());
+  BBSimple bb(nullptr);
+
+  std::vector<Node> xyBits;
+  bb.bbTerm(d_nodeManager->mkNode(kind::BITVECTOR_MULT, x, y), xyBits);
+  std::vector<Node> inputs = mkBits(x);
+  std::vector<Node> yBits = mkBits(y);
+  inputs.insert(inputs.end(), yBits.begin(), yBits.end());
+  BitblastTemplate t(kind::BITVECTOR_MULT, 6, 2);
+  ASSERT_TRUE(t.compile(inputs, xyBits));
+
+  // instantiating with the bits of the operands gives the same circuit as
+  // bit-blasting directly
+  std::vector<Node> bits;
+  t.instantiate(inputs, bits);
+  ASSERT_EQ(bits, xyBits);
+
+  std::vector<Node> abBits;
+  bb.bbTerm(d_nodeManager->mkNode(kind::BITVECTOR_MULT, a, b), abBits);
+  inputs = mkBits(a);
+  std::vector<Node> bBits = mkBits(b);
+  inputs.insert(inputs.end(), bBits.begin(), bBits.end());
+  bits.clear();
+  t.instantiate(inputs, bits);
+  ASSERT_EQ(bits, abBits);
+
+  // templates survive writing and reading
+  std::stringstream ss;
+  t.write(ss);
+  t.write(ss);
+  for (size_t i = 0; i < 2; ++i)
+  {
+    BitblastTemplate r;
+    ASSERT_TRUE(r.read(ss));
+    ASSERT_EQ(r.getKind(), kind::BITVECTOR_MULT);
+    ASSERT_EQ(r.getWidth(), 6u);
+    ASSERT_EQ(r.getArity(), 2u);
+    bits.clear();
+    r.instantiate(inputs, bits);
+    ASSERT_EQ(bits, abBits);
+  }
+}
+
+TEST_F(TestTheoryWhiteBvBitblastTemplate, compile_unsupported)
+{
+  TypeNode type = d_nodeManager->mkBitVectorType(2);
+  Node x = d_nodeManager->mkSkolem("x", type);
+  Node y = d_nodeManager->mkSkolem("y", type);
+  std::vector<Node> inputs = mkBits(x);
+  // the bits of y are not inputs of the template
+  std::vector<Node> outputs = mkBits(y);
+  BitblastTemplate t(kind::BITVECTOR_MULT, 1, 2);
+  ASSERT_FALSE(t.compile(inputs, {outputs[0]}));
+}
+
+TEST_F(TestTheoryWhiteBvBitblastTemplate, read_invalid)
+{
+  BitblastTemplate t;
+  std::stringstream unknownOp("bvadd 1 2 1\nand 2 3\n4\n");
+  ASSERT_FALSE(t.read(unknownOp));
+  std::stringstream forwardRef("bvmul 1 2 1\nand 2 5\n4\n");
+  ASSERT_FALSE(t.read(forwardRef));
+  std::stringstream badArity("bvmul 1 2 1\nnot 2 3\n4\n");
+  ASSERT_FALSE(t.read(badArity));
+  std::stringstream truncated("bvmul 2 2 1\nand 2 4\n6\n");
+  ASSERT_FALSE(t.read(truncated));
+  std::stringstream opArity("bvudiv 1 3 1\nand 2 3\n4\n");
+  ASSERT_FALSE(t.read(opArity));
+  std::stringstream tooWide("bvmul 4294967295 2 1\nand 2 3\n4\n");
+  ASSERT_FALSE(t.read(tooWide));
+  std::stringstream valid("bvmul 1 2 1\nand 2 3\n4\n");
+  ASSERT_TRUE(t.read(valid));
+}
+
+TEST_F(TestTheoryWhiteBvBitblastTemplate, load_save)
+{
+  char filename[] = "templatesXXXXXX";
+  int fd = mkstemp(filename);
+  ASSERT_NE(fd, -1);
+  close(fd);
+  {
+    // invalid records between, inside and after valid ones, and a duplicate
+    std::ofstream out(filename);
+    out << "garbage\n"
+        << "bvmul 1 2 1\nand 2 3\n4\n"
+        << "bvurem 1 3 1\nand 2 3\n4\n"
+        << "bvudiv 1 2 2\nand 2\n"
+        << "bvudiv 1 2 1\nor 2 3\n4\n"
+        << "bvmul 1 2 1\nand 2 3\n4\n"
+        << "bvmul 2 2 1\nand 2 4\n";
+  }
+  BitblastTemplateCache cache;
+  cache.d_file = filename;
+  cache.load();
+  ASSERT_EQ(cache.d_templates.size(), 2u);
+  ASSERT_NE(cache.d_templates.find(BitblastTemplateCache::Key(
+                kind::BITVECTOR_MULT, 1, 2)),
+            cache.d_templates.end());
+  ASSERT_NE(cache.d_templates.find(BitblastTemplateCache::Key(
+                kind::BITVECTOR_UDIV, 1, 2)),
+            cache.d_templates.end());
+
+  // saving replaces the file by the valid templates only
+  cache.save();
+  std::ifstream in(filename);
+  std::stringstream expected;
+  for (const auto& t : cache.d_templates)
+  {
+    t.second->write(expected);
+  }
+  std::stringstream saved;
+  saved << in.rdbuf();
+  ASSERT_EQ(saved.str(), expected.str());
+  std::remove(filename);
+}
+
+}  // namespace test
+}  // namespace cvc5
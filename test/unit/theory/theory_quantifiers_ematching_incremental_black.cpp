@@ -0,0 +1,100 @@
+/*********************                                                        */
+/*! \file theory_quantifiers_ematching_incremental_black.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of incremental E-matching.
+ **
+ ** Black box testing of E-matching that only matches the modified terms in
+ ** later instantiation rounds (--e-matching-incremental).
+ **/
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "api/cvc4cpp.h"
+#include "test.h"
+
+namespace cvc5 {
+
+using namespace api;
+
+namespace test {
+
+class TestTheoryBlackQuantifiersEMatchingIncremental : public TestInternal
+{
+ protected:
+  /**
+   * Solve a problem that needs a round of E-matching for each term of a
+   * chain f(b, a), f(h(b), a), ..., where each round only adds one term that
+   * matches the trigger f(x, a). Return the result, the number of
+   * instantiations in numInsts, and print the instantiations to out.
+   */
+  api::Result solve(bool incremental, double& numInsts, std::ostream& out)
+  {
+    Solver solver;
+    solver.setOption("e-matching-incremental", incremental ? "true" : "false");
+    solver.setOption("print-inst-full", "true");
+    solver.setLogic("UF");
+    Sort u = solver.mkUninterpretedSort("U");
+    Sort ub = solver.mkFunctionSort(u, solver.getBooleanSort());
+    Term f = solver.mkConst(solver.mkFunctionSort({u, u}, u), "f");
+    Term h = solver.mkConst(solver.mkFunctionSort(u, u), "h");
+    Term r = solver.mkConst(ub, "R");
+    Term a = solver.mkConst(u, "a");
+    Term b = solver.mkConst(u, "b");
+    Term c = solver.mkConst(u, "c");
+    Term x = solver.mkVar(u, "x");
+    auto fa = [&](Term arg) {
+      return solver.mkTerm(
+          APPLY_UF, r, solver.mkTerm(APPLY_UF, f, arg, a));
+    };
+    auto hn = [&](Term arg, size_t n) {
+      for (size_t i = 0; i < n; i++)
+      {
+        arg = solver.mkTerm(APPLY_UF, h, arg);
+      }
+      return arg;
+    };
+    solver.assertFormula(
+        solver.mkTerm(FORALL,
+                      solver.mkTerm(BOUND_VAR_LIST, x),
+                      solver.mkTerm(IMPLIES, fa(x), fa(hn(x, 1)))));
+    // a term of f whose second argument is not a, which is never matched
+    solver.assertFormula(solver.mkTerm(
+        APPLY_UF, r, solver.mkTerm(APPLY_UF, f, c, b)));
+    solver.assertFormula(solver.mkTerm(EQUAL, c, hn(b, 1)));
+    solver.assertFormula(fa(b));
+    solver.assertFormula(fa(hn(c, 4)).notTerm());
+    api::Result res = solver.checkSat();
+    solver.printInstantiations(out);
+    std::map<std::string, double> stats = solver.getStatisticsSnapshot();
+    numInsts = stats["Instantiate::Instantiations_Total"];
+    return res;
+  }
+};
+
+TEST_F(TestTheoryBlackQuantifiersEMatchingIncremental, same_instantiations)
+{
+  double numInsts = 0;
+  std::stringstream insts;
+  api::Result res = solve(true, numInsts, insts);
+  ASSERT_TRUE(res.isUnsat());
+  double expectedNumInsts = 0;
+  std::stringstream expected;
+  ASSERT_EQ(solve(false, expectedNumInsts, expected), res);
+  ASSERT_EQ(numInsts, expectedNumInsts);
+  ASSERT_EQ(insts.str(), expected.str());
+#ifdef CVC4_STATISTICS_ON
+  // the chain needs an instantiation for each of its five links
+  ASSERT_GE(numInsts, 5);
+#endif
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,98 @@
+/*********************                                                        */
+/*! \file theory_quantifiers_ematching_threads_black.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of E-matching on several threads.
+ **
+ ** Black box testing of E-matching on several threads (--quant-threads).
+ **/
+
+#include <sstream>
+#include <string>
+
+#include "api/cvc4cpp.h"
+#include "base/output.h"
+#include "test.h"
+
+namespace cvc5 {
+
+using namespace api;
+
+namespace test {
+
+class TestTheoryBlackQuantifiersEMatchingThreads : public TestInternal
+{
+ protected:
+  /**
+   * Solve a problem that needs several rounds of E-matching on the
+   * quantified formulas with threads threads, return the result and print
+   * the instantiations to out.
+   */
+  api::Result solve(const std::string& threads, std::ostream& out)
+  {
+    Solver solver;
+    solver.setOption("quant-threads", threads);
+    solver.setOption("print-inst-full", "true");
+    solver.setLogic("UF");
+    Sort u = solver.mkUninterpretedSort("U");
+    Sort uu = solver.mkFunctionSort(u, u);
+    Sort ub = solver.mkFunctionSort(u, solver.getBooleanSort());
+    Term f = solver.mkConst(uu, "f");
+    Term g = solver.mkConst(uu, "g");
+    Term p = solver.mkConst(ub, "P");
+    Term q = solver.mkConst(ub, "Q");
+    Term r = solver.mkConst(ub, "R");
+    Term a = solver.mkConst(u, "a");
+    Term x = solver.mkVar(u, "x");
+    Term vars = solver.mkTerm(BOUND_VAR_LIST, x);
+    auto app = [&](Term fun, Term arg) {
+      return solver.mkTerm(APPLY_UF, fun, arg);
+    };
+    auto forall = [&](Term body) {
+      solver.assertFormula(solver.mkTerm(FORALL, vars, body));
+    };
+    forall(solver.mkTerm(IMPLIES, app(p, x), app(p, app(f, x))));
+    forall(solver.mkTerm(IMPLIES, app(p, x), app(q, app(g, x))));
+    forall(solver.mkTerm(IMPLIES, app(q, x), app(r, x)));
+    forall(
+        solver.mkTerm(IMPLIES, app(r, app(g, x)), app(r, app(f, x))));
+    solver.assertFormula(app(p, a));
+    solver.assertFormula(app(r, app(f, app(f, app(f, a)))).notTerm());
+    api::Result res = solver.checkSat();
+    solver.printInstantiations(out);
+    return res;
+  }
+};
+
+#ifdef CVC4_THREAD_SAFE_NODES
+TEST_F(TestTheoryBlackQuantifiersEMatchingThreads, same_instantiations)
+{
+  std::stringstream expected;
+  api::Result res = solve("1", expected);
+  ASSERT_TRUE(res.isUnsat());
+  ASSERT_FALSE(expected.str().empty());
+  for (const char* threads : {"2", "4"})
+  {
+    std::stringstream insts;
+    ASSERT_EQ(solve(threads, insts), res);
+    ASSERT_EQ(insts.str(), expected.str());
+  }
+}
+
+#ifdef CVC4_TRACING
+TEST_F(TestTheoryBlackQuantifiersEMatchingThreads, no_tracing)
+{
+  TraceChannel.on("inst-engine");
+  std::stringstream insts;
+  ASSERT_THROW(solve("4", insts), CVC4ApiException);
+  TraceChannel.off("inst-engine");
+}
+#endif
+#endif
+}  // namespace test
+}  // namespace cvc5
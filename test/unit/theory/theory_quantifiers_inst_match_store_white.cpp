@@ -0,0 +1,147 @@
+/*********************                                                        */
+/*! \file theory_quantifiers_inst_match_store_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the flat instantiation stores
+ **
+ ** White box testing of the flat instantiation stores.
+ **/
+
+#include <memory>
+#include <vector>
+
+#include "context/context.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+#include "test_smt.h"
+#include "theory/quantifiers/inst_match_store.h"
+#include "theory/quantifiers/quantifiers_state.h"
+#include "theory/quantifiers_engine.h"
+#include "theory/theory_engine.h"
+
+namespace cvc5 {
+
+using namespace theory;
+using namespace theory::quantifiers;
+
+namespace test {
+
+class TestTheoryWhiteQuantifiersInstMatchStore : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    d_scope.reset(new smt::SmtScope(d_smtEngine.get()));
+    d_context.reset(new context::Context());
+    // a second quantifiers state would register its statistics again
+    d_qstate =
+        &d_smtEngine->getTheoryEngine()->getQuantifiersEngine()->d_qstate;
+    TypeNode u = d_nodeManager->mkSort("U");
+    for (size_t i = 0; i < 4; i++)
+    {
+      d_terms.push_back(d_nodeManager->mkVar(u));
+    }
+    Node x = d_nodeManager->mkBoundVar(u);
+    Node y = d_nodeManager->mkBoundVar(u);
+    Node p = d_nodeManager->mkVar(
+        d_nodeManager->mkFunctionType({u, u}, d_nodeManager->booleanType()));
+    d_quant = d_nodeManager->mkNode(
+        kind::FORALL,
+        d_nodeManager->mkNode(kind::BOUND_VAR_LIST, x, y),
+        d_nodeManager->mkNode(kind::APPLY_UF, p, x, y));
+  }
+
+  /** Get the tuple of the i-th and j-th terms */
+  std::vector<Node> tuple(size_t i, size_t j)
+  {
+    return {d_terms[i], d_terms[j]};
+  }
+
+  std::unique_ptr<smt::SmtScope> d_scope;
+  std::unique_ptr<context::Context> d_context;
+  QuantifiersState* d_qstate;
+  std::vector<Node> d_terms;
+  Node d_quant;
+};
+
+TEST_F(TestTheoryWhiteQuantifiersInstMatchStore, add_remove)
+{
+  InstMatchStore s(2);
+  ASSERT_FALSE(s.existsInstMatch(*d_qstate, d_quant, tuple(0, 1)));
+  ASSERT_TRUE(s.addInstMatch(*d_qstate, d_quant, tuple(0, 1)));
+  ASSERT_FALSE(s.addInstMatch(*d_qstate, d_quant, tuple(0, 1)));
+  ASSERT_TRUE(s.addInstMatch(*d_qstate, d_quant, tuple(1, 0)));
+  ASSERT_TRUE(s.existsInstMatch(*d_qstate, d_quant, tuple(0, 1)));
+  ASSERT_FALSE(s.existsInstMatch(*d_qstate, d_quant, tuple(1, 1)));
+
+  ASSERT_TRUE(s.removeInstMatch(d_quant, tuple(0, 1)));
+  ASSERT_FALSE(s.removeInstMatch(d_quant, tuple(0, 1)));
+  ASSERT_FALSE(s.existsInstMatch(*d_qstate, d_quant, tuple(0, 1)));
+  ASSERT_TRUE(s.existsInstMatch(*d_qstate, d_quant, tuple(1, 0)));
+  ASSERT_TRUE(s.addInstMatch(*d_qstate, d_quant, tuple(0, 1)));
+
+  std::vector<std::vector<Node>> insts;
+  s.getInstantiations(d_quant, insts);
+  ASSERT_EQ(insts.size(), 2);
+  ASSERT_EQ(insts[0], tuple(1, 0));
+  ASSERT_EQ(insts[1], tuple(0, 1));
+  ASSERT_GT(s.getMemoryUsage(), 0);
+}
+
+TEST_F(TestTheoryWhiteQuantifiersInstMatchStore, grow)
+{
+  InstMatchStore s(2);
+  // tuples of fresh terms, which require the table to grow several times
+  std::vector<std::vector<Node>> tuples;
+  TypeNode u = d_terms[0].getType();
+  for (size_t i = 0; i < 1000; i++)
+  {
+    tuples.push_back({d_terms[i % 4], d_nodeManager->mkVar(u)});
+    ASSERT_TRUE(s.addInstMatch(*d_qstate, d_quant, tuples.back()));
+  }
+  for (const std::vector<Node>& t : tuples)
+  {
+    ASSERT_TRUE(s.existsInstMatch(*d_qstate, d_quant, t));
+  }
+  std::vector<std::vector<Node>> insts;
+  s.getInstantiations(d_quant, insts);
+  ASSERT_EQ(insts, tuples);
+  s.clear();
+  ASSERT_FALSE(s.existsInstMatch(*d_qstate, d_quant, tuples[0]));
+}
+
+TEST_F(TestTheoryWhiteQuantifiersInstMatchStore, context_dependent)
+{
+  CDInstMatchStore s(d_context.get(), 2);
+  ASSERT_TRUE(s.addInstMatch(*d_qstate, d_quant, tuple(0, 1)));
+  d_context->push();
+  ASSERT_TRUE(s.addInstMatch(*d_qstate, d_quant, tuple(1, 2)));
+  ASSERT_TRUE(s.removeInstMatch(d_quant, tuple(0, 1)));
+  ASSERT_FALSE(s.existsInstMatch(*d_qstate, d_quant, tuple(0, 1)));
+  d_context->push();
+  ASSERT_TRUE(s.addInstMatch(*d_qstate, d_quant, tuple(0, 1)));
+  ASSERT_TRUE(s.addInstMatch(*d_qstate, d_quant, tuple(2, 3)));
+  d_context->pop();
+  ASSERT_FALSE(s.existsInstMatch(*d_qstate, d_quant, tuple(0, 1)));
+  ASSERT_FALSE(s.existsInstMatch(*d_qstate, d_quant, tuple(2, 3)));
+  ASSERT_TRUE(s.existsInstMatch(*d_qstate, d_quant, tuple(1, 2)));
+  d_context->pop();
+  ASSERT_TRUE(s.existsInstMatch(*d_qstate, d_quant, tuple(0, 1)));
+  ASSERT_FALSE(s.existsInstMatch(*d_qstate, d_quant, tuple(1, 2)));
+  ASSERT_TRUE(s.addInstMatch(*d_qstate, d_quant, tuple(2, 3)));
+
+  std::vector<std::vector<Node>> insts;
+  s.getInstantiations(d_quant, insts);
+  ASSERT_EQ(insts.size(), 2);
+  ASSERT_EQ(insts[0], tuple(0, 1));
+  ASSERT_EQ(insts[1], tuple(2, 3));
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,146 @@
+/*********************                                                        */
+/*! \file theory_quantifiers_term_arg_table_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the flat index of the ground applications of
+ ** an operator
+ **
+ ** White box testing of the flat index of the ground applications of an
+ ** operator.
+ **/
+
+#include <vector>
+
+#include "test_node.h"
+#include "theory/quantifiers/term_arg_table.h"
+
+namespace cvc5 {
+
+using namespace theory;
+using namespace theory::quantifiers;
+
+namespace test {
+
+class TestTheoryWhiteQuantifiersTermArgTable : public TestNode
+{
+ protected:
+  void SetUp() override
+  {
+    TestNode::SetUp();
+    TypeNode u = d_nodeManager->mkSort("U");
+    for (size_t i = 0; i < 4; i++)
+    {
+      d_consts.push_back(d_nodeManager->mkVar(u));
+    }
+    d_f = d_nodeManager->mkVar(d_nodeManager->mkFunctionType({u, u}, u));
+  }
+
+  /** Make the application of f to the i-th and j-th constants */
+  Node mkApp(size_t i, size_t j)
+  {
+    return d_nodeManager->mkNode(
+        kind::APPLY_UF, d_f, d_consts[i], d_consts[j]);
+  }
+
+  /** Get the i-th and j-th constants */
+  std::vector<TNode> args(size_t i, size_t j)
+  {
+    return {d_consts[i], d_consts[j]};
+  }
+
+  std::vector<Node> d_consts;
+  Node d_f;
+};
+
+TEST_F(TestTheoryWhiteQuantifiersTermArgTable, congruence)
+{
+  TermArgTable tat;
+  Node t01 = mkApp(0, 1);
+  Node t10 = mkApp(1, 0);
+  Node t02 = mkApp(0, 2);
+  ASSERT_EQ(tat.addOrGetTerm(t01, args(0, 1), d_consts[3]), t01);
+  ASSERT_EQ(tat.addOrGetTerm(t10, args(1, 0), d_consts[3]), t10);
+  // t02 is congruent to t01 if 2 and 1 are equal
+  ASSERT_EQ(tat.addOrGetTerm(t02, args(0, 1), d_consts[3]), t01);
+  ASSERT_EQ(tat.getNumTerms(), 2);
+  ASSERT_EQ(tat.getTerm(1), t10);
+  ASSERT_EQ(tat.getNumArgs(1), 2);
+  ASSERT_EQ(tat.getArg(1, 0), d_consts[1]);
+  ASSERT_EQ(tat.getRepresentative(1), d_consts[3]);
+
+  ASSERT_EQ(tat.existsTerm(args(0, 1)), t01);
+  ASSERT_TRUE(tat.existsTerm(args(1, 1)).isNull());
+
+  ASSERT_TRUE(tat.inRelevantDomain(0, d_consts[1]));
+  ASSERT_FALSE(tat.inRelevantDomain(0, d_consts[2]));
+  ASSERT_FALSE(tat.inRelevantDomain(2, d_consts[0]));
+  ASSERT_TRUE(tat.hasTermsInEqc(d_consts[3]));
+  ASSERT_FALSE(tat.hasTermsInEqc(d_consts[0]));
+
+  tat.clear();
+  ASSERT_EQ(tat.getNumTerms(), 0);
+  ASSERT_TRUE(tat.existsTerm(args(0, 1)).isNull());
+  ASSERT_FALSE(tat.hasTermsInEqc(d_consts[3]));
+}
+
+TEST_F(TestTheoryWhiteQuantifiersTermArgTable, grow)
+{
+  TermArgTable tat;
+  std::vector<Node> terms;
+  TypeNode u = d_consts[0].getType();
+  for (size_t i = 0; i < 1000; i++)
+  {
+    Node c = d_nodeManager->mkVar(u);
+    terms.push_back(
+        d_nodeManager->mkNode(kind::APPLY_UF, d_f, d_consts[i % 4], c));
+    std::vector<TNode> reps = {d_consts[i % 4], c};
+    ASSERT_EQ(tat.addOrGetTerm(terms.back(), reps, c), terms.back());
+  }
+  for (size_t i = 0; i < 1000; i++)
+  {
+    std::vector<TNode> reps = {terms[i][0], terms[i][1]};
+    ASSERT_EQ(tat.existsTerm(reps), terms[i]);
+    ASSERT_EQ(tat.getTerm(i), terms[i]);
+  }
+}
+
+TEST_F(TestTheoryWhiteQuantifiersTermArgTable, tries)
+{
+  TermArgTable tat;
+  Node t01 = mkApp(0, 1);
+  Node t02 = mkApp(0, 2);
+  Node t12 = mkApp(1, 2);
+  tat.addOrGetTerm(t01, args(0, 1), d_consts[3]);
+  // not in the equality engine
+  tat.addUnindexedTerm(t02, args(0, 2), t02);
+
+  TNodeTrie* trie = tat.getTrie();
+  ASSERT_EQ(trie->existsTerm(args(0, 1)), t01);
+  ASSERT_TRUE(trie->existsTerm(args(0, 2)).isNull());
+  TNodeTrie* eqcTrie = tat.getEqcTrie();
+  ASSERT_EQ(eqcTrie->d_data.size(), 2);
+  ASSERT_EQ(eqcTrie->d_data[d_consts[3]].existsTerm(args(0, 1)), t01);
+  ASSERT_EQ(eqcTrie->d_data[t02].existsTerm(args(0, 2)), t02);
+  ASSERT_TRUE(tat.hasTermsInEqc(t02));
+
+  // the tries are extended with the terms added since
+  tat.addOrGetTerm(t12, args(1, 2), d_consts[3]);
+  ASSERT_EQ(tat.getTrie()->existsTerm(args(1, 2)), t12);
+  ASSERT_EQ(tat.getEqcTrie()->d_data[d_consts[3]].existsTerm(args(1, 2)), t12);
+
+  std::vector<Node> uterms;
+  tat.takeUnindexedTerms(uterms);
+  ASSERT_EQ(uterms, std::vector<Node>{t02});
+  ASSERT_TRUE(tat.getUnindexedTerms().empty());
+  ASSERT_EQ(tat.getEqcTrie()->d_data.size(), 1);
+  ASSERT_FALSE(tat.hasTermsInEqc(t02));
+  ASSERT_TRUE(tat.hasTermsInEqc(d_consts[3]));
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,156 @@
+/*********************                                                        */
+/*! \file theory_quantifiers_trigger_index_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the discrimination tree of trigger patterns.
+ **
+ ** White box testing of the selection of the ground terms that non-simple
+ ** single triggers are matched against (--trigger-index).
+ **/
+
+#include <algorithm>
+#include <vector>
+
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+#include "test_smt.h"
+#include "theory/quantifiers/ematching/inst_match_generator.h"
+#include "theory/quantifiers/ematching/inst_strategy_e_matching.h"
+#include "theory/quantifiers/ematching/instantiation_engine.h"
+#include "theory/quantifiers/ematching/trigger_index.h"
+#include "theory/quantifiers/quantifiers_modules.h"
+#include "theory/quantifiers_engine.h"
+#include "theory/theory_engine.h"
+
+namespace cvc5 {
+
+using namespace kind;
+using namespace theory;
+using namespace theory::quantifiers;
+using namespace theory::quantifiers::inst;
+
+namespace test {
+
+class TestTheoryWhiteQuantifiersTriggerIndex : public TestSmtNoFinishInit
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmtNoFinishInit::SetUp();
+    d_smtEngine->setLogic("UF");
+    // keep the equalities between constants, which would be substituted
+    d_smtEngine->setOption("simplification", "none");
+    // find the instances by E-matching, not by conflict-based instantiation
+    d_smtEngine->setOption("quant-cf", "false");
+    d_smtEngine->finishInit();
+    TypeNode u = d_nodeManager->mkSort("U");
+    TypeNode boolType = d_nodeManager->booleanType();
+    d_f = d_nodeManager->mkVar("f",
+                               d_nodeManager->mkFunctionType({u, u, u}, u));
+    d_g = d_nodeManager->mkVar("g", d_nodeManager->mkFunctionType(u, u));
+    d_p = d_nodeManager->mkVar("P", d_nodeManager->mkFunctionType(u, boolType));
+    d_q = d_nodeManager->mkVar("Q", d_nodeManager->mkFunctionType(u, boolType));
+    for (const char* name : {"a", "b", "c", "d", "e"})
+    {
+      d_consts.push_back(d_nodeManager->mkVar(name, u));
+    }
+    d_x = d_nodeManager->mkBoundVar("x", u);
+    d_y = d_nodeManager->mkBoundVar("y", u);
+  }
+
+  Node f(Node s, Node t, Node r)
+  {
+    return d_nodeManager->mkNode(APPLY_UF, d_f, s, t, r);
+  }
+  Node g(Node s) { return d_nodeManager->mkNode(APPLY_UF, d_g, s); }
+  Node p(Node s) { return d_nodeManager->mkNode(APPLY_UF, d_p, s); }
+  Node q(Node s) { return d_nodeManager->mkNode(APPLY_UF, d_q, s); }
+  Node forall(const std::vector<Node>& vars, Node body)
+  {
+    return d_nodeManager->mkNode(
+        FORALL, d_nodeManager->mkNode(BOUND_VAR_LIST, vars), body);
+  }
+
+  /**
+   * Get the candidates of the last instantiation round of the indexed trigger
+   * whose pattern is an application of f with last argument arg, or an
+   * application of g if arg is null.
+   */
+  std::vector<Node> getCandidates(Node arg)
+  {
+    smt::SmtScope scope(d_smtEngine.get());
+    QuantifiersEngine* qe =
+        d_smtEngine->getTheoryEngine()->getQuantifiersEngine();
+    TriggerIndex* index =
+        qe->d_qmodules->d_inst_engine->d_i_ag->d_index.get();
+    EXPECT_NE(index, nullptr);
+    for (size_t i = 0, ngens = index->d_gens.size(); i < ngens; i++)
+    {
+      Node pat = index->d_gens[i]->d_pattern;
+      if (pat.getOperator() == d_f
+          && (arg.isNull() ? pat[2].getKind() == APPLY_UF : pat[2] == arg))
+      {
+        std::vector<Node> cands = index->d_cands[i];
+        std::sort(cands.begin(), cands.end());
+        return cands;
+      }
+    }
+    ADD_FAILURE() << "no indexed trigger for an application of f";
+    return {};
+  }
+
+  std::vector<Node> d_consts;
+  Node d_f;
+  Node d_g;
+  Node d_p;
+  Node d_q;
+  Node d_x;
+  Node d_y;
+};
+
+TEST_F(TestTheoryWhiteQuantifiersTriggerIndex, pruning)
+{
+  Node a = d_consts[0];
+  Node b = d_consts[1];
+  Node c = d_consts[2];
+  Node d = d_consts[3];
+  Node e = d_consts[4];
+  // the triggers are f(x, g(y), a) and f(x, y, g(y)), which are not simple
+  // since g(y) does not contain x
+  d_smtEngine->assertFormula(forall({d_x, d_y}, p(f(d_x, g(d_y), a))));
+  d_smtEngine->assertFormula(forall({d_x, d_y}, q(f(d_x, d_y, g(d_y)))));
+  Node fbea = f(b, e, a);
+  Node fcgcd = f(c, g(c), d);
+  Node fbba = f(b, b, a);
+  Node fabe = f(a, b, e);
+  Node fcagc = f(c, a, g(c));
+  d_smtEngine->assertFormula(p(f(b, c, c)));
+  d_smtEngine->assertFormula(q(fbea));
+  d_smtEngine->assertFormula(q(fcagc));
+  d_smtEngine->assertFormula(q(fcgcd).andNode(p(fbba)).andNode(p(fabe)));
+  d_smtEngine->assertFormula(d.eqNode(a));
+  d_smtEngine->assertFormula(e.eqNode(g(b)));
+  // the triggers are created and matched against all terms in the first
+  // instantiation round, and indexed from the second round on, which finds
+  // no new instances since the problem is satisfiable
+  ASSERT_NE(d_smtEngine->checkSat().isSat(), Result::UNSAT);
+
+  // f(x, g(y), a) is only matched against the terms whose second argument is
+  // equal to an application of g and whose third argument is equal to a,
+  // f(x, y, g(y)) against those whose third argument is equal to an
+  // application of g
+  std::vector<Node> expected = {fbea, fcgcd};
+  std::sort(expected.begin(), expected.end());
+  ASSERT_EQ(getCandidates(a), expected);
+  expected = {fabe, fcagc};
+  std::sort(expected.begin(), expected.end());
+  ASSERT_EQ(getCandidates(Node::null()), expected);
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -202,5 +202,62 @@ TEST_F(TestUtilBlackBitVector, static_helpers)
   ASSERT_EQ(BitVector::mkMinSigned(4).toSignedInteger(), Integer(-8));
   ASSERT_EQ(BitVector::mkMaxSigned(4).toSignedInteger(), Integer(7));
 }
+
+TEST_F(TestUtilBlackBitVector, word_size_boundaries)
+{
+  // bit-vectors of up to 64 bits are stored in a machine word, larger ones as
+  // Integer; results must agree across that boundary
+  for (unsigned size : {1u, 63u, 64u, 65u, 128u})
+  {
+    Integer mod = Integer(1).multiplyByPow2(size);
+    BitVector ones = BitVector::mkOnes(size);
+    BitVector min = BitVector::mkMinSigned(size);
+    BitVector max = BitVector::mkMaxSigned(size);
+    BitVector one = BitVector::mkOne(size);
+    BitVector zero = BitVector::mkZero(size);
+    ASSERT_EQ(ones.getValue(), mod - 1);
+    ASSERT_EQ(BitVector(size, Integer(-1)), ones);
+    ASSERT_EQ(ones.toSignedInteger(), Integer(-1));
+    ASSERT_EQ(min.toSignedInteger(), -Integer(1).multiplyByPow2(size - 1));
+    ASSERT_EQ(max.toSignedInteger(), Integer(1).multiplyByPow2(size - 1) - 1);
+    ASSERT_EQ(ones.toString(), std::string(size, '1'));
+    ASSERT_EQ(min.isPow2(), size);
+
+    ASSERT_EQ(ones + one, zero);
+    ASSERT_EQ(zero - one, ones);
+    ASSERT_EQ(-one, ones);
+    ASSERT_EQ(ones * ones, one);
+    ASSERT_EQ(ones.unsignedDivTotal(zero), ones);
+    ASSERT_EQ(ones.unsignedRemTotal(zero), ones);
+    ASSERT_EQ(ones.unsignedDivTotal(ones), one);
+    ASSERT_EQ(~min, max);
+    ASSERT_EQ(min | max, ones);
+    ASSERT_EQ(min & max, zero);
+    ASSERT_EQ(min ^ ones, max);
+
+    ASSERT_TRUE(min.signedLessThan(max));
+    ASSERT_TRUE(ones.signedLessThan(zero));
+    ASSERT_TRUE(zero.unsignedLessThan(ones));
+    ASSERT_TRUE(max < min);
+
+    BitVector amount(size, uint64_t(size - 1));
+    ASSERT_EQ(one.leftShift(amount), min);
+    ASSERT_EQ(min.logicalRightShift(amount), one);
+    ASSERT_EQ(min.arithRightShift(amount), ones);
+    ASSERT_EQ(min.arithRightShift(ones), ones);
+    ASSERT_EQ(max.arithRightShift(ones), zero);
+    ASSERT_EQ(one.leftShift(ones), zero);
+
+    ASSERT_EQ(ones.zeroExtend(size).getValue(), mod - 1);
+    ASSERT_EQ(ones.signExtend(size), BitVector::mkOnes(2 * size));
+    ASSERT_EQ(min.concat(one).extract(2 * size - 1, size), min);
+    ASSERT_EQ(min.concat(one).extract(size - 1, 0), one);
+    ASSERT_EQ(min.concat(one).extract(2 * size - 1, 2 * size - 1),
+              BitVector::mkOne(1));
+    ASSERT_EQ(ones.concat(zero).extract(2 * size - 1, size), ones);
+    ASSERT_EQ(BitVector(size, one).getValue(), Integer(1));
+    ASSERT_EQ(ones.hash(), BitVector(size, mod - 1).hash());
+  }
+}
 }  // namespace test
 }  // namespace cvc5
@@ -14,6 +14,7 @@
  ** Black box testing of cvc5::Rational.
  **/
 
+#include <limits>
 #include <sstream>
 
 #include "test.h"
@@ -43,5 +44,40 @@ TEST_F(TestUtilBlackRational, fromDecimal)
   ASSERT_THROW(Rational::fromDecimal("1.2/3");, std::invalid_argument);
   ASSERT_THROW(Rational::fromDecimal("Hello, world!");, std::invalid_argument);
 }
+
+TEST_F(TestUtilBlackRational, overflow)
+{
+  // values that fit into 64 bits are computed without GMP, results that do
+  // not fit must be promoted
+  const long max = std::numeric_limits<long>::max();
+  const long min = std::numeric_limits<long>::min();
+  Rational rmax(max);
+  Rational rmin(min);
+  Rational one(1);
+  Integer imax(max);
+  Integer imin(min);
+
+  ASSERT_EQ(rmax + one, Rational(imax + 1));
+  ASSERT_EQ((rmax + one) - one, rmax);
+  ASSERT_EQ(rmin, Rational(imin));
+  ASSERT_EQ(-rmin, Rational(-imin));
+  ASSERT_EQ(-(-rmin), rmin);
+  ASSERT_EQ(rmin + one, -rmax);
+  ASSERT_EQ(rmax * rmax, Rational(imax * imax));
+  ASSERT_EQ((rmax * rmax) / rmax, rmax);
+  ASSERT_EQ(Rational(1L, max) + Rational(1L, max - 1),
+            Rational(imax + Integer(max - 1), imax * Integer(max - 1)));
+  ASSERT_EQ(Rational(max, 2L) * Rational(2L, max), one);
+  ASSERT_EQ(Rational(min, 2L).getNumerator(), Integer(min / 2));
+  ASSERT_EQ(Rational(1L, min).getDenominator(), -imin);
+  ASSERT_EQ(rmin.inverse().getDenominator(), -imin);
+  ASSERT_TRUE(rmin < rmax);
+  ASSERT_TRUE(Rational(max, 3L) > Rational(max - 1, 3L));
+  ASSERT_EQ(Rational(-7, 2).floor(), Integer(-4));
+  ASSERT_EQ(Rational(-7, 2).ceiling(), Integer(-3));
+  ASSERT_EQ(Rational(6, -4), Rational(-3, 2));
+  ASSERT_EQ(Rational(6, -4).toString(), "-3/2");
+  ASSERT_EQ((rmax + one).toString(), "9223372036854775808");
+}
 }  // namespace test
 }  // namespace cvc5
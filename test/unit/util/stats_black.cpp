@@ -23,6 +23,7 @@
 #include "expr/proof_rule.h"
 #include "lib/clock_gettime.h"
 #include "test.h"
+#include "util/statistics_export.h"
 #include "util/statistics_registry.h"
 #include "util/stats_histogram.h"
 #include "util/stats_timer.h"
@@ -160,5 +161,56 @@ TEST_F(TestUtilBlackStats, stats)
   ASSERT_EQ(ret, 0);
 #endif
 }
+
+TEST_F(TestUtilBlackStats, sample)
+{
+#ifdef CVC4_STATISTICS_ON
+  StatisticsRegistry reg;
+  IntStat sInt("int", 3);
+  TimerStat sTimer("timer");
+  BackedStat<std::string> backedStr("backed", "baz");
+  RegisterStatistic r1(&reg, &sInt);
+  RegisterStatistic r2(&reg, &sTimer);
+  RegisterStatistic r3(&reg, &backedStr);
+
+  sInt += 4;
+  ++sInt;
+  sInt.maxAssign(5);
+  ASSERT_EQ(sInt.get(), 8);
+  sInt.maxAssign(10);
+  sInt.minAssign(9);
+  ASSERT_EQ(sInt.get(), 9);
+
+  sTimer.start();
+  ASSERT_TRUE(sTimer.running());
+  sTimer.stop();
+  ASSERT_FALSE(sTimer.running());
+
+  // only the counters and timers may be sampled
+  std::vector<std::pair<std::string, double>> values;
+  reg.sample(values);
+  ASSERT_EQ(values.size(), 2u);
+  ASSERT_EQ(values[0].first, "int");
+  ASSERT_EQ(values[0].second, 9);
+  ASSERT_EQ(values[1].first, "timer");
+  ASSERT_EQ(values[1].second,
+            std::chrono::duration<double>(sTimer.get()).count());
+#endif
+}
+
+TEST_F(TestUtilBlackStats, sampleExport)
+{
+  std::vector<std::pair<std::string, double>> values = {
+      {"a::b", 12345678}, {"c \"d\"", 0.5}};
+  std::stringstream json;
+  printStatisticsJson(json, values);
+  ASSERT_EQ(json.str(),
+            "{\n  \"a::b\": 12345678,\n  \"c \\\"d\\\"\": 0.5\n}\n");
+  std::stringstream prom;
+  printStatisticsPrometheus(prom, values);
+  ASSERT_EQ(prom.str(),
+            "# HELP cvc4_a__b a::b\ncvc4_a__b 12345678\n"
+            "# HELP cvc4_c__d_ c \"d\"\ncvc4_c__d_ 0.5\n");
+}
 }  // namespace test
 }  // namespace cvc5